@@ -7,10 +7,8 @@ ConnectionManager::ConnectionManager(const std::string& streamerId)
 }
 
 opentera::WebrtcConfiguration ConnectionManager::createWebRTCConfig() {
-    std::vector<opentera::IceServer> iceServers = {
-        opentera::IceServer("stun:stun2.l.google.com:19302"),
-    };
-    return opentera::WebrtcConfiguration::create(iceServers);
+    // The streamers are on the same local network, a STUN server only delays the candidate gathering
+    return opentera::WebrtcConfiguration::createForLocalNetwork();
 }
 
 opentera::SignalingServerConfiguration ConnectionManager::createSignalingConfig() {
@@ -1,9 +1,67 @@
 #include "datachannel_observer.h"
+#include "telemetry_protocol.h"
 #include <iostream>
 #include <stdexcept>
 
-CustomDataChannelObserver::CustomDataChannelObserver(const std::string& streamerId)
-    : m_streamerId(streamerId) {
+using namespace opentera;
+
+CustomDataChannelObserver::CustomDataChannelObserver(const std::string& streamerId,
+                                                     std::shared_ptr<PixelStreamingLatencyProbe> latencyProbe,
+                                                     std::shared_ptr<PixelStreamingClockSync> clockSync,
+                                                     std::shared_ptr<DataChannelSendQueue> sendQueue)
+    : m_streamerId(streamerId)
+    , m_latencyProbe(std::move(latencyProbe))
+    , m_clockSync(std::move(clockSync))
+    , m_sendQueue(std::move(sendQueue)) {
+    m_dispatcher.setOnError([this](const std::string& error) {
+        std::cerr << "Error in OnMessage for streamer " << m_streamerId << ": " << error << std::endl;
+    });
+
+    m_dispatcher.setOnCustomMessage(TelemetryProtocol::TransformJsonMessageId,
+                                    [this](const PixelStreamingCustomMessage& message) {
+        // Add JSON data to synchronizer
+        if (g_frameSynchronizer) {
+            g_frameSynchronizer->addJsonData(m_streamerId, message.text());
+        } else {
+            std::cerr << "Warning: Frame synchronizer not initialized" << std::endl;
+        }
+    });
+
+    // Sent instead of the JSON data by the streamers that accepted the telemetry format request
+    m_dispatcher.setOnCustomMessage(TelemetryProtocol::TransformBinaryMessageId,
+                                    [this](const PixelStreamingCustomMessage& message) {
+        if (g_frameSynchronizer) {
+            g_frameSynchronizer->addBinaryData(m_streamerId, message.data, message.dataSize);
+        }
+    });
+
+    m_dispatcher.setOnCustomMessage(TelemetryProtocol::ClockSyncResponseMessageId,
+                                    [this](const PixelStreamingCustomMessage& message) {
+        if (m_clockSync) {
+            m_clockSync->handleCustomMessage(message);
+        }
+    });
+
+    m_dispatcher.setOnQualityControlOwnership([this](const PixelStreamingQualityControlOwnershipMessage& message) {
+        std::cout << "Quality control ownership for streamer " << m_streamerId << ": "
+                  << message.hasQualityControlOwnership << std::endl;
+    });
+
+    m_dispatcher.setOnTextMessage([this](const PixelStreamingTextMessage& message) {
+        if (m_latencyProbe && m_latencyProbe->handleTextMessage(message)) {
+            return;
+        }
+        if (message.id == PixelStreamingFromStreamerMessageId::InitialSettings) {
+            std::cout << "Initial settings for streamer " << m_streamerId << ": "
+                      << message.text.toUtf8() << std::endl;
+        }
+    });
+
+    m_dispatcher.setOnVideoEncoderAvgQP([this](const PixelStreamingVideoEncoderAvgQPMessage& message) {
+        if (m_latencyProbe) {
+            m_latencyProbe->handleVideoEncoderAvgQP(message);
+        }
+    });
 }
 
 void CustomDataChannelObserver::OnStateChange() {
@@ -12,24 +70,7 @@ void CustomDataChannelObserver::OnStateChange() {
 
 void CustomDataChannelObserver::OnMessage(const webrtc::DataBuffer& buffer) {
     try {
-        if (buffer.data.size() < 1) {
-            std::cerr << "Received empty buffer" << std::endl;
-            return;
-        }
-
-        uint8_t messageId = buffer.data[0];
-        
-        if (messageId == 123) {  // Transform data message
-            const char* data = reinterpret_cast<const char*>(buffer.data.data() + 1);
-            std::string jsonStr(data, buffer.data.size() - 1);
-            
-            // Add JSON data to synchronizer
-            if (g_frameSynchronizer) {
-                g_frameSynchronizer->addJsonData(m_streamerId, jsonStr);
-            } else {
-                std::cerr << "Warning: Frame synchronizer not initialized" << std::endl;
-            }
-        }
+        m_dispatcher.dispatch(buffer);
     } catch (const std::exception& e) {
         std::cerr << "Error in OnMessage for streamer " << m_streamerId 
                   << ": " << e.what() << std::endl;
@@ -37,5 +78,7 @@ void CustomDataChannelObserver::OnMessage(const webrtc::DataBuffer& buffer) {
 }
 
 void CustomDataChannelObserver::OnBufferedAmountChange(uint64_t previous_amount) {
-    // Empty implementation
-}
\ No newline at end of file
+    if (m_sendQueue) {
+        m_sendQueue->onBufferedAmountChange();
+    }
+}
@@ -1,6 +1,11 @@
 #pragma once
 #include <api/data_channel_interface.h>
 #include <rtc_base/ref_count.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingClockSync.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingLatencyProbe.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingProtocol.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelSendQueue.h>
+#include <memory>
 #include <string>
 #include "frame_synchronizer.h"
 
@@ -11,31 +16,26 @@ class CustomDataChannelObserver :
     public webrtc::DataChannelObserver,
     public rtc::RefCountInterface {
 public:
-    explicit CustomDataChannelObserver(const std::string& streamerId);
+    // The latency probe receives the LatencyTest responses and the encoder QP,
+    // the clock sync receives the clock synchronization responses. Both can be null.
+    // The send queue of the data channel is resumed when the buffered amount changes, it can be null.
+    CustomDataChannelObserver(const std::string& streamerId,
+                              std::shared_ptr<opentera::PixelStreamingLatencyProbe> latencyProbe,
+                              std::shared_ptr<opentera::PixelStreamingClockSync> clockSync,
+                              std::shared_ptr<opentera::DataChannelSendQueue> sendQueue);
 
     // Virtual functions declarations
     void OnStateChange() override;
     void OnMessage(const webrtc::DataBuffer& buffer) override;
     void OnBufferedAmountChange(uint64_t previous_amount) override;
 
-    struct MessageHeader {
-        uint8_t messageType;    
-        uint32_t payloadLength;
-    
-        static MessageHeader Parse(const uint8_t* data) {
-            MessageHeader header;
-            if (!data) {
-                throw std::runtime_error("Invalid data pointer for header parsing");
-            }
-            header.messageType = data[0];
-            memcpy(&header.payloadLength, data + 1, sizeof(uint32_t));
-            return header;
-        }
-    };
-
 protected:
     ~CustomDataChannelObserver() override = default;
 
 private:
     std::string m_streamerId;
-};
\ No newline at end of file
+    std::shared_ptr<opentera::PixelStreamingLatencyProbe> m_latencyProbe;
+    std::shared_ptr<opentera::PixelStreamingClockSync> m_clockSync;
+    std::shared_ptr<opentera::DataChannelSendQueue> m_sendQueue;
+    opentera::PixelStreamingMessageDispatcher m_dispatcher;
+};
@@ -1,19 +1,31 @@
 #include "frame_synchronizer.h"
+#include "transform_decoder.h"
+#include <rtc_base/time_utils.h>
+#include <cmath>
 #include <iostream>
 
+// Returns the local time minus the streamer time at remoteTimeUs, like ClockOffsetEstimator::toLocalTimeUs
+static int64_t estimateClockOffsetUs(const opentera::ClockOffsetEstimate& estimate, int64_t remoteTimeUs) {
+    double elapsedS = static_cast<double>(remoteTimeUs - estimate.offsetUs - estimate.referenceTimeUs) / 1e6;
+    return -(estimate.offsetUs + static_cast<int64_t>(std::llround(elapsedS * estimate.driftPpm)));
+}
+
 FrameSynchronizer::FrameSynchronizer(const std::vector<std::string>& streamerIds,
                                    size_t queueSize,
                                    uint64_t syncThresholdMs)
     : m_streamerIds(streamerIds)
+    , m_telemetryStore(streamerIds)
     , m_maxQueueSize(queueSize)
     , m_syncThresholdMs(syncThresholdMs)
     , m_isRunning(true)
 {
     // Initialize frame queues for each streamer
     for (const auto& id : streamerIds) {
-        m_frameQueues[id] = std::queue<std::pair<uint64_t, cv::Mat>>();
-        m_latestJsonData[id] = "";  // Initialize JSON data
+        m_frameQueues[id] = std::queue<std::pair<uint64_t, opentera::PooledVideoFrame>>();
     }
+
+    // Every streamer can send telemetry, so a frame set has at most one transform per streamer pair
+    m_transformBatch.reserve(streamerIds.size() * streamerIds.size());
 }
 
 FrameSynchronizer::~FrameSynchronizer() {
@@ -28,10 +40,20 @@ void FrameSynchronizer::stop() {
 
 void FrameSynchronizer::clearQueues() {
     for (auto& queue : m_frameQueues) {
-        std::queue<std::pair<uint64_t, cv::Mat>> empty;
+        std::queue<std::pair<uint64_t, opentera::PooledVideoFrame>> empty;
         std::swap(queue.second, empty);
     }
-    m_latestJsonData.clear();
+    m_telemetryStore.clear();
+}
+
+void FrameSynchronizer::setClockSync(const std::string& streamerId,
+                                     std::shared_ptr<opentera::PixelStreamingClockSync> clockSync) {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (clockSync) {
+        m_clockSyncs[streamerId] = std::move(clockSync);
+    } else {
+        m_clockSyncs.erase(streamerId);
+    }
 }
 
 void FrameSynchronizer::setCallback(SyncCallback callback) {
@@ -39,22 +61,92 @@ void FrameSynchronizer::setCallback(SyncCallback callback) {
     m_callback = callback;
 }
 
-void FrameSynchronizer::addJsonData(const std::string& streamerId, const std::string& jsonData) {
+void FrameSynchronizer::addJsonData(const std::string& streamerId, std::string_view jsonData) {
+    int64_t receiveTimeUs = rtc::TimeMicros();
+
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+    if (!TransformDecoder::decode(jsonData, sample, remoteTimeUs)) {
+        std::cerr << "Invalid transform data from streamer " << streamerId << std::endl;
+        return;
+    }
+    addTransform(streamerId, sample, remoteTimeUs, receiveTimeUs);
+}
+
+void FrameSynchronizer::addBinaryData(const std::string& streamerId, const uint8_t* data, size_t size) {
+    int64_t receiveTimeUs = rtc::TimeMicros();
+
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+    if (!TransformDecoder::decodeBinary(data, size, sample, remoteTimeUs)) {
+        std::cerr << "Invalid binary transform data from streamer " << streamerId << std::endl;
+        return;
+    }
+    addTransform(streamerId, sample, remoteTimeUs, receiveTimeUs);
+}
+
+void FrameSynchronizer::addTransform(const std::string& streamerId, TransformSample& sample, int64_t remoteTimeUs,
+                                     int64_t receiveTimeUs) {
     std::unique_lock<std::mutex> lock(m_mutex);
-    
     if (!m_isRunning) {
         return;
     }
 
-    // Update JSON data for this streamer
-    auto it = m_latestJsonData.find(streamerId);
-    if (it != m_latestJsonData.end()) {
-        it->second = jsonData;
+    std::optional<opentera::ClockOffsetEstimate> estimate;
+    auto clockSyncIt = m_clockSyncs.find(streamerId);
+    if (clockSyncIt != m_clockSyncs.end()) {
+        estimate = clockSyncIt->second->estimate();
+    }
+    SampleClock clock{estimate, updateReceiveOffsetUs(streamerId, remoteTimeUs, receiveTimeUs)};
+
+    // Every sample is converted once, with the offset at its own time. The stored samples are only moved when the
+    // estimate changes, otherwise the samples converted with a smaller offset would be older than the stored ones
+    // and dropped.
+    auto it = m_sampleClocks.find(streamerId);
+    if (it == m_sampleClocks.end()) {
+        m_sampleClocks.emplace(streamerId, clock);
+    } else if (!isSameClock(it->second, clock)) {
+        m_telemetryStore.shiftSamples(
+            streamerId, clockOffsetUs(clock, remoteTimeUs) - clockOffsetUs(it->second, remoteTimeUs));
+        it->second = clock;
     }
+
+    sample.timestampUs = remoteTimeUs + clockOffsetUs(clock, remoteTimeUs);
+    m_telemetryStore.addSample(streamerId, sample);
+}
+
+int64_t FrameSynchronizer::clockOffsetUs(const SampleClock& clock, int64_t remoteTimeUs) {
+    return clock.estimate ? estimateClockOffsetUs(*clock.estimate, remoteTimeUs) : clock.receiveOffsetUs;
+}
+
+// The estimates are replaced on every clock synchronization response, so they are compared by their values
+bool FrameSynchronizer::isSameClock(const SampleClock& a, const SampleClock& b) {
+    if (a.estimate.has_value() != b.estimate.has_value()) {
+        return false;
+    }
+    if (!a.estimate) {
+        return a.receiveOffsetUs == b.receiveOffsetUs;
+    }
+    return a.estimate->referenceTimeUs == b.estimate->referenceTimeUs &&
+           a.estimate->offsetUs == b.estimate->offsetUs &&
+           a.estimate->driftPpm == b.estimate->driftPpm;
+}
+
+int64_t FrameSynchronizer::updateReceiveOffsetUs(const std::string& streamerId, int64_t remoteTimeUs,
+                                                 int64_t receiveTimeUs) {
+    // The smallest difference between the receive time and the streamer time is the clock offset plus the
+    // smallest transmission delay, which is the best estimate available without a clock synchronization.
+    int64_t offsetUs = receiveTimeUs - remoteTimeUs;
+    auto it = m_receiveOffsetsUs.find(streamerId);
+    if (it == m_receiveOffsetsUs.end() || offsetUs < it->second) {
+        m_receiveOffsetsUs[streamerId] = offsetUs;
+        return offsetUs;
+    }
+    return it->second;
 }
 
 void FrameSynchronizer::addFrame(const std::string& streamerId, 
-                               const cv::Mat& frame, 
+                               const opentera::PooledVideoFrame& frame, 
                                uint64_t timestampUs) {
     std::unique_lock<std::mutex> lock(m_mutex);
     
@@ -69,9 +161,27 @@ void FrameSynchronizer::addFrame(const std::string& streamerId,
         return;
     }
 
-    // Add frame to queue
+    // Frames are matched with their receive time until the streamer sent its first RTCP sender report, then with
+    // their capture time. A stream never mixes both clocks, since the capture time is earlier by the stream latency.
     auto& queue = it->second;
-    queue.push({timestampUs, frame.clone()});
+    bool& usesCaptureTime = m_usesCaptureTimes[streamerId];
+    int64_t captureTimeUs = frame.timestamps().captureTimeUs;
+    if (captureTimeUs >= 0 && !usesCaptureTime) {
+        usesCaptureTime = true;
+        std::queue<std::pair<uint64_t, opentera::PooledVideoFrame>> empty;
+        std::swap(queue, empty);
+    }
+
+    uint64_t frameTimeUs = timestampUs;
+    if (usesCaptureTime) {
+        if (captureTimeUs < 0) {
+            return;
+        }
+        frameTimeUs = static_cast<uint64_t>(captureTimeUs);
+    }
+
+    // Add frame to queue
+    queue.push({frameTimeUs, frame});
 
     // Remove old frames if queue is too large
     while (queue.size() > m_maxQueueSize) {
@@ -111,14 +221,18 @@ void FrameSynchronizer::trySync() {
     }
 
     if (canSync && m_callback) {
-        // Collect synchronized frames
-        std::unordered_map<std::string, cv::Mat> syncedFrames;
-        for (auto& pair : m_frameQueues) {
-            syncedFrames[pair.first] = pair.second.front().second.clone();
-            pair.second.pop();
+        // Collect synchronized frames and the transforms at their capture time
+        std::unordered_map<std::string, opentera::PooledVideoFrame> syncedFrames;
+        m_transformBatch.clear();
+        for (size_t i = 0; i < m_streamerIds.size(); i++) {
+            auto& queue = m_frameQueues[m_streamerIds[i]];
+            auto& [frameTimeUs, frame] = queue.front();
+            m_telemetryStore.appendSamplesAt(static_cast<int64_t>(frameTimeUs), static_cast<uint16_t>(i), m_transformBatch);
+            syncedFrames[m_streamerIds[i]] = std::move(frame);
+            queue.pop();
         }
 
-        // Call callback with synchronized frames and current JSON data
-        m_callback(syncedFrames, m_latestJsonData);
+        // Call callback with synchronized frames and their transforms
+        m_callback(syncedFrames, m_transformBatch);
     }
 }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingClockSync.h>
+#include <OpenteraWebrtcNativeClient/Sinks/VideoFramePool.h>
+#include "telemetry_store.h"
+
 #include <opencv2/core.hpp>
 #include <unordered_map>
 #include <queue>
@@ -7,15 +11,18 @@
 #include <condition_variable>
 #include <functional>
 #include <memory>
+#include <optional>
 #include <vector>
 #include <string>
+#include <string_view>
 
 class FrameSynchronizer {
 public:
-    // Define callback type for synchronized frames and JSON data
+    // Define callback type for synchronized frames and their transforms.
+    // The batch indexes refer to streamerIds() and the batch is only valid during the callback.
     using SyncCallback = std::function<void(
-        const std::unordered_map<std::string, cv::Mat>&,
-        const std::unordered_map<std::string, std::string>&
+        const std::unordered_map<std::string, opentera::PooledVideoFrame>&,
+        const TransformBatch&
     )>;
     
     // Constructor
@@ -27,10 +34,18 @@ public:
     ~FrameSynchronizer();
 
     // Add a new frame from a specific streamer
-    void addFrame(const std::string& streamerId, const cv::Mat& frame, uint64_t timestampUs);
+    // The frame is kept without copying its pixels
+    void addFrame(const std::string& streamerId, const opentera::PooledVideoFrame& frame, uint64_t timestampUs);
+
+    // Add JSON transform data from a specific streamer (see TransformDecoder for the schema)
+    void addJsonData(const std::string& streamerId, std::string_view jsonData);
 
-    // Add JSON data from a specific streamer
-    void addJsonData(const std::string& streamerId, const std::string& jsonData);
+    // Add binary transform data from a specific streamer (TelemetryProtocol::BinaryTransformV1)
+    void addBinaryData(const std::string& streamerId, const uint8_t* data, size_t size);
+
+    // Set the clock synchronization of a streamer, used to convert its transform timestamps to the local clock.
+    // Until it has an estimate, and when it is null, the smallest receive delay is used as the clock offset.
+    void setClockSync(const std::string& streamerId, std::shared_ptr<opentera::PixelStreamingClockSync> clockSync);
 
     // Set callback for synchronized data
     void setCallback(SyncCallback callback);
@@ -38,6 +53,8 @@ public:
     // Stop synchronizer
     void stop();
 
+    const std::vector<std::string>& streamerIds() const { return m_streamerIds; }
+
 private:
     // Internal synchronization check
     void trySync();
@@ -45,10 +62,32 @@ private:
     // Clear all queues
     void clearQueues();
 
+    void addTransform(const std::string& streamerId, TransformSample& sample, int64_t remoteTimeUs,
+                      int64_t receiveTimeUs);
+
+    // Returns the smallest receive time minus streamer time of the streamer, which is the clock offset used
+    // without a clock synchronization estimate
+    int64_t updateReceiveOffsetUs(const std::string& streamerId, int64_t remoteTimeUs, int64_t receiveTimeUs);
+
 private:
+    // The clock conversion of the stored samples of a streamer
+    struct SampleClock {
+        std::optional<opentera::ClockOffsetEstimate> estimate;  // std::nullopt when the receive offset is used
+        int64_t receiveOffsetUs;
+    };
+
+    // Returns the offset that converts the timestamp of the streamer clock to the local steady clock
+    static int64_t clockOffsetUs(const SampleClock& clock, int64_t remoteTimeUs);
+    static bool isSameClock(const SampleClock& a, const SampleClock& b);
+
     std::vector<std::string> m_streamerIds;
-    std::unordered_map<std::string, std::queue<std::pair<uint64_t, cv::Mat>>> m_frameQueues;
-    std::unordered_map<std::string, std::string> m_latestJsonData;  // Latest JSON data for each streamer
+    std::unordered_map<std::string, std::queue<std::pair<uint64_t, opentera::PooledVideoFrame>>> m_frameQueues;
+    TelemetryStore m_telemetryStore;
+    TransformBatch m_transformBatch;  // Reused for every synchronized frame set
+    std::unordered_map<std::string, std::shared_ptr<opentera::PixelStreamingClockSync>> m_clockSyncs;
+    std::unordered_map<std::string, int64_t> m_receiveOffsetsUs;  // Local time minus streamer time, per streamer
+    std::unordered_map<std::string, SampleClock> m_sampleClocks;
+    std::unordered_map<std::string, bool> m_usesCaptureTimes;  // Frames timed with their capture time, per streamer
     size_t m_maxQueueSize;
     uint64_t m_syncThresholdMs;
     std::mutex m_mutex;
@@ -5,14 +5,24 @@
 #include <OpenteraWebrtcNativeClient/Configurations/SignalingServerConfiguration.h>
 #include <OpenteraWebrtcNativeClient/Signaling/SignalingClient.h>
 #include <OpenteraWebrtcNativeClient/Signaling/UE5PixelStreamingSignalingClient.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingClockSync.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingInputSender.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingLatencyProbe.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingMessageEncoder.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelSendQueue.h>
+#include <OpenteraWebrtcNativeClient/Utils/FieldTrials.h>
 
 #include <opencv2/core.hpp>
 #include <opencv2/videoio.hpp>
 #include <opencv2/highgui.hpp>
 
+#include <nlohmann/json.hpp>
+
 #include "oscpack/osc/OscOutboundPacketStream.h"
 #include "oscpack/ip/UdpSocket.h"
 
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <thread>
 #include <mutex>
@@ -34,6 +44,7 @@
 #include "monitors.h"
 #include "datachannel_observer.h"
 #include "frame_synchronizer.h"
+#include "telemetry_protocol.h"
 
 using namespace opentera;
 using namespace std;
@@ -92,6 +103,74 @@ bool validateInputTypes(const std::vector<OscValue>& values) {
 // PixelStreaming Configuration
 #define SINGALING_SERVER_ADDRESS "ws://192.168.0.165:80/signaling"
 
+// ICE restarts tried before the client is rebuilt after a connection loss
+constexpr size_t ICE_RESTART_ATTEMPT_COUNT = 2;
+// A streamer started after the client is subscribed at the next streamer list refresh
+constexpr std::chrono::seconds STREAMER_LIST_REFRESH_INTERVAL(5);
+// Connections created before the offer, so the offer is answered without creating one (0 disables the pool)
+constexpr size_t PEER_CONNECTION_POOL_SIZE = 1;
+// The frames are rendered as soon as they are decoded, the smoothness is traded for the teleoperation latency
+constexpr std::chrono::milliseconds MINIMUM_PLAYOUT_DELAY(0);
+constexpr std::chrono::milliseconds MAXIMUM_PLAYOUT_DELAY(0);
+
+const char* toString(VideoFreezeRecoveryStep step) {
+    switch (step) {
+        case VideoFreezeRecoveryStep::RequestKeyFrame:
+            return "key frame request";
+        case VideoFreezeRecoveryStep::RestartIce:
+            return "ICE restart";
+        case VideoFreezeRecoveryStep::Reconnect:
+            return "reconnection";
+    }
+    return "unknown";
+}
+
+using DataChannelSend = std::function<bool(const webrtc::DataBuffer&)>;
+
+// Sends the messages with the send queue of a data channel, so they wait while the data channel buffers too much
+DataChannelSend queuedSend(std::shared_ptr<DataChannelSendQueue> sendQueue, DataChannelSendPriority priority) {
+    return [sendQueue, priority](const webrtc::DataBuffer& buffer) { return sendQueue->send(buffer, priority); };
+}
+
+// Interval between the input sends, one video frame at 60 fps
+constexpr std::chrono::milliseconds INPUT_SEND_INTERVAL(16);
+
+// Input senders of the streamers with an open data channel
+std::mutex inputSendersMutex;
+std::unordered_map<std::string, std::shared_ptr<PixelStreamingInputSender>> inputSenders;
+
+// Streamer whose data channel receives the vehicle commands (--input-streamer). The commands are sent with OSC
+// when it is empty. It is set before the OSC thread starts.
+std::string inputStreamerId;
+// Peer connection pool size of the clients (--pool-size), so the connection setup can be compared with and without
+// the pool. It is set before the streamer threads start.
+size_t peerConnectionPoolSize = PEER_CONNECTION_POOL_SIZE;
+
+// Durations from the connection to the first frame of a streamer, averaged over its reconnections. The clients of a
+// streamer are created one after the other, so the first frames are never reported concurrently.
+struct ConnectToFirstFrameStats {
+    std::chrono::milliseconds total{0};
+    int count = 0;
+
+    // Returns the mean duration
+    std::chrono::milliseconds add(std::chrono::milliseconds duration) {
+        total += duration;
+        count++;
+        return total / count;
+    }
+};
+
+// Queues a UI interaction on the data channel of a streamer.
+// Returns false if the data channel of the streamer is not open.
+bool sendUIInteraction(const std::string& streamerId, const std::string& json) {
+    std::lock_guard<std::mutex> lock(inputSendersMutex);
+    auto it = inputSenders.find(streamerId);
+    if (it == inputSenders.end()) {
+        return false;
+    }
+    return it->second->enqueue(PixelStreamingMessageEncoder::uiInteraction(json));
+}
+
 void oscMessageHandler() {
     UdpTransmitSocket transmitSocket(IpEndpointName(ADDRESS, PORT));
     
@@ -131,6 +210,23 @@ void oscMessageHandler() {
 
             // Validate input types
             if (validateInputTypes(values)) {
+                // The command is sent with the data channel of the input streamer when one is chosen
+                if (!inputStreamerId.empty()) {
+                    nlohmann::json command = {
+                        {"MoveVehicleForRealtime", {
+                            std::get<int>(values[0]),
+                            std::get<std::string>(values[1]),
+                            std::get<std::string>(values[2]),
+                            std::get<std::string>(values[3])
+                        }}
+                    };
+                    if (!sendUIInteraction(inputStreamerId, command.dump())) {
+                        std::cerr << "Streamer " << inputStreamerId << " is not connected, the command is not sent"
+                                  << std::endl;
+                    }
+                    continue;
+                }
+
                 char buffer[OUTPUT_BUFFER_SIZE];
                 osc::OutboundPacketStream p(buffer, OUTPUT_BUFFER_SIZE);
 
@@ -161,16 +257,15 @@ void oscMessageHandler() {
     }
 }
 
-void onVideoFrameReceived(MainWindow* mainWindow, const std::string& streamId, const cv::Mat& frame, uint64_t timestampUs)
+void onVideoFrameReceived(MainWindow* mainWindow, const std::string& streamId, const PooledVideoFrame& frame, uint64_t timestampUs)
 {
     if (!mainWindow || frame.empty()) {
         return;
     }
 
     try {
-        // Create a copy of the frame for display
-        cv::Mat frameCopy = frame.clone();
-        mainWindow->addFrame(streamId, frameCopy);
+        // The frame is shared with the display and the synchronizer without copying its pixels
+        mainWindow->addFrame(streamId, frame);
 
         // Add frame to synchronizer
         if (g_frameSynchronizer) {
@@ -181,31 +276,181 @@ void onVideoFrameReceived(MainWindow* mainWindow, const std::string& streamId, c
     }
 }
 
+// Keeps the client frame size in sync with its widget until the client is destroyed. The destructor waits for the
+// running callback, and the size is set without waiting for the client thread, so the GUI thread never blocks on it.
+struct DisplaySizeSubscription {
+    MainWindow* mainWindow;
+    std::string streamerId;
+
+    DisplaySizeSubscription(MainWindow* window, const std::string& id, StreamClient* client)
+        : mainWindow(window), streamerId(id) {
+        mainWindow->setOnDisplaySizeChanged(streamerId, [client](int width, int height) {
+            client->setVideoFrameTargetSizeAsync(width, height);
+        });
+    }
+    ~DisplaySizeSubscription() {
+        mainWindow->setOnDisplaySizeChanged(streamerId, nullptr);
+    }
+};
+
+// Interval between the LatencyTest requests sent to each streamer
+constexpr std::chrono::seconds LATENCY_PROBE_INTERVAL(5);
+
+// Holds the latency probe of the current data channel of a streamer and feeds it the displayed frames
+struct LatencyProbeSubscription {
+    MainWindow* mainWindow;
+    std::string streamerId;
+    std::mutex mutex;
+    std::shared_ptr<PixelStreamingLatencyProbe> latencyProbe;
+
+    LatencyProbeSubscription(MainWindow* window, const std::string& id)
+        : mainWindow(window), streamerId(id) {
+    }
+    ~LatencyProbeSubscription() {
+        mainWindow->setOnFrameDisplayed(streamerId, nullptr);
+        std::lock_guard<std::mutex> lock(mutex);
+        if (latencyProbe) {
+            latencyProbe->stop();
+        }
+    }
+
+    std::shared_ptr<PixelStreamingLatencyProbe> reset(const DataChannelSend& send) {
+        auto newLatencyProbe = std::make_shared<PixelStreamingLatencyProbe>(send, LATENCY_PROBE_INTERVAL);
+        newLatencyProbe->setOnLatencyReport([id = streamerId](const PixelStreamingLatencyReport& report) {
+            std::cout << "Latency for streamer " << id
+                      << ": capture->display " << report.captureToDisplayTimeMs << " ms"
+                      << " (capture " << report.captureTimeMs
+                      << ", encode " << report.encodeTimeMs
+                      << ", capture->send " << report.captureToSendTimeMs
+                      << ", network " << report.networkLatencyMs
+                      << ", jitter buffer " << report.receiveToDecodeTimeMs
+                      << ", decode " << report.decodeTimeMs
+                      << ", decode->display " << report.decodeToDisplayTimeMs
+                      << "), QP " << report.averageQP << std::endl;
+        });
+        mainWindow->setOnFrameDisplayed(streamerId, [newLatencyProbe](const VideoFrameTimestamps& timestamps) {
+            newLatencyProbe->onFrameDisplayed(timestamps);
+        });
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (latencyProbe) {
+            latencyProbe->stop();
+        }
+        latencyProbe = newLatencyProbe;
+        return latencyProbe;
+    }
+};
+
+// Interval between the clock synchronization requests sent to each streamer
+constexpr std::chrono::seconds CLOCK_SYNC_INTERVAL(1);
+
+// Holds the clock synchronization of the current data channel of a streamer and gives it to the frame synchronizer
+struct ClockSyncSubscription {
+    std::string streamerId;
+    std::mutex mutex;
+    std::shared_ptr<PixelStreamingClockSync> clockSync;
+
+    explicit ClockSyncSubscription(const std::string& id) : streamerId(id) {
+    }
+    ~ClockSyncSubscription() {
+        if (g_frameSynchronizer) {
+            g_frameSynchronizer->setClockSync(streamerId, nullptr);
+        }
+        std::lock_guard<std::mutex> lock(mutex);
+        if (clockSync) {
+            clockSync->stop();
+        }
+    }
+
+    std::shared_ptr<PixelStreamingClockSync> reset(const DataChannelSend& send) {
+        auto newClockSync = std::make_shared<PixelStreamingClockSync>(
+            send,
+            TelemetryProtocol::ClockSyncRequestMessageId,
+            TelemetryProtocol::ClockSyncResponseMessageId,
+            CLOCK_SYNC_INTERVAL);
+        if (g_frameSynchronizer) {
+            g_frameSynchronizer->setClockSync(streamerId, newClockSync);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        if (clockSync) {
+            clockSync->stop();
+        }
+        clockSync = newClockSync;
+        return clockSync;
+    }
+};
+
+// Holds the input sender of the current data channel of a streamer while the data channel is open
+struct InputSenderSubscription {
+    std::string streamerId;
+
+    explicit InputSenderSubscription(const std::string& id) : streamerId(id) {
+    }
+    ~InputSenderSubscription() {
+        reset(nullptr);
+    }
+
+    // A null send function removes the input sender
+    std::shared_ptr<PixelStreamingInputSender> reset(const DataChannelSend& send) {
+        std::shared_ptr<PixelStreamingInputSender> newInputSender;
+        if (send) {
+            newInputSender = std::make_shared<PixelStreamingInputSender>(send, INPUT_SEND_INTERVAL);
+        }
+
+        std::lock_guard<std::mutex> lock(inputSendersMutex);
+        auto it = inputSenders.find(streamerId);
+        if (it != inputSenders.end()) {
+            it->second->stop();
+            inputSenders.erase(it);
+        }
+        if (newInputSender) {
+            inputSenders[streamerId] = newInputSender;
+        }
+        return newInputSender;
+    }
+};
+
 void handleStreamer(MainWindow* mainWindow, const std::string& streamerId) {
     const int MAX_RETRY_COUNT = 3;    
     const int RETRY_DELAY_MS = 1000;  
+    auto connectToFirstFrameStats = std::make_shared<ConnectToFirstFrameStats>();
     
     while (isRunning) {
         try {
-            vector<IceServer> iceServers = {
-                //IceServer("stun:stun2.l.google.com:19302"),
-                //IceServer("turn:192.168.0.165:3478", "webrtc", "ue5test")
-            };
-            auto webrtcConfig = WebrtcConfiguration::create({iceServers});
+            // The streamers are on the same local network, so only the host candidates are gathered
+            auto webrtcConfig = WebrtcConfiguration::createForLocalNetwork();
             auto signalingServerConfiguration = SignalingServerConfiguration::create(
                 SINGALING_SERVER_ADDRESS, "C++", "chat", "abc");
 
+            // The client callbacks reference the subscriptions and the reconnection state, so they are declared
+            // before the client and destroyed after it
+            LatencyProbeSubscription latencyProbeSubscription(mainWindow, streamerId);
+            ClockSyncSubscription clockSyncSubscription(streamerId);
+            InputSenderSubscription inputSenderSubscription(streamerId);
+            bool connectionLost = false;
+            std::mutex reconnectMutex;
+            std::condition_variable reconnectCV;
+            int retryCount = 0;
+
             auto client = std::make_unique<StreamClient>(
                 signalingServerConfiguration,
                 webrtcConfig,
                 VideoStreamConfiguration::create(),
                 std::vector<std::string>{streamerId},
                 streamerId);
-
-            bool connectionLost = false;
-            std::mutex reconnectMutex;
-            std::condition_variable reconnectCV;
-            int retryCount = 0;
+            // References the client, so it is destroyed before it
+            DisplaySizeSubscription displaySizeSubscription(mainWindow, streamerId, client.get());
+            client->setVideoFrameFormat(VideoFrameFormat::BGRA);  // Format_RGB32 layout, displayed without conversion
+            // Wi-Fi roaming is recovered in place, the client is only rebuilt when the ICE restarts fail
+            client->setIceRestartAttempts(ICE_RESTART_ATTEMPT_COUNT);
+            client->setStreamerListRefreshInterval(STREAMER_LIST_REFRESH_INTERVAL);
+            client->setPeerConnectionPoolSize(peerConnectionPoolSize);
+            // A frozen video is recovered with key frame requests, then an ICE restart, then a new client
+            client->setVideoFreezeWatchdogConfiguration(VideoFreezeWatchdogConfiguration::create());
+            client->setOnVideoFreezeRecovery([streamerId](const Client& client, VideoFreezeRecoveryStep step) {
+                std::cout << "Frozen video for streamer: " << streamerId << ", " << toString(step) << std::endl;
+            });
 
             // Set connection closed callback
             client->setOnSignalingConnectionClosed([&]() {
@@ -242,20 +487,58 @@ void handleStreamer(MainWindow* mainWindow, const std::string& streamerId) {
                 reconnectCV.notify_one();
             });
 
-            client->setOnDataChannelOpened([streamerId](const Client& client, 
-                rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel) {
+            // The ICE restarts failed or the frozen video was not recovered
+            client->setOnClientConnectionFailed([&](const Client& client) {
+                clientIdToStreamId.erase(client.id());
+                std::cout << "Connection failed for client ID: " << client.id() << std::endl;
+                std::lock_guard<std::mutex> lock(reconnectMutex);
+                connectionLost = true;
+                reconnectCV.notify_one();
+            });
+
+            client->setOnDataChannelOpened(
+                [streamerId, &latencyProbeSubscription, &clockSyncSubscription, &inputSenderSubscription](
+                const Client& client, rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel) {
                 std::cout << "DataChannel opened for streamer: " << streamerId << std::endl;
-                auto observer = new rtc::RefCountedObject<CustomDataChannelObserver>(streamerId);
+                // The timing and input messages are not delayed by the queued telemetry
+                auto sendQueue = std::make_shared<DataChannelSendQueue>(dataChannel);
+                auto controlSend = queuedSend(sendQueue, DataChannelSendPriority::High);
+                auto latencyProbe = latencyProbeSubscription.reset(controlSend);
+                auto clockSync = clockSyncSubscription.reset(controlSend);
+                auto observer = new rtc::RefCountedObject<CustomDataChannelObserver>(
+                    streamerId, latencyProbe, clockSync, sendQueue);
                 dataChannel->RegisterObserver(observer);
+                latencyProbe->start();
+                clockSync->start();
+                inputSenderSubscription.reset(controlSend)->start();
+
+                // Ask for the binary telemetry, the streamers that do not support it keep sending JSON
+                uint8_t telemetryVersion = TelemetryProtocol::BinaryTransformVersion;
+                sendQueue->send(PixelStreamingMessageEncoder::custom(
+                    TelemetryProtocol::TelemetryFormatRequestMessageId, &telemetryVersion, sizeof(telemetryVersion)));
             });
 
+            // Compares the connection setup with and without the peer connection pool
+            auto connectTime = std::make_shared<std::chrono::steady_clock::time_point>();
+            auto isFirstFrameReceived = std::make_shared<std::atomic_bool>(false);
             client->setOnVideoFrameReceived(
-                [mainWindow, streamerId](const Client& client, const cv::Mat& frame, uint64_t timestampUs) {
+                [mainWindow, streamerId, connectTime, isFirstFrameReceived, connectToFirstFrameStats](
+                    const Client& client, const PooledVideoFrame& frame, uint64_t timestampUs) {
+                    if (!isFirstFrameReceived->exchange(true)) {
+                        auto connectToFirstFrame = std::chrono::duration_cast<std::chrono::milliseconds>(
+                            std::chrono::steady_clock::now() - *connectTime);
+                        auto mean = connectToFirstFrameStats->add(connectToFirstFrame);
+                        std::cout << "Connect to first frame for streamer: " << streamerId << " "
+                                  << connectToFirstFrame.count() << " ms (pool size " << peerConnectionPoolSize
+                                  << ", mean " << mean.count() << " ms over " << connectToFirstFrameStats->count
+                                  << " connections)" << std::endl;
+                    }
                     onVideoFrameReceived(mainWindow, streamerId, frame, timestampUs);
                 });
 
             // Attempt to connect
             std::cout << "Attempting to connect streamer: " << streamerId << std::endl;
+            *connectTime = std::chrono::steady_clock::now();
             client->connect();
 
             // Wait for connection loss or error
@@ -293,6 +576,9 @@ int main(int argc, char* argv[]) {
     qputenv("QT_QPA_PLATFORM", "xcb");
     QApplication app(argc, argv);
 
+    // The field trials must be initialized before the clients are created
+    initializeFieldTrials(createPlayoutDelayFieldTrials(MINIMUM_PLAYOUT_DELAY, MAXIMUM_PLAYOUT_DELAY));
+
     // Set up command line parser
     QCommandLineParser parser;
     parser.setApplicationDescription("Multi-Stream Video Display Application");
@@ -308,6 +594,23 @@ int main(int argc, char* argv[]) {
     );
     parser.addOption(displayModeOption);
 
+    // Add input streamer option
+    QCommandLineOption inputStreamerOption(
+        QStringList() << "i" << "input-streamer",
+        "Streamer receiving the vehicle commands on its data channel (default: the commands are sent with OSC)",
+        "streamer"
+    );
+    parser.addOption(inputStreamerOption);
+
+    // Add peer connection pool size option
+    QCommandLineOption poolSizeOption(
+        QStringList() << "p" << "pool-size",
+        "Peer connection pool size, 0 disables the pool (default: " + QString::number(PEER_CONNECTION_POOL_SIZE) + ")",
+        "size",
+        QString::number(PEER_CONNECTION_POOL_SIZE)
+    );
+    parser.addOption(poolSizeOption);
+
     // Add streamer parameter support
     parser.addPositionalArgument("streamers", "Streamer IDs or 'all' for all cameras");
 
@@ -316,7 +619,7 @@ int main(int argc, char* argv[]) {
     // Get streamer parameters
     const QStringList args = parser.positionalArguments();
     if (args.isEmpty()) {
-        std::cerr << "Usage: " << argv[0] << " [--display=grid|full] <streamer_id1> [streamer_id2 ...] or 'all'" << std::endl;
+        std::cerr << "Usage: " << argv[0] << " [--display=grid|full] [--input-streamer=<streamer_id>] [--pool-size=<size>] <streamer_id1> [streamer_id2 ...] or 'all'" << std::endl;
         return 1;
     }
 
@@ -325,6 +628,15 @@ int main(int argc, char* argv[]) {
     MainWindow::DisplayMode initialMode = 
         (displayMode.toLower() == "full") ? MainWindow::FullScreen : MainWindow::GridLayout;
 
+    inputStreamerId = parser.value(inputStreamerOption).toStdString();
+
+    bool isPoolSizeValid = false;
+    peerConnectionPoolSize = parser.value(poolSizeOption).toUInt(&isPoolSizeValid);
+    if (!isPoolSizeValid) {
+        std::cerr << "Invalid peer connection pool size: " << parser.value(poolSizeOption).toStdString() << std::endl;
+        return 1;
+    }
+
     std::string StreamerId = "JsonStreamerComponent";
 
     // Process streamer list
@@ -343,6 +655,12 @@ int main(int argc, char* argv[]) {
     std::string defaultStreamerId = "JsonStreamerComponent";
     streamerList.push_back(defaultStreamerId);
 
+    if (!inputStreamerId.empty() &&
+        std::find(streamerList.begin(), streamerList.end(), inputStreamerId) == streamerList.end()) {
+        std::cerr << "The input streamer " << inputStreamerId << " is not in the streamer list" << std::endl;
+        return 1;
+    }
+
     // Create main window (only once)
     std::unique_ptr<MainWindow> mainWindow = std::make_unique<MainWindow>(streamerList, initialMode);
 
@@ -351,8 +669,8 @@ int main(int argc, char* argv[]) {
 
     // Set frame synchronizer callback
     g_frameSynchronizer->setCallback([](
-        const std::unordered_map<std::string, cv::Mat>& frames,
-        const std::unordered_map<std::string, std::string>& jsonData) {
+        const std::unordered_map<std::string, PooledVideoFrame>& frames,
+        const TransformBatch& transforms) {
         // Synchronization debug output code commented out
     });
 
@@ -34,7 +34,58 @@ void MainWindow::setupVideoWidgets()
         widget->setWindowFlags(Qt::Window);
         widget->setWindowTitle(QString::fromStdString(streamId));
         m_videoWidgets[streamId] = widget;
+
+        widget->setOnDisplaySizeChanged([this, streamId](const QSize& size) {
+            // The callback is called with the lock held, so it cannot run after it is unregistered. It does not
+            // take the lock of the frame path.
+            std::lock_guard<std::mutex> lock(m_displaySizeMutex);
+            m_displaySizes[streamId] = size;
+            auto it = m_onDisplaySizeChanged.find(streamId);
+            if (it != m_onDisplaySizeChanged.end()) {
+                it->second(size.width(), size.height());
+            }
+        });
+
+        widget->setOnFrameDisplayed([this, streamId](const opentera::VideoFrameTimestamps& timestamps) {
+            std::function<void(const opentera::VideoFrameTimestamps&)> callback;
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                auto it = m_onFrameDisplayed.find(streamId);
+                if (it != m_onFrameDisplayed.end()) {
+                    callback = it->second;
+                }
+            }
+            if (callback) {
+                callback(timestamps);
+            }
+        });
+    }
+}
+
+void MainWindow::setOnDisplaySizeChanged(const std::string& streamId, std::function<void(int, int)> callback)
+{
+    std::lock_guard<std::mutex> lock(m_displaySizeMutex);
+    if (!callback) {
+        m_onDisplaySizeChanged.erase(streamId);
+        return;
+    }
+
+    auto it = m_displaySizes.find(streamId);
+    if (it != m_displaySizes.end()) {
+        callback(it->second.width(), it->second.height());
+    }
+    m_onDisplaySizeChanged[streamId] = std::move(callback);
+}
+
+void MainWindow::setOnFrameDisplayed(const std::string& streamId,
+                                     std::function<void(const opentera::VideoFrameTimestamps&)> callback)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (!callback) {
+        m_onFrameDisplayed.erase(streamId);
+        return;
     }
+    m_onFrameDisplayed[streamId] = std::move(callback);
 }
 
 void MainWindow::distributeWindowsToScreens()
@@ -85,7 +136,7 @@ void MainWindow::distributeWindowsToScreens()
 }
 
 
-void MainWindow::addFrame(const std::string& streamId, const cv::Mat& frame)
+void MainWindow::addFrame(const std::string& streamId, const opentera::PooledVideoFrame& frame)
 {
     try {
         std::lock_guard<std::mutex> lock(m_mutex);
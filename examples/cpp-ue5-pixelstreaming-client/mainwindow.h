@@ -3,11 +3,14 @@
 #include <QMainWindow>
 #include <QVector>
 #include <QScreen>
+#include <OpenteraWebrtcNativeClient/Sinks/VideoFramePool.h>
 #include <opencv2/core.hpp>
 #include <memory>
 #include <unordered_map>
 #include <queue>
 #include <mutex>
+#include <functional>
+#include <QSize>
 
 class VideoWidget;
 
@@ -25,7 +28,15 @@ public:
                        QWidget *parent = nullptr);
     ~MainWindow();
 
-    void addFrame(const std::string& streamId, const cv::Mat& frame);
+    void addFrame(const std::string& streamId, const opentera::PooledVideoFrame& frame);
+
+    // The callback is called with the display size of the stream widget, now and whenever it changes. It must not
+    // block, since the resizes wait for it. Pass nullptr to unregister it, which waits for the running call.
+    void setOnDisplaySizeChanged(const std::string& streamId, std::function<void(int, int)> callback);
+    // The callback is called from the GUI thread when a new frame of the stream is painted.
+    // Pass nullptr to unregister it.
+    void setOnFrameDisplayed(const std::string& streamId,
+                             std::function<void(const opentera::VideoFrameTimestamps&)> callback);
     void setDisplayMode(DisplayMode mode);
     DisplayMode displayMode() const { return m_displayMode; }
 
@@ -41,6 +52,10 @@ private:
 private:
     std::vector<std::string> m_streamerList;
     std::unordered_map<std::string, VideoWidget*> m_videoWidgets;
+    std::unordered_map<std::string, QSize> m_displaySizes;
+    std::unordered_map<std::string, std::function<void(int, int)>> m_onDisplaySizeChanged;
+    std::unordered_map<std::string, std::function<void(const opentera::VideoFrameTimestamps&)>> m_onFrameDisplayed;
     std::mutex m_mutex;
+    std::mutex m_displaySizeMutex;
     DisplayMode m_displayMode;
 };
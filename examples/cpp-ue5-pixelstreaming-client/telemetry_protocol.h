@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstdint>
+
+// Custom Pixel Streaming message ids used by the streamers of this example to exchange telemetry
+namespace TelemetryProtocol {
+    // Streamer -> client: UTF-8 JSON transform (see TransformDecoder)
+    constexpr uint8_t TransformJsonMessageId = 123;
+    // Streamer -> client: binary transform (BinaryTransformV1)
+    constexpr uint8_t TransformBinaryMessageId = 124;
+    // Client -> streamer: [uint8 highest supported binary version]. A streamer that supports the binary format
+    // switches to TransformBinaryMessageId, the others ignore the request and keep sending JSON.
+    constexpr uint8_t TelemetryFormatRequestMessageId = 125;
+    // Client -> streamer: clock synchronization request, streamer -> client: response (see PixelStreamingClockSync).
+    // The streamer times must come from the clock of the transform timestamps.
+    constexpr uint8_t ClockSyncRequestMessageId = 126;
+    constexpr uint8_t ClockSyncResponseMessageId = 127;
+
+    constexpr uint8_t BinaryTransformVersion = 1;
+
+    // Little-endian layout of the binary transform payload (after the message id). Later versions may append
+    // fields, so longer payloads are accepted.
+#pragma pack(push, 1)
+    struct BinaryTransformV1 {
+        uint8_t version;
+        uint8_t flags;         // Reserved, 0
+        uint16_t reserved;     // Reserved, 0
+        int64_t timestampUs;   // Streamer clock
+        double location[3];    // X, Y, Z in centimeters
+        float rotation[3];     // Pitch, Yaw, Roll in degrees
+        float fov;             // Horizontal field of view in degrees
+    };
+#pragma pack(pop)
+
+    static_assert(sizeof(BinaryTransformV1) == 52, "BinaryTransformV1 must not be padded");
+}
@@ -0,0 +1,167 @@
+#include "telemetry_store.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    double lerp(double a, double b, double t) {
+        return a + (b - a) * t;
+    }
+
+    // Interpolates an angle in degrees along the shortest path, so 179 -> -179 goes through 180
+    double lerpAngle(double a, double b, double t) {
+        double delta = std::remainder(b - a, 360.0);
+        return a + delta * t;
+    }
+}
+
+void TransformBatch::reserve(size_t capacity) {
+    frameIndex.reserve(capacity);
+    sourceIndex.reserve(capacity);
+    timestampUs.reserve(capacity);
+    locationX.reserve(capacity);
+    locationY.reserve(capacity);
+    locationZ.reserve(capacity);
+    pitch.reserve(capacity);
+    yaw.reserve(capacity);
+    roll.reserve(capacity);
+    fov.reserve(capacity);
+}
+
+void TransformBatch::clear() {
+    frameIndex.clear();
+    sourceIndex.clear();
+    timestampUs.clear();
+    locationX.clear();
+    locationY.clear();
+    locationZ.clear();
+    pitch.clear();
+    yaw.clear();
+    roll.clear();
+    fov.clear();
+}
+
+void TransformBatch::push_back(uint16_t frame, uint16_t source, const TransformSample& sample) {
+    frameIndex.push_back(frame);
+    sourceIndex.push_back(source);
+    timestampUs.push_back(sample.timestampUs);
+    locationX.push_back(sample.location[0]);
+    locationY.push_back(sample.location[1]);
+    locationZ.push_back(sample.location[2]);
+    pitch.push_back(sample.rotation[0]);
+    yaw.push_back(sample.rotation[1]);
+    roll.push_back(sample.rotation[2]);
+    fov.push_back(sample.fov);
+}
+
+TelemetryStore::TelemetryStore(const std::vector<std::string>& streamerIds, size_t capacity)
+    : m_rings(streamerIds.size()) {
+    for (size_t i = 0; i < streamerIds.size(); i++) {
+        m_rings[i].samples.resize(std::max<size_t>(capacity, 2));
+        m_ringIndexes[streamerIds[i]] = i;
+    }
+}
+
+void TelemetryStore::addSample(const std::string& streamerId, const TransformSample& sample) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_ringIndexes.find(streamerId);
+    if (it == m_ringIndexes.end()) {
+        return;
+    }
+
+    Ring& ring = m_rings[it->second];
+    if (ring.size > 0 && sample.timestampUs <= ring.at(ring.size - 1).timestampUs) {
+        return;
+    }
+
+    if (ring.size < ring.samples.size()) {
+        ring.samples[(ring.begin + ring.size) % ring.samples.size()] = sample;
+        ring.size++;
+    } else {
+        // Overwrite the oldest sample
+        ring.samples[ring.begin] = sample;
+        ring.begin = (ring.begin + 1) % ring.samples.size();
+    }
+}
+
+void TelemetryStore::shiftSamples(const std::string& streamerId, int64_t offsetUs) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_ringIndexes.find(streamerId);
+    if (it == m_ringIndexes.end()) {
+        return;
+    }
+
+    Ring& ring = m_rings[it->second];
+    for (size_t i = 0; i < ring.size; i++) {
+        ring.samples[(ring.begin + i) % ring.samples.size()].timestampUs += offsetUs;
+    }
+}
+
+std::optional<TransformSample> TelemetryStore::sampleAt(const std::string& streamerId, int64_t timeUs) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_ringIndexes.find(streamerId);
+    if (it == m_ringIndexes.end()) {
+        return std::nullopt;
+    }
+    return interpolate(m_rings[it->second], timeUs);
+}
+
+void TelemetryStore::appendSamplesAt(int64_t timeUs, uint16_t frameIndex, TransformBatch& batch) const {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    for (size_t i = 0; i < m_rings.size(); i++) {
+        auto sample = interpolate(m_rings[i], timeUs);
+        if (sample) {
+            batch.push_back(frameIndex, static_cast<uint16_t>(i), *sample);
+        }
+    }
+}
+
+void TelemetryStore::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (auto& ring : m_rings) {
+        ring.begin = 0;
+        ring.size = 0;
+    }
+}
+
+std::optional<TransformSample> TelemetryStore::interpolate(const Ring& ring, int64_t timeUs) {
+    if (ring.size == 0) {
+        return std::nullopt;
+    }
+    if (timeUs <= ring.at(0).timestampUs) {
+        return ring.at(0);
+    }
+    if (timeUs >= ring.at(ring.size - 1).timestampUs) {
+        return ring.at(ring.size - 1);
+    }
+
+    // Binary search of the first sample after timeUs
+    size_t low = 1;
+    size_t high = ring.size - 1;
+    while (low < high) {
+        size_t middle = (low + high) / 2;
+        if (ring.at(middle).timestampUs <= timeUs) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+
+    const TransformSample& before = ring.at(low - 1);
+    const TransformSample& after = ring.at(low);
+    double t = static_cast<double>(timeUs - before.timestampUs) /
+               static_cast<double>(after.timestampUs - before.timestampUs);
+
+    TransformSample sample;
+    sample.timestampUs = timeUs;
+    for (size_t i = 0; i < 3; i++) {
+        sample.location[i] = lerp(before.location[i], after.location[i], t);
+        sample.rotation[i] = lerpAngle(before.rotation[i], after.rotation[i], t);
+    }
+    sample.fov = lerp(before.fov, after.fov, t);
+    return sample;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// A transform sent by a streamer, with its timestamp converted to the local steady clock (rtc::TimeMicros)
+struct TransformSample {
+    int64_t timestampUs = 0;
+    std::array<double, 3> location{};  // X, Y, Z in centimeters
+    std::array<double, 3> rotation{};  // Pitch, Yaw, Roll in degrees
+    double fov = 0.0;                  // Horizontal field of view of the camera in degrees
+};
+
+// The transforms of a synchronized frame set, as a struct of arrays. Row i is the transform of the telemetry
+// streamer sourceIndex[i], interpolated at the capture time of the frame of the streamer frameIndex[i].
+// The indexes are the positions of the streamers in the list given to the store.
+struct TransformBatch {
+    std::vector<uint16_t> frameIndex;
+    std::vector<uint16_t> sourceIndex;
+    std::vector<int64_t> timestampUs;
+    std::vector<double> locationX;
+    std::vector<double> locationY;
+    std::vector<double> locationZ;
+    std::vector<double> pitch;
+    std::vector<double> yaw;
+    std::vector<double> roll;
+    std::vector<double> fov;
+
+    size_t size() const { return timestampUs.size(); }
+    void reserve(size_t capacity);
+    // Keeps the capacity, so a batch can be reused without allocating
+    void clear();
+    void push_back(uint16_t frame, uint16_t source, const TransformSample& sample);
+};
+
+// Keeps the latest transform samples of each streamer in a ring ordered by timestamp,
+// so they can be interpolated to the capture time of any recent frame.
+class TelemetryStore {
+public:
+    explicit TelemetryStore(const std::vector<std::string>& streamerIds, size_t capacity = 256);
+
+    // Samples older than the newest sample of the streamer are dropped
+    void addSample(const std::string& streamerId, const TransformSample& sample);
+
+    // Adds offsetUs to the timestamps of the samples of a streamer, when its clock offset estimate changes,
+    // so the stored samples stay in the clock domain of the next ones
+    void shiftSamples(const std::string& streamerId, int64_t offsetUs);
+
+    // Returns the sample interpolated at timeUs, or the nearest sample when timeUs is outside of the stored range
+    std::optional<TransformSample> sampleAt(const std::string& streamerId, int64_t timeUs) const;
+
+    // Appends to batch the sample of every streamer that has one, interpolated at timeUs
+    void appendSamplesAt(int64_t timeUs, uint16_t frameIndex, TransformBatch& batch) const;
+
+    void clear();
+
+private:
+    struct Ring {
+        std::vector<TransformSample> samples;
+        size_t begin = 0;
+        size_t size = 0;
+
+        const TransformSample& at(size_t index) const { return samples[(begin + index) % samples.size()]; }
+    };
+
+    static std::optional<TransformSample> interpolate(const Ring& ring, int64_t timeUs);
+
+private:
+    std::vector<Ring> m_rings;
+    std::unordered_map<std::string, size_t> m_ringIndexes;
+    mutable std::mutex m_mutex;
+};
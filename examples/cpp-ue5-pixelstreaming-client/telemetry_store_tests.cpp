@@ -0,0 +1,119 @@
+#include "telemetry_store.h"
+
+#include <gtest/gtest.h>
+
+namespace {
+    const std::string StreamerId = "streamer";
+
+    TransformSample createSample(int64_t timestampUs, double x, double yaw) {
+        TransformSample sample;
+        sample.timestampUs = timestampUs;
+        sample.location = {x, 2 * x, 3 * x};
+        sample.rotation = {0.0, yaw, 0.0};
+        sample.fov = 90.0;
+        return sample;
+    }
+}
+
+TEST(TelemetryStoreTests, sampleAt_noSample_shouldReturnNullopt) {
+    TelemetryStore testee({StreamerId});
+
+    EXPECT_FALSE(testee.sampleAt(StreamerId, 1000).has_value());
+    EXPECT_FALSE(testee.sampleAt("unknown", 1000).has_value());
+}
+
+TEST(TelemetryStoreTests, sampleAt_betweenSamples_shouldInterpolate) {
+    TelemetryStore testee({StreamerId});
+    testee.addSample(StreamerId, createSample(1000, 0.0, 10.0));
+    testee.addSample(StreamerId, createSample(2000, 10.0, 20.0));
+    testee.addSample(StreamerId, createSample(3000, 30.0, 40.0));
+
+    auto sample = testee.sampleAt(StreamerId, 2500);
+
+    ASSERT_TRUE(sample.has_value());
+    EXPECT_EQ(sample->timestampUs, 2500);
+    EXPECT_DOUBLE_EQ(sample->location[0], 20.0);
+    EXPECT_DOUBLE_EQ(sample->location[1], 40.0);
+    EXPECT_DOUBLE_EQ(sample->location[2], 60.0);
+    EXPECT_DOUBLE_EQ(sample->rotation[1], 30.0);
+    EXPECT_DOUBLE_EQ(sample->fov, 90.0);
+}
+
+TEST(TelemetryStoreTests, sampleAt_outsideOfTheSamples_shouldReturnTheNearestSample) {
+    TelemetryStore testee({StreamerId});
+    testee.addSample(StreamerId, createSample(1000, 0.0, 0.0));
+    testee.addSample(StreamerId, createSample(2000, 10.0, 0.0));
+
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 500)->location[0], 0.0);
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 2500)->location[0], 10.0);
+}
+
+TEST(TelemetryStoreTests, sampleAt_angleAcross180_shouldInterpolateAlongTheShortestPath) {
+    TelemetryStore testee({StreamerId});
+    testee.addSample(StreamerId, createSample(1000, 0.0, 170.0));
+    testee.addSample(StreamerId, createSample(2000, 0.0, -170.0));
+
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 1500)->rotation[1], 180.0);
+}
+
+TEST(TelemetryStoreTests, sampleAt_fullRing_shouldKeepTheNewestSamples) {
+    TelemetryStore testee({StreamerId}, 4);
+    for (int64_t i = 1; i <= 6; i++) {
+        testee.addSample(StreamerId, createSample(i * 1000, static_cast<double>(i), 0.0));
+    }
+
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 0)->location[0], 3.0);
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 5500)->location[0], 5.5);
+}
+
+TEST(TelemetryStoreTests, addSample_olderSample_shouldDropIt) {
+    TelemetryStore testee({StreamerId});
+    testee.addSample(StreamerId, createSample(2000, 10.0, 0.0));
+    testee.addSample(StreamerId, createSample(1000, 0.0, 0.0));
+
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 1000)->location[0], 10.0);
+}
+
+TEST(TelemetryStoreTests, shiftSamples_smallerClockOffset_shouldKeepTheNextSamples) {
+    TelemetryStore testee({StreamerId});
+    testee.addSample(StreamerId, createSample(10000, 0.0, 0.0));
+    testee.addSample(StreamerId, createSample(11000, 10.0, 0.0));
+
+    // The clock offset decreases by 5 ms, so the next sample is older than the stored ones with the previous offset
+    testee.shiftSamples(StreamerId, -5000);
+    testee.addSample(StreamerId, createSample(7000, 20.0, 0.0));
+
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 5000)->location[0], 0.0);
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 5500)->location[0], 5.0);
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 6500)->location[0], 15.0);
+    EXPECT_DOUBLE_EQ(testee.sampleAt(StreamerId, 7000)->location[0], 20.0);
+}
+
+TEST(TelemetryStoreTests, shiftSamples_shouldOnlyShiftTheSamplesOfTheStreamer) {
+    TelemetryStore testee({StreamerId, "other"});
+    testee.addSample(StreamerId, createSample(1000, 0.0, 0.0));
+    testee.addSample("other", createSample(1000, 0.0, 0.0));
+
+    testee.shiftSamples(StreamerId, 500);
+
+    EXPECT_EQ(testee.sampleAt(StreamerId, 0)->timestampUs, 1500);
+    EXPECT_EQ(testee.sampleAt("other", 0)->timestampUs, 1000);
+}
+
+TEST(TelemetryStoreTests, appendSamplesAt_shouldAppendTheSampleOfEveryStreamer) {
+    TelemetryStore testee({StreamerId, "empty", "other"});
+    testee.addSample(StreamerId, createSample(1000, 0.0, 0.0));
+    testee.addSample(StreamerId, createSample(2000, 10.0, 0.0));
+    testee.addSample("other", createSample(1000, 5.0, 0.0));
+
+    TransformBatch batch;
+    testee.appendSamplesAt(1500, 1, batch);
+
+    ASSERT_EQ(batch.size(), 2u);
+    EXPECT_EQ(batch.frameIndex[0], 1);
+    EXPECT_EQ(batch.sourceIndex[0], 0);
+    EXPECT_DOUBLE_EQ(batch.locationX[0], 5.0);
+    EXPECT_EQ(batch.frameIndex[1], 1);
+    EXPECT_EQ(batch.sourceIndex[1], 2);
+    EXPECT_DOUBLE_EQ(batch.locationX[1], 5.0);
+}
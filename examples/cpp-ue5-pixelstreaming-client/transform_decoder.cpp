@@ -0,0 +1,234 @@
+#include "transform_decoder.h"
+#include "telemetry_protocol.h"
+
+#include <charconv>
+#include <cstring>
+
+namespace {
+    // Bits of the fields found in the message
+    enum Field : uint32_t {
+        TimestampField = 1 << 0,
+        LocationXField = 1 << 1,
+        LocationYField = 1 << 2,
+        LocationZField = 1 << 3,
+        PitchField = 1 << 4,
+        YawField = 1 << 5,
+        RollField = 1 << 6,
+        FovField = 1 << 7,
+
+        RequiredFields = TimestampField | LocationXField | LocationYField | LocationZField |
+                         PitchField | YawField | RollField
+    };
+
+    constexpr int MaxDepth = 32;
+}
+
+// A cursor over the JSON text. Every function returns false when the text is malformed.
+class TransformDecoder::Reader {
+public:
+    explicit Reader(std::string_view text) : m_current(text.data()), m_end(text.data() + text.size()) {}
+
+    void skipWhitespace() {
+        while (m_current < m_end &&
+               (*m_current == ' ' || *m_current == '\t' || *m_current == '\n' || *m_current == '\r')) {
+            m_current++;
+        }
+    }
+
+    bool consume(char c) {
+        skipWhitespace();
+        if (m_current < m_end && *m_current == c) {
+            m_current++;
+            return true;
+        }
+        return false;
+    }
+
+    bool peek(char c) {
+        skipWhitespace();
+        return m_current < m_end && *m_current == c;
+    }
+
+    bool atEnd() {
+        skipWhitespace();
+        return m_current == m_end;
+    }
+
+    // The keys of the schema have no escape sequence, so the key is returned as a view of the text
+    bool readString(std::string_view& value) {
+        if (!consume('"')) {
+            return false;
+        }
+        const char* begin = m_current;
+        while (m_current < m_end && *m_current != '"') {
+            if (*m_current == '\\') {
+                m_current++;
+            }
+            m_current++;
+        }
+        if (m_current >= m_end) {
+            return false;
+        }
+        value = std::string_view(begin, static_cast<size_t>(m_current - begin));
+        m_current++;
+        return true;
+    }
+
+    bool readNumber(double& value) {
+        skipWhitespace();
+        auto result = std::from_chars(m_current, m_end, value);
+        if (result.ec != std::errc()) {
+            return false;
+        }
+        m_current = result.ptr;
+        return true;
+    }
+
+    bool skipValue(int depth = 0) {
+        if (depth > MaxDepth) {
+            return false;
+        }
+
+        skipWhitespace();
+        if (m_current >= m_end) {
+            return false;
+        }
+
+        std::string_view ignored;
+        switch (*m_current) {
+            case '"':
+                return readString(ignored);
+            case '{':
+                return readObject([this, depth](std::string_view) { return skipValue(depth + 1); });
+            case '[':
+                m_current++;
+                if (consume(']')) {
+                    return true;
+                }
+                do {
+                    if (!skipValue(depth + 1)) {
+                        return false;
+                    }
+                } while (consume(','));
+                return consume(']');
+            case 't':
+                return skipLiteral("true");
+            case 'f':
+                return skipLiteral("false");
+            case 'n':
+                return skipLiteral("null");
+            default:
+                double number;
+                return readNumber(number);
+        }
+    }
+
+    // Calls onMember(key) for every member; onMember must read the value
+    template<class F>
+    bool readObject(F&& onMember) {
+        if (!consume('{')) {
+            return false;
+        }
+        if (consume('}')) {
+            return true;
+        }
+        do {
+            std::string_view key;
+            if (!readString(key) || !consume(':') || !onMember(key)) {
+                return false;
+            }
+        } while (consume(','));
+        return consume('}');
+    }
+
+private:
+    bool skipLiteral(std::string_view literal) {
+        if (static_cast<size_t>(m_end - m_current) < literal.size() ||
+            std::string_view(m_current, literal.size()) != literal) {
+            return false;
+        }
+        m_current += literal.size();
+        return true;
+    }
+
+private:
+    const char* m_current;
+    const char* m_end;
+};
+
+bool TransformDecoder::decode(std::string_view json, TransformSample& sample, int64_t& remoteTimeUs) {
+    Reader reader(json);
+    uint32_t fields = 0;
+
+    auto readField = [&](double& value, Field field) {
+        if (reader.peek('{') || reader.peek('[') || reader.peek('"')) {
+            return reader.skipValue();
+        }
+        if (!reader.readNumber(value)) {
+            return reader.skipValue();
+        }
+        fields |= field;
+        return true;
+    };
+
+    double timestampMs = 0.0;
+    bool ok = reader.readObject([&](std::string_view key) {
+        if (key == "Timestamp") {
+            return readField(timestampMs, TimestampField);
+        } else if (key == "Location" && reader.peek('{')) {
+            return reader.readObject([&](std::string_view axis) {
+                if (axis == "X") {
+                    return readField(sample.location[0], LocationXField);
+                } else if (axis == "Y") {
+                    return readField(sample.location[1], LocationYField);
+                } else if (axis == "Z") {
+                    return readField(sample.location[2], LocationZField);
+                }
+                return reader.skipValue();
+            });
+        } else if (key == "Rotation" && reader.peek('{')) {
+            return reader.readObject([&](std::string_view axis) {
+                if (axis == "Pitch") {
+                    return readField(sample.rotation[0], PitchField);
+                } else if (axis == "Yaw") {
+                    return readField(sample.rotation[1], YawField);
+                } else if (axis == "Roll") {
+                    return readField(sample.rotation[2], RollField);
+                }
+                return reader.skipValue();
+            });
+        } else if (key == "FOV") {
+            return readField(sample.fov, FovField);
+        }
+        return reader.skipValue();
+    });
+
+    if (!ok || !reader.atEnd() || (fields & RequiredFields) != RequiredFields) {
+        return false;
+    }
+    if ((fields & FovField) == 0) {
+        sample.fov = 0.0;
+    }
+    remoteTimeUs = static_cast<int64_t>(timestampMs * 1000.0);
+    return true;
+}
+
+bool TransformDecoder::decodeBinary(const uint8_t* data, size_t size, TransformSample& sample, int64_t& remoteTimeUs) {
+    if (data == nullptr || size < sizeof(TelemetryProtocol::BinaryTransformV1) ||
+        data[0] < TelemetryProtocol::BinaryTransformVersion) {
+        return false;
+    }
+
+    // The later versions only append fields, so their prefix is a BinaryTransformV1.
+    // The payload is not aligned, so it is copied instead of being cast.
+    TelemetryProtocol::BinaryTransformV1 message;
+    std::memcpy(&message, data, sizeof(message));
+
+    remoteTimeUs = message.timestampUs;
+    for (size_t i = 0; i < 3; i++) {
+        sample.location[i] = message.location[i];
+        sample.rotation[i] = message.rotation[i];
+    }
+    sample.fov = message.fov;
+    return true;
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "telemetry_store.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+// Decodes the JSON transform messages of the streamers in a single pass, without building a DOM:
+// {"Timestamp": ms, "Location": {"X", "Y", "Z"}, "Rotation": {"Pitch", "Yaw", "Roll"}, "FOV": degrees}
+// The keys can be in any order and the unknown keys are skipped.
+class TransformDecoder {
+public:
+    // Returns false if the JSON is malformed or a required field is missing.
+    // remoteTimeUs is the timestamp of the streamer clock; sample.timestampUs is not modified.
+    static bool decode(std::string_view json, TransformSample& sample, int64_t& remoteTimeUs);
+
+    // Decodes a TelemetryProtocol::BinaryTransformV1 payload. The later versions are decoded from their
+    // BinaryTransformV1 prefix. Returns false if the payload is too short or its version is 0.
+    // The host must be little-endian, like the payload.
+    static bool decodeBinary(const uint8_t* data, size_t size, TransformSample& sample, int64_t& remoteTimeUs);
+
+private:
+    class Reader;
+};
@@ -0,0 +1,129 @@
+// Compares the TransformDecoder with the nlohmann DOM parsing of the transform messages,
+// and with the decoding of the same transforms in the binary format.
+// Usage: CppUE5PixelStreamingTransformDecoderBenchmark [message_count]
+
+#include "transform_decoder.h"
+#include "telemetry_protocol.h"
+
+#include <nlohmann/json.hpp>
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+    std::vector<std::string> createMessages(size_t count) {
+        std::mt19937 generator(42);
+        std::uniform_real_distribution<double> distribution(-10000.0, 10000.0);
+
+        std::vector<std::string> messages;
+        messages.reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            nlohmann::json json = {
+                {"Timestamp", 1700000000000.0 + static_cast<double>(i) * 16.667},
+                {"Location", {{"X", distribution(generator)}, {"Y", distribution(generator)}, {"Z", distribution(generator)}}},
+                {"Rotation", {{"Pitch", distribution(generator) / 100.0}, {"Yaw", distribution(generator) / 100.0},
+                              {"Roll", distribution(generator) / 100.0}}},
+                {"FOV", 90.0},
+                {"Name", "CameraActor_" + std::to_string(i % 9)}
+            };
+            messages.push_back(json.dump());
+        }
+        return messages;
+    }
+
+    std::vector<std::string> toBinaryMessages(const std::vector<std::string>& jsonMessages) {
+        std::vector<std::string> messages;
+        messages.reserve(jsonMessages.size());
+        for (const auto& jsonMessage : jsonMessages) {
+            auto json = nlohmann::json::parse(jsonMessage);
+            TelemetryProtocol::BinaryTransformV1 message{};
+            message.version = TelemetryProtocol::BinaryTransformVersion;
+            message.timestampUs = static_cast<int64_t>(json["Timestamp"].get<double>() * 1000.0);
+            message.location[0] = json["Location"]["X"].get<double>();
+            message.location[1] = json["Location"]["Y"].get<double>();
+            message.location[2] = json["Location"]["Z"].get<double>();
+            message.rotation[0] = json["Rotation"]["Pitch"].get<float>();
+            message.rotation[1] = json["Rotation"]["Yaw"].get<float>();
+            message.rotation[2] = json["Rotation"]["Roll"].get<float>();
+            message.fov = json["FOV"].get<float>();
+
+            std::string bytes(sizeof(message), '\0');
+            std::memcpy(bytes.data(), &message, sizeof(message));
+            messages.push_back(std::move(bytes));
+        }
+        return messages;
+    }
+
+    bool decodeWithNlohmann(const std::string& message, TransformSample& sample, int64_t& remoteTimeUs) {
+        auto json = nlohmann::json::parse(message, nullptr, false);
+        if (json.is_discarded() || !json.is_object()) {
+            return false;
+        }
+        try {
+            const auto& location = json.at("Location");
+            const auto& rotation = json.at("Rotation");
+            sample.location = {location.at("X").get<double>(), location.at("Y").get<double>(),
+                               location.at("Z").get<double>()};
+            sample.rotation = {rotation.at("Pitch").get<double>(), rotation.at("Yaw").get<double>(),
+                               rotation.at("Roll").get<double>()};
+            sample.fov = json.value("FOV", 0.0);
+            remoteTimeUs = static_cast<int64_t>(json.at("Timestamp").get<double>() * 1000.0);
+        } catch (const nlohmann::json::exception&) {
+            return false;
+        }
+        return true;
+    }
+
+    template<class F>
+    void run(const char* name, const std::vector<std::string>& messages, F&& decode) {
+        TransformSample sample;
+        int64_t remoteTimeUs = 0;
+        double checksum = 0.0;
+        size_t failureCount = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& message : messages) {
+            if (decode(message, sample, remoteTimeUs)) {
+                checksum += sample.location[0] + sample.rotation[1] + static_cast<double>(remoteTimeUs % 1000);
+            } else {
+                failureCount++;
+            }
+        }
+        auto end = std::chrono::steady_clock::now();
+
+        double elapsedUs = std::chrono::duration<double, std::micro>(end - start).count();
+        std::cout << name << ": " << elapsedUs / static_cast<double>(messages.size()) << " us/message, "
+                  << static_cast<double>(messages.size()) / (elapsedUs / 1e6) << " messages/s"
+                  << " (failures: " << failureCount << ", checksum: " << checksum << ")" << std::endl;
+    }
+}
+
+int main(int argc, char* argv[]) {
+    size_t messageCount = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 100000;
+    if (messageCount == 0) {
+        std::cerr << "Usage: " << argv[0] << " [message_count]" << std::endl;
+        return 1;
+    }
+
+    auto messages = createMessages(messageCount);
+    std::cout << "Decoding " << messageCount << " messages of about " << messages[0].size() << " bytes" << std::endl;
+
+    run("nlohmann", messages, decodeWithNlohmann);
+    run("TransformDecoder", messages, [](const std::string& message, TransformSample& sample, int64_t& remoteTimeUs) {
+        return TransformDecoder::decode(message, sample, remoteTimeUs);
+    });
+
+    auto binaryMessages = toBinaryMessages(messages);
+    std::cout << "Binary messages: " << binaryMessages[0].size() << " bytes" << std::endl;
+    run("TransformDecoder (binary)", binaryMessages,
+        [](const std::string& message, TransformSample& sample, int64_t& remoteTimeUs) {
+            return TransformDecoder::decodeBinary(reinterpret_cast<const uint8_t*>(message.data()), message.size(),
+                                                  sample, remoteTimeUs);
+        });
+    return 0;
+}
@@ -0,0 +1,198 @@
+#include "transform_decoder.h"
+#include "telemetry_protocol.h"
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+    std::vector<uint8_t> createBinaryMessage(uint8_t version, size_t appendedSize = 0) {
+        TelemetryProtocol::BinaryTransformV1 message{};
+        message.version = version;
+        message.timestampUs = 123456;
+        message.location[0] = 1.0;
+        message.location[1] = 2.0;
+        message.location[2] = 3.0;
+        message.rotation[0] = 10.0f;
+        message.rotation[1] = 20.0f;
+        message.rotation[2] = 30.0f;
+        message.fov = 90.0f;
+
+        std::vector<uint8_t> data(sizeof(message) + appendedSize, 0xFF);
+        std::memcpy(data.data(), &message, sizeof(message));
+        return data;
+    }
+}
+
+TEST(TransformDecoderTests, decodeBinary_version1_shouldDecodeTheTransform) {
+    auto data = createBinaryMessage(1);
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    ASSERT_TRUE(TransformDecoder::decodeBinary(data.data(), data.size(), sample, remoteTimeUs));
+
+    EXPECT_EQ(remoteTimeUs, 123456);
+    EXPECT_DOUBLE_EQ(sample.location[0], 1.0);
+    EXPECT_DOUBLE_EQ(sample.location[1], 2.0);
+    EXPECT_DOUBLE_EQ(sample.location[2], 3.0);
+    EXPECT_DOUBLE_EQ(sample.rotation[0], 10.0);
+    EXPECT_DOUBLE_EQ(sample.rotation[1], 20.0);
+    EXPECT_DOUBLE_EQ(sample.rotation[2], 30.0);
+    EXPECT_DOUBLE_EQ(sample.fov, 90.0);
+}
+
+TEST(TransformDecoderTests, decodeBinary_laterVersionWithAppendedFields_shouldDecodeTheV1Prefix) {
+    auto data = createBinaryMessage(2, 16);
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    ASSERT_TRUE(TransformDecoder::decodeBinary(data.data(), data.size(), sample, remoteTimeUs));
+
+    EXPECT_EQ(remoteTimeUs, 123456);
+    EXPECT_DOUBLE_EQ(sample.location[2], 3.0);
+    EXPECT_DOUBLE_EQ(sample.fov, 90.0);
+}
+
+TEST(TransformDecoderTests, decodeBinary_version0_shouldReturnFalse) {
+    auto data = createBinaryMessage(0);
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    EXPECT_FALSE(TransformDecoder::decodeBinary(data.data(), data.size(), sample, remoteTimeUs));
+}
+
+TEST(TransformDecoderTests, decodeBinary_tooShort_shouldReturnFalse) {
+    auto data = createBinaryMessage(1);
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    EXPECT_FALSE(TransformDecoder::decodeBinary(data.data(), data.size() - 1, sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decodeBinary(nullptr, 0, sample, remoteTimeUs));
+}
+
+TEST(TransformDecoderTests, decode_allFields_shouldDecodeTheTransform) {
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    ASSERT_TRUE(TransformDecoder::decode(
+        R"({"Timestamp": 1234.5, "Location": {"X": 1, "Y": 2.5, "Z": -3e2},
+            "Rotation": {"Pitch": 10, "Yaw": 20, "Roll": 30}, "FOV": 90})",
+        sample, remoteTimeUs));
+
+    EXPECT_EQ(remoteTimeUs, 1234500);
+    EXPECT_DOUBLE_EQ(sample.location[0], 1.0);
+    EXPECT_DOUBLE_EQ(sample.location[1], 2.5);
+    EXPECT_DOUBLE_EQ(sample.location[2], -300.0);
+    EXPECT_DOUBLE_EQ(sample.rotation[0], 10.0);
+    EXPECT_DOUBLE_EQ(sample.rotation[1], 20.0);
+    EXPECT_DOUBLE_EQ(sample.rotation[2], 30.0);
+    EXPECT_DOUBLE_EQ(sample.fov, 90.0);
+}
+
+TEST(TransformDecoderTests, decode_reorderedKeysAndUnknownValues_shouldSkipTheUnknownValues) {
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    ASSERT_TRUE(TransformDecoder::decode(
+        R"({"Extra": {"A": [1, {"B": [[], {}]}, "x"], "C": null}, "FOV": 60,
+            "Rotation": {"Roll": 3, "W": [true, false], "Yaw": 2, "Pitch": 1},
+            "List": [{"D": {"E": []}}, -1],
+            "Location": {"Z": 6, "Y": 5, "Unknown": {"F": "]}"}, "X": 4}, "Timestamp": 7})",
+        sample, remoteTimeUs));
+
+    EXPECT_EQ(remoteTimeUs, 7000);
+    EXPECT_DOUBLE_EQ(sample.location[0], 4.0);
+    EXPECT_DOUBLE_EQ(sample.location[1], 5.0);
+    EXPECT_DOUBLE_EQ(sample.location[2], 6.0);
+    EXPECT_DOUBLE_EQ(sample.rotation[0], 1.0);
+    EXPECT_DOUBLE_EQ(sample.rotation[1], 2.0);
+    EXPECT_DOUBLE_EQ(sample.rotation[2], 3.0);
+    EXPECT_DOUBLE_EQ(sample.fov, 60.0);
+}
+
+TEST(TransformDecoderTests, decode_tooDeepUnknownValue_shouldReturnFalse) {
+    std::string json = R"({"Extra": )" + std::string(64, '[') + std::string(64, ']') +
+        R"(, "Timestamp": 1, "Location": {"X": 1, "Y": 2, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}})";
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    EXPECT_FALSE(TransformDecoder::decode(json, sample, remoteTimeUs));
+}
+
+TEST(TransformDecoderTests, decode_missingRequiredField_shouldReturnFalse) {
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Location": {"X": 1, "Y": 2, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}})",
+        sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}})", sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": {"X": 1, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}})",
+        sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": {"X": 1, "Y": 2, "Z": 3}})", sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": {"X": 1, "Y": 2, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2}})",
+        sample, remoteTimeUs));
+}
+
+TEST(TransformDecoderTests, decode_missingFov_shouldSetTheFovTo0) {
+    TransformSample sample;
+    sample.fov = 90.0;
+    int64_t remoteTimeUs = 0;
+
+    ASSERT_TRUE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": {"X": 1, "Y": 2, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}})",
+        sample, remoteTimeUs));
+
+    EXPECT_DOUBLE_EQ(sample.fov, 0.0);
+}
+
+TEST(TransformDecoderTests, decode_escapedQuotesInStrings_shouldSkipTheStrings) {
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    ASSERT_TRUE(TransformDecoder::decode(
+        R"({"Name": "a \"quoted\" \\", "Timestamp": 1, "Location": {"X": 1, "Y": 2, "Z": 3},
+            "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}, "Path": "\\\"}"})",
+        sample, remoteTimeUs));
+
+    EXPECT_EQ(remoteTimeUs, 1000);
+}
+
+TEST(TransformDecoderTests, decode_trailingGarbage_shouldReturnFalse) {
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    EXPECT_TRUE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": {"X": 1, "Y": 2, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}} )",
+        sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": {"X": 1, "Y": 2, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}}x)",
+        sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": {"X": 1, "Y": 2, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}}{})",
+        sample, remoteTimeUs));
+}
+
+TEST(TransformDecoderTests, decode_nonNumberFieldValue_shouldReturnFalse) {
+    TransformSample sample;
+    int64_t remoteTimeUs = 0;
+
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": "1", "Location": {"X": 1, "Y": 2, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}})",
+        sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": {"X": true, "Y": 2, "Z": 3}, "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}})",
+        sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": {"X": 1, "Y": 2, "Z": 3}, "Rotation": {"Pitch": [1], "Yaw": 2, "Roll": 3}})",
+        sample, remoteTimeUs));
+    EXPECT_FALSE(TransformDecoder::decode(
+        R"({"Timestamp": 1, "Location": [1, 2, 3], "Rotation": {"Pitch": 1, "Yaw": 2, "Roll": 3}})",
+        sample, remoteTimeUs));
+}
@@ -13,24 +13,35 @@ VideoWidget::VideoWidget(const std::string& streamId, QWidget *parent)
     setFocusPolicy(Qt::StrongFocus);  // Allow receiving keyboard events
 }
 
-void VideoWidget::updateFrame(const cv::Mat& frame)
+void VideoWidget::updateFrame(const opentera::PooledVideoFrame& frame)
 {
     if (frame.empty()) {
         return;
     }
 
     try {
-        cv::Mat temp;
-        if (frame.channels() == 3) {
-            cv::cvtColor(frame.clone(), temp, cv::COLOR_BGR2RGB);
+        // The client delivers BGRA, which is the memory layout of Format_RGB32, so no conversion is needed
+        const cv::Mat& mat = frame.mat();
+        QImage::Format format;
+        if (mat.type() == CV_8UC4) {
+            format = QImage::Format_RGB32;
+        } else if (mat.type() == CV_8UC3) {
+            format = QImage::Format_BGR888;
+        } else if (mat.type() == CV_8UC1) {
+            format = QImage::Format_Grayscale8;
         } else {
-            temp = frame.clone();
+            return;
         }
 
-        m_image = QImage((const unsigned char*)(temp.data),
-                        temp.cols, temp.rows,
-                        temp.step,
-                        QImage::Format_RGB888).copy(); // Create a deep copy
+        // The image refers to the pooled frame, which is released when the image is destroyed
+        m_image = QImage(static_cast<const uchar*>(mat.data),
+                        mat.cols, mat.rows,
+                        static_cast<qsizetype>(mat.step),
+                        format,
+                        [](void* heldFrame) { delete static_cast<opentera::PooledVideoFrame*>(heldFrame); },
+                        new opentera::PooledVideoFrame(frame));
+        m_frameTimestamps = frame.timestamps();
+        m_isFrameDisplayed = false;
 
         update();
     } catch (const std::exception& e) {
@@ -64,6 +75,13 @@ void VideoWidget::paintEvent(QPaintEvent* event)
         // Stretch the image to fill the entire window
         painter.drawImage(rect(), m_image);
     }
+
+    if (!m_isFrameDisplayed) {
+        m_isFrameDisplayed = true;
+        if (m_onFrameDisplayed) {
+            m_onFrameDisplayed(m_frameTimestamps);
+        }
+    }
 }
 
 void VideoWidget::showEvent(QShowEvent* event)
@@ -129,6 +147,27 @@ void VideoWidget::moveEvent(QMoveEvent* event)
 void VideoWidget::resizeEvent(QResizeEvent* event)
 {
     QWidget::resizeEvent(event);
+
+    if (m_onDisplaySizeChanged) {
+        m_onDisplaySizeChanged(displaySize());
+    }
+}
+
+void VideoWidget::setOnDisplaySizeChanged(std::function<void(const QSize&)> callback)
+{
+    m_onDisplaySizeChanged = std::move(callback);
+}
+
+void VideoWidget::setOnFrameDisplayed(std::function<void(const opentera::VideoFrameTimestamps&)> callback)
+{
+    m_onFrameDisplayed = std::move(callback);
+}
+
+QSize VideoWidget::displaySize() const
+{
+    // Frames are scaled to the physical pixels of the widget, not to its logical size
+    qreal ratio = devicePixelRatioF();
+    return QSize(qRound(width() * ratio), qRound(height() * ratio));
 }
 
 
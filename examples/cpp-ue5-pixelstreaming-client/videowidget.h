@@ -5,8 +5,10 @@
 #include <QPainter>
 #include <QDebug>
 #include <QKeyEvent>
+#include <OpenteraWebrtcNativeClient/Sinks/VideoFramePool.h>
 #include <opencv2/core.hpp>
 #include <opencv2/imgproc.hpp>
+#include <functional>
 
 class VideoWidget : public QWidget {
     Q_OBJECT
@@ -18,12 +20,19 @@ public:
     };
 
     explicit VideoWidget(const std::string& streamId, QWidget *parent = nullptr);
-    void updateFrame(const cv::Mat& frame);
+    void updateFrame(const opentera::PooledVideoFrame& frame);
     void showFullScreen();
     void setDisplayMode(DisplayMode mode);
     DisplayMode displayMode() const { return m_displayMode; }
     void setGridPosition(const QRect& rect);
 
+    // Called with the size of the widget in device pixels whenever it changes
+    void setOnDisplaySizeChanged(std::function<void(const QSize&)> callback);
+    QSize displaySize() const;
+
+    // Called with the timestamps of each new frame once it is painted
+    void setOnFrameDisplayed(std::function<void(const opentera::VideoFrameTimestamps&)> callback);
+
 protected:
     void paintEvent(QPaintEvent* event) override;
     void resizeEvent(QResizeEvent* event) override;
@@ -40,4 +49,8 @@ private:
     bool m_keepAspectRatio;
     DisplayMode m_displayMode;
     QRect m_gridRect;
+    std::function<void(const QSize&)> m_onDisplaySizeChanged;
+    opentera::VideoFrameTimestamps m_frameTimestamps;
+    bool m_isFrameDisplayed = true;
+    std::function<void(const opentera::VideoFrameTimestamps&)> m_onFrameDisplayed;
 };
\ No newline at end of file
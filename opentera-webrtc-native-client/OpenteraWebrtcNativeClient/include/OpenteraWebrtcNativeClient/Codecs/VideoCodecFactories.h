@@ -4,6 +4,7 @@
 #include <OpenteraWebrtcNativeClient/Configurations/VideoStreamConfiguration.h>
 #include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
 
+#include <api/video_codecs/video_decoder.h>
 #include <api/video_codecs/video_decoder_factory.h>
 #include <api/video_codecs/video_encoder_factory.h>
 
@@ -56,6 +57,48 @@ namespace opentera
             const webrtc::SdpVideoFormat& format) override;
     };
 
+    /**
+     * @brief A video decoder that never decodes. It is used when only the encoded frames are needed.
+     *
+     * A key frame is requested until one is received, so the encoded frame stream always starts with a key frame.
+     */
+    class PassthroughVideoDecoder : public webrtc::VideoDecoder
+    {
+        bool m_hasReceivedKeyFrame;
+
+    public:
+        PassthroughVideoDecoder();
+        ~PassthroughVideoDecoder() override = default;
+
+        DECLARE_NOT_COPYABLE(PassthroughVideoDecoder);
+        DECLARE_NOT_MOVABLE(PassthroughVideoDecoder);
+
+        bool Configure(const Settings& settings) override;
+        int32_t Decode(const webrtc::EncodedImage& inputImage, bool missingFrames, int64_t renderTimeMs) override;
+        int32_t RegisterDecodeCompleteCallback(webrtc::DecodedImageCallback* callback) override;
+        int32_t Release() override;
+        DecoderInfo GetDecoderInfo() const override;
+        const char* ImplementationName() const override;
+    };
+
+    class PassthroughVideoDecoderFactory : public webrtc::VideoDecoderFactory
+    {
+        std::unique_ptr<webrtc::VideoDecoderFactory> m_factory;
+
+    public:
+        explicit PassthroughVideoDecoderFactory(std::unique_ptr<webrtc::VideoDecoderFactory> factory);
+        ~PassthroughVideoDecoderFactory() override = default;
+
+        DECLARE_NOT_COPYABLE(PassthroughVideoDecoderFactory);
+        DECLARE_NOT_MOVABLE(PassthroughVideoDecoderFactory);
+
+        std::vector<webrtc::SdpVideoFormat> GetSupportedFormats() const override;
+        CodecSupport QueryCodecSupport(const webrtc::SdpVideoFormat& format, bool referenceScaling) const override;
+        std::unique_ptr<webrtc::VideoDecoder> Create(
+              const webrtc::Environment& env,
+              const webrtc::SdpVideoFormat& format) override;
+    };
+
     std::unique_ptr<webrtc::VideoDecoderFactory>
         createVideoDecoderFactory(const VideoStreamConfiguration& configuration);
     std::unique_ptr<webrtc::VideoEncoderFactory>
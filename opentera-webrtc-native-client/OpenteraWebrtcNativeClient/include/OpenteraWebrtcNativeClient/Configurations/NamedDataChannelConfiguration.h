@@ -0,0 +1,117 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_CONFIGURATIONS_NAMED_DATA_CHANNEL_CONFIGURATION_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_CONFIGURATIONS_NAMED_DATA_CHANNEL_CONFIGURATION_H
+
+#include <OpenteraWebrtcNativeClient/Configurations/DataChannelConfiguration.h>
+
+#include <string>
+
+namespace opentera
+{
+    /**
+     * @brief Represents the SCTP scheduling priority of a data channel relative to the other channels of a peer
+     */
+    enum class DataChannelPriority
+    {
+        VeryLow,
+        Low,
+        Medium,
+        High
+    };
+
+    /**
+     * @brief Represents the configuration of an additional data channel opened with each peer.
+     */
+    class NamedDataChannelConfiguration
+    {
+        std::string m_label;
+        DataChannelConfiguration m_dataChannelConfiguration;
+        DataChannelPriority m_priority;
+
+        NamedDataChannelConfiguration(
+            std::string&& label,
+            DataChannelConfiguration&& dataChannelConfiguration,
+            DataChannelPriority priority);
+
+    public:
+        NamedDataChannelConfiguration(const NamedDataChannelConfiguration& other) = default;
+        NamedDataChannelConfiguration(NamedDataChannelConfiguration&& other) = default;
+        virtual ~NamedDataChannelConfiguration() = default;
+
+        static NamedDataChannelConfiguration create(std::string label);
+        static NamedDataChannelConfiguration create(std::string label, DataChannelConfiguration dataChannelConfiguration);
+        static NamedDataChannelConfiguration
+            create(std::string label, DataChannelConfiguration dataChannelConfiguration, DataChannelPriority priority);
+
+        [[nodiscard]] const std::string& label() const;
+        [[nodiscard]] const DataChannelConfiguration& dataChannelConfiguration() const;
+        [[nodiscard]] DataChannelPriority priority() const;
+
+        explicit operator webrtc::DataChannelInit() const;
+
+        NamedDataChannelConfiguration& operator=(const NamedDataChannelConfiguration& other) = default;
+        NamedDataChannelConfiguration& operator=(NamedDataChannelConfiguration&& other) = default;
+    };
+
+    /**
+     * @brief Creates a named data channel configuration with default values.
+     *
+     * @param label The data channel label, it must be unique and different from the room name
+     * @return A named data channel configuration with default values
+     */
+    inline NamedDataChannelConfiguration NamedDataChannelConfiguration::create(std::string label)
+    {
+        return {std::move(label), DataChannelConfiguration::create(), DataChannelPriority::Medium};
+    }
+
+    /**
+     * @brief Creates a named data channel configuration with the specified values.
+     *
+     * @param label The data channel label, it must be unique and different from the room name
+     * @param dataChannelConfiguration The reliability and the protocol of the data channel
+     * @return A named data channel configuration with the specified values
+     */
+    inline NamedDataChannelConfiguration
+        NamedDataChannelConfiguration::create(std::string label, DataChannelConfiguration dataChannelConfiguration)
+    {
+        return {std::move(label), std::move(dataChannelConfiguration), DataChannelPriority::Medium};
+    }
+
+    /**
+     * @brief Creates a named data channel configuration with the specified values.
+     *
+     * @param label The data channel label, it must be unique and different from the room name
+     * @param dataChannelConfiguration The reliability and the protocol of the data channel
+     * @param priority The SCTP scheduling priority of the data channel
+     * @return A named data channel configuration with the specified values
+     */
+    inline NamedDataChannelConfiguration NamedDataChannelConfiguration::create(
+        std::string label,
+        DataChannelConfiguration dataChannelConfiguration,
+        DataChannelPriority priority)
+    {
+        return {std::move(label), std::move(dataChannelConfiguration), priority};
+    }
+
+    /**
+     * @brief Returns the data channel label.
+     * @return The data channel label
+     */
+    inline const std::string& NamedDataChannelConfiguration::label() const { return m_label; }
+
+    /**
+     * @brief Returns the reliability and the protocol of the data channel.
+     * @return The reliability and the protocol of the data channel
+     */
+    inline const DataChannelConfiguration& NamedDataChannelConfiguration::dataChannelConfiguration() const
+    {
+        return m_dataChannelConfiguration;
+    }
+
+    /**
+     * @brief Returns the SCTP scheduling priority of the data channel.
+     * @return The SCTP scheduling priority of the data channel
+     */
+    inline DataChannelPriority NamedDataChannelConfiguration::priority() const { return m_priority; }
+}
+
+#endif
@@ -0,0 +1,69 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_CONFIGURATIONS_RECEIVE_LATENCY_CONFIGURATION_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_CONFIGURATIONS_RECEIVE_LATENCY_CONFIGURATION_H
+
+#include <chrono>
+#include <optional>
+
+namespace opentera
+{
+    /**
+     * @brief Represents the latency configuration of the received videos of a stream.
+     *
+     * WebRTC adapts the jitter buffer delay to the network jitter. A minimum delay makes the playout smoother at the
+     * cost of latency. The playout delay of all streams is set with the field trials (see FieldTrials.h).
+     */
+    class ReceiveLatencyConfiguration
+    {
+        std::optional<std::chrono::milliseconds> m_jitterBufferMinimumDelay;
+
+        explicit ReceiveLatencyConfiguration(std::optional<std::chrono::milliseconds> jitterBufferMinimumDelay);
+
+    public:
+        ReceiveLatencyConfiguration(const ReceiveLatencyConfiguration& other) = default;
+        ReceiveLatencyConfiguration(ReceiveLatencyConfiguration&& other) = default;
+        virtual ~ReceiveLatencyConfiguration() = default;
+
+        static ReceiveLatencyConfiguration create();
+        static ReceiveLatencyConfiguration create(std::chrono::milliseconds jitterBufferMinimumDelay);
+
+        [[nodiscard]] std::optional<std::chrono::milliseconds> jitterBufferMinimumDelay() const;
+
+        ReceiveLatencyConfiguration& operator=(const ReceiveLatencyConfiguration& other) = default;
+        ReceiveLatencyConfiguration& operator=(ReceiveLatencyConfiguration&& other) = default;
+    };
+
+    /**
+     * @brief Creates a receive latency configuration with default values.
+     *
+     * The jitter buffer delay only depends on the network jitter, which gives the lowest latency.
+     *
+     * @return A receive latency configuration with default values
+     */
+    inline ReceiveLatencyConfiguration ReceiveLatencyConfiguration::create()
+    {
+        return ReceiveLatencyConfiguration(std::nullopt);
+    }
+
+    /**
+     * @brief Creates a receive latency configuration with the specified value.
+     *
+     * @param jitterBufferMinimumDelay The minimum delay of the jitter buffer
+     * @return A receive latency configuration with the specified value
+     */
+    inline ReceiveLatencyConfiguration
+        ReceiveLatencyConfiguration::create(std::chrono::milliseconds jitterBufferMinimumDelay)
+    {
+        return ReceiveLatencyConfiguration(jitterBufferMinimumDelay);
+    }
+
+    /**
+     * @brief Returns the minimum delay of the jitter buffer.
+     * @return The minimum delay of the jitter buffer, or std::nullopt if the delay only depends on the network jitter
+     */
+    inline std::optional<std::chrono::milliseconds> ReceiveLatencyConfiguration::jitterBufferMinimumDelay() const
+    {
+        return m_jitterBufferMinimumDelay;
+    }
+}
+
+#endif
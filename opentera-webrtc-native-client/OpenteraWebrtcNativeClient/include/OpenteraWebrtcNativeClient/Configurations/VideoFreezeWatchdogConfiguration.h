@@ -0,0 +1,129 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_CONFIGURATIONS_VIDEO_FREEZE_WATCHDOG_CONFIGURATION_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_CONFIGURATIONS_VIDEO_FREEZE_WATCHDOG_CONFIGURATION_H
+
+#include <chrono>
+#include <cstddef>
+
+namespace opentera
+{
+    /**
+     * @brief Represents a frozen video watchdog configuration.
+     *
+     * A received video is frozen when no frame is decoded for the frozen timeout. The watchdog requests key frames
+     * first, then restarts ICE and finally asks for a new connection.
+     */
+    class VideoFreezeWatchdogConfiguration
+    {
+        std::chrono::milliseconds m_frozenTimeout;
+        std::chrono::milliseconds m_keyFrameRequestInterval;
+        size_t m_keyFrameRequestCount;
+        std::chrono::milliseconds m_iceRestartTimeout;
+
+        VideoFreezeWatchdogConfiguration(
+            std::chrono::milliseconds frozenTimeout,
+            std::chrono::milliseconds keyFrameRequestInterval,
+            size_t keyFrameRequestCount,
+            std::chrono::milliseconds iceRestartTimeout);
+
+    public:
+        VideoFreezeWatchdogConfiguration(const VideoFreezeWatchdogConfiguration& other) = default;
+        VideoFreezeWatchdogConfiguration(VideoFreezeWatchdogConfiguration&& other) = default;
+        virtual ~VideoFreezeWatchdogConfiguration() = default;
+
+        static VideoFreezeWatchdogConfiguration create();
+        static VideoFreezeWatchdogConfiguration create(std::chrono::milliseconds frozenTimeout);
+        static VideoFreezeWatchdogConfiguration create(
+            std::chrono::milliseconds frozenTimeout,
+            std::chrono::milliseconds keyFrameRequestInterval,
+            size_t keyFrameRequestCount,
+            std::chrono::milliseconds iceRestartTimeout);
+
+        [[nodiscard]] std::chrono::milliseconds frozenTimeout() const;
+        [[nodiscard]] std::chrono::milliseconds keyFrameRequestInterval() const;
+        [[nodiscard]] size_t keyFrameRequestCount() const;
+        [[nodiscard]] std::chrono::milliseconds iceRestartTimeout() const;
+
+        VideoFreezeWatchdogConfiguration& operator=(const VideoFreezeWatchdogConfiguration& other) = default;
+        VideoFreezeWatchdogConfiguration& operator=(VideoFreezeWatchdogConfiguration&& other) = default;
+    };
+
+    /**
+     * @brief Creates a frozen video watchdog configuration with default values.
+     *
+     * The video is frozen after 1 s without decoded frame. 3 key frames are requested 300 ms apart, then ICE is
+     * restarted and a new connection is requested if no frame is decoded within 3 s.
+     *
+     * @return A frozen video watchdog configuration with default values
+     */
+    inline VideoFreezeWatchdogConfiguration VideoFreezeWatchdogConfiguration::create()
+    {
+        using namespace std::chrono_literals;
+        return {1000ms, 300ms, 3, 3000ms};
+    }
+
+    /**
+     * @brief Creates a frozen video watchdog configuration with the specified value.
+     *
+     * @param frozenTimeout The duration without decoded frame after which the video is frozen
+     * @return A frozen video watchdog configuration with the specified value
+     */
+    inline VideoFreezeWatchdogConfiguration
+        VideoFreezeWatchdogConfiguration::create(std::chrono::milliseconds frozenTimeout)
+    {
+        using namespace std::chrono_literals;
+        return {frozenTimeout, 300ms, 3, 3000ms};
+    }
+
+    /**
+     * @brief Creates a frozen video watchdog configuration with the specified values.
+     *
+     * @param frozenTimeout The duration without decoded frame after which the video is frozen
+     * @param keyFrameRequestInterval The minimum duration between the recovery steps that are not a reconnection
+     * @param keyFrameRequestCount The number of key frame requests before restarting ICE. 0 means no key frame request.
+     * @param iceRestartTimeout The duration after the ICE restart after which a new connection is requested
+     * @return A frozen video watchdog configuration with the specified values
+     */
+    inline VideoFreezeWatchdogConfiguration VideoFreezeWatchdogConfiguration::create(
+        std::chrono::milliseconds frozenTimeout,
+        std::chrono::milliseconds keyFrameRequestInterval,
+        size_t keyFrameRequestCount,
+        std::chrono::milliseconds iceRestartTimeout)
+    {
+        return {frozenTimeout, keyFrameRequestInterval, keyFrameRequestCount, iceRestartTimeout};
+    }
+
+    /**
+     * @brief Returns the duration without decoded frame after which the video is frozen.
+     * @return The duration without decoded frame after which the video is frozen
+     */
+    inline std::chrono::milliseconds VideoFreezeWatchdogConfiguration::frozenTimeout() const
+    {
+        return m_frozenTimeout;
+    }
+
+    /**
+     * @brief Returns the minimum duration between the recovery steps that are not a reconnection.
+     * @return The minimum duration between the recovery steps that are not a reconnection
+     */
+    inline std::chrono::milliseconds VideoFreezeWatchdogConfiguration::keyFrameRequestInterval() const
+    {
+        return m_keyFrameRequestInterval;
+    }
+
+    /**
+     * @brief Returns the number of key frame requests before restarting ICE.
+     * @return The number of key frame requests before restarting ICE
+     */
+    inline size_t VideoFreezeWatchdogConfiguration::keyFrameRequestCount() const { return m_keyFrameRequestCount; }
+
+    /**
+     * @brief Returns the duration after the ICE restart after which a new connection is requested.
+     * @return The duration after the ICE restart after which a new connection is requested
+     */
+    inline std::chrono::milliseconds VideoFreezeWatchdogConfiguration::iceRestartTimeout() const
+    {
+        return m_iceRestartTimeout;
+    }
+}
+
+#endif
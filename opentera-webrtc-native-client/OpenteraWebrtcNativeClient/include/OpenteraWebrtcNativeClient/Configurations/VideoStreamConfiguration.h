@@ -27,11 +27,13 @@ namespace opentera
         std::unordered_set<VideoStreamCodec> m_forcedCodecs;  // Empty means all
         bool m_forceGStreamerHardwareAcceleration;
         bool m_useGStreamerSoftwareEncoderDecoder;
+        bool m_receiveEncodedVideoOnly;
 
         VideoStreamConfiguration(
             std::unordered_set<VideoStreamCodec> forcedCodecs,
             bool forceGStreamerHardwareAcceleration,
-            bool useGStreamerSoftwareEncoderDecoder);
+            bool useGStreamerSoftwareEncoderDecoder,
+            bool receiveEncodedVideoOnly);
 
     public:
         VideoStreamConfiguration(const VideoStreamConfiguration& other) = default;
@@ -44,10 +46,16 @@ namespace opentera
             std::unordered_set<VideoStreamCodec> forcedCodecs,
             bool forceGStreamerHardwareAcceleration,
             bool useGStreamerSoftwareEncoderDecoder);
+        static VideoStreamConfiguration create(
+            std::unordered_set<VideoStreamCodec> forcedCodecs,
+            bool forceGStreamerHardwareAcceleration,
+            bool useGStreamerSoftwareEncoderDecoder,
+            bool receiveEncodedVideoOnly);
 
         [[nodiscard]] const std::unordered_set<VideoStreamCodec>& forcedCodecs() const;
         [[nodiscard]] bool forceGStreamerHardwareAcceleration() const;
         [[nodiscard]] bool useGStreamerSoftwareEncoderDecoder() const;
+        [[nodiscard]] bool receiveEncodedVideoOnly() const;
 
         VideoStreamConfiguration& operator=(const VideoStreamConfiguration& other) = default;
         VideoStreamConfiguration& operator=(VideoStreamConfiguration&& other) = default;
@@ -57,7 +65,7 @@ namespace opentera
      * @brief Creates a stream configuration with default values.
      * @return A stream configuration with default values
      */
-    inline VideoStreamConfiguration VideoStreamConfiguration::create() { return {{}, false, false}; }
+    inline VideoStreamConfiguration VideoStreamConfiguration::create() { return {{}, false, false, false}; }
 
     /**
      * @brief Creates a video stream configuration with the specified value.
@@ -67,7 +75,7 @@ namespace opentera
      */
     inline VideoStreamConfiguration VideoStreamConfiguration::create(std::unordered_set<VideoStreamCodec> forcedCodecs)
     {
-        return {std::move(forcedCodecs), false, false};
+        return {std::move(forcedCodecs), false, false, false};
     }
 
     /**
@@ -85,7 +93,32 @@ namespace opentera
         bool forceGStreamerHardwareAcceleration,
         bool useGStreamerSoftwareEncoderDecoder)
     {
-        return {std::move(forcedCodecs), forceGStreamerHardwareAcceleration, useGStreamerSoftwareEncoderDecoder};
+        return {std::move(forcedCodecs), forceGStreamerHardwareAcceleration, useGStreamerSoftwareEncoderDecoder, false};
+    }
+
+    /**
+     * @brief Creates a video stream configuration with the specified values.
+     *
+     * @param forcedCodecs Indicates the codecs that must be used. An empty set means all codecs.
+     * @param forceGStreamerHardwareAcceleration Indicates that hardware accelerated codecs must be used. It has no
+     * effect when the library is not built with GStreamer.
+     * @param useGStreamerSoftwareEncoderDecoder Indicates to use GStreamer software codecs instead of WebRTC ones. It
+     * has no effect when the library is not built with GStreamer.
+     * @param receiveEncodedVideoOnly Indicates that the received video streams are never decoded. The video is still
+     * negotiated and the encoded frames are still delivered, but no decoded frames are produced.
+     * @return A video stream channel configuration with the specified values
+     */
+    inline VideoStreamConfiguration VideoStreamConfiguration::create(
+        std::unordered_set<VideoStreamCodec> forcedCodecs,
+        bool forceGStreamerHardwareAcceleration,
+        bool useGStreamerSoftwareEncoderDecoder,
+        bool receiveEncodedVideoOnly)
+    {
+        return {
+            std::move(forcedCodecs),
+            forceGStreamerHardwareAcceleration,
+            useGStreamerSoftwareEncoderDecoder,
+            receiveEncodedVideoOnly};
     }
 
     /**
@@ -115,6 +148,12 @@ namespace opentera
         return m_useGStreamerSoftwareEncoderDecoder;
     }
 
+    /**
+     * @brief Indicates that the received video streams are never decoded.
+     * @return true if only the encoded frames of the received video streams are available.
+     */
+    inline bool VideoStreamConfiguration::receiveEncodedVideoOnly() const { return m_receiveEncodedVideoOnly; }
+
 }
 
 #endif
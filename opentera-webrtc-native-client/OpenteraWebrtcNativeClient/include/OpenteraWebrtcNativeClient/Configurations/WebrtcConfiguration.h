@@ -7,14 +7,45 @@
 
 namespace opentera
 {
+    /**
+     * @brief Represents the networks used to gather the ICE candidates.
+     */
+    enum class IceCandidateNetworkPolicy
+    {
+        // All networks are used
+        All,
+        // The costly networks (for example, cellular) are not used
+        LowCost
+    };
+
+    /**
+     * @brief Represents when the ICE candidates are gathered.
+     */
+    enum class IceGatheringPolicy
+    {
+        // The candidates are gathered once, when the connection is negotiated or ICE is restarted
+        GatherOnce,
+        // The candidates are gathered again when the networks change
+        GatherContinually
+    };
+
     /**
      * @brief Represents a WebRTC peer connection configuration.
      */
     class WebrtcConfiguration
     {
         std::vector<IceServer> m_iceServers;
+        IceCandidateNetworkPolicy m_candidateNetworkPolicy;
+        IceGatheringPolicy m_gatheringPolicy;
+        bool m_tcpCandidatesEnabled;
+        bool m_bundleRequired;
 
-        explicit WebrtcConfiguration(std::vector<IceServer>&& iceServers);
+        WebrtcConfiguration(
+            std::vector<IceServer>&& iceServers,
+            IceCandidateNetworkPolicy candidateNetworkPolicy,
+            IceGatheringPolicy gatheringPolicy,
+            bool tcpCandidatesEnabled,
+            bool bundleRequired);
 
     public:
         WebrtcConfiguration(const WebrtcConfiguration& other) = default;
@@ -23,8 +54,19 @@ namespace opentera
 
         static WebrtcConfiguration create();
         static WebrtcConfiguration create(std::vector<IceServer> iceServers);
+        static WebrtcConfiguration create(
+            std::vector<IceServer> iceServers,
+            IceCandidateNetworkPolicy candidateNetworkPolicy,
+            IceGatheringPolicy gatheringPolicy,
+            bool tcpCandidatesEnabled,
+            bool bundleRequired);
+        static WebrtcConfiguration createForLocalNetwork();
 
         [[nodiscard]] const std::vector<IceServer>& iceServers() const;
+        [[nodiscard]] IceCandidateNetworkPolicy candidateNetworkPolicy() const;
+        [[nodiscard]] IceGatheringPolicy gatheringPolicy() const;
+        [[nodiscard]] bool tcpCandidatesEnabled() const;
+        [[nodiscard]] bool bundleRequired() const;
 
         explicit operator webrtc::PeerConnectionInterface::RTCConfiguration() const;
 
@@ -36,7 +78,7 @@ namespace opentera
      * @brief Creates a WebRTC peer connection configuration with default values.
      * @return A WebRTC peer connection configuration with default values
      */
-    inline WebrtcConfiguration WebrtcConfiguration::create() { return WebrtcConfiguration({}); }
+    inline WebrtcConfiguration WebrtcConfiguration::create() { return create({}); }
 
     /**
      * @brief Creates a WebRTC peer connection configuration with the specified value.
@@ -45,7 +87,51 @@ namespace opentera
      */
     inline WebrtcConfiguration WebrtcConfiguration::create(std::vector<IceServer> iceServers)
     {
-        return WebrtcConfiguration(std::move(iceServers));
+        return WebrtcConfiguration(
+            std::move(iceServers),
+            IceCandidateNetworkPolicy::All,
+            IceGatheringPolicy::GatherOnce,
+            true,
+            false);
+    }
+
+    /**
+     * @brief Creates a WebRTC peer connection configuration with the specified values.
+     *
+     * @param iceServers The ice servers
+     * @param candidateNetworkPolicy The networks used to gather the ICE candidates
+     * @param gatheringPolicy When the ICE candidates are gathered
+     * @param tcpCandidatesEnabled Indicates if the TCP candidates are gathered
+     * @param bundleRequired Indicates if all media are sent over one transport with RTP and RTCP multiplexed. The
+     * remote peer must support BUNDLE.
+     * @return A WebRTC peer connection configuration with the specified values
+     */
+    inline WebrtcConfiguration WebrtcConfiguration::create(
+        std::vector<IceServer> iceServers,
+        IceCandidateNetworkPolicy candidateNetworkPolicy,
+        IceGatheringPolicy gatheringPolicy,
+        bool tcpCandidatesEnabled,
+        bool bundleRequired)
+    {
+        return WebrtcConfiguration(
+            std::move(iceServers),
+            candidateNetworkPolicy,
+            gatheringPolicy,
+            tcpCandidatesEnabled,
+            bundleRequired);
+    }
+
+    /**
+     * @brief Creates a WebRTC peer connection configuration for peers on the same local network.
+     *
+     * There is no ice server, so only the host candidates are gathered without waiting for STUN or TURN servers.
+     * The TCP candidates are not gathered and BUNDLE is required, so there is only one transport to connect.
+     *
+     * @return A WebRTC peer connection configuration for peers on the same local network
+     */
+    inline WebrtcConfiguration WebrtcConfiguration::createForLocalNetwork()
+    {
+        return WebrtcConfiguration({}, IceCandidateNetworkPolicy::All, IceGatheringPolicy::GatherOnce, false, true);
     }
 
     /**
@@ -53,6 +139,33 @@ namespace opentera
      * @return The ice servers
      */
     inline const std::vector<IceServer>& WebrtcConfiguration::iceServers() const { return m_iceServers; }
+
+    /**
+     * Returns the networks used to gather the ICE candidates.
+     * @return The networks used to gather the ICE candidates
+     */
+    inline IceCandidateNetworkPolicy WebrtcConfiguration::candidateNetworkPolicy() const
+    {
+        return m_candidateNetworkPolicy;
+    }
+
+    /**
+     * Returns when the ICE candidates are gathered.
+     * @return When the ICE candidates are gathered
+     */
+    inline IceGatheringPolicy WebrtcConfiguration::gatheringPolicy() const { return m_gatheringPolicy; }
+
+    /**
+     * Indicates if the TCP candidates are gathered.
+     * @return true if the TCP candidates are gathered
+     */
+    inline bool WebrtcConfiguration::tcpCandidatesEnabled() const { return m_tcpCandidatesEnabled; }
+
+    /**
+     * Indicates if all media are sent over one transport with RTP and RTCP multiplexed.
+     * @return true if all media are sent over one transport with RTP and RTCP multiplexed
+     */
+    inline bool WebrtcConfiguration::bundleRequired() const { return m_bundleRequired; }
 }
 
 #endif
@@ -4,17 +4,37 @@
 #include <OpenteraWebrtcNativeClient/WebrtcClient.h>
 #include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
 #include <OpenteraWebrtcNativeClient/Configurations/DataChannelConfiguration.h>
+#include <OpenteraWebrtcNativeClient/Configurations/NamedDataChannelConfiguration.h>
+#include <OpenteraWebrtcNativeClient/Utils/BoundedStream.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunk.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelCompressor.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelSendQueue.h>
 
 #include <api/data_channel_interface.h>
 
+#include <map>
+#include <memory>
+
 namespace opentera
 {
+    /**
+     * @brief A message received on the main data channel.
+     */
+    struct ReceivedDataChannelMessage
+    {
+        Client client;
+        webrtc::DataBuffer buffer;
+    };
+
+    using DataChannelMessageStream = BoundedStream<ReceivedDataChannelMessage>;
+
     /**
      * @brief Represents a client for data channel communication.
      */
     class DataChannelClient : public WebrtcClient
     {
         DataChannelConfiguration m_dataChannelConfiguration;
+        std::vector<NamedDataChannelConfiguration> m_namedDataChannelConfigurations;
 
         std::function<void(const Client&)> m_onDataChannelOpened;
         std::function<void(const Client&)> m_onDataChannelClosed;
@@ -22,12 +42,35 @@ namespace opentera
         std::function<void(const Client&, const uint8_t*, std::size_t)> m_onDataChannelMessageBinary;
         std::function<void(const Client&, const std::string&)> m_onDataChannelMessageString;
 
+        bool m_isChunkedMessageEnabled;
+        std::function<void(const Client&, const DataChannelTransferProgress&)> m_onDataChannelReceiveProgress;
+
+        std::function<void(const Client&, const std::string&)> m_onNamedDataChannelOpened;
+        std::function<void(const Client&, const std::string&)> m_onNamedDataChannelClosed;
+        std::function<void(const Client&, const std::string&, const std::string&)> m_onNamedDataChannelError;
+        std::function<void(const Client&, const std::string&, const uint8_t*, std::size_t)>
+            m_onNamedDataChannelMessageBinary;
+        std::function<void(const Client&, const std::string&, const std::string&)> m_onNamedDataChannelMessageString;
+
+        std::shared_ptr<DataChannelCompressor> m_dataChannelCompressor;
+        std::map<std::string, std::shared_ptr<DataChannelCompressor>> m_namedDataChannelCompressors;
+
+        // Shared with the peer connection handlers, which can outlive the client members
+        std::shared_ptr<BoundedStreamGroup<ReceivedDataChannelMessage>> m_dataChannelMessageStreams;
+
     public:
+        static constexpr size_t DefaultDataChannelMessageStreamCapacity = 256;
+
         DataChannelClient(
             SignalingServerConfiguration signalingServerConfiguration,
             WebrtcConfiguration webrtcConfiguration,
             DataChannelConfiguration dataChannelConfiguration);
-        ~DataChannelClient() override = default;
+        DataChannelClient(
+            SignalingServerConfiguration signalingServerConfiguration,
+            WebrtcConfiguration webrtcConfiguration,
+            DataChannelConfiguration dataChannelConfiguration,
+            std::vector<NamedDataChannelConfiguration> namedDataChannelConfigurations);
+        ~DataChannelClient() override;
 
         DECLARE_NOT_COPYABLE(DataChannelClient);
         DECLARE_NOT_MOVABLE(DataChannelClient);
@@ -37,27 +80,134 @@ namespace opentera
         bool sendToAll(const uint8_t* data, std::size_t size);
         bool sendToAll(const std::string& message);
 
+        bool sendTo(
+            const uint8_t* data,
+            std::size_t size,
+            const std::vector<std::string>& ids,
+            DataChannelSendPriority priority,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+        bool sendTo(
+            const std::string& message,
+            const std::vector<std::string>& ids,
+            DataChannelSendPriority priority,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+        bool sendToAll(
+            const uint8_t* data,
+            std::size_t size,
+            DataChannelSendPriority priority,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+        bool sendToAll(
+            const std::string& message,
+            DataChannelSendPriority priority,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+
+        bool sendTo(
+            const webrtc::DataBuffer& buffer,
+            const std::vector<std::string>& ids,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+        bool sendToAll(
+            const webrtc::DataBuffer& buffer,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+
+        bool sendChunkedTo(
+            const webrtc::DataBuffer& buffer,
+            const std::vector<std::string>& ids,
+            const std::function<void(const Client&, const DataChannelTransferProgress&)>& onProgress = nullptr,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+        bool sendChunkedToAll(
+            const webrtc::DataBuffer& buffer,
+            const std::function<void(const Client&, const DataChannelTransferProgress&)>& onProgress = nullptr,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+
+        bool sendOnChannelTo(
+            const std::string& label,
+            const webrtc::DataBuffer& buffer,
+            const std::vector<std::string>& ids,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+        bool sendOnChannelTo(
+            const std::string& label,
+            const std::string& message,
+            const std::vector<std::string>& ids,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+        bool sendOnChannelToAll(
+            const std::string& label,
+            const webrtc::DataBuffer& buffer,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+        bool sendOnChannelToAll(
+            const std::string& label,
+            const std::string& message,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            const std::function<void(const Client&, bool)>& onComplete = nullptr);
+
+        void setChunkedMessageEnabled(bool enabled);
+        [[nodiscard]] bool isChunkedMessageEnabled();
+
+        void setDataChannelCompressor(const std::shared_ptr<DataChannelCompressor>& compressor);
+        void setNamedDataChannelCompressor(
+            const std::string& label,
+            const std::shared_ptr<DataChannelCompressor>& compressor);
+
+        std::shared_ptr<DataChannelMessageStream> createDataChannelMessageStream(
+            size_t capacity = DefaultDataChannelMessageStreamCapacity,
+            StreamDropPolicy dropPolicy = StreamDropPolicy::DropNewest);
+
         void setOnDataChannelOpened(const std::function<void(const Client&)>& callback);
         void setOnDataChannelClosed(const std::function<void(const Client&)>& callback);
         void setOnDataChannelError(const std::function<void(const Client&, const std::string&)>& callback);
         void setOnDataChannelMessageBinary(
             const std::function<void(const Client&, const uint8_t*, std::size_t)>& callback);
         void setOnDataChannelMessageString(const std::function<void(const Client&, const std::string&)>& callback);
+        void setOnDataChannelReceiveProgress(
+            const std::function<void(const Client&, const DataChannelTransferProgress&)>& callback);
 
-    protected:
-        bool sendTo(const webrtc::DataBuffer& buffer, const std::vector<std::string>& ids);
-        bool sendToAll(const webrtc::DataBuffer& buffer);
+        void setOnNamedDataChannelOpened(const std::function<void(const Client&, const std::string&)>& callback);
+        void setOnNamedDataChannelClosed(const std::function<void(const Client&, const std::string&)>& callback);
+        void setOnNamedDataChannelError(
+            const std::function<void(const Client&, const std::string&, const std::string&)>& callback);
+        void setOnNamedDataChannelMessageBinary(
+            const std::function<void(const Client&, const std::string&, const uint8_t*, std::size_t)>& callback);
+        void setOnNamedDataChannelMessageString(
+            const std::function<void(const Client&, const std::string&, const std::string&)>& callback);
 
+    protected:
         std::unique_ptr<PeerConnectionHandler>
             createPeerConnectionHandler(const std::string& id, const Client& peerClient, bool isCaller) override;
+
+    private:
+        bool send(
+            PeerConnectionHandler& handler,
+            const webrtc::DataBuffer& buffer,
+            std::map<DataChannelCompressor*, webrtc::DataBuffer>& compressedBuffers,
+            DataChannelSendPriority priority,
+            const std::function<void(const Client&, bool)>& onComplete);
+        bool sendOnChannel(
+            PeerConnectionHandler& handler,
+            const std::string& label,
+            const webrtc::DataBuffer& buffer,
+            std::map<DataChannelCompressor*, webrtc::DataBuffer>& compressedBuffers,
+            DataChannelSendPriority priority,
+            const std::function<void(const Client&, bool)>& onComplete);
+        bool sendChunked(
+            PeerConnectionHandler& handler,
+            const webrtc::DataBuffer& buffer,
+            const std::function<void(const Client&, const DataChannelTransferProgress&)>& onProgress,
+            const std::function<void(const Client&, bool)>& onComplete);
     };
 
     /**
      * @brief Sends binary data to the specified clients.
      *
+     * The data are queued while the data channel of a client buffers too much data.
+     *
      * @param data The binary data
      * @param size The binary data size
      * @param ids The client ids
+     * @return true if the data channels of all the specified clients are open and the data are sent or queued
      */
     inline bool DataChannelClient::sendTo(const uint8_t* data, size_t size, const std::vector<std::string>& ids)
     {
@@ -69,6 +219,7 @@ namespace opentera
      *
      * @param message The string message
      * @param ids The client ids
+     * @return true if the data channels of all the specified clients are open and the message is sent or queued
      */
     inline bool DataChannelClient::sendTo(const std::string& message, const std::vector<std::string>& ids)
     {
@@ -80,6 +231,7 @@ namespace opentera
      *
      * @param data The binary data
      * @param size The binary data size
+     * @return true if the data channels of all clients are open and the data are sent or queued
      */
     inline bool DataChannelClient::sendToAll(const uint8_t* data, size_t size)
     {
@@ -90,12 +242,209 @@ namespace opentera
      * @brief Sends a string message to all clients.
      *
      * @param message The string message
+     * @return true if the data channels of all clients are open and the message is sent or queued
      */
     inline bool DataChannelClient::sendToAll(const std::string& message)
     {
         return sendToAll(webrtc::DataBuffer(message));
     }
 
+    /**
+     * @brief Sends binary data to the specified clients with a priority.
+     *
+     * The high priority data are sent before the queued normal priority data. The completion callback is called
+     * from the internal client thread once per client. The callback should not block.
+     *
+     * @parblock
+     * Callback parameters:
+     * - client: The client the data are sent to
+     * - sent: true if the data channel accepted the data, false if it failed or the data channel closed
+     * @endparblock
+     *
+     * @param data The binary data
+     * @param size The binary data size
+     * @param ids The client ids
+     * @param priority The priority
+     * @param onComplete The completion callback, it can be null
+     * @return true if the data channels of all the specified clients are open and the data are sent or queued
+     */
+    inline bool DataChannelClient::sendTo(
+        const uint8_t* data,
+        size_t size,
+        const std::vector<std::string>& ids,
+        DataChannelSendPriority priority,
+        const std::function<void(const Client&, bool)>& onComplete)
+    {
+        return sendTo(webrtc::DataBuffer(rtc::CopyOnWriteBuffer(data, size), true), ids, priority, onComplete);
+    }
+
+    /**
+     * @brief Sends a string message to the specified clients with a priority.
+     *
+     * See the binary overload for the priority and the completion callback.
+     *
+     * @param message The string message
+     * @param ids The client ids
+     * @param priority The priority
+     * @param onComplete The completion callback, it can be null
+     * @return true if the data channels of all the specified clients are open and the message is sent or queued
+     */
+    inline bool DataChannelClient::sendTo(
+        const std::string& message,
+        const std::vector<std::string>& ids,
+        DataChannelSendPriority priority,
+        const std::function<void(const Client&, bool)>& onComplete)
+    {
+        return sendTo(webrtc::DataBuffer(message), ids, priority, onComplete);
+    }
+
+    /**
+     * @brief Sends binary data to all clients with a priority.
+     *
+     * See sendTo for the priority and the completion callback.
+     *
+     * @param data The binary data
+     * @param size The binary data size
+     * @param priority The priority
+     * @param onComplete The completion callback, it can be null
+     * @return true if the data channels of all clients are open and the data are sent or queued
+     */
+    inline bool DataChannelClient::sendToAll(
+        const uint8_t* data,
+        size_t size,
+        DataChannelSendPriority priority,
+        const std::function<void(const Client&, bool)>& onComplete)
+    {
+        return sendToAll(webrtc::DataBuffer(rtc::CopyOnWriteBuffer(data, size), true), priority, onComplete);
+    }
+
+    /**
+     * @brief Sends a string message to all clients with a priority.
+     *
+     * See sendTo for the priority and the completion callback.
+     *
+     * @param message The string message
+     * @param priority The priority
+     * @param onComplete The completion callback, it can be null
+     * @return true if the data channels of all clients are open and the message is sent or queued
+     */
+    inline bool DataChannelClient::sendToAll(
+        const std::string& message,
+        DataChannelSendPriority priority,
+        const std::function<void(const Client&, bool)>& onComplete)
+    {
+        return sendToAll(webrtc::DataBuffer(message), priority, onComplete);
+    }
+
+    /**
+     * @brief Sends a string message on a named data channel to the specified clients.
+     *
+     * See the webrtc::DataBuffer overload for the priority and the completion callback.
+     *
+     * @param label The data channel label
+     * @param message The string message
+     * @param ids The client ids
+     * @param priority The priority
+     * @param onComplete The completion callback, it can be null
+     * @return true if the data channels of all the specified clients are open and the message is sent or queued
+     */
+    inline bool DataChannelClient::sendOnChannelTo(
+        const std::string& label,
+        const std::string& message,
+        const std::vector<std::string>& ids,
+        DataChannelSendPriority priority,
+        const std::function<void(const Client&, bool)>& onComplete)
+    {
+        return sendOnChannelTo(label, webrtc::DataBuffer(message), ids, priority, onComplete);
+    }
+
+    /**
+     * @brief Sends a string message on a named data channel to all clients.
+     *
+     * See sendOnChannelTo for the priority and the completion callback.
+     *
+     * @param label The data channel label
+     * @param message The string message
+     * @param priority The priority
+     * @param onComplete The completion callback, it can be null
+     * @return true if the data channels of all clients are open and the message is sent or queued
+     */
+    inline bool DataChannelClient::sendOnChannelToAll(
+        const std::string& label,
+        const std::string& message,
+        DataChannelSendPriority priority,
+        const std::function<void(const Client&, bool)>& onComplete)
+    {
+        return sendOnChannelToAll(label, webrtc::DataBuffer(message), priority, onComplete);
+    }
+
+    /**
+     * @brief Enables the reassembly of the chunked messages received by the next data channels.
+     *
+     * The chunks of a message sent with sendChunkedTo or sendChunkedToAll are delivered as one message to the binary
+     * or string message callback. It must be enabled by the receiving clients before they connect. When it is
+     * disabled, the chunks are delivered as binary data.
+     *
+     * @param enabled true to reassemble the chunked messages
+     */
+    inline void DataChannelClient::setChunkedMessageEnabled(bool enabled)
+    {
+        callSync(getInternalClientThread(), [this, enabled]() { m_isChunkedMessageEnabled = enabled; });
+    }
+
+    /**
+     * @brief Indicates if the reassembly of the chunked messages is enabled.
+     * @return true if the reassembly of the chunked messages is enabled
+     */
+    inline bool DataChannelClient::isChunkedMessageEnabled()
+    {
+        return callSync(getInternalClientThread(), [this]() { return m_isChunkedMessageEnabled; });
+    }
+
+    /**
+     * @brief Sets the compressor of the main data channel.
+     *
+     * The compression is negotiated when the data channel opens, so it is only used when both peers set a compressor
+     * with the same codec and dictionary before they connect. The messages sent with sendTo and sendToAll are
+     * compressed once for the clients that negotiated the compression, and they are sent uncompressed to the other
+     * clients. The messages received by the next data channels are decompressed. The small messages and the messages
+     * that do not shrink are sent uncompressed. The invalid compressed messages are dropped and counted by the
+     * compressor statistics. The chunked messages are not compressed.
+     *
+     * @param compressor The compressor, it can be null to disable the compression
+     */
+    inline void DataChannelClient::setDataChannelCompressor(const std::shared_ptr<DataChannelCompressor>& compressor)
+    {
+        callSync(getInternalClientThread(), [this, &compressor]() { m_dataChannelCompressor = compressor; });
+    }
+
+    /**
+     * @brief Sets the compressor of a named data channel.
+     *
+     * See setDataChannelCompressor for the compressed messages.
+     *
+     * @param label The data channel label
+     * @param compressor The compressor, it can be null to disable the compression
+     */
+    inline void DataChannelClient::setNamedDataChannelCompressor(
+        const std::string& label,
+        const std::shared_ptr<DataChannelCompressor>& compressor)
+    {
+        callSync(
+            getInternalClientThread(),
+            [this, &label, &compressor]()
+            {
+                if (compressor)
+                {
+                    m_namedDataChannelCompressors[label] = compressor;
+                }
+                else
+                {
+                    m_namedDataChannelCompressors.erase(label);
+                }
+            });
+    }
+
     /**
      * @brief Sets the callback that is called when a data channel opens.
      *
@@ -187,6 +536,124 @@ namespace opentera
     {
         callSync(getInternalClientThread(), [this, &callback]() { m_onDataChannelMessageString = callback; });
     }
+
+    /**
+     * @brief Sets the callback that is called when a chunk of a chunked message is received.
+     *
+     * The callback is called from the internal client thread. The callback should not block.
+     *
+     * @parblock
+     * Callback parameters:
+     * - client: The client the message is from
+     * - progress: The progress of the message
+     * @endparblock
+     *
+     * @param callback The callback
+     */
+    inline void DataChannelClient::setOnDataChannelReceiveProgress(
+        const std::function<void(const Client&, const DataChannelTransferProgress&)>& callback)
+    {
+        callSync(getInternalClientThread(), [this, &callback]() { m_onDataChannelReceiveProgress = callback; });
+    }
+
+    /**
+     * @brief Sets the callback that is called when a named data channel opens.
+     *
+     * The callback is called from the internal client thread. The callback should not block.
+     *
+     * @parblock
+     * Callback parameters:
+     * - client: The client of the data channel that opens
+     * - label: The label of the data channel that opens
+     * @endparblock
+     *
+     * @param callback The callback
+     */
+    inline void DataChannelClient::setOnNamedDataChannelOpened(
+        const std::function<void(const Client&, const std::string&)>& callback)
+    {
+        callSync(getInternalClientThread(), [this, &callback]() { m_onNamedDataChannelOpened = callback; });
+    }
+
+    /**
+     * @brief Sets the callback that is called when a named data channel closes.
+     *
+     * The callback is called from the internal client thread. The callback should not block.
+     *
+     * @parblock
+     * Callback parameters:
+     * - client: The client of the data channel that closes
+     * - label: The label of the data channel that closes
+     * @endparblock
+     *
+     * @param callback The callback
+     */
+    inline void DataChannelClient::setOnNamedDataChannelClosed(
+        const std::function<void(const Client&, const std::string&)>& callback)
+    {
+        callSync(getInternalClientThread(), [this, &callback]() { m_onNamedDataChannelClosed = callback; });
+    }
+
+    /**
+     * @brief Sets the callback that is called when a named data channel error occurs.
+     *
+     * The callback is called from the internal client thread. The callback should not block.
+     *
+     * @parblock
+     * Callback parameters:
+     * - client: The client of the data channel error
+     * - label: The label of the data channel
+     * - error: The error message
+     * @endparblock
+     *
+     * @param callback The callback
+     */
+    inline void DataChannelClient::setOnNamedDataChannelError(
+        const std::function<void(const Client&, const std::string&, const std::string&)>& callback)
+    {
+        callSync(getInternalClientThread(), [this, &callback]() { m_onNamedDataChannelError = callback; });
+    }
+
+    /**
+     * @brief Sets the callback that is called when binary data are received on a named data channel.
+     *
+     * The callback is called from the internal client thread. The callback should not block.
+     *
+     * @parblock
+     * Callback parameters:
+     * - client: The client the binary data are from
+     * - label: The label of the data channel
+     * - data: The binary data
+     * - dataSize: The binary data size
+     * @endparblock
+     *
+     * @param callback The callback
+     */
+    inline void DataChannelClient::setOnNamedDataChannelMessageBinary(
+        const std::function<void(const Client&, const std::string&, const uint8_t*, std::size_t)>& callback)
+    {
+        callSync(getInternalClientThread(), [this, &callback]() { m_onNamedDataChannelMessageBinary = callback; });
+    }
+
+    /**
+     * @brief Sets the callback that is called when a string message is received on a named data channel.
+     *
+     * The callback is called from the internal client thread. The callback should not block.
+     *
+     * @parblock
+     * Callback parameters:
+     * - client: The client the message is from
+     * - label: The label of the data channel
+     * - message: The string message
+     * @endparblock
+     *
+     * @param callback The callback
+     */
+    inline void DataChannelClient::setOnNamedDataChannelMessageString(
+        const std::function<void(const Client&, const std::string&, const std::string&)>& callback)
+    {
+        callSync(getInternalClientThread(), [this, &callback]() { m_onNamedDataChannelMessageString = callback; });
+    }
 }
 
 #endif
@@ -3,10 +3,21 @@
 
 #include <OpenteraWebrtcNativeClient/Handlers/PeerConnectionHandler.h>
 #include <OpenteraWebrtcNativeClient/Configurations/DataChannelConfiguration.h>
+#include <OpenteraWebrtcNativeClient/Configurations/NamedDataChannelConfiguration.h>
+#include <OpenteraWebrtcNativeClient/Handlers/NamedDataChannelHandler.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunkReassembler.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunkSender.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelCompressor.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelSendQueue.h>
 
 #include <api/data_channel_interface.h>
 
+#include <atomic>
 #include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
 
 namespace opentera
 {
@@ -19,8 +30,30 @@ namespace opentera
         std::function<void(const Client&, const std::string&)> m_onDataChannelError;
         std::function<void(const Client&, const webrtc::DataBuffer& buffer)> m_onDataChannelMessageBinary;
         std::function<void(const Client&, const std::string&)> m_onDataChannelMessageString;
+        bool m_isChunkedMessageEnabled;
+        std::function<void(const Client&, const DataChannelTransferProgress&)> m_onDataChannelReceiveProgress;
+
+        std::vector<NamedDataChannelConfiguration> m_namedDataChannelConfigurations;
+        std::function<void(const Client&, const std::string&)> m_onNamedDataChannelOpen;
+        std::function<void(const Client&, const std::string&)> m_onNamedDataChannelClosed;
+        std::function<void(const Client&, const std::string&, const std::string&)> m_onNamedDataChannelError;
+        std::function<void(const Client&, const std::string&, const webrtc::DataBuffer&)>
+            m_onNamedDataChannelMessageBinary;
+        std::function<void(const Client&, const std::string&, const std::string&)> m_onNamedDataChannelMessageString;
+
+        std::shared_ptr<DataChannelCompressor> m_dataChannelCompressor;
+        std::map<std::string, std::shared_ptr<DataChannelCompressor>> m_namedDataChannelCompressors;
+        std::atomic<bool> m_isPeerCompressionEnabled;
 
         rtc::scoped_refptr<webrtc::DataChannelInterface> m_dataChannel;
+        std::unique_ptr<DataChannelSendQueue> m_sendQueue;
+        std::unique_ptr<DataChannelChunkSender> m_chunkSender;
+        std::unique_ptr<DataChannelChunkReassembler> m_chunkReassembler;
+
+        // The channels are added from the signaling thread and used from the internal client thread. The handlers are
+        // shared, so the data channels are never called with the mutex locked.
+        std::mutex m_namedDataChannelHandlersMutex;
+        std::map<std::string, std::shared_ptr<NamedDataChannelHandler>> m_namedDataChannelHandlers;
 
         bool m_onDataChannelClosedCalled;
 
@@ -39,22 +72,57 @@ namespace opentera
             std::function<void(const Client&)> onDataChannelClosed,
             std::function<void(const Client&, const std::string&)> onDataChannelError,
             std::function<void(const Client&, const webrtc::DataBuffer& buffer)> onDataChannelMessageBinary,
-            std::function<void(const Client&, const std::string&)> onDataChannelMessageString);
+            std::function<void(const Client&, const std::string&)> onDataChannelMessageString,
+            bool isChunkedMessageEnabled,
+            std::function<void(const Client&, const DataChannelTransferProgress&)> onDataChannelReceiveProgress,
+            std::vector<NamedDataChannelConfiguration> namedDataChannelConfigurations,
+            std::function<void(const Client&, const std::string&)> onNamedDataChannelOpen,
+            std::function<void(const Client&, const std::string&)> onNamedDataChannelClosed,
+            std::function<void(const Client&, const std::string&, const std::string&)> onNamedDataChannelError,
+            std::function<void(const Client&, const std::string&, const webrtc::DataBuffer&)>
+                onNamedDataChannelMessageBinary,
+            std::function<void(const Client&, const std::string&, const std::string&)> onNamedDataChannelMessageString,
+            std::shared_ptr<DataChannelCompressor> dataChannelCompressor,
+            std::map<std::string, std::shared_ptr<DataChannelCompressor>> namedDataChannelCompressors);
 
         ~DataChannelPeerConnectionHandler() override;
 
         void setPeerConnection(const rtc::scoped_refptr<webrtc::PeerConnectionInterface>& peerConnection) override;
 
-        bool send(const webrtc::DataBuffer& buffer);
+        bool send(
+            const webrtc::DataBuffer& buffer,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            std::function<void(const Client&, bool)> onComplete = nullptr);
+        bool sendChunked(
+            const webrtc::DataBuffer& buffer,
+            std::function<void(const Client&, const DataChannelTransferProgress&)> onProgress = nullptr,
+            std::function<void(const Client&, bool)> onComplete = nullptr);
+
+        bool send(
+            const std::string& label,
+            const webrtc::DataBuffer& buffer,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            std::function<void(const Client&, bool)> onComplete = nullptr);
+
+        [[nodiscard]] std::shared_ptr<DataChannelCompressor> peerCompressor() const;
+        [[nodiscard]] std::shared_ptr<DataChannelCompressor> peerCompressor(const std::string& label);
 
         // Observer methods
         void OnDataChannel(rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel) override;
 
         void OnStateChange() override;
         void OnMessage(const webrtc::DataBuffer& buffer) override;
+        void OnBufferedAmountChange(uint64_t sentDataSize) override;
 
     protected:
         void createAnswer() override;
+
+    private:
+        void setDataChannel(rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel);
+        void addNamedDataChannel(rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel);
+        bool isNamedDataChannelLabel(const std::string& label) const;
+        void updateMaxChunkSize();
+        void onMessage(const webrtc::DataBuffer& buffer);
     };
 }
 
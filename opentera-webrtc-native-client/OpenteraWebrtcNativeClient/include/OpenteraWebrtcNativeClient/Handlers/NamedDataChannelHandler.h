@@ -0,0 +1,70 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_HANDLERS_NAMED_DATA_CHANNEL_HANDLER_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_HANDLERS_NAMED_DATA_CHANNEL_HANDLER_H
+
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelCompressor.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelSendQueue.h>
+
+#include <api/data_channel_interface.h>
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace opentera
+{
+    /**
+     * @brief Handles an additional data channel of a peer connection.
+     *
+     * Every channel has its own send queue, so a channel that buffers a lot of data does not delay the messages of
+     * the other channels. The messages are only compressed toward the peer once it advertised or acknowledged the
+     * compression of the channel.
+     */
+    class NamedDataChannelHandler : public webrtc::DataChannelObserver
+    {
+        rtc::scoped_refptr<webrtc::DataChannelInterface> m_dataChannel;
+        DataChannelSendQueue m_sendQueue;
+
+        std::function<void()> m_onOpen;
+        std::function<void()> m_onClosed;
+        std::function<void(const std::string&)> m_onError;
+        std::function<void(const webrtc::DataBuffer&)> m_onMessageBinary;
+        std::function<void(const std::string&)> m_onMessageString;
+        std::shared_ptr<DataChannelCompressor> m_compressor;
+        bool m_isCompressionAdvertisedByPeer;
+        std::atomic<bool> m_isPeerCompressionEnabled;
+
+        bool m_onClosedCalled;
+
+    public:
+        NamedDataChannelHandler(
+            rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+            std::function<void()> onOpen,
+            std::function<void()> onClosed,
+            std::function<void(const std::string&)> onError,
+            std::function<void(const webrtc::DataBuffer&)> onMessageBinary,
+            std::function<void(const std::string&)> onMessageString,
+            std::shared_ptr<DataChannelCompressor> compressor = nullptr,
+            bool isCompressionAdvertisedByPeer = false);
+        ~NamedDataChannelHandler() override;
+
+        DECLARE_NOT_COPYABLE(NamedDataChannelHandler);
+        DECLARE_NOT_MOVABLE(NamedDataChannelHandler);
+
+        [[nodiscard]] std::string label() const;
+        [[nodiscard]] std::shared_ptr<DataChannelCompressor> peerCompressor() const;
+
+        bool send(
+            const webrtc::DataBuffer& buffer,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            std::function<void(bool)> onComplete = nullptr);
+
+        // Observer methods
+        void OnStateChange() override;
+        void OnMessage(const webrtc::DataBuffer& buffer) override;
+        void OnBufferedAmountChange(uint64_t sentDataSize) override;
+    };
+}
+
+#endif
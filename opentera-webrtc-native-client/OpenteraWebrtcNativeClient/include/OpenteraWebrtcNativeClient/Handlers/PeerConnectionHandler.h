@@ -5,8 +5,12 @@
 #include <OpenteraWebrtcNativeClient/Utils/Client.h>
 
 #include <api/peer_connection_interface.h>
+#include <rtc_base/thread.h>
 
+#include <chrono>
 #include <functional>
+#include <memory>
+#include <mutex>
 
 #include <iostream>
 
@@ -50,6 +54,16 @@ namespace opentera
 
         bool m_onClientDisconnectedCalled;
 
+        std::mutex m_iceRestartMutex;
+        size_t m_maxIceRestartAttemptCount;
+        std::chrono::milliseconds m_iceRestartTimeout;
+        rtc::Thread* m_iceRestartTimeoutThread;
+        size_t m_iceRestartAttemptCount;
+        bool m_isIceRestarting;
+        bool m_isWaitingForReconnection;
+        // Expires when the handler is destroyed, so the pending ICE restart timeouts do nothing
+        std::shared_ptr<bool> m_iceRestartLifetime;
+
     public:
         PeerConnectionHandler(
             std::string&& id,
@@ -63,11 +77,16 @@ namespace opentera
         ~PeerConnectionHandler() override;
 
         virtual void setPeerConnection(const rtc::scoped_refptr<webrtc::PeerConnectionInterface>& peerConnection);
+        void setIceRestartAttempts(
+            size_t maxAttemptCount,
+            std::chrono::milliseconds timeout,
+            rtc::Thread* timeoutThread);
 
         void makePeerCall();
         void receivePeerCall(const std::string& sdp);
         void receivePeerCallAnswer(const std::string& sdp);
         void receiveIceCandidate(const std::string& sdpMid, int sdpMLineIndex, const std::string& sdp);
+        bool restartIce();
 
         // Observer methods
         void OnConnectionChange(webrtc::PeerConnectionInterface::PeerConnectionState newState) override;
@@ -92,6 +111,12 @@ namespace opentera
 
     protected:
         virtual void createAnswer();
+        bool restartIceWithTimeout();
+
+    private:
+        bool waitForReconnection();
+        void onIceRestartTimeout(size_t attempt);
+        void onReconnectionGracePeriodElapsed();
     };
 
     void setTransceiverDirection(
@@ -1,16 +1,22 @@
 #ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_HANDLERS_STREAM_PEER_CONNECTION_HANDLER_H
 #define OPENTERA_WEBRTC_NATIVE_CLIENT_HANDLERS_STREAM_PEER_CONNECTION_HANDLER_H
 
+#include <OpenteraWebrtcNativeClient/Configurations/ReceiveLatencyConfiguration.h>
 #include <OpenteraWebrtcNativeClient/Handlers/PeerConnectionHandler.h>
 #include <OpenteraWebrtcNativeClient/Sinks/VideoSink.h>
 #include <OpenteraWebrtcNativeClient/Sinks/EncodedVideoSink.h>
 #include <OpenteraWebrtcNativeClient/Sinks/AudioSink.h>
+#include <OpenteraWebrtcNativeClient/Utils/VideoFreezeWatchdog.h>
 
+#include <rtc_base/task_utils/repeating_task.h>
+#include <rtc_base/thread.h>
+
+#include <mutex>
 #include <set>
 
 namespace opentera
 {
-    using VideoFrameReceivedCallback = std::function<void(const Client&, const cv::Mat&, uint64_t)>;
+    using VideoFrameReceivedCallback = std::function<void(const Client&, const PooledVideoFrame&, uint64_t)>;
     using EncodedVideoFrameReceivedCallback = std::function<void(
         const Client& client,
         const uint8_t* data,
@@ -27,6 +33,7 @@ namespace opentera
         int sampleRate,
         size_t numberOfChannels,
         size_t numberOfFrames)>;
+    using VideoFreezeRecoveryCallback = std::function<void(const Client&, VideoFreezeRecoveryStep)>;
 
     class StreamPeerConnectionHandler : public PeerConnectionHandler
     {
@@ -45,6 +52,15 @@ namespace opentera
 
         std::set<rtc::scoped_refptr<webrtc::MediaStreamTrackInterface>> m_tracks;
 
+        std::unique_ptr<VideoFreezeWatchdog> m_videoFreezeWatchdog;
+        VideoFreezeRecoveryCallback m_onVideoFreezeRecovery;
+        std::unique_ptr<rtc::Thread> m_videoFreezeWatchdogThread;
+        webrtc::RepeatingTaskHandle m_videoFreezeWatchdogTask;
+
+        // Read by OnTrack from the WebRTC signaling thread
+        std::mutex m_receiveLatencyConfigurationMutex;
+        ReceiveLatencyConfiguration m_receiveLatencyConfiguration;
+
     public:
         StreamPeerConnectionHandler(
             std::string id,
@@ -92,6 +108,12 @@ namespace opentera
         void setAllLocalAudioTracksEnabled(bool enabled);
         void setAllRemoteAudioTracksEnabled(bool enabled);
         void setAllVideoTracksEnabled(bool enabled);
+        void setVideoSinkTargetSize(int width, int height);
+        void setVideoSinkFormat(VideoFrameFormat format);
+        void enableVideoFreezeWatchdog(
+            const VideoFreezeWatchdogConfiguration& configuration,
+            VideoFreezeRecoveryCallback onVideoFreezeRecovery);
+        void setReceiveLatencyConfiguration(const ReceiveLatencyConfiguration& configuration);
 
         // Observer methods
         void OnTrack(rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver) override;
@@ -116,6 +138,11 @@ namespace opentera
         void setAllLocalTracksEnabled(const char* kind, bool enabled);
         void setAllRemoteTracksEnabled(const char* kind, bool enabled);
 
+        void stopVideoFreezeWatchdog();
+        void recoverFrozenVideo(VideoFreezeRecoveryStep step);
+        void requestRemoteVideoKeyFrames();
+        void applyReceiveLatencyConfiguration(const rtc::scoped_refptr<webrtc::RtpReceiverInterface>& receiver);
+
         std::function<void(const Client&, rtc::scoped_refptr<webrtc::DataChannelInterface>)> m_onDataChannelOpened;
     };
 }
@@ -0,0 +1,81 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_CLOCK_SYNC_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_CLOCK_SYNC_H
+
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingProtocol.h>
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+#include <OpenteraWebrtcNativeClient/Utils/ClockOffsetEstimator.h>
+
+#include <api/data_channel_interface.h>
+#include <rtc_base/task_utils/repeating_task.h>
+#include <rtc_base/thread.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace opentera
+{
+    /**
+     * @brief Estimates the clock offset of a Pixel Streaming streamer with NTP-style ping/pong custom messages.
+     *
+     * Unreal Engine has no clock synchronization message, so the streamer must answer the custom messages:
+     *  - request (client to streamer): [requestMessageId][int64 client send time (us)]
+     *  - response (streamer to client): [responseMessageId][int64 client send time (us)]
+     *    [int64 streamer receive time (us)][int64 streamer send time (us)]
+     *
+     * The integers are little-endian. The streamer times must come from the clock of the timestamps to convert.
+     * The responses must be given to handleCustomMessage, typically from a PixelStreamingMessageDispatcher.
+     */
+    class PixelStreamingClockSync
+    {
+        std::function<bool(const webrtc::DataBuffer&)> m_send;
+        uint8_t m_requestMessageId;
+        uint8_t m_responseMessageId;
+        std::chrono::milliseconds m_interval;
+
+        std::unique_ptr<rtc::Thread> m_thread;
+        webrtc::RepeatingTaskHandle m_task;
+
+        mutable std::mutex m_mutex;
+        ClockOffsetEstimator m_estimator;
+
+    public:
+        static constexpr size_t RequestPayloadSize = sizeof(int64_t);
+        static constexpr size_t ResponsePayloadSize = 3 * sizeof(int64_t);
+
+        PixelStreamingClockSync(
+            rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+            uint8_t requestMessageId,
+            uint8_t responseMessageId,
+            std::chrono::milliseconds interval);
+        PixelStreamingClockSync(
+            std::function<bool(const webrtc::DataBuffer&)> send,
+            uint8_t requestMessageId,
+            uint8_t responseMessageId,
+            std::chrono::milliseconds interval);
+        virtual ~PixelStreamingClockSync();
+
+        DECLARE_NOT_COPYABLE(PixelStreamingClockSync);
+        DECLARE_NOT_MOVABLE(PixelStreamingClockSync);
+
+        void start();
+        void stop();
+        bool requestSync();
+
+        [[nodiscard]] uint8_t responseMessageId() const;
+        bool handleCustomMessage(const PixelStreamingCustomMessage& message);
+
+        [[nodiscard]] std::optional<ClockOffsetEstimate> estimate() const;
+        [[nodiscard]] std::optional<int64_t> toLocalTimeUs(int64_t remoteTimeUs) const;
+    };
+
+    /**
+     * @brief Returns the custom message id of the responses.
+     * @return The custom message id of the responses
+     */
+    inline uint8_t PixelStreamingClockSync::responseMessageId() const { return m_responseMessageId; }
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_INPUT_SENDER_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_INPUT_SENDER_H
+
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+
+#include <api/data_channel_interface.h>
+#include <rtc_base/task_utils/repeating_task.h>
+#include <rtc_base/thread.h>
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace opentera
+{
+    /**
+     * @brief Queues the input events sent to an Unreal Engine Pixel Streaming streamer and sends them once per tick.
+     *
+     * The events are sent in order with the data channel of the video, so they are not racing with another
+     * transport. Consecutive mouse moves are merged into one move with the latest position and the summed deltas,
+     * and a gamepad analog value replaces the queued value of the same axis. The streamer parses one event per
+     * data channel message, so a tick sends one message per remaining event. When a send fails, the remaining
+     * events are kept for the next tick.
+     */
+    class PixelStreamingInputSender
+    {
+        enum class EventType
+        {
+            Message,
+            MouseMove,
+            GamepadAnalog
+        };
+
+        struct Event
+        {
+            EventType type;
+            std::optional<webrtc::DataBuffer> message;
+            float x;
+            float y;
+            float deltaX;
+            float deltaY;
+            uint8_t controllerId;
+            uint8_t axis;
+            double value;
+        };
+
+        std::function<bool(const webrtc::DataBuffer&)> m_send;
+        std::chrono::milliseconds m_interval;
+        size_t m_maxQueueSize;
+
+        std::unique_ptr<rtc::Thread> m_thread;
+        webrtc::RepeatingTaskHandle m_task;
+
+        mutable std::mutex m_mutex;
+        std::deque<Event> m_events;
+        uint64_t m_coalescedEventCount;
+        uint64_t m_droppedEventCount;
+
+    public:
+        PixelStreamingInputSender(
+            rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+            std::chrono::milliseconds interval,
+            size_t maxQueueSize = 1024);
+        PixelStreamingInputSender(
+            std::function<bool(const webrtc::DataBuffer&)> send,
+            std::chrono::milliseconds interval,
+            size_t maxQueueSize = 1024);
+        virtual ~PixelStreamingInputSender();
+
+        DECLARE_NOT_COPYABLE(PixelStreamingInputSender);
+        DECLARE_NOT_MOVABLE(PixelStreamingInputSender);
+
+        void start();
+        void stop();
+        size_t flush();
+
+        bool enqueue(webrtc::DataBuffer message);
+        bool enqueueMouseMove(float x, float y, float deltaX, float deltaY);
+        bool enqueueGamepadAnalog(uint8_t controllerId, uint8_t axis, double value);
+
+        [[nodiscard]] size_t queueDepth() const;
+        [[nodiscard]] uint64_t coalescedEventCount() const;
+        [[nodiscard]] uint64_t droppedEventCount() const;
+
+    private:
+        bool push(Event event);
+    };
+}
+
+#endif
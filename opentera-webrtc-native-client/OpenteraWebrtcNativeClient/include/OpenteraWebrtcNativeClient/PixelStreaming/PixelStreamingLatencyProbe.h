@@ -0,0 +1,96 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_LATENCY_PROBE_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_LATENCY_PROBE_H
+
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingProtocol.h>
+#include <OpenteraWebrtcNativeClient/Sinks/VideoFramePool.h>
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+
+#include <api/data_channel_interface.h>
+#include <rtc_base/task_utils/repeating_task.h>
+#include <rtc_base/thread.h>
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+namespace opentera
+{
+    /**
+     * @brief The capture to display latency breakdown of a stream, in milliseconds.
+     *
+     * The streamer times come from the LatencyTest response. The local times come from the first frame displayed
+     * after the response. A value is NaN when the streamer or the frame did not provide the required times.
+     */
+    struct PixelStreamingLatencyReport
+    {
+        double roundTripTimeMs;
+        double streamerProcessingTimeMs;
+        double networkLatencyMs;
+
+        double captureTimeMs;
+        double encodeTimeMs;
+        double captureToSendTimeMs;
+
+        double receiveToDecodeTimeMs;
+        double decodeTimeMs;
+        double decodeToDisplayTimeMs;
+
+        double captureToDisplayTimeMs;
+        double averageQP;
+    };
+
+    /**
+     * @brief Periodically sends LatencyTest requests to an Unreal Engine Pixel Streaming streamer and correlates
+     * the streamer timings with the local receive, decode and display times of the frames.
+     *
+     * The probe does not observe the data channel. The LatencyTest and VideoEncoderAvgQP messages must be given
+     * to the probe with handleTextMessage and handleVideoEncoderAvgQP, typically from the callbacks of a
+     * PixelStreamingMessageDispatcher. The displayed frames must be reported with onFrameDisplayed. The streamer
+     * answers one request at a time, so a new request replaces the pending one.
+     */
+    class PixelStreamingLatencyProbe
+    {
+        std::function<bool(const webrtc::DataBuffer&)> m_send;
+        std::chrono::milliseconds m_interval;
+
+        std::unique_ptr<rtc::Thread> m_thread;
+        webrtc::RepeatingTaskHandle m_task;
+
+        mutable std::mutex m_mutex;
+        std::optional<int64_t> m_pendingRequestTimeUs;
+        std::optional<PixelStreamingLatencyReport> m_pendingReport;
+        int64_t m_pendingResponseTimeUs;
+        std::optional<PixelStreamingLatencyReport> m_latestReport;
+        double m_averageQP;
+        std::function<void(const PixelStreamingLatencyReport&)> m_onLatencyReport;
+
+    public:
+        PixelStreamingLatencyProbe(
+            rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+            std::chrono::milliseconds interval);
+        PixelStreamingLatencyProbe(
+            std::function<bool(const webrtc::DataBuffer&)> send,
+            std::chrono::milliseconds interval);
+        virtual ~PixelStreamingLatencyProbe();
+
+        DECLARE_NOT_COPYABLE(PixelStreamingLatencyProbe);
+        DECLARE_NOT_MOVABLE(PixelStreamingLatencyProbe);
+
+        void start();
+        void stop();
+        bool requestLatencyTest();
+
+        bool handleTextMessage(const PixelStreamingTextMessage& message);
+        void handleVideoEncoderAvgQP(const PixelStreamingVideoEncoderAvgQPMessage& message);
+        void onFrameDisplayed(const VideoFrameTimestamps& timestamps);
+
+        [[nodiscard]] std::optional<PixelStreamingLatencyReport> latestReport() const;
+        [[nodiscard]] double averageQP() const;
+
+        void setOnLatencyReport(std::function<void(const PixelStreamingLatencyReport&)> callback);
+    };
+}
+
+#endif
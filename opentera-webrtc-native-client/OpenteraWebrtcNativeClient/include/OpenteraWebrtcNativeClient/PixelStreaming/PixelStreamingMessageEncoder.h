@@ -0,0 +1,76 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_MESSAGE_ENCODER_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_MESSAGE_ENCODER_H
+
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingProtocol.h>
+
+#include <api/data_channel_interface.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace opentera
+{
+    enum class PixelStreamingMouseButton : uint8_t
+    {
+        Main = 0,
+        Auxiliary = 1,
+        Secondary = 2,
+        Fourth = 3,
+        Fifth = 4
+    };
+
+    /**
+     * @brief A touch point. The coordinates are normalized to [0, 1].
+     */
+    struct PixelStreamingTouch
+    {
+        float x;
+        float y;
+        uint8_t id;
+        float force;
+    };
+
+    /**
+     * @brief Encodes the Unreal Engine Pixel Streaming messages sent to the streamer.
+     *
+     * The positions are normalized to [0, 1] and the deltas are normalized to [-1, 1], relative to the streamed
+     * video size. The returned buffers are binary and can be sent as is with the data channel.
+     */
+    class PixelStreamingMessageEncoder
+    {
+    public:
+        PixelStreamingMessageEncoder() = delete;
+
+        static webrtc::DataBuffer iFrameRequest();
+        static webrtc::DataBuffer requestQualityControl();
+        static webrtc::DataBuffer requestInitialSettings();
+        static webrtc::DataBuffer latencyTest(int64_t startTimeMs);
+        static webrtc::DataBuffer uiInteraction(std::string_view json);
+        static webrtc::DataBuffer command(std::string_view json);
+        static webrtc::DataBuffer custom(uint8_t id, const uint8_t* data, size_t size);
+
+        static webrtc::DataBuffer keyDown(uint8_t keyCode, bool isRepeat);
+        static webrtc::DataBuffer keyUp(uint8_t keyCode);
+        static webrtc::DataBuffer keyPress(uint16_t charCode);
+
+        static webrtc::DataBuffer mouseEnter();
+        static webrtc::DataBuffer mouseLeave();
+        static webrtc::DataBuffer mouseDown(PixelStreamingMouseButton button, float x, float y);
+        static webrtc::DataBuffer mouseUp(PixelStreamingMouseButton button, float x, float y);
+        static webrtc::DataBuffer mouseDouble(PixelStreamingMouseButton button, float x, float y);
+        static webrtc::DataBuffer mouseMove(float x, float y, float deltaX, float deltaY);
+        static webrtc::DataBuffer mouseWheel(int16_t delta, float x, float y);
+
+        static webrtc::DataBuffer
+            touch(PixelStreamingToStreamerMessageId id, const std::vector<PixelStreamingTouch>& touches);
+
+        static webrtc::DataBuffer gamepadConnected();
+        static webrtc::DataBuffer gamepadDisconnected(uint8_t controllerId);
+        static webrtc::DataBuffer gamepadButtonPressed(uint8_t controllerId, uint8_t button, bool isRepeat);
+        static webrtc::DataBuffer gamepadButtonReleased(uint8_t controllerId, uint8_t button);
+        static webrtc::DataBuffer gamepadAnalog(uint8_t controllerId, uint8_t axis, double value);
+    };
+}
+
+#endif
@@ -0,0 +1,347 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_PROTOCOL_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_PIXEL_STREAMING_PIXEL_STREAMING_PROTOCOL_H
+
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+
+#include <api/data_channel_interface.h>
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+namespace opentera
+{
+    /**
+     * @brief The ids of the Unreal Engine Pixel Streaming messages sent by the streamer.
+     */
+    enum class PixelStreamingFromStreamerMessageId : uint8_t
+    {
+        QualityControlOwnership = 0,
+        Response = 1,
+        Command = 2,
+        FreezeFrame = 3,
+        UnfreezeFrame = 4,
+        VideoEncoderAvgQP = 5,
+        LatencyTest = 6,
+        InitialSettings = 7,
+        FileExtension = 8,
+        FileMimeType = 9,
+        FileContents = 10,
+        TestEcho = 11,
+        InputControlOwnership = 12,
+        GamepadResponse = 13,
+        Protocol = 255
+    };
+
+    /**
+     * @brief The ids of the Unreal Engine Pixel Streaming messages sent to the streamer.
+     */
+    enum class PixelStreamingToStreamerMessageId : uint8_t
+    {
+        IFrameRequest = 0,
+        RequestQualityControl = 1,
+        FpsRequest = 2,
+        AverageBitrateRequest = 3,
+        StartStreaming = 4,
+        StopStreaming = 5,
+        LatencyTest = 6,
+        RequestInitialSettings = 7,
+        TestEcho = 8,
+        UIInteraction = 50,
+        Command = 51,
+        KeyDown = 60,
+        KeyUp = 61,
+        KeyPress = 62,
+        MouseEnter = 70,
+        MouseLeave = 71,
+        MouseDown = 72,
+        MouseUp = 73,
+        MouseMove = 74,
+        MouseWheel = 75,
+        MouseDouble = 76,
+        TouchStart = 80,
+        TouchEnd = 81,
+        TouchMove = 82,
+        GamepadButtonPressed = 90,
+        GamepadButtonReleased = 91,
+        GamepadAnalog = 92,
+        GamepadConnected = 93,
+        GamepadDisconnected = 94
+    };
+
+    /**
+     * @brief A non-owning view of a UTF-16LE string inside a data channel message.
+     *
+     * The bytes are not required to be aligned. The view is only valid while the message buffer is alive.
+     */
+    class PixelStreamingUtf16View
+    {
+        const uint8_t* m_data;
+        size_t m_codeUnitCount;
+
+    public:
+        PixelStreamingUtf16View();
+        PixelStreamingUtf16View(const uint8_t* data, size_t codeUnitCount);
+
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] bool empty() const;
+        [[nodiscard]] char16_t operator[](size_t index) const;
+
+        [[nodiscard]] std::string toUtf8() const;
+    };
+
+    inline PixelStreamingUtf16View::PixelStreamingUtf16View() : m_data(nullptr), m_codeUnitCount(0) {}
+
+    inline PixelStreamingUtf16View::PixelStreamingUtf16View(const uint8_t* data, size_t codeUnitCount)
+        : m_data(data),
+          m_codeUnitCount(codeUnitCount)
+    {
+    }
+
+    /**
+     * @brief Returns the number of UTF-16 code units.
+     * @return The number of UTF-16 code units
+     */
+    inline size_t PixelStreamingUtf16View::size() const { return m_codeUnitCount; }
+
+    /**
+     * @brief Indicates if the string is empty.
+     * @return true if the string is empty
+     */
+    inline bool PixelStreamingUtf16View::empty() const { return m_codeUnitCount == 0; }
+
+    /**
+     * @brief Returns a UTF-16 code unit.
+     * @param index The code unit index
+     * @return The code unit
+     */
+    inline char16_t PixelStreamingUtf16View::operator[](size_t index) const
+    {
+        return static_cast<char16_t>(m_data[2 * index] | (m_data[2 * index + 1] << 8));
+    }
+
+    struct PixelStreamingQualityControlOwnershipMessage
+    {
+        bool hasQualityControlOwnership;
+    };
+
+    struct PixelStreamingInputControlOwnershipMessage
+    {
+        bool hasInputControlOwnership;
+    };
+
+    /**
+     * @brief Response, Command, LatencyTest, InitialSettings, FileExtension, FileMimeType, TestEcho,
+     * GamepadResponse and Protocol messages only contain a UTF-16 string (JSON for most of them).
+     */
+    struct PixelStreamingTextMessage
+    {
+        PixelStreamingFromStreamerMessageId id;
+        PixelStreamingUtf16View text;
+    };
+
+    /**
+     * @brief A part of a freeze frame JPEG. Every part contains the size of the whole JPEG.
+     */
+    struct PixelStreamingFreezeFrameChunk
+    {
+        uint32_t jpegSize;
+        const uint8_t* data;
+        size_t dataSize;
+    };
+
+    struct PixelStreamingVideoEncoderAvgQPMessage
+    {
+        double averageQP;
+    };
+
+    /**
+     * @brief A part of a file sent by the streamer. Every part contains the size of the whole file.
+     */
+    struct PixelStreamingFileContentsChunk
+    {
+        uint32_t fileSize;
+        const uint8_t* data;
+        size_t dataSize;
+    };
+
+    /**
+     * @brief A message whose id is not part of the Pixel Streaming protocol, for example one
+     * sent by a custom streamer component. The payload is the message without its id.
+     */
+    struct PixelStreamingCustomMessage
+    {
+        uint8_t id;
+        const uint8_t* data;
+        size_t dataSize;
+
+        [[nodiscard]] std::string_view text() const;
+    };
+
+    /**
+     * @brief Returns the payload as a UTF-8 string view.
+     * @return The payload as a UTF-8 string view
+     */
+    inline std::string_view PixelStreamingCustomMessage::text() const
+    {
+        return {reinterpret_cast<const char*>(data), dataSize};
+    }
+
+    /**
+     * @brief Decodes the messages sent by an Unreal Engine Pixel Streaming streamer and calls the matching callback.
+     *
+     * The messages are decoded without copying the payloads, so the views given to the callbacks are only valid
+     * during the callback. The decoding function is selected from a table indexed by the message id. The callbacks
+     * must be set before messages are dispatched.
+     */
+    class PixelStreamingMessageDispatcher
+    {
+        std::function<void(const std::string&)> m_onError;
+        std::function<void(const PixelStreamingQualityControlOwnershipMessage&)> m_onQualityControlOwnership;
+        std::function<void(const PixelStreamingInputControlOwnershipMessage&)> m_onInputControlOwnership;
+        std::function<void(const PixelStreamingTextMessage&)> m_onTextMessage;
+        std::function<void(const PixelStreamingFreezeFrameChunk&)> m_onFreezeFrameChunk;
+        std::function<void()> m_onUnfreezeFrame;
+        std::function<void(const PixelStreamingVideoEncoderAvgQPMessage&)> m_onVideoEncoderAvgQP;
+        std::function<void(const PixelStreamingFileContentsChunk&)> m_onFileContentsChunk;
+        std::array<std::function<void(const PixelStreamingCustomMessage&)>, 256> m_onCustomMessageById;
+
+        friend struct PixelStreamingMessageDecoders;
+
+    public:
+        PixelStreamingMessageDispatcher() = default;
+        virtual ~PixelStreamingMessageDispatcher() = default;
+
+        DECLARE_NOT_COPYABLE(PixelStreamingMessageDispatcher);
+        DECLARE_NOT_MOVABLE(PixelStreamingMessageDispatcher);
+
+        bool dispatch(const uint8_t* data, size_t size) const;
+        bool dispatch(const webrtc::DataBuffer& buffer) const;
+
+        void setOnError(std::function<void(const std::string&)> callback);
+        void setOnQualityControlOwnership(
+            std::function<void(const PixelStreamingQualityControlOwnershipMessage&)> callback);
+        void
+            setOnInputControlOwnership(std::function<void(const PixelStreamingInputControlOwnershipMessage&)> callback);
+        void setOnTextMessage(std::function<void(const PixelStreamingTextMessage&)> callback);
+        void setOnFreezeFrameChunk(std::function<void(const PixelStreamingFreezeFrameChunk&)> callback);
+        void setOnUnfreezeFrame(std::function<void()> callback);
+        void setOnVideoEncoderAvgQP(std::function<void(const PixelStreamingVideoEncoderAvgQPMessage&)> callback);
+        void setOnFileContentsChunk(std::function<void(const PixelStreamingFileContentsChunk&)> callback);
+        void setOnCustomMessage(uint8_t id, std::function<void(const PixelStreamingCustomMessage&)> callback);
+    };
+
+    /**
+     * @brief Decodes a data channel message and calls the matching callback.
+     * @param buffer The data channel message
+     * @return true if the message is valid
+     */
+    inline bool PixelStreamingMessageDispatcher::dispatch(const webrtc::DataBuffer& buffer) const
+    {
+        return dispatch(buffer.data.cdata(), buffer.data.size());
+    }
+
+    /**
+     * @brief Sets the callback that is called when a message is malformed.
+     *
+     * @parblock
+     * Callback parameters:
+     *  - error: The error message
+     * @endparblock
+     *
+     * @param callback The callback
+     */
+    inline void PixelStreamingMessageDispatcher::setOnError(std::function<void(const std::string&)> callback)
+    {
+        m_onError = std::move(callback);
+    }
+
+    /**
+     * @brief Sets the callback that is called when a QualityControlOwnership message is received.
+     * @param callback The callback
+     */
+    inline void PixelStreamingMessageDispatcher::setOnQualityControlOwnership(
+        std::function<void(const PixelStreamingQualityControlOwnershipMessage&)> callback)
+    {
+        m_onQualityControlOwnership = std::move(callback);
+    }
+
+    /**
+     * @brief Sets the callback that is called when an InputControlOwnership message is received.
+     * @param callback The callback
+     */
+    inline void PixelStreamingMessageDispatcher::setOnInputControlOwnership(
+        std::function<void(const PixelStreamingInputControlOwnershipMessage&)> callback)
+    {
+        m_onInputControlOwnership = std::move(callback);
+    }
+
+    /**
+     * @brief Sets the callback that is called when a message containing only a string is received (Response,
+     * Command, LatencyTest, InitialSettings, FileExtension, FileMimeType, TestEcho, GamepadResponse and Protocol).
+     * @param callback The callback
+     */
+    inline void PixelStreamingMessageDispatcher::setOnTextMessage(
+        std::function<void(const PixelStreamingTextMessage&)> callback)
+    {
+        m_onTextMessage = std::move(callback);
+    }
+
+    /**
+     * @brief Sets the callback that is called when a part of a freeze frame is received.
+     * @param callback The callback
+     */
+    inline void PixelStreamingMessageDispatcher::setOnFreezeFrameChunk(
+        std::function<void(const PixelStreamingFreezeFrameChunk&)> callback)
+    {
+        m_onFreezeFrameChunk = std::move(callback);
+    }
+
+    /**
+     * @brief Sets the callback that is called when an UnfreezeFrame message is received.
+     * @param callback The callback
+     */
+    inline void PixelStreamingMessageDispatcher::setOnUnfreezeFrame(std::function<void()> callback)
+    {
+        m_onUnfreezeFrame = std::move(callback);
+    }
+
+    /**
+     * @brief Sets the callback that is called when a VideoEncoderAvgQP message is received.
+     * @param callback The callback
+     */
+    inline void PixelStreamingMessageDispatcher::setOnVideoEncoderAvgQP(
+        std::function<void(const PixelStreamingVideoEncoderAvgQPMessage&)> callback)
+    {
+        m_onVideoEncoderAvgQP = std::move(callback);
+    }
+
+    /**
+     * @brief Sets the callback that is called when a part of a file is received.
+     * @param callback The callback
+     */
+    inline void PixelStreamingMessageDispatcher::setOnFileContentsChunk(
+        std::function<void(const PixelStreamingFileContentsChunk&)> callback)
+    {
+        m_onFileContentsChunk = std::move(callback);
+    }
+
+    /**
+     * @brief Sets the callback that is called when a message with a custom id is received.
+     *
+     * The callbacks of the ids that are part of the protocol are never called.
+     *
+     * @param id The custom message id
+     * @param callback The callback
+     */
+    inline void PixelStreamingMessageDispatcher::setOnCustomMessage(
+        uint8_t id,
+        std::function<void(const PixelStreamingCustomMessage&)> callback)
+    {
+        m_onCustomMessageById[id] = std::move(callback);
+    }
+}
+
+#endif
@@ -5,7 +5,9 @@
 
 #include <ixwebsocket/IXWebSocket.h>
 #include <iostream>
+#include <mutex>
 #include <regex>
+#include <set>
 #include <unordered_map>
 
 
@@ -47,24 +49,50 @@ namespace opentera
             const std::string& toId) override;
 
         void sendMessage(const std::string& message) {
-            m_ws.send(message);
+            sendWsMessage(message);
         }
 
+        void subscribe(const std::string& streamerId);
+        void unsubscribe(const std::string& streamerId);
+        void requestStreamerList();
+
+        void setClosePeerConnection(const std::function<void(const std::string& id)>& callback);
+
         void setOnOfferReceived(const std::function<void(const std::string& sdp)>& callback);
         std::function<void(const std::string& fromId, const std::string& sdp)> m_onOfferReceived;
         std::vector<std::string> m_streamerList;
         std::unordered_map<std::string, std::string> m_streamerIdMap;
+
+    protected:
+        virtual void sendWsMessage(const std::string& message);
+        virtual bool isWsOpen();
+
+        void onWsOpenEvent();
+        void onWsCloseEvent();
+        void onWsMessage(const std::string& message);
+
     private:
         std::string m_usernameFragment;
 
+        // Protects the streamer list and the subscription, which are changed by the user and the WebSocket thread
+        std::mutex m_streamersMutex;
+        std::set<std::string> m_availableStreamerIds;
+        // The player socket has one subscription at a time, so the offers are from the subscribed streamer
+        std::string m_subscribedStreamerId;
+        // The id given to the peer of the last offer, the answers of the ICE restart offers are sent to it
+        std::string m_peerId;
+        std::function<void(const std::string& id)> m_closePeerConnection;
+
+        void updateSubscription();
+        void sendSubscribe(const std::string& streamerId);
+
+        void updateUsernameFragment(const std::string& sdp);
+
         void onStreamerListReceived(const nlohmann::json& data);
 
         void connectWsEvents();
 
-        void onWsOpenEvent();
-        void onWsCloseEvent();
         void onWsErrorEvent(const std::string& error);
-        void onWsMessage(const std::string& message);
 
         void onJoinRoomAnswerEvent(const nlohmann::json& data);
 
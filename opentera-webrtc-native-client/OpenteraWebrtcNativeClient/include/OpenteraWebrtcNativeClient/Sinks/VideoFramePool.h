@@ -0,0 +1,155 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_SINKS_VIDEO_FRAME_POOL_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_SINKS_VIDEO_FRAME_POOL_H
+
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+
+#include <opencv2/core.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+namespace opentera
+{
+    /**
+     * @brief The local times of the steps of a received video frame.
+     *
+     * The times are in microseconds from the WebRTC monotonic clock (rtc::TimeMicros). A time is -1 when unknown.
+     * The capture time is estimated from the RTCP sender reports of the streamer, so it is unknown until the
+     * first report is received.
+     */
+    struct VideoFrameTimestamps
+    {
+        int64_t captureTimeUs = -1;
+        int64_t receiveTimeUs = -1;
+        int64_t decodeStartTimeUs = -1;
+        int64_t decodeFinishTimeUs = -1;
+        int64_t sinkTimeUs = -1;
+    };
+
+    /**
+     * @brief An immutable video frame image whose buffer comes from a VideoFramePool.
+     *
+     * Copying a frame, or a cv::Mat header of its image, does not copy the pixels. The buffer
+     * goes back to its pool only when no frame and no cv::Mat header refer to it anymore, so
+     * frames can be kept as long as needed on any thread. The pixels must not be modified.
+     */
+    class PooledVideoFrame
+    {
+        cv::Mat m_mat;
+        VideoFrameTimestamps m_timestamps;
+
+    public:
+        PooledVideoFrame() = default;
+        explicit PooledVideoFrame(cv::Mat mat);
+        PooledVideoFrame(cv::Mat mat, const VideoFrameTimestamps& timestamps);
+        PooledVideoFrame(const PooledVideoFrame& other) = default;
+        PooledVideoFrame(PooledVideoFrame&& other) = default;
+        virtual ~PooledVideoFrame() = default;
+
+        [[nodiscard]] const cv::Mat& mat() const;
+        [[nodiscard]] int width() const;
+        [[nodiscard]] int height() const;
+        [[nodiscard]] bool empty() const;
+        [[nodiscard]] const VideoFrameTimestamps& timestamps() const;
+
+        operator const cv::Mat&() const;
+
+        PooledVideoFrame& operator=(const PooledVideoFrame& other) = default;
+        PooledVideoFrame& operator=(PooledVideoFrame&& other) = default;
+    };
+
+    inline PooledVideoFrame::PooledVideoFrame(cv::Mat mat) : m_mat(std::move(mat)) {}
+
+    inline PooledVideoFrame::PooledVideoFrame(cv::Mat mat, const VideoFrameTimestamps& timestamps)
+        : m_mat(std::move(mat)),
+          m_timestamps(timestamps)
+    {
+    }
+
+    /**
+     * @brief Returns a cv::Mat header of the frame image. No pixel is copied.
+     * @return The frame image
+     */
+    inline const cv::Mat& PooledVideoFrame::mat() const { return m_mat; }
+
+    /**
+     * @brief Returns the frame width.
+     * @return The frame width
+     */
+    inline int PooledVideoFrame::width() const { return m_mat.cols; }
+
+    /**
+     * @brief Returns the frame height.
+     * @return The frame height
+     */
+    inline int PooledVideoFrame::height() const { return m_mat.rows; }
+
+    /**
+     * @brief Indicates if the frame has no image.
+     * @return true if the frame has no image
+     */
+    inline bool PooledVideoFrame::empty() const { return m_mat.empty(); }
+
+    /**
+     * @brief Returns the local receive, decode and sink times of the frame.
+     * @return The frame timestamps
+     */
+    inline const VideoFrameTimestamps& PooledVideoFrame::timestamps() const { return m_timestamps; }
+
+    /**
+     * @brief Returns a cv::Mat header of the frame image. No pixel is copied.
+     * @return The frame image
+     */
+    inline PooledVideoFrame::operator const cv::Mat&() const { return m_mat; }
+
+    /**
+     * @brief A pool of image buffers for PooledVideoFrame.
+     *
+     * A buffer is reused once the pool holds the only reference to it. At most capacity buffers
+     * are kept by the pool. When all of them are in use, the pool is exhausted and the frame gets
+     * a buffer that is allocated and freed like an unpooled image, so the frames are never dropped
+     * by the pool. The memory is then only bounded by the frames kept by the consumer, and the
+     * exhaustions are counted so a consumer that keeps too many frames can be detected. The pool
+     * must be used from a single thread. The frames and the counter can be used from any thread.
+     */
+    class VideoFramePool
+    {
+        size_t m_capacity;
+        std::vector<cv::Mat> m_buffers;
+        std::atomic<uint64_t> m_exhaustionCount;
+
+    public:
+        explicit VideoFramePool(size_t capacity);
+        virtual ~VideoFramePool() = default;
+
+        DECLARE_NOT_COPYABLE(VideoFramePool);
+        DECLARE_NOT_MOVABLE(VideoFramePool);
+
+        cv::Mat acquire(int rows, int cols, int type);
+
+        [[nodiscard]] size_t capacity() const;
+        [[nodiscard]] size_t size() const;
+        [[nodiscard]] uint64_t exhaustionCount() const;
+    };
+
+    /**
+     * @brief Returns the maximum number of buffers kept by the pool.
+     * @return The maximum number of buffers kept by the pool
+     */
+    inline size_t VideoFramePool::capacity() const { return m_capacity; }
+
+    /**
+     * @brief Returns the number of buffers kept by the pool.
+     * @return The number of buffers kept by the pool
+     */
+    inline size_t VideoFramePool::size() const { return m_buffers.size(); }
+
+    /**
+     * @brief Returns the number of buffers allocated outside of the pool because all pooled buffers were in use.
+     * @return The number of buffers allocated outside of the pool
+     */
+    inline uint64_t VideoFramePool::exhaustionCount() const { return m_exhaustionCount; }
+}
+
+#endif
@@ -1,15 +1,37 @@
 #ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_VIDEO_SINK_H
 #define OPENTERA_WEBRTC_NATIVE_CLIENT_VIDEO_SINK_H
 
+#include <OpenteraWebrtcNativeClient/Sinks/VideoFramePool.h>
+
+#include <api/video/i420_buffer.h>
 #include <api/video/video_frame.h>
 #include <api/video/video_sink_interface.h>
 #include <api/video/video_source_interface.h>
+#include <common_video/include/video_frame_buffer_pool.h>
 #include <opencv2/core.hpp>
 
+#include <atomic>
+#include <cstdint>
+
 namespace opentera
 {
 
-    using VideoSinkCallback = std::function<void(const cv::Mat&, uint64_t)>;
+    /**
+     * @brief The pixel layout of the images produced by VideoSink.
+     *
+     * The names give the byte order in memory. BGRA matches QImage::Format_RGB32 and
+     * QImage::Format_ARGB32 on little-endian platforms.
+     */
+    enum class VideoFrameFormat
+    {
+        BGR,  // CV_8UC3
+        RGB,  // CV_8UC3
+        BGRA,  // CV_8UC4, the alpha channel is always 255
+        RGBA,  // CV_8UC4, the alpha channel is always 255
+        Gray  // CV_8UC1, the luma plane
+    };
+
+    using VideoSinkCallback = std::function<void(const PooledVideoFrame&, uint64_t)>;
 
     /**
      * @brief Class that sinks frame from a webrtc stream
@@ -18,14 +40,34 @@ namespace opentera
     {
         VideoSinkCallback m_onFrameReceived;
         rtc::VideoSinkWants m_wants;
-        cv::Mat m_bgrImg;
-        cv::Mat m_bgrRotatedImg;
+        VideoFramePool m_framePool;
+
+        std::atomic<VideoFrameFormat> m_format;
+        // The width is in the high 32 bits and the height in the low 32 bits, so they are always read together
+        std::atomic<uint64_t> m_targetSize;
+        webrtc::VideoFrameBufferPool m_scaledBufferPool;
+        webrtc::VideoFrameBufferPool m_rotatedBufferPool;
 
     public:
         explicit VideoSink(VideoSinkCallback onFrameReceived);
 
         void OnFrame(const webrtc::VideoFrame& frame) override;
         [[nodiscard]] rtc::VideoSinkWants wants() const;
+        [[nodiscard]] uint64_t framePoolExhaustionCount() const;
+
+        void setTargetSize(int width, int height);
+        void setFormat(VideoFrameFormat format);
+
+    private:
+        PooledVideoFrame convertFromI420(
+            const webrtc::I420BufferInterface& buffer,
+            VideoFrameFormat format,
+            const VideoFrameTimestamps& timestamps);
+
+        rtc::scoped_refptr<webrtc::I420BufferInterface>
+            scaleToTargetSize(rtc::scoped_refptr<webrtc::I420BufferInterface> buffer, webrtc::VideoRotation rotation);
+        rtc::scoped_refptr<webrtc::I420BufferInterface>
+            rotate(rtc::scoped_refptr<webrtc::I420BufferInterface> buffer, webrtc::VideoRotation rotation);
     };
 
     /**
@@ -34,6 +76,13 @@ namespace opentera
      */
     inline rtc::VideoSinkWants VideoSink::wants() const { return m_wants; }
 
+    /**
+     * @brief Returns the number of frames whose image was allocated outside of the frame pool because the
+     * callback kept all pooled images.
+     * @return The number of frames allocated outside of the frame pool
+     */
+    inline uint64_t VideoSink::framePoolExhaustionCount() const { return m_framePool.exhaustionCount(); }
+
 }
 
 #endif
@@ -6,14 +6,28 @@
 #include <OpenteraWebrtcNativeClient/Handlers/StreamPeerConnectionHandler.h>
 
 #include <OpenteraWebrtcNativeClient/Signaling/WebSocketSignalingClient.h>
+#include <OpenteraWebrtcNativeClient/Utils/BoundedStream.h>
 #include <OpenteraWebrtcNativeClient/WebrtcClient.h>
 
 #include <iostream>
 
 #include <memory>
+#include <optional>
 
 namespace opentera
 {
+    /**
+     * @brief A video frame received from a client.
+     */
+    struct ReceivedVideoFrame
+    {
+        Client client;
+        PooledVideoFrame frame;
+        uint64_t timestampUs;
+    };
+
+    using VideoFrameStream = BoundedStream<ReceivedVideoFrame>;
+
     /**
      * @brief A signaling client to join a WebRTC room and stream a video source.
      */
@@ -34,6 +48,18 @@ namespace opentera
         bool m_isRemoteAudioMuted;
         bool m_isLocalVideoMuted;
 
+        int m_videoFrameTargetWidth;
+        int m_videoFrameTargetHeight;
+        VideoFrameFormat m_videoFrameFormat;
+
+        // Shared with the video sinks, which can outlive the client members
+        std::shared_ptr<BoundedStreamGroup<ReceivedVideoFrame>> m_videoFrameStreams;
+
+        std::optional<VideoFreezeWatchdogConfiguration> m_videoFreezeWatchdogConfiguration;
+        VideoFreezeRecoveryCallback m_onVideoFreezeRecovery;
+
+        ReceiveLatencyConfiguration m_receiveLatencyConfiguration;
+
     public:
         std::string streamId;
         StreamClient(
@@ -74,16 +100,30 @@ namespace opentera
         void muteLocalAudio();
         void unmuteLocalAudio();
         void setLocalAudioMuted(bool muted);
+        std::future<void> setLocalAudioMutedAsync(bool muted);
 
         bool isRemoteAudioMuted();
         void muteRemoteAudio();
         void unmuteRemoteAudio();
         void setRemoteAudioMuted(bool muted);
+        std::future<void> setRemoteAudioMutedAsync(bool muted);
 
         bool isLocalVideoMuted();
         void muteLocalVideo();
         void unmuteLocalVideo();
         void setLocalVideoMuted(bool muted);
+        std::future<void> setLocalVideoMutedAsync(bool muted);
+
+        void setVideoFrameTargetSize(int width, int height);
+        std::future<void> setVideoFrameTargetSizeAsync(int width, int height);
+        void setVideoFrameFormat(VideoFrameFormat format);
+
+        void setVideoFreezeWatchdogConfiguration(
+            const std::optional<VideoFreezeWatchdogConfiguration>& configuration);
+        void setReceiveLatencyConfiguration(const ReceiveLatencyConfiguration& configuration);
+
+        std::shared_ptr<VideoFrameStream>
+            createVideoFrameStream(size_t capacity = 2, StreamDropPolicy dropPolicy = StreamDropPolicy::DropOldest);
 
         void setOnAddRemoteStream(const std::function<void(const Client&)>& callback);
         void setOnRemoveRemoteStream(const std::function<void(const Client&)>& callback);
@@ -91,6 +131,7 @@ namespace opentera
         void setOnEncodedVideoFrameReceived(const EncodedVideoFrameReceivedCallback& callback);
         void setOnAudioFrameReceived(const AudioFrameReceivedCallback& callback);
         void setOnMixedAudioFrameReceived(const AudioSinkCallback& callback);
+        void setOnVideoFreezeRecovery(const VideoFreezeRecoveryCallback& callback);
         void setOnDataChannelOpened(const std::function<void(const Client&, rtc::scoped_refptr<webrtc::DataChannelInterface>)>& callback) {
             callSync(getInternalClientThread(), [this, &callback]() { m_onDataChannelOpened = callback; });
         }
@@ -98,6 +139,7 @@ namespace opentera
     protected:
         std::unique_ptr<PeerConnectionHandler>
             createPeerConnectionHandler(const std::string& id, const Client& peerClient, bool isCaller) override;
+        void updatePooledPeerConnectionHandler(PeerConnectionHandler& handler) override;
     };
 
     /**
@@ -159,6 +201,26 @@ namespace opentera
      */
     inline void StreamClient::unmuteLocalVideo() { setLocalVideoMuted(false); }
 
+    /**
+     * @brief Sets the frozen video watchdog configuration of the next connections.
+     *
+     * When a received video has no decoded frame for the frozen timeout, key frames are requested, then ICE is
+     * restarted and finally the connection is closed as failed, so the client connection failed callback can
+     * reconnect. The watchdog needs the video frame callback or a video frame stream. The ICE restarts use the
+     * attempts set with setIceRestartAttempts, which are disabled by default. Without attempt left, the ICE restart
+     * step is skipped and the connection is closed as failed one key frame request interval after the last key
+     * frame request.
+     *
+     * @param configuration The watchdog configuration, std::nullopt disables the watchdog
+     */
+    inline void StreamClient::setVideoFreezeWatchdogConfiguration(
+        const std::optional<VideoFreezeWatchdogConfiguration>& configuration)
+    {
+        callSync(
+            getInternalClientThread(),
+            [this, &configuration]() { m_videoFreezeWatchdogConfiguration = configuration; });
+    }
+
     /**
      * @brief Sets the callback that is called when a stream is added.
      *
@@ -201,7 +263,7 @@ namespace opentera
      * @parblock
      * Callback parameters:
      *  - client: The client of the stream frame
-     *  - bgrImg: The BGR frame image
+     *  - img: The frame image in the format set by setVideoFrameFormat (BGR by default)
      *  - timestampUs The timestamp in microseconds
      * @endparblock
      *
@@ -285,6 +347,24 @@ namespace opentera
         m_audioDeviceModule->setOnMixedAudioFrameReceived(callback);
     }
 
+    /**
+     * @brief Sets the callback that is called when the frozen video watchdog performs a recovery step.
+     *
+     * The callback is called from the internal client thread. The callback should not block.
+     *
+     * @parblock
+     * Callback parameters:
+     *  - client: The client of the frozen video
+     *  - step: The recovery step
+     * @endparblock
+     *
+     * @param callback The callback
+     */
+    inline void StreamClient::setOnVideoFreezeRecovery(const VideoFreezeRecoveryCallback& callback)
+    {
+        callSync(getInternalClientThread(), [this, &callback]() { m_onVideoFreezeRecovery = callback; });
+    }
+
 }
 
 #endif
@@ -0,0 +1,390 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_BOUNDED_STREAM_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_BOUNDED_STREAM_H
+
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+namespace opentera
+{
+    enum class StreamDropPolicy
+    {
+        // The oldest item is dropped to make room, so the consumer always gets the most recent items
+        DropOldest,
+        // The new item is dropped, so the consumer gets every item until it falls behind
+        DropNewest
+    };
+
+    /**
+     * @brief A thread-safe queue of received items with a bounded size and an explicit drop policy.
+     *
+     * The producer is a WebRTC thread and never blocks. The consumer pulls the items with next (blocking), next
+     * with a timeout or tryNext (non-blocking). An event loop that handles many streams from one thread sets an
+     * availability callback to be woken up, and then drains the streams with tryNext.
+     */
+    template<class T>
+    class BoundedStream
+    {
+        size_t m_capacity;
+        StreamDropPolicy m_dropPolicy;
+
+        std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<T> m_items;
+        bool m_isClosed;
+        uint64_t m_droppedCount;
+        std::function<void()> m_onAvailable;
+
+    public:
+        BoundedStream(size_t capacity, StreamDropPolicy dropPolicy);
+        virtual ~BoundedStream() = default;
+
+        DECLARE_NOT_COPYABLE(BoundedStream);
+        DECLARE_NOT_MOVABLE(BoundedStream);
+
+        bool push(T item);
+
+        std::optional<T> next();
+        template<class Rep, class Period>
+        std::optional<T> next(const std::chrono::duration<Rep, Period>& timeout);
+        std::optional<T> tryNext();
+
+        void close();
+        [[nodiscard]] bool isClosed();
+
+        [[nodiscard]] size_t capacity() const;
+        [[nodiscard]] StreamDropPolicy dropPolicy() const;
+        [[nodiscard]] size_t size();
+        [[nodiscard]] uint64_t droppedCount();
+
+        void setOnAvailable(std::function<void()> callback);
+    };
+
+    /**
+     * @brief The streams of the consumers of the same items.
+     *
+     * The group keeps weak references to its streams, so a stream is removed when its consumer releases it.
+     */
+    template<class T>
+    class BoundedStreamGroup
+    {
+        std::mutex m_mutex;
+        std::vector<std::weak_ptr<BoundedStream<T>>> m_streams;
+
+    public:
+        BoundedStreamGroup() = default;
+        virtual ~BoundedStreamGroup() = default;
+
+        DECLARE_NOT_COPYABLE(BoundedStreamGroup);
+        DECLARE_NOT_MOVABLE(BoundedStreamGroup);
+
+        std::shared_ptr<BoundedStream<T>> create(size_t capacity, StreamDropPolicy dropPolicy);
+        void push(const T& item);
+        void closeAll();
+
+        [[nodiscard]] bool empty();
+    };
+
+    /**
+     * @brief Creates a stream.
+     *
+     * @param capacity The maximum number of items waiting for the consumer, at least 1
+     * @param dropPolicy The item that is dropped when the stream is full
+     */
+    template<class T>
+    BoundedStream<T>::BoundedStream(size_t capacity, StreamDropPolicy dropPolicy)
+        : m_capacity(std::max<size_t>(capacity, 1)),
+          m_dropPolicy(dropPolicy),
+          m_isClosed(false),
+          m_droppedCount(0)
+    {
+    }
+
+    /**
+     * @brief Adds an item to the stream without blocking.
+     *
+     * The availability callback is called from the thread of the caller after the item is added.
+     *
+     * @param item The item
+     * @return true if the item is added, false if it is dropped or the stream is closed
+     */
+    template<class T>
+    bool BoundedStream<T>::push(T item)
+    {
+        std::function<void()> onAvailable;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_isClosed)
+            {
+                return false;
+            }
+
+            if (m_items.size() >= m_capacity)
+            {
+                m_droppedCount++;
+                if (m_dropPolicy == StreamDropPolicy::DropNewest)
+                {
+                    return false;
+                }
+                m_items.pop_front();
+            }
+            m_items.push_back(std::move(item));
+            onAvailable = m_onAvailable;
+        }
+
+        m_condition.notify_one();
+        if (onAvailable)
+        {
+            onAvailable();
+        }
+        return true;
+    }
+
+    /**
+     * @brief Waits for the next item.
+     * @return The next item, or std::nullopt if the stream is closed and empty
+     */
+    template<class T>
+    std::optional<T> BoundedStream<T>::next()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this]() { return !m_items.empty() || m_isClosed; });
+        if (m_items.empty())
+        {
+            return std::nullopt;
+        }
+
+        T item = std::move(m_items.front());
+        m_items.pop_front();
+        return item;
+    }
+
+    /**
+     * @brief Waits for the next item for a limited time.
+     *
+     * @param timeout The maximum waiting time
+     * @return The next item, or std::nullopt if the timeout expires or the stream is closed and empty
+     */
+    template<class T>
+    template<class Rep, class Period>
+    std::optional<T> BoundedStream<T>::next(const std::chrono::duration<Rep, Period>& timeout)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait_for(lock, timeout, [this]() { return !m_items.empty() || m_isClosed; });
+        if (m_items.empty())
+        {
+            return std::nullopt;
+        }
+
+        T item = std::move(m_items.front());
+        m_items.pop_front();
+        return item;
+    }
+
+    /**
+     * @brief Returns the next item without blocking.
+     * @return The next item, or std::nullopt if the stream is empty
+     */
+    template<class T>
+    std::optional<T> BoundedStream<T>::tryNext()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_items.empty())
+        {
+            return std::nullopt;
+        }
+
+        T item = std::move(m_items.front());
+        m_items.pop_front();
+        return item;
+    }
+
+    /**
+     * @brief Closes the stream.
+     *
+     * The new items are dropped. The waiting consumers get the remaining items and then std::nullopt.
+     */
+    template<class T>
+    void BoundedStream<T>::close()
+    {
+        std::function<void()> onAvailable;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (m_isClosed)
+            {
+                return;
+            }
+            m_isClosed = true;
+            onAvailable = m_onAvailable;
+        }
+
+        m_condition.notify_all();
+        if (onAvailable)
+        {
+            onAvailable();
+        }
+    }
+
+    /**
+     * @brief Indicates if the stream is closed.
+     * @return true if the stream is closed
+     */
+    template<class T>
+    bool BoundedStream<T>::isClosed()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_isClosed;
+    }
+
+    /**
+     * @brief Returns the maximum number of items waiting for the consumer.
+     * @return The maximum number of items waiting for the consumer
+     */
+    template<class T>
+    size_t BoundedStream<T>::capacity() const
+    {
+        return m_capacity;
+    }
+
+    /**
+     * @brief Returns the drop policy.
+     * @return The drop policy
+     */
+    template<class T>
+    StreamDropPolicy BoundedStream<T>::dropPolicy() const
+    {
+        return m_dropPolicy;
+    }
+
+    /**
+     * @brief Returns the number of items waiting for the consumer.
+     * @return The number of items waiting for the consumer
+     */
+    template<class T>
+    size_t BoundedStream<T>::size()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_items.size();
+    }
+
+    /**
+     * @brief Returns the number of items dropped because the stream was full.
+     * @return The number of dropped items
+     */
+    template<class T>
+    uint64_t BoundedStream<T>::droppedCount()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_droppedCount;
+    }
+
+    /**
+     * @brief Sets the callback that is called when an item is added or the stream is closed.
+     *
+     * The callback is called from the producer thread, so it should only wake up the consumer (for example, post
+     * a task to its event loop). The callback should not block.
+     *
+     * @param callback The callback, it can be null
+     */
+    template<class T>
+    void BoundedStream<T>::setOnAvailable(std::function<void()> callback)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_onAvailable = std::move(callback);
+    }
+
+    /**
+     * @brief Creates a stream of the group.
+     *
+     * @param capacity The maximum number of items waiting for the consumer, at least 1
+     * @param dropPolicy The item that is dropped when the stream is full
+     * @return The stream
+     */
+    template<class T>
+    std::shared_ptr<BoundedStream<T>> BoundedStreamGroup<T>::create(size_t capacity, StreamDropPolicy dropPolicy)
+    {
+        auto stream = std::make_shared<BoundedStream<T>>(capacity, dropPolicy);
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_streams.emplace_back(stream);
+        return stream;
+    }
+
+    /**
+     * @brief Adds an item to all the streams of the group without blocking.
+     * @param item The item
+     */
+    template<class T>
+    void BoundedStreamGroup<T>::push(const T& item)
+    {
+        std::vector<std::shared_ptr<BoundedStream<T>>> streams;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_streams.erase(
+                std::remove_if(
+                    m_streams.begin(),
+                    m_streams.end(),
+                    [](const std::weak_ptr<BoundedStream<T>>& stream) { return stream.expired(); }),
+                m_streams.end());
+            for (const auto& stream : m_streams)
+            {
+                streams.emplace_back(stream.lock());
+            }
+        }
+
+        // The streams are filled without the lock, so the availability callbacks can create streams.
+        for (auto& stream : streams)
+        {
+            if (stream)
+            {
+                stream->push(item);
+            }
+        }
+    }
+
+    /**
+     * @brief Closes all the streams of the group.
+     */
+    template<class T>
+    void BoundedStreamGroup<T>::closeAll()
+    {
+        std::vector<std::weak_ptr<BoundedStream<T>>> streams;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            streams.swap(m_streams);
+        }
+
+        for (auto& weakStream : streams)
+        {
+            auto stream = weakStream.lock();
+            if (stream)
+            {
+                stream->close();
+            }
+        }
+    }
+
+    /**
+     * @brief Indicates if the group has no stream.
+     * @return true if the group has no stream
+     */
+    template<class T>
+    bool BoundedStreamGroup<T>::empty()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return std::none_of(
+            m_streams.begin(),
+            m_streams.end(),
+            [](const std::weak_ptr<BoundedStream<T>>& stream) { return !stream.expired(); });
+    }
+}
+
+#endif
@@ -0,0 +1,73 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_CLOCK_OFFSET_ESTIMATOR_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_CLOCK_OFFSET_ESTIMATOR_H
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <optional>
+
+namespace opentera
+{
+    /**
+     * @brief The offset and the drift of a remote clock relative to the local clock.
+     *
+     * The offset is the remote time minus the local time at referenceTimeUs (local clock). The drift is the change
+     * of the offset in microseconds per second of the local clock (ppm).
+     */
+    struct ClockOffsetEstimate
+    {
+        int64_t referenceTimeUs;
+        int64_t offsetUs;
+        double driftPpm;
+        int64_t roundTripTimeUs;
+        size_t exchangeCount;
+    };
+
+    /**
+     * @brief Estimates the offset of a remote clock with NTP-style request/response exchanges.
+     *
+     * Every exchange gives an offset whose error is bounded by half of its round trip time, so only the exchanges
+     * with the shortest round trip times of the window are kept. The offset and the drift are the linear regression
+     * of their offsets over the local time. The class is not thread-safe.
+     */
+    class ClockOffsetEstimator
+    {
+        struct Exchange
+        {
+            int64_t localTimeUs;
+            int64_t offsetUs;
+            int64_t roundTripTimeUs;
+        };
+
+        size_t m_windowSize;
+        double m_maxDriftPpm;
+        std::deque<Exchange> m_exchanges;
+        std::optional<ClockOffsetEstimate> m_estimate;
+
+    public:
+        explicit ClockOffsetEstimator(size_t windowSize = 64, double maxDriftPpm = 500.0);
+        virtual ~ClockOffsetEstimator() = default;
+
+        bool addExchange(
+            int64_t requestSendTimeUs,
+            int64_t remoteReceiveTimeUs,
+            int64_t remoteSendTimeUs,
+            int64_t responseReceiveTimeUs);
+        void reset();
+
+        [[nodiscard]] const std::optional<ClockOffsetEstimate>& estimate() const;
+        [[nodiscard]] std::optional<int64_t> offsetAt(int64_t localTimeUs) const;
+        [[nodiscard]] std::optional<int64_t> toLocalTimeUs(int64_t remoteTimeUs) const;
+
+    private:
+        void updateEstimate();
+    };
+
+    /**
+     * @brief Returns the current estimate.
+     * @return The current estimate or std::nullopt if no valid exchange was added
+     */
+    inline const std::optional<ClockOffsetEstimate>& ClockOffsetEstimator::estimate() const { return m_estimate; }
+}
+
+#endif
@@ -0,0 +1,53 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_CHUNK_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_CHUNK_H
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+namespace opentera
+{
+    /**
+     * @brief The header of a chunk of a message larger than the data channel max message size.
+     *
+     * A chunk is a binary data channel message made of the header followed by the payload bytes at offset in the
+     * original message. The fields are little-endian:
+     * - magic (uint32)
+     * - version (uint8)
+     * - flags (uint8, bit 0 set when the original message is binary)
+     * - reserved (uint16)
+     * - messageId (uint32)
+     * - totalSize (uint32)
+     * - offset (uint32)
+     */
+    struct DataChannelChunkHeader
+    {
+        static constexpr uint32_t Magic = 0x4B484354;  // "TCHK"
+        static constexpr uint8_t Version = 1;
+        static constexpr size_t Size = 20;
+
+        uint32_t messageId;
+        bool binary;
+        uint32_t totalSize;
+        uint32_t offset;
+
+        void write(uint8_t* data) const;
+        static std::optional<DataChannelChunkHeader> read(const uint8_t* data, size_t size);
+    };
+
+    /**
+     * @brief The progress of a chunked message transfer.
+     *
+     * For a sent message, the transferred bytes are the payload bytes accepted by the data channel. For a received
+     * message, they are the payload bytes received so far. The throughput is measured from the first chunk.
+     */
+    struct DataChannelTransferProgress
+    {
+        uint32_t messageId;
+        uint64_t transferredBytes;
+        uint64_t totalBytes;
+        double bytesPerSecond;
+    };
+}
+
+#endif
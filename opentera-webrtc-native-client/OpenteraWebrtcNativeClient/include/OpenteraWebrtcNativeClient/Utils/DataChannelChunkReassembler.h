@@ -0,0 +1,120 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_CHUNK_REASSEMBLER_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_CHUNK_REASSEMBLER_H
+
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunk.h>
+
+#include <api/data_channel_interface.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace opentera
+{
+    /**
+     * @brief Reassembles the messages sent by a DataChannelChunkSender.
+     *
+     * The chunks can be received in any order and interleaved with the chunks of other messages. A message is
+     * written in a buffer taken from a pool, so the buffers of the next large messages are reused once the previous
+     * messages are released. A buffer grows with the contiguous received chunks instead of being allocated with the
+     * announced message size. The chunks received after a gap are kept apart until the gap is filled, and the
+     * duplicate chunks are ignored. The capacity of the buffers, the chunks kept apart and the pooled buffers never
+     * exceed the maximum number of pending bytes. The incomplete messages are dropped when they time out or when too
+     * many messages or bytes are pending. The class is not thread-safe.
+     */
+    class DataChannelChunkReassembler
+    {
+        struct Message
+        {
+            rtc::CopyOnWriteBuffer buffer;  // The received bytes from the beginning of the message
+            std::map<uint64_t, rtc::CopyOnWriteBuffer> deferredChunks;  // The chunks after a gap, by offset
+            bool binary;
+            uint32_t totalSize;
+            std::map<uint64_t, uint64_t> receivedRanges;  // Begin and end offsets of the received bytes, merged
+            uint64_t receivedBytes;
+            int64_t startTimeUs;
+            int64_t lastChunkTimeUs;
+        };
+
+        std::function<void(const webrtc::DataBuffer&)> m_onMessage;
+        std::function<void(const DataChannelTransferProgress&)> m_onProgress;
+        size_t m_maxMessageSize;
+        size_t m_maxPendingMessageCount;
+        std::chrono::milliseconds m_timeout;
+        size_t m_maxPendingBytes;
+
+        std::unordered_map<uint32_t, Message> m_messages;
+        std::vector<rtc::CopyOnWriteBuffer> m_bufferPool;
+        uint64_t m_pendingBytes;
+        uint64_t m_pooledBytes;
+        uint64_t m_droppedMessageCount;
+
+    public:
+        static constexpr size_t DefaultMaxMessageSize = 64 * 1024 * 1024;
+        static constexpr size_t DefaultMaxPendingMessageCount = 16;
+        static constexpr std::chrono::milliseconds DefaultTimeout = std::chrono::seconds(10);
+        static constexpr size_t DefaultMaxPendingBytes = DefaultMaxMessageSize;
+        static constexpr size_t MaxPooledBufferCount = 4;
+
+        explicit DataChannelChunkReassembler(
+            std::function<void(const webrtc::DataBuffer&)> onMessage,
+            std::function<void(const DataChannelTransferProgress&)> onProgress = nullptr,
+            size_t maxMessageSize = DefaultMaxMessageSize,
+            size_t maxPendingMessageCount = DefaultMaxPendingMessageCount,
+            std::chrono::milliseconds timeout = DefaultTimeout,
+            size_t maxPendingBytes = DefaultMaxPendingBytes);
+        virtual ~DataChannelChunkReassembler() = default;
+
+        DECLARE_NOT_COPYABLE(DataChannelChunkReassembler);
+        DECLARE_NOT_MOVABLE(DataChannelChunkReassembler);
+
+        bool handleMessage(const webrtc::DataBuffer& buffer);
+        void clear();
+
+        [[nodiscard]] size_t pendingMessageCount() const;
+        [[nodiscard]] uint64_t pendingBytes() const;
+        [[nodiscard]] uint64_t pooledBytes() const;
+        [[nodiscard]] uint64_t droppedMessageCount() const;
+
+    private:
+        bool writeChunk(uint32_t messageId, Message& message, uint64_t offset, const uint8_t* data, size_t size);
+        bool deferChunk(uint32_t messageId, Message& message, uint64_t offset, const uint8_t* data, size_t size);
+        bool growBuffer(uint32_t messageId, Message& message, size_t size);
+        bool reserveBytes(uint32_t messageId, uint64_t size);
+        void dropExpiredMessages(int64_t nowUs);
+        bool dropOldestMessage(uint32_t keptMessageId);
+        void eraseMessage(std::unordered_map<uint32_t, Message>::iterator it);
+        rtc::CopyOnWriteBuffer acquireBuffer();
+        void releaseBuffer(rtc::CopyOnWriteBuffer buffer);
+    };
+
+    /**
+     * @brief Returns the number of incomplete messages.
+     * @return The number of incomplete messages
+     */
+    inline size_t DataChannelChunkReassembler::pendingMessageCount() const { return m_messages.size(); }
+
+    /**
+     * @brief Returns the number of bytes allocated for the incomplete messages, including the unused capacity.
+     * @return The number of bytes allocated for the incomplete messages
+     */
+    inline uint64_t DataChannelChunkReassembler::pendingBytes() const { return m_pendingBytes; }
+
+    /**
+     * @brief Returns the capacity of the pooled buffers.
+     * @return The capacity of the pooled buffers
+     */
+    inline uint64_t DataChannelChunkReassembler::pooledBytes() const { return m_pooledBytes; }
+
+    /**
+     * @brief Returns the number of messages dropped because they were invalid, too large, or incomplete.
+     * @return The number of dropped messages
+     */
+    inline uint64_t DataChannelChunkReassembler::droppedMessageCount() const { return m_droppedMessageCount; }
+}
+
+#endif
@@ -0,0 +1,86 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_CHUNK_SENDER_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_CHUNK_SENDER_H
+
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunk.h>
+
+#include <api/data_channel_interface.h>
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace opentera
+{
+    /**
+     * @brief Splits the messages larger than the data channel max message size into chunks and sends them.
+     *
+     * The chunks of the pending messages are sent round-robin and only a few chunks are handed to the send function
+     * at a time, so the other messages sent on the data channel are not blocked behind a large message. The next
+     * chunks are sent when the send function completes the previous ones. The receiver must reassemble the chunks
+     * with a DataChannelChunkReassembler, so the data channel must be reliable.
+     *
+     * The class is thread-safe. The send function is never called with the internal mutex locked, so it can complete
+     * the chunks synchronously.
+     */
+    class DataChannelChunkSender
+    {
+        struct Transfer
+        {
+            uint32_t messageId;
+            webrtc::DataBuffer buffer;
+            size_t nextOffset;
+            size_t sentChunkCount;
+            size_t inFlightChunkCount;
+            uint64_t acceptedBytes;
+            int64_t startTimeUs;
+            bool isDone;
+            std::function<void(const DataChannelTransferProgress&)> onProgress;
+            std::function<void(bool)> onComplete;
+        };
+
+        std::function<bool(const webrtc::DataBuffer&, std::function<void(bool)>)> m_send;
+        size_t m_maxInFlightChunkCount;
+
+        std::mutex m_mutex;
+        size_t m_maxChunkSize;
+        std::list<std::shared_ptr<Transfer>> m_transfers;
+        uint32_t m_nextMessageId;
+        size_t m_inFlightChunkCount;
+        bool m_isPumping;
+
+    public:
+        // The SCTP default max message size when the remote description does not specify it
+        static constexpr size_t DefaultMaxChunkSize = 64 * 1024;
+        static constexpr size_t DefaultMaxInFlightChunkCount = 4;
+        static constexpr size_t MaxMessageSize = UINT32_MAX;
+
+        explicit DataChannelChunkSender(
+            std::function<bool(const webrtc::DataBuffer&, std::function<void(bool)>)> send,
+            size_t maxChunkSize = DefaultMaxChunkSize,
+            size_t maxInFlightChunkCount = DefaultMaxInFlightChunkCount);
+        virtual ~DataChannelChunkSender();
+
+        DECLARE_NOT_COPYABLE(DataChannelChunkSender);
+        DECLARE_NOT_MOVABLE(DataChannelChunkSender);
+
+        bool send(
+            const webrtc::DataBuffer& buffer,
+            std::function<void(const DataChannelTransferProgress&)> onProgress = nullptr,
+            std::function<void(bool)> onComplete = nullptr);
+        void cancel();
+
+        void setMaxChunkSize(size_t maxChunkSize);
+        [[nodiscard]] size_t maxChunkSize();
+        [[nodiscard]] size_t pendingMessageCount();
+
+    private:
+        void pump();
+        void onChunkComplete(const std::shared_ptr<Transfer>& transfer, size_t payloadSize, bool sent);
+        void fail(const std::shared_ptr<Transfer>& transfer);
+    };
+}
+
+#endif
@@ -0,0 +1,141 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_COMPRESSOR_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_COMPRESSOR_H
+
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+
+#include <api/data_channel_interface.h>
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace opentera
+{
+    enum class DataChannelCompressionCodec : uint8_t
+    {
+        None = 0,
+        // Available when the library is built with OPENTERA_WEBRTC_ENABLE_ZSTD
+        Zstd = 1
+    };
+
+    /**
+     * @brief The statistics of a DataChannelCompressor.
+     *
+     * The compressed bytes include the frame headers. The times are the CPU time spent in the codec.
+     */
+    struct DataChannelCompressionStats
+    {
+        uint64_t compressedMessageCount = 0;
+        uint64_t uncompressedMessageCount = 0;
+        uint64_t uncompressedBytes = 0;
+        uint64_t compressedBytes = 0;
+        int64_t compressionTimeUs = 0;
+
+        uint64_t decompressedMessageCount = 0;
+        uint64_t decompressionErrorCount = 0;
+        int64_t decompressionTimeUs = 0;
+
+        [[nodiscard]] double compressionRatio() const;
+    };
+
+    /**
+     * @brief Compresses the data channel messages above a size threshold.
+     *
+     * A compressed message is a binary message made of a header followed by the compressed payload. The fields of
+     * the header are little-endian:
+     * - magic (uint32)
+     * - version (uint8)
+     * - codec (uint8)
+     * - flags (uint8, bit 0 set when the original message is binary, bit 1 set for an acknowledgement)
+     * - reserved (uint8)
+     * - uncompressedSize (uint32)
+     * - dictionaryId (uint32, 0 without dictionary)
+     *
+     * The messages below the threshold, and the messages that do not shrink, are sent as is, so the receiver must
+     * accept both. A dictionary made of typical messages (for example, the JSON of the telemetry) improves the ratio
+     * of the small messages a lot, and both peers must use the same dictionary. The class is thread-safe, so a
+     * compressor can be shared by the data channels of all the peers.
+     *
+     * The compression is negotiated per data channel. The peer that creates the data channel advertises its codec
+     * and dictionary in the data channel protocol, and the other peer answers with an acknowledgement (a header
+     * without payload) when it has a matching compressor. The messages are only compressed toward a peer that
+     * advertised or acknowledged the compression, so a peer without compressor never receives compressed messages.
+     */
+    class DataChannelCompressor
+    {
+        struct Contexts;
+
+        DataChannelCompressionCodec m_codec;
+        size_t m_threshold;
+        int m_level;
+        std::vector<uint8_t> m_dictionary;
+        uint32_t m_dictionaryId;
+        size_t m_maxUncompressedSize;
+
+        std::mutex m_mutex;
+        std::unique_ptr<Contexts> m_contexts;
+        DataChannelCompressionStats m_stats;
+
+    public:
+        static constexpr uint32_t Magic = 0x504D4354;  // "TCMP"
+        static constexpr uint8_t Version = 1;
+        static constexpr size_t HeaderSize = 16;
+        static constexpr const char* ProtocolPrefix = "tcmp/";
+        static constexpr size_t DefaultThreshold = 256;
+        static constexpr int DefaultLevel = 3;
+        static constexpr size_t DefaultMaxUncompressedSize = 64 * 1024 * 1024;
+
+        explicit DataChannelCompressor(
+            DataChannelCompressionCodec codec,
+            size_t threshold = DefaultThreshold,
+            int level = DefaultLevel,
+            std::vector<uint8_t> dictionary = {},
+            size_t maxUncompressedSize = DefaultMaxUncompressedSize);
+        virtual ~DataChannelCompressor();
+
+        DECLARE_NOT_COPYABLE(DataChannelCompressor);
+        DECLARE_NOT_MOVABLE(DataChannelCompressor);
+
+        static bool isSupported(DataChannelCompressionCodec codec);
+
+        [[nodiscard]] DataChannelCompressionCodec codec() const;
+        [[nodiscard]] uint32_t dictionaryId() const;
+
+        [[nodiscard]] std::string advertise(const std::string& protocol) const;
+        [[nodiscard]] bool isAdvertisedBy(const std::string& protocol) const;
+        [[nodiscard]] webrtc::DataBuffer createAcknowledgement() const;
+        [[nodiscard]] bool isAcknowledgement(const webrtc::DataBuffer& message) const;
+
+        webrtc::DataBuffer compress(const webrtc::DataBuffer& message);
+        std::optional<webrtc::DataBuffer> decompress(const webrtc::DataBuffer& message);
+
+        [[nodiscard]] DataChannelCompressionStats stats();
+        void resetStats();
+    };
+
+    /**
+     * @brief Returns the uncompressed bytes divided by the compressed bytes of the compressed messages.
+     * @return The compression ratio, or 1 if no message is compressed
+     */
+    inline double DataChannelCompressionStats::compressionRatio() const
+    {
+        return compressedBytes > 0 ? static_cast<double>(uncompressedBytes) / compressedBytes : 1.0;
+    }
+
+    /**
+     * @brief Returns the codec of the compressed messages.
+     * @return The codec of the compressed messages
+     */
+    inline DataChannelCompressionCodec DataChannelCompressor::codec() const { return m_codec; }
+
+    /**
+     * @brief Returns the identifier of the dictionary written in the headers.
+     * @return The identifier of the dictionary, 0 without dictionary
+     */
+    inline uint32_t DataChannelCompressor::dictionaryId() const { return m_dictionaryId; }
+}
+
+#endif
@@ -0,0 +1,94 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_SEND_QUEUE_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_DATA_CHANNEL_SEND_QUEUE_H
+
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+
+#include <api/data_channel_interface.h>
+
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+
+namespace opentera
+{
+    enum class DataChannelSendPriority
+    {
+        Normal,
+        // For the control messages, they are sent before the queued normal messages
+        High
+    };
+
+    /**
+     * @brief Queues the messages of a data channel while its buffered amount is high.
+     *
+     * A message is sent when the buffered amount stays below the high watermark once it is sent. When a message
+     * does not fit, the queue is paused until the buffered amount drops to the low watermark. The high priority
+     * messages do not wait for the low watermark and are sent before the normal messages. A message is always
+     * sent when nothing is buffered, so a message larger than the high watermark is not blocked.
+     *
+     * onBufferedAmountChange must be called from webrtc::DataChannelObserver::OnBufferedAmountChange. The class
+     * is thread-safe and the data channel is never called with the internal mutex locked, so the queue can be
+     * used from the data channel observer.
+     */
+    class DataChannelSendQueue
+    {
+        struct Entry
+        {
+            webrtc::DataBuffer buffer;
+            std::function<void(bool)> onComplete;
+        };
+
+        std::function<bool(const webrtc::DataBuffer&)> m_send;
+        std::function<uint64_t()> m_bufferedAmount;
+        uint64_t m_highWatermark;
+        uint64_t m_lowWatermark;
+        uint64_t m_maxQueuedBytes;
+
+        std::mutex m_mutex;
+        std::deque<Entry> m_highPriorityEntries;
+        std::deque<Entry> m_normalPriorityEntries;
+        uint64_t m_queuedBytes;
+        bool m_isPaused;
+        bool m_isDraining;
+        bool m_hasBufferedAmountChanged;
+
+    public:
+        static constexpr uint64_t DefaultHighWatermark = 1024 * 1024;
+        static constexpr uint64_t DefaultLowWatermark = 256 * 1024;
+        static constexpr uint64_t DefaultMaxQueuedBytes = 16 * 1024 * 1024;
+
+        DataChannelSendQueue(
+            rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+            uint64_t highWatermark = DefaultHighWatermark,
+            uint64_t lowWatermark = DefaultLowWatermark,
+            uint64_t maxQueuedBytes = DefaultMaxQueuedBytes);
+        DataChannelSendQueue(
+            std::function<bool(const webrtc::DataBuffer&)> send,
+            std::function<uint64_t()> bufferedAmount,
+            uint64_t highWatermark = DefaultHighWatermark,
+            uint64_t lowWatermark = DefaultLowWatermark,
+            uint64_t maxQueuedBytes = DefaultMaxQueuedBytes);
+        virtual ~DataChannelSendQueue();
+
+        DECLARE_NOT_COPYABLE(DataChannelSendQueue);
+        DECLARE_NOT_MOVABLE(DataChannelSendQueue);
+
+        bool send(
+            const webrtc::DataBuffer& buffer,
+            DataChannelSendPriority priority = DataChannelSendPriority::Normal,
+            std::function<void(bool)> onComplete = nullptr);
+        void onBufferedAmountChange();
+        void clear();
+
+        [[nodiscard]] size_t queuedMessageCount();
+        [[nodiscard]] uint64_t queuedBytes();
+        [[nodiscard]] bool isPaused();
+
+    private:
+        bool hasSendableEntry() const;
+        void drain();
+    };
+}
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_FIELD_TRIALS_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_FIELD_TRIALS_H
+
+#include <chrono>
+#include <string>
+
+namespace opentera
+{
+    std::string createPlayoutDelayFieldTrials(
+        std::chrono::milliseconds minimumPlayoutDelay,
+        std::chrono::milliseconds maximumPlayoutDelay);
+
+    void initializeFieldTrials(const std::string& fieldTrials);
+}
+
+#endif
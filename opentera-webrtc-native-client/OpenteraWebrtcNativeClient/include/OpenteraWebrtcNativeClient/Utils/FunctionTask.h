@@ -4,6 +4,8 @@
 #include <rtc_base/event.h>
 #include <rtc_base/thread.h>
 
+#include <future>
+#include <memory>
 #include <type_traits>
 
 namespace opentera
@@ -62,6 +64,32 @@ namespace opentera
     {
         thread->PostTask([function = std::forward<F>(function)]() { function(); });
     }
+
+    /**
+     * @brief Calls a function on a thread without blocking the caller.
+     *
+     * The function is called immediately when the caller is on the thread, so waiting the future from the thread
+     * does not deadlock. The future can be polled with wait_for(0s) from an event loop.
+     *
+     * @param thread The thread
+     * @param function The function
+     * @return The future of the function result, it holds the exception thrown by the function
+     */
+    template<class F>
+    std::future<std::invoke_result_t<F>> callFuture(rtc::Thread* thread, F&& function)
+    {
+        auto task = std::make_shared<std::packaged_task<std::invoke_result_t<F>()>>(std::forward<F>(function));
+        std::future<std::invoke_result_t<F>> future = task->get_future();
+        if (thread->IsCurrent())
+        {
+            (*task)();
+        }
+        else
+        {
+            thread->PostTask([task]() { (*task)(); });
+        }
+        return future;
+    }
 }
 
 #endif
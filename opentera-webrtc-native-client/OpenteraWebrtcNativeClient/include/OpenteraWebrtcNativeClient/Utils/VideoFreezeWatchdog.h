@@ -0,0 +1,77 @@
+#ifndef OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_VIDEO_FREEZE_WATCHDOG_H
+#define OPENTERA_WEBRTC_NATIVE_CLIENT_UTILS_VIDEO_FREEZE_WATCHDOG_H
+
+#include <OpenteraWebrtcNativeClient/Configurations/VideoFreezeWatchdogConfiguration.h>
+#include <OpenteraWebrtcNativeClient/Utils/ClassMacro.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+
+namespace opentera
+{
+    /**
+     * @brief Represents the recovery steps of a frozen video, from the cheapest to the most expensive.
+     */
+    enum class VideoFreezeRecoveryStep
+    {
+        // A key frame is requested from the sender (RTCP PLI/FIR)
+        RequestKeyFrame,
+        // The ICE candidates are gathered again and the connection is renegotiated
+        RestartIce,
+        // The connection is closed, so a new one can be created
+        Reconnect
+    };
+
+    struct VideoFreezeWatchdogStats
+    {
+        uint64_t freezeCount;
+        uint64_t recoveredFreezeCount;
+        uint64_t keyFrameRequestCount;
+        uint64_t iceRestartCount;
+        uint64_t reconnectionCount;
+    };
+
+    /**
+     * @brief Detects the frozen received videos and chooses their recovery steps.
+     *
+     * The watchdog is armed by the first decoded frame. Afterward, update must be called periodically and returns
+     * the recovery step to perform, if any. The escalation restarts from the first step when a frame is decoded
+     * again. The class is thread-safe, so the frames can be reported from a WebRTC thread.
+     */
+    class VideoFreezeWatchdog
+    {
+        VideoFreezeWatchdogConfiguration m_configuration;
+
+        mutable std::mutex m_mutex;
+        std::optional<int64_t> m_lastFrameTimeUs;
+        std::optional<int64_t> m_lastStepTimeUs;
+        bool m_isFrozen;
+        size_t m_keyFrameRequestCount;
+        bool m_isIceRestarted;
+        bool m_isIceRestartSkipped;
+        bool m_isReconnectionRequested;
+        VideoFreezeWatchdogStats m_stats;
+
+    public:
+        explicit VideoFreezeWatchdog(VideoFreezeWatchdogConfiguration configuration);
+        virtual ~VideoFreezeWatchdog() = default;
+
+        DECLARE_NOT_COPYABLE(VideoFreezeWatchdog);
+        DECLARE_NOT_MOVABLE(VideoFreezeWatchdog);
+
+        void onFrameDecoded(int64_t timeUs);
+        std::optional<VideoFreezeRecoveryStep> update(int64_t timeUs);
+        void onIceRestartSkipped();
+        void reset();
+
+        [[nodiscard]] bool isFrozen() const;
+        [[nodiscard]] VideoFreezeWatchdogStats stats() const;
+
+    private:
+        void resetEscalation();
+    };
+}
+
+#endif
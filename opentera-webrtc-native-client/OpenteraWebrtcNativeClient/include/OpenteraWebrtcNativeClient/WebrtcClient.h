@@ -13,8 +13,12 @@
 
 #include <api/peer_connection_interface.h>
 #include <api/scoped_refptr.h>
+#include <rtc_base/task_utils/repeating_task.h>
 
+#include <chrono>
+#include <deque>
 #include <functional>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -51,6 +55,15 @@ namespace opentera
 
         std::function<void(const std::string& log)> m_logger;
 
+        size_t m_maxIceRestartAttemptCount;
+        std::chrono::milliseconds m_iceRestartTimeout;
+
+        webrtc::RepeatingTaskHandle m_streamerListRefreshTask;
+
+        // Callee connections created before the offers, so the offers are answered without creating them
+        size_t m_peerConnectionPoolSize;
+        std::deque<std::unique_ptr<PeerConnectionHandler>> m_pooledPeerConnectionHandlers;
+
         std::unique_ptr<rtc::Thread> m_networkThread;
         std::unique_ptr<rtc::Thread> m_workerThread;
         std::unique_ptr<rtc::Thread> m_signalingThread;
@@ -81,14 +94,24 @@ namespace opentera
         DECLARE_NOT_MOVABLE(WebrtcClient);
 
         void setTlsVerificationEnabled(bool isEnabled);
+        void setIceRestartAttempts(
+            size_t maxAttemptCount,
+            std::chrono::milliseconds timeout = std::chrono::milliseconds(2000));
+        void setPeerConnectionPoolSize(size_t size);
 
         void connect();
         void close();
         void closeSync();
+        std::future<void> closeAsync();
 
         void callAll();
         void callIds(const std::vector<std::string>& ids);
 
+        void subscribe(const std::string& streamerId);
+        void unsubscribe(const std::string& streamerId);
+        void refreshStreamerList();
+        void setStreamerListRefreshInterval(std::chrono::milliseconds interval);
+
         void hangUpAll();
         void closeAllRoomPeerConnections();
 
@@ -97,9 +120,11 @@ namespace opentera
         std::string id();
 
         std::vector<std::string> getConnectedRoomClientIds();
+        std::future<std::vector<std::string>> getConnectedRoomClientIdsAsync();
 
         RoomClient getRoomClient(const std::string& id);
         std::vector<RoomClient> getRoomClients();
+        std::future<std::vector<RoomClient>> getRoomClientsAsync();
 
         void setOnSignalingConnectionOpened(const std::function<void()>& callback);
         void setOnSignalingConnectionClosed(const std::function<void()>& callback);
@@ -126,6 +151,7 @@ namespace opentera
 
         virtual std::unique_ptr<PeerConnectionHandler>
             createPeerConnectionHandler(const std::string& id, const Client& peerClient, bool isCaller) = 0;
+        virtual void updatePooledPeerConnectionHandler(PeerConnectionHandler& handler);
 
         std::function<void(const std::string&)> getOnErrorFunction();
         std::function<void(const Client&)> getOnClientConnectedFunction();
@@ -151,10 +177,37 @@ namespace opentera
         bool getCallAcceptance(const std::string& id);
 
         std::unique_ptr<PeerConnectionHandler>
-            createConnection(const std::string& peerId, const Client& peerClient, bool isCaller);
+            createConnection(const std::string& peerId, const Client& peerClient, bool isCaller, bool isPooled = false);
         void removeConnection(const std::string& id);
+
+        std::unique_ptr<PeerConnectionHandler> claimPooledConnection();
+        void fillPeerConnectionPool();
     };
 
+    /**
+     * @brief Sets the ICE restarts of the next connections when they are disconnected or failed.
+     *
+     * The connection is renegotiated in place with an ICE restart offer, so the tracks, the sinks, the decoders and
+     * the data channels are kept. The client disconnected and connection failed callbacks are only called when all
+     * attempts fail. An attempt fails when the connection is not connected after the timeout. A disconnected
+     * connection is only restarted if it is still disconnected after 2 s, since this state is often transient. The
+     * remote client must accept the offers of this client, even when it is the callee.
+     *
+     * @param maxAttemptCount The maximum number of ICE restarts before reporting the connection loss. 0 disables
+     * the ICE restarts.
+     * @param timeout The maximum duration of an ICE restart
+     */
+    inline void WebrtcClient::setIceRestartAttempts(size_t maxAttemptCount, std::chrono::milliseconds timeout)
+    {
+        callSync(
+            m_internalClientThread.get(),
+            [this, maxAttemptCount, timeout]()
+            {
+                m_maxIceRestartAttemptCount = maxAttemptCount;
+                m_iceRestartTimeout = timeout;
+            });
+    }
+
     /**
      * @brief Indicates if the client is connected to the signaling server.
      * @return true if the client is connected to the signaling server
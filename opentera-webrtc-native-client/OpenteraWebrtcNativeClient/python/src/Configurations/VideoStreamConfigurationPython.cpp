@@ -46,6 +46,25 @@ void opentera::initVideoStreamConfigurationPython(py::module& m)
             py::arg("forced_codecs"),
             py::arg("force_gstreamer_hardware_acceleration"),
             py::arg("use_gstreamer_software_encoder_decoder"))
+        .def_static(
+            "create",
+            py::overload_cast<unordered_set<VideoStreamCodec>, bool, bool, bool>(&VideoStreamConfiguration::create),
+            "Creates a video stream configuration with the specified values.\n"
+            "\n"
+            ":param forced_codecs: Indicates the codecs that must be used. An empty set means all codecs.\n"
+            ":param force_gstreamer_hardware_acceleration: Indicates that hardware accelerated codecs must be used. It "
+            "has no effect when the library is not built with GStreamer.\n"
+            ":param use_gstreamer_software_encoder_decoder: Indicates to use GStreamer software codecs instead of "
+            "WebRTC ones. It has no effect when the library is not built with GStreamer.\n"
+            ":param receive_encoded_video_only: Indicates that the received video streams are never decoded. The "
+            "video is still negotiated and the encoded frames are still delivered, but no decoded frames are "
+            "produced.\n"
+            "\n"
+            ":return: A video stream configuration with the specified values",
+            py::arg("forced_codecs"),
+            py::arg("force_gstreamer_hardware_acceleration"),
+            py::arg("use_gstreamer_software_encoder_decoder"),
+            py::arg("receive_encoded_video_only"))
 
         .def_property_readonly(
             "forced_codecs",
@@ -64,5 +83,11 @@ void opentera::initVideoStreamConfigurationPython(py::module& m)
             &VideoStreamConfiguration::useGStreamerSoftwareEncoderDecoder,
             "Indicates to use GStreamer software codecs instead of WebRTC ones.\n"
             "\n"
-            ":return: True if GStreamer software codecs must be used instead of WebRTC ones");
+            ":return: True if GStreamer software codecs must be used instead of WebRTC ones")
+        .def_property_readonly(
+            "receive_encoded_video_only",
+            &VideoStreamConfiguration::receiveEncodedVideoOnly,
+            "Indicates that the received video streams are never decoded.\n"
+            "\n"
+            ":return: True if only the encoded frames of the received video streams are available.");
 }
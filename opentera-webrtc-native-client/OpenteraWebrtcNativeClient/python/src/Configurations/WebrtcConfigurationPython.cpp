@@ -10,6 +10,14 @@ namespace py = pybind11;
 
 void opentera::initWebrtcConfigurationPython(pybind11::module& m)
 {
+    py::enum_<IceCandidateNetworkPolicy>(m, "IceCandidateNetworkPolicy")
+        .value("ALL", IceCandidateNetworkPolicy::All)
+        .value("LOW_COST", IceCandidateNetworkPolicy::LowCost);
+
+    py::enum_<IceGatheringPolicy>(m, "IceGatheringPolicy")
+        .value("GATHER_ONCE", IceGatheringPolicy::GatherOnce)
+        .value("GATHER_CONTINUALLY", IceGatheringPolicy::GatherContinually);
+
     py::class_<WebrtcConfiguration>(m, "WebrtcConfiguration", "Represents a WebRTC peer connection configuration.")
         .def_static(
             "create",
@@ -29,11 +37,66 @@ void opentera::initWebrtcConfigurationPython(pybind11::module& m)
             ":return: A WebRTC peer connection configuration with the specified "
             "value",
             py::arg("ice_servers"))
+        .def_static(
+            "create",
+            py::overload_cast<vector<IceServer>, IceCandidateNetworkPolicy, IceGatheringPolicy, bool, bool>(
+                &WebrtcConfiguration::create),
+            "Creates a WebRTC peer connection configuration with the specified "
+            "values.\n"
+            "\n"
+            ":param ice_servers: The ice servers\n"
+            ":param candidate_network_policy: The networks used to gather the ICE candidates\n"
+            ":param gathering_policy: When the ICE candidates are gathered\n"
+            ":param tcp_candidates_enabled: Indicates if the TCP candidates are gathered\n"
+            ":param bundle_required: Indicates if all media are sent over one transport with RTP and RTCP "
+            "multiplexed. The remote peer must support BUNDLE.\n"
+            "\n"
+            ":return: A WebRTC peer connection configuration with the specified "
+            "values",
+            py::arg("ice_servers"),
+            py::arg("candidate_network_policy"),
+            py::arg("gathering_policy"),
+            py::arg("tcp_candidates_enabled"),
+            py::arg("bundle_required"))
+        .def_static(
+            "create_for_local_network",
+            &WebrtcConfiguration::createForLocalNetwork,
+            "Creates a WebRTC peer connection configuration for peers on the same local network.\n"
+            "\n"
+            "There is no ice server, so only the host candidates are gathered without waiting for STUN or TURN "
+            "servers. The TCP candidates are not gathered and BUNDLE is required, so there is only one transport to "
+            "connect.\n"
+            "\n"
+            ":return: A WebRTC peer connection configuration for peers on the same local network")
 
         .def_property_readonly(
             "ice_servers",
             &WebrtcConfiguration::iceServers,
             "Returns the ice servers.\n"
             "\n"
-            ":return: The ice servers");
+            ":return: The ice servers")
+        .def_property_readonly(
+            "candidate_network_policy",
+            &WebrtcConfiguration::candidateNetworkPolicy,
+            "Returns the networks used to gather the ICE candidates.\n"
+            "\n"
+            ":return: The networks used to gather the ICE candidates")
+        .def_property_readonly(
+            "gathering_policy",
+            &WebrtcConfiguration::gatheringPolicy,
+            "Returns when the ICE candidates are gathered.\n"
+            "\n"
+            ":return: When the ICE candidates are gathered")
+        .def_property_readonly(
+            "tcp_candidates_enabled",
+            &WebrtcConfiguration::tcpCandidatesEnabled,
+            "Indicates if the TCP candidates are gathered.\n"
+            "\n"
+            ":return: True if the TCP candidates are gathered")
+        .def_property_readonly(
+            "bundle_required",
+            &WebrtcConfiguration::bundleRequired,
+            "Indicates if all media are sent over one transport with RTP and RTCP multiplexed.\n"
+            "\n"
+            ":return: True if all media are sent over one transport with RTP and RTCP multiplexed");
 }
@@ -23,6 +23,20 @@ void setOnDataChannelMessageBinary(
     self.setOnDataChannelMessageBinary(callback);
 }
 
+// The bytes are copied once, with the GIL, in the payload shared by the data channels
+webrtc::DataBuffer toDataBuffer(const py::bytes& bytes)
+{
+    char* data = nullptr;
+    Py_ssize_t size = 0;
+    if (PyBytes_AsStringAndSize(bytes.ptr(), &data, &size) != 0)
+    {
+        throw py::error_already_set();
+    }
+    return webrtc::DataBuffer(
+        rtc::CopyOnWriteBuffer(reinterpret_cast<const uint8_t*>(data), static_cast<size_t>(size)),
+        true);
+}
+
 void opentera::initDataChannelClientPython(pybind11::module& m)
 {
     py::class_<DataChannelClient, WebrtcClient>(
@@ -45,10 +59,10 @@ void opentera::initDataChannelClientPython(pybind11::module& m)
             "send_to",
             [](DataChannelClient& self, const py::bytes& bytes, const vector<string>& ids)
             {
-                auto data = bytes.cast<string>();
-                self.sendTo(reinterpret_cast<const uint8_t*>(data.data()), data.size(), ids);
+                auto buffer = toDataBuffer(bytes);
+                py::gil_scoped_release release;
+                self.sendTo(buffer, ids);
             },
-            py::call_guard<py::gil_scoped_release>(),
             "Sends binary data to the specified clients.\n"
             "\n"
             ":param bytes: The binary data\n"
@@ -69,10 +83,10 @@ void opentera::initDataChannelClientPython(pybind11::module& m)
             "send_to_all",
             [](DataChannelClient& self, const py::bytes& bytes)
             {
-                auto data = bytes.cast<string>();
-                self.sendToAll(reinterpret_cast<const uint8_t*>(data.data()), data.size());
+                auto buffer = toDataBuffer(bytes);
+                py::gil_scoped_release release;
+                self.sendToAll(buffer);
             },
-            py::call_guard<py::gil_scoped_release>(),
             "Sends binary data to all clients.\n"
             "\n"
             ":param bytes: The binary data (bytes)\n",
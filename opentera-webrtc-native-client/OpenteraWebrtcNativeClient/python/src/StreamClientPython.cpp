@@ -14,25 +14,25 @@ void setOnVideoFrameReceived(
     StreamClient& self,
     const function<void(const Client&, const py::array_t<uint8_t>&, uint64_t)>& pythonCallback)
 {
-    auto callback = [=](const Client& client, const cv::Mat& bgrImg, uint64_t timestampUs)
+    auto callback = [=](const Client& client, const PooledVideoFrame& frame, uint64_t timestampUs)
     {
-        size_t height = bgrImg.rows;
-        size_t width = bgrImg.cols;
-        size_t channelCount = bgrImg.channels();
+        const cv::Mat& img = frame.mat();
+        size_t height = img.rows;
+        size_t width = img.cols;
+        size_t channelCount = img.channels();
 
-        py::buffer_info bufferInfo(
-            bgrImg.data,
-            sizeof(uint8_t),
-            py::format_descriptor<uint8_t>::format(),
-            3,  // Number of dimensions
-            {height, width, channelCount},  // Buffer dimensions
-            // Strides (in bytes) for each index
-            {bgrImg.step[0], bgrImg.step[1], sizeof(uint8_t)},
-            true);  // Readonly
+        // The numpy array keeps a reference to the pooled frame instead of copying the pixels.
+        auto heldFrame = new PooledVideoFrame(frame);
 
         py::gil_scoped_acquire acquire;
-        py::array_t<uint8_t> numpyBgrImg(bufferInfo);
-        pythonCallback(client, numpyBgrImg, timestampUs);
+        py::capsule base(heldFrame, [](void* p) { delete static_cast<PooledVideoFrame*>(p); });
+        py::array_t<uint8_t> numpyImg(
+            {height, width, channelCount},  // Buffer dimensions
+            {img.step[0], img.step[1], sizeof(uint8_t)},  // Strides (in bytes) for each index
+            img.data,
+            base);
+        numpyImg.attr("setflags")(py::arg("write") = false);
+        pythonCallback(client, numpyImg, timestampUs);
     };
 
     self.setOnVideoFrameReceived(callback);
@@ -153,6 +153,13 @@ void opentera::initStreamClientPython(pybind11::module& m)
         .value("H264", VideoCodecType::H264)
         .value("MULTIPLEX", VideoCodecType::Multiplex);
 
+    py::enum_<VideoFrameFormat>(m, "VideoFrameFormat")
+        .value("BGR", VideoFrameFormat::BGR)
+        .value("RGB", VideoFrameFormat::RGB)
+        .value("BGRA", VideoFrameFormat::BGRA)
+        .value("RGBA", VideoFrameFormat::RGBA)
+        .value("GRAY", VideoFrameFormat::Gray);
+
     py::class_<StreamClient, WebrtcClient>(
         m,
         "StreamClient",
@@ -274,6 +281,29 @@ void opentera::initStreamClientPython(pybind11::module& m)
             &StreamClient::unmuteLocalVideo,
             py::call_guard<py::gil_scoped_release>(),
             "Unmutes the local video.")
+        .def(
+            "set_video_frame_target_size",
+            &StreamClient::setVideoFrameTargetSize,
+            py::call_guard<py::gil_scoped_release>(),
+            "Sets the size of the area where the received video frames are displayed.\n"
+            "\n"
+            "The received frames are downscaled before the color conversion so they fit in this size while keeping "
+            "their aspect ratio. They are never upscaled.\n"
+            "\n"
+            ":param width: The target width, 0 to receive the frames at their native size\n"
+            ":param height: The target height, 0 to receive the frames at their native size",
+            py::arg("width"),
+            py::arg("height"))
+        .def(
+            "set_video_frame_format",
+            &StreamClient::setVideoFrameFormat,
+            py::call_guard<py::gil_scoped_release>(),
+            "Sets the pixel layout of the received video frames.\n"
+            "\n"
+            "The frames are converted from I420 to this layout in a single pass.\n"
+            "\n"
+            ":param format: The pixel layout of the received video frames (BGR by default)",
+            py::arg("format"))
 
         .def_property(
             "on_add_remote_stream",
@@ -313,7 +343,8 @@ void opentera::initStreamClientPython(pybind11::module& m)
             "\n"
             "Callback parameters:\n"
             " - client: The client of the stream frame\n"
-            " - bgr_img: The BGR frame image (numpy.array[uint8])\n"
+            " - img: The frame image in the format set by set_video_frame_format, BGR by default "
+            "(numpy.array[uint8])\n"
             " - timestamp_us The timestamp in microseconds\n"
             "\n"
             ":param callback: The callback")
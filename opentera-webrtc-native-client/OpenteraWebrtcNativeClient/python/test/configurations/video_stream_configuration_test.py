@@ -10,6 +10,7 @@ class VideoStreamConfigurationTestCase(unittest.TestCase):
         self.assertEqual(testee.forced_codecs, set())
         self.assertEqual(testee.force_gstreamer_hardware_acceleration, False)
         self.assertEqual(testee.use_gstreamer_software_encoder_decoder, False)
+        self.assertEqual(testee.receive_encoded_video_only, False)
 
     def test_create__forced_codecs__should_set_the_attributes(self):
         testee = webrtc.VideoStreamConfiguration.create({webrtc.VideoStreamCodec.VP8})
@@ -17,6 +18,7 @@ class VideoStreamConfigurationTestCase(unittest.TestCase):
         self.assertEqual(testee.forced_codecs, {webrtc.VideoStreamCodec.VP8})
         self.assertEqual(testee.force_gstreamer_hardware_acceleration, False)
         self.assertEqual(testee.use_gstreamer_software_encoder_decoder, False)
+        self.assertEqual(testee.receive_encoded_video_only, False)
 
     def test_create__all__should_set_the_attributes(self):
         testee = webrtc.VideoStreamConfiguration.create({webrtc.VideoStreamCodec.VP9, webrtc.VideoStreamCodec.H264},
@@ -25,3 +27,12 @@ class VideoStreamConfigurationTestCase(unittest.TestCase):
         self.assertEqual(testee.forced_codecs, {webrtc.VideoStreamCodec.VP9, webrtc.VideoStreamCodec.H264})
         self.assertEqual(testee.force_gstreamer_hardware_acceleration, True)
         self.assertEqual(testee.use_gstreamer_software_encoder_decoder, False)
+        self.assertEqual(testee.receive_encoded_video_only, False)
+
+    def test_create__receive_encoded_video_only__should_set_the_attributes(self):
+        testee = webrtc.VideoStreamConfiguration.create({webrtc.VideoStreamCodec.H264}, False, True, True)
+
+        self.assertEqual(testee.forced_codecs, {webrtc.VideoStreamCodec.H264})
+        self.assertEqual(testee.force_gstreamer_hardware_acceleration, False)
+        self.assertEqual(testee.use_gstreamer_software_encoder_decoder, True)
+        self.assertEqual(testee.receive_encoded_video_only, True)
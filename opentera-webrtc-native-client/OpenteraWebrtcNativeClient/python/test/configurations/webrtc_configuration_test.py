@@ -8,9 +8,32 @@ class WebrtcConfigurationTestCase(unittest.TestCase):
         testee = webrtc.WebrtcConfiguration.create()
 
         self.assertEqual(testee.ice_servers, [])
+        self.assertEqual(testee.candidate_network_policy, webrtc.IceCandidateNetworkPolicy.ALL)
+        self.assertEqual(testee.gathering_policy, webrtc.IceGatheringPolicy.GATHER_ONCE)
+        self.assertEqual(testee.tcp_candidates_enabled, True)
+        self.assertEqual(testee.bundle_required, False)
 
     def test_create__ice_servers__should_set_the_attributes(self):
         testee = webrtc.WebrtcConfiguration.create([webrtc.IceServer('url1')])
 
         self.assertEqual(len(testee.ice_servers), 1)
         self.assertEqual(testee.ice_servers[0].urls, ['url1'])
+
+    def test_create__all__should_set_the_attributes(self):
+        testee = webrtc.WebrtcConfiguration.create([webrtc.IceServer('url1')],
+                                                   webrtc.IceCandidateNetworkPolicy.LOW_COST,
+                                                   webrtc.IceGatheringPolicy.GATHER_CONTINUALLY,
+                                                   False, True)
+
+        self.assertEqual(len(testee.ice_servers), 1)
+        self.assertEqual(testee.candidate_network_policy, webrtc.IceCandidateNetworkPolicy.LOW_COST)
+        self.assertEqual(testee.gathering_policy, webrtc.IceGatheringPolicy.GATHER_CONTINUALLY)
+        self.assertEqual(testee.tcp_candidates_enabled, False)
+        self.assertEqual(testee.bundle_required, True)
+
+    def test_create_for_local_network__should_set_the_attributes(self):
+        testee = webrtc.WebrtcConfiguration.create_for_local_network()
+
+        self.assertEqual(testee.ice_servers, [])
+        self.assertEqual(testee.tcp_candidates_enabled, False)
+        self.assertEqual(testee.bundle_required, True)
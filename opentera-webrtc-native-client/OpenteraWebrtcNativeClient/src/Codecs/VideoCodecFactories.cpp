@@ -18,6 +18,7 @@
 #include <api/video_codecs/video_decoder.h>
 #include <api/video_codecs/video_encoder.h>
 #include <media/base/media_constants.h>
+#include <modules/video_coding/include/video_error_codes.h>
 
 #include <unordered_map>
 #include <algorithm>
@@ -140,6 +141,90 @@ unique_ptr<webrtc::VideoEncoder>
 }
 
 
+PassthroughVideoDecoder::PassthroughVideoDecoder() : m_hasReceivedKeyFrame(false) {}
+
+bool PassthroughVideoDecoder::Configure(const Settings& settings)
+{
+    m_hasReceivedKeyFrame = false;
+    return true;
+}
+
+int32_t PassthroughVideoDecoder::Decode(const webrtc::EncodedImage& inputImage, bool missingFrames, int64_t renderTimeMs)
+{
+    if (inputImage._frameType == webrtc::VideoFrameType::kVideoFrameKey)
+    {
+        m_hasReceivedKeyFrame = true;
+    }
+    else if (missingFrames)
+    {
+        m_hasReceivedKeyFrame = false;
+    }
+
+    return m_hasReceivedKeyFrame ? WEBRTC_VIDEO_CODEC_OK : WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME;
+}
+
+int32_t PassthroughVideoDecoder::RegisterDecodeCompleteCallback(webrtc::DecodedImageCallback* callback)
+{
+    return WEBRTC_VIDEO_CODEC_OK;
+}
+
+int32_t PassthroughVideoDecoder::Release()
+{
+    m_hasReceivedKeyFrame = false;
+    return WEBRTC_VIDEO_CODEC_OK;
+}
+
+webrtc::VideoDecoder::DecoderInfo PassthroughVideoDecoder::GetDecoderInfo() const
+{
+    DecoderInfo info;
+    info.implementation_name = ImplementationName();
+    info.is_hardware_accelerated = false;
+    return info;
+}
+
+const char* PassthroughVideoDecoder::ImplementationName() const
+{
+    return "OpenteraPassthrough";
+}
+
+
+PassthroughVideoDecoderFactory::PassthroughVideoDecoderFactory(unique_ptr<webrtc::VideoDecoderFactory> factory)
+    : m_factory(move(factory))
+{
+}
+
+vector<webrtc::SdpVideoFormat> PassthroughVideoDecoderFactory::GetSupportedFormats() const
+{
+    return m_factory->GetSupportedFormats();
+}
+
+webrtc::VideoDecoderFactory::CodecSupport
+    PassthroughVideoDecoderFactory::QueryCodecSupport(const webrtc::SdpVideoFormat& format, bool referenceScaling) const
+{
+    return m_factory->QueryCodecSupport(format, referenceScaling);
+}
+
+unique_ptr<webrtc::VideoDecoder>
+    PassthroughVideoDecoderFactory::Create(const webrtc::Environment& env, const webrtc::SdpVideoFormat& format)
+{
+    return make_unique<PassthroughVideoDecoder>();
+}
+
+static unique_ptr<webrtc::VideoDecoderFactory> wrapVideoDecoderFactory(
+    unique_ptr<webrtc::VideoDecoderFactory> factory,
+    const VideoStreamConfiguration& configuration)
+{
+    unique_ptr<webrtc::VideoDecoderFactory> forcedCodecFactory =
+        make_unique<ForcedCodecVideoDecoderFactory>(move(factory), configuration.forcedCodecs());
+
+    if (configuration.receiveEncodedVideoOnly())
+    {
+        return make_unique<PassthroughVideoDecoderFactory>(move(forcedCodecFactory));
+    }
+    return forcedCodecFactory;
+}
+
+
 #ifdef USE_GSTREAMER
 
 unique_ptr<webrtc::VideoDecoderFactory>
@@ -149,9 +234,7 @@ unique_ptr<webrtc::VideoDecoderFactory>
         configuration.forceGStreamerHardwareAcceleration(),
         configuration.useGStreamerSoftwareEncoderDecoder());
 
-    return make_unique<ForcedCodecVideoDecoderFactory>(
-        move(gstreamerVideoDecoderFactory),
-        configuration.forcedCodecs());
+    return wrapVideoDecoderFactory(move(gstreamerVideoDecoderFactory), configuration);
 }
 
 unique_ptr<webrtc::VideoEncoderFactory>
@@ -176,9 +259,7 @@ using BuiltinVideoDecoderFactory = webrtc::VideoDecoderFactoryTemplate<
 unique_ptr<webrtc::VideoDecoderFactory>
     opentera::createVideoDecoderFactory(const VideoStreamConfiguration& configuration)
 {
-    return make_unique<ForcedCodecVideoDecoderFactory>(
-        make_unique<BuiltinVideoDecoderFactory>(),
-        configuration.forcedCodecs());
+    return wrapVideoDecoderFactory(make_unique<BuiltinVideoDecoderFactory>(), configuration);
 }
 
 using BuiltinVideoEncoderFactory = webrtc::VideoEncoderFactoryTemplate<
@@ -0,0 +1,41 @@
+#include <OpenteraWebrtcNativeClient/Configurations/NamedDataChannelConfiguration.h>
+
+using namespace opentera;
+using namespace std;
+
+static webrtc::Priority toWebrtcPriority(DataChannelPriority priority)
+{
+    switch (priority)
+    {
+        case DataChannelPriority::VeryLow:
+            return webrtc::Priority::kVeryLow;
+        case DataChannelPriority::Low:
+            return webrtc::Priority::kLow;
+        case DataChannelPriority::High:
+            return webrtc::Priority::kHigh;
+        case DataChannelPriority::Medium:
+        default:
+            return webrtc::Priority::kMedium;
+    }
+}
+
+NamedDataChannelConfiguration::NamedDataChannelConfiguration(
+    string&& label,
+    DataChannelConfiguration&& dataChannelConfiguration,
+    DataChannelPriority priority)
+    : m_label(move(label)),
+      m_dataChannelConfiguration(move(dataChannelConfiguration)),
+      m_priority(priority)
+{
+}
+
+/**
+ * Converts a NamedDataChannelConfiguration to a webrtc::DataChannelInit.
+ * @return The converted webrtc::DataChannelInit
+ */
+NamedDataChannelConfiguration::operator webrtc::DataChannelInit() const
+{
+    auto configuration = static_cast<webrtc::DataChannelInit>(m_dataChannelConfiguration);
+    configuration.priority = toWebrtcPriority(m_priority);
+    return configuration;
+}
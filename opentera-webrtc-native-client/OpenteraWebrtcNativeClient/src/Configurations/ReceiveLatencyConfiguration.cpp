@@ -0,0 +1,9 @@
+#include <OpenteraWebrtcNativeClient/Configurations/ReceiveLatencyConfiguration.h>
+
+using namespace opentera;
+using namespace std;
+
+ReceiveLatencyConfiguration::ReceiveLatencyConfiguration(optional<chrono::milliseconds> jitterBufferMinimumDelay)
+    : m_jitterBufferMinimumDelay(jitterBufferMinimumDelay)
+{
+}
@@ -0,0 +1,16 @@
+#include <OpenteraWebrtcNativeClient/Configurations/VideoFreezeWatchdogConfiguration.h>
+
+using namespace opentera;
+using namespace std;
+
+VideoFreezeWatchdogConfiguration::VideoFreezeWatchdogConfiguration(
+    chrono::milliseconds frozenTimeout,
+    chrono::milliseconds keyFrameRequestInterval,
+    size_t keyFrameRequestCount,
+    chrono::milliseconds iceRestartTimeout)
+    : m_frozenTimeout(frozenTimeout),
+      m_keyFrameRequestInterval(keyFrameRequestInterval),
+      m_keyFrameRequestCount(keyFrameRequestCount),
+      m_iceRestartTimeout(iceRestartTimeout)
+{
+}
@@ -26,9 +26,11 @@ absl::optional<VideoStreamCodec> opentera::stringToVideoStreamCodec(string_view
 VideoStreamConfiguration::VideoStreamConfiguration(
     unordered_set<VideoStreamCodec> forcedCodecs,
     bool forceGStreamerHardwareAcceleration,
-    bool useGStreamerSoftwareEncoderDecoder)
+    bool useGStreamerSoftwareEncoderDecoder,
+    bool receiveEncodedVideoOnly)
     : m_forcedCodecs(move(forcedCodecs)),
       m_forceGStreamerHardwareAcceleration(forceGStreamerHardwareAcceleration),
-      m_useGStreamerSoftwareEncoderDecoder(useGStreamerSoftwareEncoderDecoder)
+      m_useGStreamerSoftwareEncoderDecoder(useGStreamerSoftwareEncoderDecoder),
+      m_receiveEncodedVideoOnly(receiveEncodedVideoOnly)
 {
 }
@@ -3,7 +3,19 @@
 using namespace opentera;
 using namespace std;
 
-WebrtcConfiguration::WebrtcConfiguration(vector<IceServer>&& iceServers) : m_iceServers(move(iceServers)) {}
+WebrtcConfiguration::WebrtcConfiguration(
+    vector<IceServer>&& iceServers,
+    IceCandidateNetworkPolicy candidateNetworkPolicy,
+    IceGatheringPolicy gatheringPolicy,
+    bool tcpCandidatesEnabled,
+    bool bundleRequired)
+    : m_iceServers(move(iceServers)),
+      m_candidateNetworkPolicy(candidateNetworkPolicy),
+      m_gatheringPolicy(gatheringPolicy),
+      m_tcpCandidatesEnabled(tcpCandidatesEnabled),
+      m_bundleRequired(bundleRequired)
+{
+}
 
 /**
  * Converts a AudioSourceConfiguration to a
@@ -20,5 +32,35 @@ WebrtcConfiguration::operator webrtc::PeerConnectionInterface::RTCConfiguration(
 
     configuration.sdp_semantics = webrtc::SdpSemantics::kUnifiedPlan;
 
+    switch (m_candidateNetworkPolicy)
+    {
+        case IceCandidateNetworkPolicy::All:
+            configuration.candidate_network_policy = webrtc::PeerConnectionInterface::kCandidateNetworkPolicyAll;
+            break;
+        case IceCandidateNetworkPolicy::LowCost:
+            configuration.candidate_network_policy = webrtc::PeerConnectionInterface::kCandidateNetworkPolicyLowCost;
+            break;
+    }
+
+    switch (m_gatheringPolicy)
+    {
+        case IceGatheringPolicy::GatherOnce:
+            configuration.continual_gathering_policy = webrtc::PeerConnectionInterface::GATHER_ONCE;
+            break;
+        case IceGatheringPolicy::GatherContinually:
+            configuration.continual_gathering_policy = webrtc::PeerConnectionInterface::GATHER_CONTINUALLY;
+            break;
+    }
+
+    configuration.tcp_candidate_policy = m_tcpCandidatesEnabled
+                                             ? webrtc::PeerConnectionInterface::kTcpCandidatePolicyEnabled
+                                             : webrtc::PeerConnectionInterface::kTcpCandidatePolicyDisabled;
+
+    if (m_bundleRequired)
+    {
+        configuration.bundle_policy = webrtc::PeerConnectionInterface::kBundlePolicyMaxBundle;
+        configuration.rtcp_mux_policy = webrtc::PeerConnectionInterface::kRtcpMuxPolicyRequire;
+    }
+
     return configuration;
 }
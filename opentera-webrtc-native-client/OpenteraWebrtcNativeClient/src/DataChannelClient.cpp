@@ -4,6 +4,25 @@
 using namespace opentera;
 using namespace std;
 
+// Compresses the message once per compressor, only for the peers that negotiated the compression
+static const webrtc::DataBuffer& compressForPeer(
+    const shared_ptr<DataChannelCompressor>& peerCompressor,
+    const webrtc::DataBuffer& buffer,
+    map<DataChannelCompressor*, webrtc::DataBuffer>& compressedBuffers)
+{
+    if (!peerCompressor)
+    {
+        return buffer;
+    }
+
+    auto it = compressedBuffers.find(peerCompressor.get());
+    if (it == compressedBuffers.end())
+    {
+        it = compressedBuffers.emplace(peerCompressor.get(), peerCompressor->compress(buffer)).first;
+    }
+    return it->second;
+}
+
 /**
  * @brief Creates a data channel client with the specified configurations.
  *
@@ -15,16 +34,222 @@ DataChannelClient::DataChannelClient(
     SignalingServerConfiguration signalingServerConfiguration,
     WebrtcConfiguration webrtcConfiguration,
     DataChannelConfiguration dataChannelConfiguration)
+    : DataChannelClient(
+          move(signalingServerConfiguration),
+          move(webrtcConfiguration),
+          move(dataChannelConfiguration),
+          {})
+{
+}
+
+/**
+ * @brief Creates a data channel client that opens additional named data channels with each peer.
+ *
+ * The main data channel is named after the room and its opening and closing drive the client connection. The named
+ * data channels have their own reliability, priority and send queue, so lossy high-rate messages do not delay the
+ * reliable messages of another channel. The peers must use the same named data channel configurations.
+ *
+ * @param signalingServerConfiguration The signaling server configuration
+ * @param webrtcConfiguration The WebRTC configuration
+ * @param dataChannelConfiguration The main data channel configuration
+ * @param namedDataChannelConfigurations The named data channel configurations
+ */
+DataChannelClient::DataChannelClient(
+    SignalingServerConfiguration signalingServerConfiguration,
+    WebrtcConfiguration webrtcConfiguration,
+    DataChannelConfiguration dataChannelConfiguration,
+    vector<NamedDataChannelConfiguration> namedDataChannelConfigurations)
     : WebrtcClient(move(signalingServerConfiguration), move(webrtcConfiguration), VideoStreamConfiguration::create()),
-      m_dataChannelConfiguration(move(dataChannelConfiguration))
+      m_dataChannelConfiguration(move(dataChannelConfiguration)),
+      m_namedDataChannelConfigurations(move(namedDataChannelConfigurations)),
+      m_isChunkedMessageEnabled(false),
+      m_dataChannelMessageStreams(make_shared<BoundedStreamGroup<ReceivedDataChannelMessage>>())
+{
+}
+
+DataChannelClient::~DataChannelClient()
+{
+    m_dataChannelMessageStreams->closeAll();
+}
+
+/**
+ * @brief Sends a message to the specified clients without copying its payload.
+ *
+ * The payload is shared by the data channels of all the specified clients. Build it in place with
+ * rtc::CopyOnWriteBuffer(size) and MutableData(), or adopt an existing rtc::Buffer by moving it into an
+ * rtc::CopyOnWriteBuffer. See the binary sendTo overload for the priority and the completion callback. The message
+ * is still sent to the other clients when a data channel is not open.
+ *
+ * @param buffer The message
+ * @param ids The client ids
+ * @param priority The priority
+ * @param onComplete The completion callback, it can be null
+ * @return true if the data channels of all the specified clients are open and the message is sent or queued
+ */
+bool DataChannelClient::sendTo(
+    const webrtc::DataBuffer& buffer,
+    const vector<string>& ids,
+    DataChannelSendPriority priority,
+    const function<void(const Client&, bool)>& onComplete)
+{
+    return callSync(
+        getInternalClientThread(),
+        [&]()
+        {
+            map<DataChannelCompressor*, webrtc::DataBuffer> compressedBuffers;
+            bool ok = true;
+            for (const auto& id : ids)
+            {
+                auto it = m_peerConnectionHandlersById.find(id);
+                if (it != m_peerConnectionHandlersById.end())
+                {
+                    ok = send(*it->second, buffer, compressedBuffers, priority, onComplete) && ok;
+                }
+            }
+            return ok;
+        });
+}
+
+/**
+ * @brief Sends a message to all clients without copying its payload.
+ *
+ * The payload is shared by the data channels of all clients. See sendTo for the payload, the priority and the
+ * completion callback.
+ *
+ * @param buffer The message
+ * @param priority The priority
+ * @param onComplete The completion callback, it can be null
+ * @return true if the data channels of all clients are open and the message is sent or queued
+ */
+bool DataChannelClient::sendToAll(
+    const webrtc::DataBuffer& buffer,
+    DataChannelSendPriority priority,
+    const function<void(const Client&, bool)>& onComplete)
+{
+    return callSync(
+        getInternalClientThread(),
+        [&]()
+        {
+            map<DataChannelCompressor*, webrtc::DataBuffer> compressedBuffers;
+            bool ok = true;
+            for (auto& pair : m_peerConnectionHandlersById)
+            {
+                ok = send(*pair.second, buffer, compressedBuffers, priority, onComplete) && ok;
+            }
+            return ok;
+        });
+}
+
+/**
+ * @brief Sends a message on a named data channel to the specified clients.
+ *
+ * The message is queued by the send queue of the named data channel only. See the binary sendTo overload for the
+ * priority and the completion callback. The message is still sent to the other clients when a client has no open
+ * data channel with this label.
+ *
+ * @param label The data channel label
+ * @param buffer The message
+ * @param ids The client ids
+ * @param priority The priority
+ * @param onComplete The completion callback, it can be null
+ * @return true if the data channels with this label of all the specified clients are open and the message is sent
+ * or queued, false if a client has no data channel with this label
+ */
+bool DataChannelClient::sendOnChannelTo(
+    const string& label,
+    const webrtc::DataBuffer& buffer,
+    const vector<string>& ids,
+    DataChannelSendPriority priority,
+    const function<void(const Client&, bool)>& onComplete)
+{
+    return callSync(
+        getInternalClientThread(),
+        [&]()
+        {
+            map<DataChannelCompressor*, webrtc::DataBuffer> compressedBuffers;
+            bool ok = true;
+            for (const auto& id : ids)
+            {
+                auto it = m_peerConnectionHandlersById.find(id);
+                if (it != m_peerConnectionHandlersById.end())
+                {
+                    ok = sendOnChannel(*it->second, label, buffer, compressedBuffers, priority, onComplete) && ok;
+                }
+            }
+            return ok;
+        });
+}
+
+/**
+ * @brief Sends a message on a named data channel to all clients.
+ *
+ * See sendOnChannelTo for the priority and the completion callback.
+ *
+ * @param label The data channel label
+ * @param buffer The message
+ * @param priority The priority
+ * @param onComplete The completion callback, it can be null
+ * @return true if the data channels with this label of all clients are open and the message is sent or queued,
+ * false if a client has no data channel with this label
+ */
+bool DataChannelClient::sendOnChannelToAll(
+    const string& label,
+    const webrtc::DataBuffer& buffer,
+    DataChannelSendPriority priority,
+    const function<void(const Client&, bool)>& onComplete)
 {
+    return callSync(
+        getInternalClientThread(),
+        [&]()
+        {
+            map<DataChannelCompressor*, webrtc::DataBuffer> compressedBuffers;
+            bool ok = true;
+            for (auto& pair : m_peerConnectionHandlersById)
+            {
+                ok = sendOnChannel(*pair.second, label, buffer, compressedBuffers, priority, onComplete) && ok;
+            }
+            return ok;
+        });
 }
 
-bool DataChannelClient::sendTo(const webrtc::DataBuffer& buffer, const vector<string>& ids)
+/**
+ * @brief Sends a message of any size to the specified clients in chunks.
+ *
+ * The message is split in chunks no larger than the negotiated max message size of the data channel. The chunks
+ * of the pending messages are interleaved and the other messages are sent between them, so a large message does
+ * not block the control messages. The receiving clients must enable the chunked messages
+ * (setChunkedMessageEnabled) and the data channel must be reliable.
+ *
+ * The callbacks are called from the internal client thread once per chunk and once per client. The callbacks
+ * should not block. The message is still sent to the other clients when a data channel is not open.
+ *
+ * @parblock
+ * Progress callback parameters:
+ * - client: The client the message is sent to
+ * - progress: The progress of the message, the transferred bytes are the bytes accepted by the data channel
+ * @endparblock
+ *
+ * @parblock
+ * Completion callback parameters:
+ * - client: The client the message is sent to
+ * - sent: true if the data channel accepted all the chunks, false if it failed or the data channel closed
+ * @endparblock
+ *
+ * @param buffer The message
+ * @param ids The client ids
+ * @param onProgress The progress callback, it can be null
+ * @param onComplete The completion callback, it can be null
+ * @return true if the message is pending for all the specified clients
+ */
+bool DataChannelClient::sendChunkedTo(
+    const webrtc::DataBuffer& buffer,
+    const vector<string>& ids,
+    const function<void(const Client&, const DataChannelTransferProgress&)>& onProgress,
+    const function<void(const Client&, bool)>& onComplete)
 {
     return callSync(
         getInternalClientThread(),
-        [this, buffer, ids]()
+        [&]()
         {
             bool ok = true;
             for (const auto& id : ids)
@@ -32,28 +257,125 @@ bool DataChannelClient::sendTo(const webrtc::DataBuffer& buffer, const vector<st
                 auto it = m_peerConnectionHandlersById.find(id);
                 if (it != m_peerConnectionHandlersById.end())
                 {
-                    ok = ok && dynamic_cast<DataChannelPeerConnectionHandler*>(it->second.get())->send(buffer);
+                    ok = sendChunked(*it->second, buffer, onProgress, onComplete) && ok;
                 }
             }
             return ok;
         });
 }
 
-bool DataChannelClient::sendToAll(const webrtc::DataBuffer& buffer)
+/**
+ * @brief Sends a message of any size to all clients in chunks.
+ *
+ * See sendChunkedTo for the chunks and the callbacks.
+ *
+ * @param buffer The message
+ * @param onProgress The progress callback, it can be null
+ * @param onComplete The completion callback, it can be null
+ * @return true if the message is pending for all clients
+ */
+bool DataChannelClient::sendChunkedToAll(
+    const webrtc::DataBuffer& buffer,
+    const function<void(const Client&, const DataChannelTransferProgress&)>& onProgress,
+    const function<void(const Client&, bool)>& onComplete)
 {
     return callSync(
         getInternalClientThread(),
-        [this, buffer]()
+        [&]()
         {
             bool ok = true;
             for (auto& pair : m_peerConnectionHandlersById)
             {
-                ok = ok && dynamic_cast<DataChannelPeerConnectionHandler*>(pair.second.get())->send(buffer);
+                ok = sendChunked(*pair.second, buffer, onProgress, onComplete) && ok;
             }
             return ok;
         });
 }
 
+bool DataChannelClient::send(
+    PeerConnectionHandler& handler,
+    const webrtc::DataBuffer& buffer,
+    map<DataChannelCompressor*, webrtc::DataBuffer>& compressedBuffers,
+    DataChannelSendPriority priority,
+    const function<void(const Client&, bool)>& onComplete)
+{
+    function<void(const Client&, bool)> onHandlerComplete;
+    if (onComplete)
+    {
+        onHandlerComplete = [this, onComplete](const Client& client, bool sent)
+        { invokeIfCallable(onComplete, client, sent); };
+    }
+    auto& dataChannelHandler = dynamic_cast<DataChannelPeerConnectionHandler&>(handler);
+    return dataChannelHandler.send(
+        compressForPeer(dataChannelHandler.peerCompressor(), buffer, compressedBuffers),
+        priority,
+        move(onHandlerComplete));
+}
+
+bool DataChannelClient::sendOnChannel(
+    PeerConnectionHandler& handler,
+    const string& label,
+    const webrtc::DataBuffer& buffer,
+    map<DataChannelCompressor*, webrtc::DataBuffer>& compressedBuffers,
+    DataChannelSendPriority priority,
+    const function<void(const Client&, bool)>& onComplete)
+{
+    function<void(const Client&, bool)> onHandlerComplete;
+    if (onComplete)
+    {
+        onHandlerComplete = [this, onComplete](const Client& client, bool sent)
+        { invokeIfCallable(onComplete, client, sent); };
+    }
+    auto& dataChannelHandler = dynamic_cast<DataChannelPeerConnectionHandler&>(handler);
+    return dataChannelHandler.send(
+        label,
+        compressForPeer(dataChannelHandler.peerCompressor(label), buffer, compressedBuffers),
+        priority,
+        move(onHandlerComplete));
+}
+
+bool DataChannelClient::sendChunked(
+    PeerConnectionHandler& handler,
+    const webrtc::DataBuffer& buffer,
+    const function<void(const Client&, const DataChannelTransferProgress&)>& onProgress,
+    const function<void(const Client&, bool)>& onComplete)
+{
+    function<void(const Client&, const DataChannelTransferProgress&)> onHandlerProgress;
+    if (onProgress)
+    {
+        onHandlerProgress = [this, onProgress](const Client& client, const DataChannelTransferProgress& progress)
+        { invokeIfCallable(onProgress, client, progress); };
+    }
+    function<void(const Client&, bool)> onHandlerComplete;
+    if (onComplete)
+    {
+        onHandlerComplete = [this, onComplete](const Client& client, bool sent)
+        { invokeIfCallable(onComplete, client, sent); };
+    }
+    return dynamic_cast<DataChannelPeerConnectionHandler&>(handler).sendChunked(
+        buffer,
+        move(onHandlerProgress),
+        move(onHandlerComplete));
+}
+
+/**
+ * @brief Creates a stream of the messages received on the main data channel.
+ *
+ * The messages are added to the stream from a WebRTC thread, in addition to the message callbacks. The consumer pulls
+ * them with next, next with a timeout or tryNext, and several streams can be handled by one thread with their
+ * availability callbacks. The stream is closed when the client is destroyed, and it stops receiving messages when
+ * it is released.
+ *
+ * @param capacity The maximum number of messages waiting for the consumer
+ * @param dropPolicy The message that is dropped when the stream is full
+ * @return The stream
+ */
+shared_ptr<DataChannelMessageStream>
+    DataChannelClient::createDataChannelMessageStream(size_t capacity, StreamDropPolicy dropPolicy)
+{
+    return m_dataChannelMessageStreams->create(capacity, dropPolicy);
+}
+
 unique_ptr<PeerConnectionHandler>
     DataChannelClient::createPeerConnectionHandler(const string& id, const Client& peerClient, bool isCaller)
 {
@@ -65,8 +387,10 @@ unique_ptr<PeerConnectionHandler>
     };
     auto onDataChannelError = [this](const Client& client, const string& error)
     { invokeIfCallable(m_onDataChannelError, client, error); };
-    auto onDataChannelMessageBinary = [this](const Client& client, const webrtc::DataBuffer& buffer)
+    auto onDataChannelMessageBinary =
+        [this, streams = m_dataChannelMessageStreams](const Client& client, const webrtc::DataBuffer& buffer)
     {
+        streams->push(ReceivedDataChannelMessage{client, buffer});
         function<void()> callback = [this, client, buffer]()
         {
             if (m_onDataChannelMessageBinary)
@@ -76,8 +400,35 @@ unique_ptr<PeerConnectionHandler>
         };
         invokeIfCallable(callback);
     };
-    auto onDataChannelMessageString = [this](const Client& client, const string& message)
-    { invokeIfCallable(m_onDataChannelMessageString, client, message); };
+    auto onDataChannelMessageString =
+        [this, streams = m_dataChannelMessageStreams](const Client& client, const string& message)
+    {
+        streams->push(ReceivedDataChannelMessage{client, webrtc::DataBuffer(message)});
+        invokeIfCallable(m_onDataChannelMessageString, client, message);
+    };
+    auto onDataChannelReceiveProgress = [this](const Client& client, const DataChannelTransferProgress& progress)
+    { invokeIfCallable(m_onDataChannelReceiveProgress, client, progress); };
+
+    auto onNamedDataChannelOpen = [this](const Client& client, const string& label)
+    { invokeIfCallable(m_onNamedDataChannelOpened, client, label); };
+    auto onNamedDataChannelClosed = [this](const Client& client, const string& label)
+    { invokeIfCallable(m_onNamedDataChannelClosed, client, label); };
+    auto onNamedDataChannelError = [this](const Client& client, const string& label, const string& error)
+    { invokeIfCallable(m_onNamedDataChannelError, client, label, error); };
+    auto onNamedDataChannelMessageBinary =
+        [this](const Client& client, const string& label, const webrtc::DataBuffer& buffer)
+    {
+        function<void()> callback = [this, client, label, buffer]()
+        {
+            if (m_onNamedDataChannelMessageBinary)
+            {
+                m_onNamedDataChannelMessageBinary(client, label, buffer.data.data<uint8_t>(), buffer.size());
+            }
+        };
+        invokeIfCallable(callback);
+    };
+    auto onNamedDataChannelMessageString = [this](const Client& client, const string& label, const string& message)
+    { invokeIfCallable(m_onNamedDataChannelMessageString, client, label, message); };
 
     return make_unique<DataChannelPeerConnectionHandler>(
         id,
@@ -93,5 +444,15 @@ unique_ptr<PeerConnectionHandler>
         onDataChannelClosed,
         onDataChannelError,
         onDataChannelMessageBinary,
-        onDataChannelMessageString);
+        onDataChannelMessageString,
+        m_isChunkedMessageEnabled,
+        onDataChannelReceiveProgress,
+        m_namedDataChannelConfigurations,
+        onNamedDataChannelOpen,
+        onNamedDataChannelClosed,
+        onNamedDataChannelError,
+        onNamedDataChannelMessageBinary,
+        onNamedDataChannelMessageString,
+        m_dataChannelCompressor,
+        m_namedDataChannelCompressors);
 }
@@ -1,5 +1,9 @@
 #include <OpenteraWebrtcNativeClient/Handlers/DataChannelPeerConnectionHandler.h>
 
+#include <api/sctp_transport_interface.h>
+
+#include <algorithm>
+
 using namespace opentera;
 using namespace std;
 
@@ -17,7 +21,17 @@ DataChannelPeerConnectionHandler::DataChannelPeerConnectionHandler(
     function<void(const Client&)> onDataChannelClosed,
     function<void(const Client&, const string&)> onDataChannelError,
     function<void(const Client&, const webrtc::DataBuffer& buffer)> onDataChannelMessageBinary,
-    function<void(const Client&, const string&)> onDataChannelMessageString)
+    function<void(const Client&, const string&)> onDataChannelMessageString,
+    bool isChunkedMessageEnabled,
+    function<void(const Client&, const DataChannelTransferProgress&)> onDataChannelReceiveProgress,
+    vector<NamedDataChannelConfiguration> namedDataChannelConfigurations,
+    function<void(const Client&, const string&)> onNamedDataChannelOpen,
+    function<void(const Client&, const string&)> onNamedDataChannelClosed,
+    function<void(const Client&, const string&, const string&)> onNamedDataChannelError,
+    function<void(const Client&, const string&, const webrtc::DataBuffer&)> onNamedDataChannelMessageBinary,
+    function<void(const Client&, const string&, const string&)> onNamedDataChannelMessageString,
+    shared_ptr<DataChannelCompressor> dataChannelCompressor,
+    map<string, shared_ptr<DataChannelCompressor>> namedDataChannelCompressors)
     : PeerConnectionHandler(
           move(id),
           move(peerClient),
@@ -33,15 +47,37 @@ DataChannelPeerConnectionHandler::DataChannelPeerConnectionHandler(
       m_onDataChannelError(move(onDataChannelError)),
       m_onDataChannelMessageBinary(move(onDataChannelMessageBinary)),
       m_onDataChannelMessageString(move(onDataChannelMessageString)),
+      m_isChunkedMessageEnabled(isChunkedMessageEnabled),
+      m_onDataChannelReceiveProgress(move(onDataChannelReceiveProgress)),
+      m_namedDataChannelConfigurations(move(namedDataChannelConfigurations)),
+      m_onNamedDataChannelOpen(move(onNamedDataChannelOpen)),
+      m_onNamedDataChannelClosed(move(onNamedDataChannelClosed)),
+      m_onNamedDataChannelError(move(onNamedDataChannelError)),
+      m_onNamedDataChannelMessageBinary(move(onNamedDataChannelMessageBinary)),
+      m_onNamedDataChannelMessageString(move(onNamedDataChannelMessageString)),
+      m_dataChannelCompressor(move(dataChannelCompressor)),
+      m_namedDataChannelCompressors(move(namedDataChannelCompressors)),
+      m_isPeerCompressionEnabled(false),
       m_onDataChannelClosedCalled(true)
 {
 }
 
 DataChannelPeerConnectionHandler::~DataChannelPeerConnectionHandler()
 {
+    // The handlers close their data channel, which blocks on the signaling thread, so they are destroyed unlocked
+    map<string, shared_ptr<NamedDataChannelHandler>> namedDataChannelHandlers;
+    {
+        lock_guard<mutex> lock(m_namedDataChannelHandlersMutex);
+        swap(namedDataChannelHandlers, m_namedDataChannelHandlers);
+    }
+    namedDataChannelHandlers.clear();
+
     if (m_dataChannel)
     {
         m_dataChannel->UnregisterObserver();
+        // The chunk sender is cancelled first, so the queue clearing does not send its next chunks
+        m_chunkSender->cancel();
+        m_sendQueue->clear();
         m_dataChannel->Close();
 
         if (!m_onDataChannelClosedCalled)
@@ -58,38 +94,155 @@ void DataChannelPeerConnectionHandler::setPeerConnection(
     PeerConnectionHandler::setPeerConnection(peerConnection);
     if (m_isCaller)
     {
+        // The compression is advertised in the protocol, and it is enabled when the peer acknowledges it
         auto configuration = static_cast<webrtc::DataChannelInit>(m_dataChannelConfiguration);
+        if (m_dataChannelCompressor)
+        {
+            configuration.protocol = m_dataChannelCompressor->advertise(configuration.protocol);
+        }
         auto dataChannelOrError = m_peerConnection->CreateDataChannelOrError(m_signalingClient.room(), &configuration);
         if (dataChannelOrError.ok())
         {
-            m_dataChannel = dataChannelOrError.MoveValue();
-            m_dataChannel->RegisterObserver(this);
+            setDataChannel(dataChannelOrError.MoveValue());
         }
         else
         {
             m_onError(string("CreateDataChannel failed: ") + dataChannelOrError.error().message());
         }
+
+        for (const auto& namedDataChannelConfiguration : m_namedDataChannelConfigurations)
+        {
+            auto namedConfiguration = static_cast<webrtc::DataChannelInit>(namedDataChannelConfiguration);
+            auto compressorIt = m_namedDataChannelCompressors.find(namedDataChannelConfiguration.label());
+            if (compressorIt != m_namedDataChannelCompressors.end())
+            {
+                namedConfiguration.protocol = compressorIt->second->advertise(namedConfiguration.protocol);
+            }
+            auto namedDataChannelOrError =
+                m_peerConnection->CreateDataChannelOrError(namedDataChannelConfiguration.label(), &namedConfiguration);
+            if (namedDataChannelOrError.ok())
+            {
+                addNamedDataChannel(namedDataChannelOrError.MoveValue());
+            }
+            else
+            {
+                m_onError(string("CreateDataChannel failed: ") + namedDataChannelOrError.error().message());
+            }
+        }
     }
 }
 
-bool DataChannelPeerConnectionHandler::send(const webrtc::DataBuffer& buffer)
+bool DataChannelPeerConnectionHandler::send(
+    const webrtc::DataBuffer& buffer,
+    DataChannelSendPriority priority,
+    function<void(const Client&, bool)> onComplete)
 {
-    if (m_dataChannel)
+    // The messages are only queued while the data channel is open, like webrtc::DataChannelInterface::Send
+    if (!m_dataChannel || m_dataChannel->state() != webrtc::DataChannelInterface::kOpen)
+    {
+        return false;
+    }
+
+    function<void(bool)> onQueueComplete;
+    if (onComplete)
     {
-        return m_dataChannel->Send(buffer);
+        onQueueComplete = [peerClient = m_peerClient, onComplete = move(onComplete)](bool sent)
+        { onComplete(peerClient, sent); };
     }
-    else
+    return m_sendQueue->send(buffer, priority, move(onQueueComplete));
+}
+
+bool DataChannelPeerConnectionHandler::send(
+    const string& label,
+    const webrtc::DataBuffer& buffer,
+    DataChannelSendPriority priority,
+    function<void(const Client&, bool)> onComplete)
+{
+    function<void(bool)> onQueueComplete;
+    if (onComplete)
+    {
+        onQueueComplete = [peerClient = m_peerClient, onComplete = move(onComplete)](bool sent)
+        { onComplete(peerClient, sent); };
+    }
+
+    shared_ptr<NamedDataChannelHandler> handler;
+    {
+        lock_guard<mutex> lock(m_namedDataChannelHandlersMutex);
+        auto it = m_namedDataChannelHandlers.find(label);
+        if (it == m_namedDataChannelHandlers.end())
+        {
+            return false;
+        }
+        handler = it->second;
+    }
+    return handler->send(buffer, priority, move(onQueueComplete));
+}
+
+/**
+ * @brief Returns the compressor of the main data channel if the peer advertised or acknowledged the compression.
+ * @return The compressor of the main data channel, or null if the messages must be sent uncompressed
+ */
+shared_ptr<DataChannelCompressor> DataChannelPeerConnectionHandler::peerCompressor() const
+{
+    return m_isPeerCompressionEnabled ? m_dataChannelCompressor : nullptr;
+}
+
+/**
+ * @brief Returns the compressor of a named data channel if the peer advertised or acknowledged the compression.
+ *
+ * @param label The data channel label
+ * @return The compressor of the named data channel, or null if the messages must be sent uncompressed
+ */
+shared_ptr<DataChannelCompressor> DataChannelPeerConnectionHandler::peerCompressor(const string& label)
+{
+    lock_guard<mutex> lock(m_namedDataChannelHandlersMutex);
+    auto it = m_namedDataChannelHandlers.find(label);
+    return it != m_namedDataChannelHandlers.end() ? it->second->peerCompressor() : nullptr;
+}
+
+bool DataChannelPeerConnectionHandler::sendChunked(
+    const webrtc::DataBuffer& buffer,
+    function<void(const Client&, const DataChannelTransferProgress&)> onProgress,
+    function<void(const Client&, bool)> onComplete)
+{
+    if (!m_dataChannel || m_dataChannel->state() != webrtc::DataChannelInterface::kOpen)
     {
         return false;
     }
+
+    function<void(const DataChannelTransferProgress&)> onSenderProgress;
+    if (onProgress)
+    {
+        onSenderProgress = [peerClient = m_peerClient, onProgress = move(onProgress)](
+                               const DataChannelTransferProgress& progress) { onProgress(peerClient, progress); };
+    }
+    function<void(bool)> onSenderComplete;
+    if (onComplete)
+    {
+        onSenderComplete = [peerClient = m_peerClient, onComplete = move(onComplete)](bool sent)
+        { onComplete(peerClient, sent); };
+    }
+    return m_chunkSender->send(buffer, move(onSenderProgress), move(onSenderComplete));
 }
 
 void DataChannelPeerConnectionHandler::OnDataChannel(rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel)
 {
-    if (!m_isCaller)
+    if (m_isCaller)
+    {
+        return;
+    }
+
+    // The main channel is the first one that is not configured as a named channel, so a peer without named
+    // channels still works.
+    if (!m_dataChannel && !isNamedDataChannelLabel(dataChannel->label()))
+    {
+        m_isPeerCompressionEnabled =
+            m_dataChannelCompressor && m_dataChannelCompressor->isAdvertisedBy(dataChannel->protocol());
+        setDataChannel(move(dataChannel));
+    }
+    else
     {
-        m_dataChannel = dataChannel;
-        m_dataChannel->RegisterObserver(this);
+        addNamedDataChannel(move(dataChannel));
     }
 }
 
@@ -100,6 +253,11 @@ void DataChannelPeerConnectionHandler::OnStateChange()
         switch (m_dataChannel->state())
         {
             case webrtc::DataChannelInterface::kOpen:
+                updateMaxChunkSize();
+                if (!m_isCaller && m_isPeerCompressionEnabled)
+                {
+                    m_sendQueue->send(m_dataChannelCompressor->createAcknowledgement(), DataChannelSendPriority::High);
+                }
                 m_onDataChannelOpen(m_peerClient);
                 m_onDataChannelClosedCalled = false;
                 break;
@@ -108,6 +266,10 @@ void DataChannelPeerConnectionHandler::OnStateChange()
                 {
                     m_onDataChannelError(m_peerClient, m_dataChannel->error().message());
                 }
+                if (m_chunkReassembler)
+                {
+                    m_chunkReassembler->clear();
+                }
                 m_onDataChannelClosed(m_peerClient);
                 m_onDataChannelClosedCalled = true;
                 break;
@@ -119,13 +281,18 @@ void DataChannelPeerConnectionHandler::OnStateChange()
 
 void DataChannelPeerConnectionHandler::OnMessage(const webrtc::DataBuffer& buffer)
 {
-    if (buffer.binary)
+    if (m_chunkReassembler && m_chunkReassembler->handleMessage(buffer))
     {
-        m_onDataChannelMessageBinary(m_peerClient, buffer);
+        return;
     }
-    else if (!buffer.binary)
+    onMessage(buffer);
+}
+
+void DataChannelPeerConnectionHandler::OnBufferedAmountChange(uint64_t sentDataSize)
+{
+    if (m_sendQueue)
     {
-        m_onDataChannelMessageString(m_peerClient, string(buffer.data.data<char>(), buffer.size()));
+        m_sendQueue->onBufferedAmountChange();
     }
 }
 
@@ -143,3 +310,107 @@ void DataChannelPeerConnectionHandler::createAnswer()
 
     PeerConnectionHandler::createAnswer();
 }
+
+void DataChannelPeerConnectionHandler::setDataChannel(rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel)
+{
+    m_dataChannel = move(dataChannel);
+    m_sendQueue = make_unique<DataChannelSendQueue>(m_dataChannel);
+    m_chunkSender = make_unique<DataChannelChunkSender>(
+        [this](const webrtc::DataBuffer& buffer, function<void(bool)> onComplete)
+        { return m_sendQueue->send(buffer, DataChannelSendPriority::Normal, move(onComplete)); });
+    if (m_isChunkedMessageEnabled)
+    {
+        function<void(const DataChannelTransferProgress&)> onProgress;
+        if (m_onDataChannelReceiveProgress)
+        {
+            onProgress = [this](const DataChannelTransferProgress& progress)
+            { m_onDataChannelReceiveProgress(m_peerClient, progress); };
+        }
+        m_chunkReassembler = make_unique<DataChannelChunkReassembler>(
+            [this](const webrtc::DataBuffer& buffer) { onMessage(buffer); },
+            move(onProgress));
+    }
+    m_dataChannel->RegisterObserver(this);
+}
+
+void DataChannelPeerConnectionHandler::addNamedDataChannel(
+    rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel)
+{
+    string label = dataChannel->label();
+    auto compressorIt = m_namedDataChannelCompressors.find(label);
+    auto compressor = compressorIt != m_namedDataChannelCompressors.end() ? compressorIt->second : nullptr;
+    bool isCompressionAdvertisedByPeer =
+        !m_isCaller && compressor && compressor->isAdvertisedBy(dataChannel->protocol());
+    auto handler = make_shared<NamedDataChannelHandler>(
+        move(dataChannel),
+        [this, label]() { m_onNamedDataChannelOpen(m_peerClient, label); },
+        [this, label]() { m_onNamedDataChannelClosed(m_peerClient, label); },
+        [this, label](const string& error) { m_onNamedDataChannelError(m_peerClient, label, error); },
+        [this, label](const webrtc::DataBuffer& buffer)
+        { m_onNamedDataChannelMessageBinary(m_peerClient, label, buffer); },
+        [this, label](const string& message) { m_onNamedDataChannelMessageString(m_peerClient, label, message); },
+        move(compressor),
+        isCompressionAdvertisedByPeer);
+
+    // A replaced handler is destroyed unlocked
+    {
+        lock_guard<mutex> lock(m_namedDataChannelHandlersMutex);
+        swap(m_namedDataChannelHandlers[label], handler);
+    }
+}
+
+bool DataChannelPeerConnectionHandler::isNamedDataChannelLabel(const string& label) const
+{
+    return any_of(
+        m_namedDataChannelConfigurations.begin(),
+        m_namedDataChannelConfigurations.end(),
+        [&label](const NamedDataChannelConfiguration& configuration) { return configuration.label() == label; });
+}
+
+// The chunks stay small, even when the negotiated max message size is larger, so they do not block the other
+// messages for long.
+void DataChannelPeerConnectionHandler::updateMaxChunkSize()
+{
+    auto sctpTransport = m_peerConnection->GetSctpTransport();
+    if (!sctpTransport)
+    {
+        return;
+    }
+
+    auto maxMessageSize = sctpTransport->Information().MaxMessageSize();
+    if (maxMessageSize && *maxMessageSize > 0)
+    {
+        m_chunkSender->setMaxChunkSize(
+            min(static_cast<size_t>(*maxMessageSize), DataChannelChunkSender::DefaultMaxChunkSize));
+    }
+}
+
+void DataChannelPeerConnectionHandler::onMessage(const webrtc::DataBuffer& buffer)
+{
+    optional<webrtc::DataBuffer> decompressed;
+    if (m_dataChannelCompressor)
+    {
+        if (m_dataChannelCompressor->isAcknowledgement(buffer))
+        {
+            m_isPeerCompressionEnabled = true;
+            return;
+        }
+
+        // The invalid compressed messages are dropped and counted by the compressor statistics.
+        decompressed = m_dataChannelCompressor->decompress(buffer);
+        if (!decompressed)
+        {
+            return;
+        }
+    }
+
+    const webrtc::DataBuffer& message = decompressed ? *decompressed : buffer;
+    if (message.binary)
+    {
+        m_onDataChannelMessageBinary(m_peerClient, message);
+    }
+    else if (!message.binary)
+    {
+        m_onDataChannelMessageString(m_peerClient, string(message.data.data<char>(), message.size()));
+    }
+}
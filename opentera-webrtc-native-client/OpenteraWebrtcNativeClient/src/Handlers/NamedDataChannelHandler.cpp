@@ -0,0 +1,123 @@
+#include <OpenteraWebrtcNativeClient/Handlers/NamedDataChannelHandler.h>
+
+using namespace opentera;
+using namespace std;
+
+NamedDataChannelHandler::NamedDataChannelHandler(
+    rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+    function<void()> onOpen,
+    function<void()> onClosed,
+    function<void(const string&)> onError,
+    function<void(const webrtc::DataBuffer&)> onMessageBinary,
+    function<void(const string&)> onMessageString,
+    shared_ptr<DataChannelCompressor> compressor,
+    bool isCompressionAdvertisedByPeer)
+    : m_dataChannel(move(dataChannel)),
+      m_sendQueue(m_dataChannel),
+      m_onOpen(move(onOpen)),
+      m_onClosed(move(onClosed)),
+      m_onError(move(onError)),
+      m_onMessageBinary(move(onMessageBinary)),
+      m_onMessageString(move(onMessageString)),
+      m_compressor(move(compressor)),
+      m_isCompressionAdvertisedByPeer(m_compressor && isCompressionAdvertisedByPeer),
+      m_isPeerCompressionEnabled(m_isCompressionAdvertisedByPeer),
+      m_onClosedCalled(true)
+{
+    m_dataChannel->RegisterObserver(this);
+}
+
+NamedDataChannelHandler::~NamedDataChannelHandler()
+{
+    m_dataChannel->UnregisterObserver();
+    m_sendQueue.clear();
+    m_dataChannel->Close();
+
+    if (!m_onClosedCalled)
+    {
+        m_onClosedCalled = true;
+        m_onClosed();
+    }
+}
+
+string NamedDataChannelHandler::label() const
+{
+    return m_dataChannel->label();
+}
+
+// Returns null until the peer advertised or acknowledged the compression
+shared_ptr<DataChannelCompressor> NamedDataChannelHandler::peerCompressor() const
+{
+    return m_isPeerCompressionEnabled ? m_compressor : nullptr;
+}
+
+bool NamedDataChannelHandler::send(
+    const webrtc::DataBuffer& buffer,
+    DataChannelSendPriority priority,
+    function<void(bool)> onComplete)
+{
+    if (m_dataChannel->state() != webrtc::DataChannelInterface::kOpen)
+    {
+        return false;
+    }
+    return m_sendQueue.send(buffer, priority, move(onComplete));
+}
+
+void NamedDataChannelHandler::OnStateChange()
+{
+    switch (m_dataChannel->state())
+    {
+        case webrtc::DataChannelInterface::kOpen:
+            if (m_isCompressionAdvertisedByPeer)
+            {
+                m_sendQueue.send(m_compressor->createAcknowledgement(), DataChannelSendPriority::High);
+            }
+            m_onOpen();
+            m_onClosedCalled = false;
+            break;
+        case webrtc::DataChannelInterface::kClosed:
+            if (!m_dataChannel->error().ok())
+            {
+                m_onError(m_dataChannel->error().message());
+            }
+            m_onClosed();
+            m_onClosedCalled = true;
+            break;
+        default:
+            break;
+    }
+}
+
+void NamedDataChannelHandler::OnMessage(const webrtc::DataBuffer& buffer)
+{
+    optional<webrtc::DataBuffer> decompressed;
+    if (m_compressor)
+    {
+        if (m_compressor->isAcknowledgement(buffer))
+        {
+            m_isPeerCompressionEnabled = true;
+            return;
+        }
+
+        decompressed = m_compressor->decompress(buffer);
+        if (!decompressed)
+        {
+            return;
+        }
+    }
+
+    const webrtc::DataBuffer& message = decompressed ? *decompressed : buffer;
+    if (message.binary)
+    {
+        m_onMessageBinary(message);
+    }
+    else
+    {
+        m_onMessageString(string(message.data.data<char>(), message.size()));
+    }
+}
+
+void NamedDataChannelHandler::OnBufferedAmountChange(uint64_t sentDataSize)
+{
+    m_sendQueue.onBufferedAmountChange();
+}
@@ -3,6 +3,8 @@
 using namespace opentera;
 using namespace std;
 
+constexpr chrono::milliseconds ReconnectionGracePeriod(2000);
+
 class OnlyFailureSetSessionDescriptionObserver : public webrtc::SetSessionDescriptionObserver
 {
     function<void(const string&)> m_onError;
@@ -59,7 +61,14 @@ PeerConnectionHandler::PeerConnectionHandler(
       m_onClientConnected(move(onClientConnected)),
       m_onClientDisconnected(move(onClientDisconnected)),
       m_onClientConnectionFailed(move(onClientConnectionFailed)),
-      m_onClientDisconnectedCalled(true)
+      m_onClientDisconnectedCalled(true),
+      m_maxIceRestartAttemptCount(0),
+      m_iceRestartTimeout(0),
+      m_iceRestartTimeoutThread(nullptr),
+      m_iceRestartAttemptCount(0),
+      m_isIceRestarting(false),
+      m_isWaitingForReconnection(false),
+      m_iceRestartLifetime(make_shared<bool>(true))
 {
 }
 
@@ -85,6 +94,18 @@ void PeerConnectionHandler::setPeerConnection(const rtc::scoped_refptr<webrtc::P
     m_peerConnection = peerConnection;
 }
 
+// The timeout thread must be the thread that destroys the handler.
+void PeerConnectionHandler::setIceRestartAttempts(
+    size_t maxAttemptCount,
+    chrono::milliseconds timeout,
+    rtc::Thread* timeoutThread)
+{
+    lock_guard<mutex> lock(m_iceRestartMutex);
+    m_maxIceRestartAttemptCount = maxAttemptCount;
+    m_iceRestartTimeout = timeout;
+    m_iceRestartTimeoutThread = timeoutThread;
+}
+
 void PeerConnectionHandler::makePeerCall()
 {
     m_peerConnection->CreateOffer(this, webrtc::PeerConnectionInterface::RTCOfferAnswerOptions());
@@ -133,18 +154,52 @@ void PeerConnectionHandler::receiveIceCandidate(const string& sdpMid, int sdpMLi
     }
 }
 
+// The ICE restart offer is sent by both roles. The session, the tracks, the sinks and the data channels are kept.
+bool PeerConnectionHandler::restartIce()
+{
+    if (!m_peerConnection)
+    {
+        return false;
+    }
+
+    webrtc::PeerConnectionInterface::RTCOfferAnswerOptions options;
+    options.ice_restart = true;
+    m_peerConnection->CreateOffer(this, options);
+    return true;
+}
+
 void PeerConnectionHandler::OnConnectionChange(webrtc::PeerConnectionInterface::PeerConnectionState newState)
 {
     switch (newState)
     {
         case webrtc::PeerConnectionInterface::PeerConnectionState::kConnected:
-            m_onClientConnected(m_peerClient);
-            m_onClientDisconnectedCalled = false;
+            {
+                lock_guard<mutex> lock(m_iceRestartMutex);
+                m_iceRestartAttemptCount = 0;
+                m_isIceRestarting = false;
+                m_isWaitingForReconnection = false;
+            }
+            // A successful ICE restart is not reported, since the client was never reported as disconnected.
+            if (m_onClientDisconnectedCalled)
+            {
+                m_onClientConnected(m_peerClient);
+                m_onClientDisconnectedCalled = false;
+            }
             break;
         case webrtc::PeerConnectionInterface::PeerConnectionState::kFailed:
-            m_onClientConnectionFailed(m_peerClient);
+            if (!restartIceWithTimeout())
+            {
+                m_onClientConnectionFailed(m_peerClient);
+            }
             break;
         case webrtc::PeerConnectionInterface::PeerConnectionState::kDisconnected:
+            if (waitForReconnection())
+            {
+                break;
+            }
+            m_onClientDisconnected(m_peerClient);
+            m_onClientDisconnectedCalled = true;
+            break;
         case webrtc::PeerConnectionInterface::PeerConnectionState::kClosed:
             m_onClientDisconnected(m_peerClient);
             m_onClientDisconnectedCalled = true;
@@ -179,7 +234,8 @@ void PeerConnectionHandler::OnCreateSessionDescriptionObserverSuccess(webrtc::Se
     string sdp;
     desc->ToString(&sdp);
 
-    if (m_isCaller)
+    // The ICE restart offers of the callee are sent like the offers of the caller
+    if (desc->GetType() == webrtc::SdpType::kOffer)
     {
         m_signalingClient.callPeer(m_peerClient.id(), sdp);
     }
@@ -219,6 +275,126 @@ void PeerConnectionHandler::createAnswer()
     m_peerConnection->CreateAnswer(this, webrtc::PeerConnectionInterface::RTCOfferAnswerOptions());
 }
 
+// Returns true if an ICE restart is in progress, so the connection loss must not be reported yet. Every ICE restart
+// goes through this method, so the attempts are counted and a restart is never started while another is in progress.
+bool PeerConnectionHandler::restartIceWithTimeout()
+{
+    size_t attempt;
+    {
+        lock_guard<mutex> lock(m_iceRestartMutex);
+        if (m_isIceRestarting)
+        {
+            return true;
+        }
+        if (m_iceRestartAttemptCount >= m_maxIceRestartAttemptCount || m_iceRestartTimeoutThread == nullptr)
+        {
+            return false;
+        }
+
+        m_iceRestartAttemptCount++;
+        m_isIceRestarting = true;
+        attempt = m_iceRestartAttemptCount;
+
+        m_iceRestartTimeoutThread->PostDelayedTask(
+            [this, attempt, lifetime = weak_ptr<bool>(m_iceRestartLifetime)]()
+            {
+                if (!lifetime.expired())
+                {
+                    onIceRestartTimeout(attempt);
+                }
+            },
+            webrtc::TimeDelta::Millis(m_iceRestartTimeout.count()));
+    }
+
+    if (!restartIce())
+    {
+        lock_guard<mutex> lock(m_iceRestartMutex);
+        m_isIceRestarting = false;
+        return false;
+    }
+    return true;
+}
+
+// The disconnected state is often transient, so ICE is only restarted if the connection does not recover by itself
+// within the grace period. Returns true if the connection loss must not be reported yet.
+bool PeerConnectionHandler::waitForReconnection()
+{
+    lock_guard<mutex> lock(m_iceRestartMutex);
+    if (m_isIceRestarting || m_isWaitingForReconnection)
+    {
+        return true;
+    }
+    if (m_iceRestartAttemptCount >= m_maxIceRestartAttemptCount || m_iceRestartTimeoutThread == nullptr)
+    {
+        return false;
+    }
+
+    m_isWaitingForReconnection = true;
+    m_iceRestartTimeoutThread->PostDelayedTask(
+        [this, lifetime = weak_ptr<bool>(m_iceRestartLifetime)]()
+        {
+            if (!lifetime.expired())
+            {
+                onReconnectionGracePeriodElapsed();
+            }
+        },
+        webrtc::TimeDelta::Millis(ReconnectionGracePeriod.count()));
+    return true;
+}
+
+// Must be called from the ICE restart timeout thread
+void PeerConnectionHandler::onIceRestartTimeout(size_t attempt)
+{
+    {
+        lock_guard<mutex> lock(m_iceRestartMutex);
+        if (!m_isIceRestarting || m_iceRestartAttemptCount != attempt)
+        {
+            return;
+        }
+        m_isIceRestarting = false;
+    }
+
+    // The state does not change when an ICE restart succeeds on a connected transport.
+    if (m_peerConnection->peer_connection_state() ==
+        webrtc::PeerConnectionInterface::PeerConnectionState::kConnected)
+    {
+        lock_guard<mutex> lock(m_iceRestartMutex);
+        m_iceRestartAttemptCount = 0;
+        return;
+    }
+
+    if (!restartIceWithTimeout())
+    {
+        m_onClientConnectionFailed(m_peerClient);
+    }
+}
+
+// Must be called from the ICE restart timeout thread
+void PeerConnectionHandler::onReconnectionGracePeriodElapsed()
+{
+    {
+        lock_guard<mutex> lock(m_iceRestartMutex);
+        if (!m_isWaitingForReconnection)
+        {
+            return;
+        }
+        m_isWaitingForReconnection = false;
+    }
+
+    // The connected and failed states are handled by OnConnectionChange.
+    if (m_peerConnection->peer_connection_state() !=
+        webrtc::PeerConnectionInterface::PeerConnectionState::kDisconnected)
+    {
+        return;
+    }
+
+    if (!restartIceWithTimeout())
+    {
+        m_onClientDisconnected(m_peerClient);
+        m_onClientDisconnectedCalled = true;
+    }
+}
+
 void opentera::setTransceiverDirection(
     const rtc::scoped_refptr<webrtc::RtpTransceiverInterface>& transceiver,
     webrtc::RtpTransceiverDirection direction)
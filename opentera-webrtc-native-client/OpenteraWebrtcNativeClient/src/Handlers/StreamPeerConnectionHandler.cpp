@@ -1,4 +1,7 @@
 #include <OpenteraWebrtcNativeClient/Handlers/StreamPeerConnectionHandler.h>
+#include <OpenteraWebrtcNativeClient/Utils/FunctionTask.h>
+
+#include <rtc_base/time_utils.h>
 
 #include <functional>
 #include <memory>
@@ -9,6 +12,8 @@ using namespace rtc;
 using namespace webrtc;
 using namespace std;
 
+constexpr int64_t VideoFreezeWatchdogCheckIntervalMs = 50;
+
 StreamPeerConnectionHandler::StreamPeerConnectionHandler(
     string id,
     Client peerClient,
@@ -37,17 +42,25 @@ StreamPeerConnectionHandler::StreamPeerConnectionHandler(
           move(onClientDisconnected),
           move(onClientConnectionFailed)),
       m_offerToReceiveAudio(hasOnMixedAudioFrameReceivedCallback || onAudioFrameReceived),
-      m_offerToReceiveVideo(static_cast<bool>(onVideoFrameReceived)),
+      m_offerToReceiveVideo(onVideoFrameReceived || onEncodedVideoFrameReceived),
       m_videoTrack(move(videoTrack)),
       m_audioTrack(move(audioTrack)),
       m_onAddRemoteStream(move(onAddRemoteStream)),
       m_onRemoveRemoteStream(move(onRemoveRemoteStream)),
+      m_receiveLatencyConfiguration(ReceiveLatencyConfiguration::create()),
       m_onDataChannelOpened(onDataChannelOpened)
 {
     if (onVideoFrameReceived)
     {
-        m_videoSink = make_unique<VideoSink>([=](const cv::Mat& bgrImg, uint64_t timestampUs)
-                                             { onVideoFrameReceived(m_peerClient, bgrImg, timestampUs); });
+        m_videoSink = make_unique<VideoSink>(
+            [=](const PooledVideoFrame& frame, uint64_t timestampUs)
+            {
+                if (m_videoFreezeWatchdog != nullptr)
+                {
+                    m_videoFreezeWatchdog->onFrameDecoded(TimeMicros());
+                }
+                onVideoFrameReceived(m_peerClient, frame, timestampUs);
+            });
     }
 
     if (onEncodedVideoFrameReceived)
@@ -93,6 +106,8 @@ StreamPeerConnectionHandler::StreamPeerConnectionHandler(
 
 StreamPeerConnectionHandler::~StreamPeerConnectionHandler()
 {
+    stopVideoFreezeWatchdog();
+
     for (auto& transceiver : m_peerConnection->GetTransceivers())
     {
         transceiver->StopStandard();
@@ -141,6 +156,75 @@ void StreamPeerConnectionHandler::setAllVideoTracksEnabled(bool enabled)
     setAllLocalTracksEnabled(MediaStreamTrackInterface::kVideoKind, enabled);
 }
 
+void StreamPeerConnectionHandler::setVideoSinkTargetSize(int width, int height)
+{
+    if (m_videoSink != nullptr)
+    {
+        m_videoSink->setTargetSize(width, height);
+    }
+}
+
+void StreamPeerConnectionHandler::setVideoSinkFormat(VideoFrameFormat format)
+{
+    if (m_videoSink != nullptr)
+    {
+        m_videoSink->setFormat(format);
+    }
+}
+
+// Must be called before the peer connection is set. The watchdog needs the decoded frames, so it is not enabled
+// without video frame callback.
+void StreamPeerConnectionHandler::enableVideoFreezeWatchdog(
+    const VideoFreezeWatchdogConfiguration& configuration,
+    VideoFreezeRecoveryCallback onVideoFreezeRecovery)
+{
+    if (m_videoSink == nullptr || m_videoFreezeWatchdog != nullptr)
+    {
+        return;
+    }
+
+    m_videoFreezeWatchdog = make_unique<VideoFreezeWatchdog>(configuration);
+    m_onVideoFreezeRecovery = move(onVideoFreezeRecovery);
+
+    m_videoFreezeWatchdogThread = Thread::Create();
+    m_videoFreezeWatchdogThread->SetName("VideoFreezeWatchdog", nullptr);
+    m_videoFreezeWatchdogThread->Start();
+    callSync(
+        m_videoFreezeWatchdogThread.get(),
+        [this]()
+        {
+            m_videoFreezeWatchdogTask = RepeatingTaskHandle::Start(
+                m_videoFreezeWatchdogThread.get(),
+                [this]()
+                {
+                    auto step = m_videoFreezeWatchdog->update(TimeMicros());
+                    if (step.has_value())
+                    {
+                        recoverFrozenVideo(*step);
+                    }
+                    return TimeDelta::Millis(VideoFreezeWatchdogCheckIntervalMs);
+                });
+        });
+}
+
+// Applies the configuration to the current video receivers and to the next ones
+void StreamPeerConnectionHandler::setReceiveLatencyConfiguration(const ReceiveLatencyConfiguration& configuration)
+{
+    {
+        lock_guard<mutex> lock(m_receiveLatencyConfigurationMutex);
+        m_receiveLatencyConfiguration = configuration;
+    }
+
+    if (m_peerConnection == nullptr)
+    {
+        return;
+    }
+    for (auto& receiver : m_peerConnection->GetReceivers())
+    {
+        applyReceiveLatencyConfiguration(receiver);
+    }
+}
+
 void StreamPeerConnectionHandler::OnTrack(rtc::scoped_refptr<webrtc::RtpTransceiverInterface> transceiver)
 {
     if (m_tracks.empty())
@@ -150,6 +234,10 @@ void StreamPeerConnectionHandler::OnTrack(rtc::scoped_refptr<webrtc::RtpTranscei
     m_tracks.insert(transceiver->receiver()->track());
 
     auto videoTrack = dynamic_cast<VideoTrackInterface*>(transceiver->receiver()->track().get());
+    if (videoTrack != nullptr)
+    {
+        applyReceiveLatencyConfiguration(transceiver->receiver());
+    }
     if (videoTrack != nullptr && m_videoSink != nullptr)
     {
         videoTrack->AddOrUpdateSink(m_videoSink.get(), m_videoSink->wants());
@@ -179,6 +267,10 @@ void StreamPeerConnectionHandler::OnRemoveTrack(rtc::scoped_refptr<webrtc::RtpRe
     {
         videoTrack->RemoveSink(m_videoSink.get());
     }
+    if (videoTrack != nullptr && m_videoFreezeWatchdog != nullptr)
+    {
+        m_videoFreezeWatchdog->reset();
+    }
     if (videoTrack != nullptr && m_encodedVideoSink != nullptr)
     {
         videoTrack->GetSource()->RemoveEncodedSink(m_encodedVideoSink.get());
@@ -285,6 +377,79 @@ void StreamPeerConnectionHandler::setAllRemoteTracksEnabled(const char* kind, bo
     }
 }
 
+void StreamPeerConnectionHandler::stopVideoFreezeWatchdog()
+{
+    if (m_videoFreezeWatchdogThread == nullptr)
+    {
+        return;
+    }
+
+    callSync(m_videoFreezeWatchdogThread.get(), [this]() { m_videoFreezeWatchdogTask.Stop(); });
+    m_videoFreezeWatchdogThread->Stop();
+}
+
+// Must be called from the video freeze watchdog thread
+void StreamPeerConnectionHandler::recoverFrozenVideo(VideoFreezeRecoveryStep step)
+{
+    switch (step)
+    {
+        case VideoFreezeRecoveryStep::RequestKeyFrame:
+            requestRemoteVideoKeyFrames();
+            break;
+        case VideoFreezeRecoveryStep::RestartIce:
+            // Without ICE restart attempt left, the step is not reported and the watchdog reconnects at its next check.
+            if (!restartIceWithTimeout())
+            {
+                m_videoFreezeWatchdog->onIceRestartSkipped();
+                return;
+            }
+            break;
+        case VideoFreezeRecoveryStep::Reconnect:
+            m_onClientConnectionFailed(m_peerClient);
+            break;
+    }
+
+    if (m_onVideoFreezeRecovery)
+    {
+        m_onVideoFreezeRecovery(m_peerClient, step);
+    }
+}
+
+// The remote video sources send a PLI or a FIR to the sender
+void StreamPeerConnectionHandler::requestRemoteVideoKeyFrames()
+{
+    for (auto& receiver : m_peerConnection->GetReceivers())
+    {
+        auto track = receiver->track();
+        if (track && track->kind() == MediaStreamTrackInterface::kVideoKind)
+        {
+            static_cast<VideoTrackInterface*>(track.get())->GetSource()->GenerateKeyFrame();
+        }
+    }
+}
+
+// The audio receivers are not changed, the audio/video synchronization delays them with the video
+void StreamPeerConnectionHandler::applyReceiveLatencyConfiguration(
+    const rtc::scoped_refptr<webrtc::RtpReceiverInterface>& receiver)
+{
+    auto track = receiver->track();
+    if (!track || track->kind() != MediaStreamTrackInterface::kVideoKind)
+    {
+        return;
+    }
+
+    absl::optional<double> jitterBufferMinimumDelaySeconds;
+    {
+        lock_guard<mutex> lock(m_receiveLatencyConfigurationMutex);
+        auto jitterBufferMinimumDelay = m_receiveLatencyConfiguration.jitterBufferMinimumDelay();
+        if (jitterBufferMinimumDelay.has_value())
+        {
+            jitterBufferMinimumDelaySeconds = chrono::duration<double>(*jitterBufferMinimumDelay).count();
+        }
+    }
+    receiver->SetJitterBufferMinimumDelay(jitterBufferMinimumDelaySeconds);
+}
+
 void StreamPeerConnectionHandler::OnDataChannel(rtc::scoped_refptr<webrtc::DataChannelInterface> data_channel) {
     if (m_onDataChannelOpened) {
         m_onDataChannelOpened(m_peerClient, data_channel);
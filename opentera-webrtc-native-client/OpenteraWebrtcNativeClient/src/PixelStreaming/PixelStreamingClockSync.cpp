@@ -0,0 +1,170 @@
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingClockSync.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingMessageEncoder.h>
+#include <OpenteraWebrtcNativeClient/Utils/FunctionTask.h>
+
+#include <rtc_base/time_utils.h>
+
+using namespace opentera;
+using namespace std;
+
+static void writeInt64(uint8_t* data, int64_t value)
+{
+    auto bits = static_cast<uint64_t>(value);
+    for (size_t i = 0; i < sizeof(bits); i++)
+    {
+        data[i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
+
+static int64_t readInt64(const uint8_t* data)
+{
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(bits); i++)
+    {
+        bits |= static_cast<uint64_t>(data[i]) << (8 * i);
+    }
+    return static_cast<int64_t>(bits);
+}
+
+/**
+ * @brief Creates a clock synchronization that sends its requests with a data channel.
+ *
+ * @param dataChannel The data channel connected to the streamer
+ * @param requestMessageId The custom message id of the requests
+ * @param responseMessageId The custom message id of the responses
+ * @param interval The interval between the requests once started
+ */
+PixelStreamingClockSync::PixelStreamingClockSync(
+    rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+    uint8_t requestMessageId,
+    uint8_t responseMessageId,
+    chrono::milliseconds interval)
+    : PixelStreamingClockSync(
+          [dataChannel = move(dataChannel)](const webrtc::DataBuffer& buffer) { return dataChannel->Send(buffer); },
+          requestMessageId,
+          responseMessageId,
+          interval)
+{
+}
+
+/**
+ * @brief Creates a clock synchronization that sends its requests with a function.
+ *
+ * @param send The function that sends a message to the streamer
+ * @param requestMessageId The custom message id of the requests
+ * @param responseMessageId The custom message id of the responses
+ * @param interval The interval between the requests once started
+ */
+PixelStreamingClockSync::PixelStreamingClockSync(
+    function<bool(const webrtc::DataBuffer&)> send,
+    uint8_t requestMessageId,
+    uint8_t responseMessageId,
+    chrono::milliseconds interval)
+    : m_send(move(send)),
+      m_requestMessageId(requestMessageId),
+      m_responseMessageId(responseMessageId),
+      m_interval(interval)
+{
+    m_thread = rtc::Thread::Create();
+    m_thread->SetName("PixelStreamingClockSync", nullptr);
+    m_thread->Start();
+}
+
+PixelStreamingClockSync::~PixelStreamingClockSync()
+{
+    stop();
+    m_thread->Stop();
+}
+
+/**
+ * @brief Starts sending the requests periodically. The first request is sent immediately.
+ */
+void PixelStreamingClockSync::start()
+{
+    callSync(
+        m_thread.get(),
+        [this]()
+        {
+            if (m_task.Running())
+            {
+                return;
+            }
+
+            m_task = webrtc::RepeatingTaskHandle::Start(
+                m_thread.get(),
+                [this]()
+                {
+                    requestSync();
+                    return webrtc::TimeDelta::Millis(m_interval.count());
+                });
+        });
+}
+
+/**
+ * @brief Stops sending the requests. The estimate is kept and the late responses are still handled.
+ */
+void PixelStreamingClockSync::stop()
+{
+    callSync(m_thread.get(), [this]() { m_task.Stop(); });
+}
+
+/**
+ * @brief Sends a request now.
+ * @return true if the request is sent
+ */
+bool PixelStreamingClockSync::requestSync()
+{
+    uint8_t payload[RequestPayloadSize];
+    writeInt64(payload, rtc::TimeMicros());
+    return m_send(PixelStreamingMessageEncoder::custom(m_requestMessageId, payload, sizeof(payload)));
+}
+
+/**
+ * @brief Handles a custom message of the streamer.
+ *
+ * @param message The message
+ * @return true if the message is a response, even if it is malformed
+ */
+bool PixelStreamingClockSync::handleCustomMessage(const PixelStreamingCustomMessage& message)
+{
+    if (message.id != m_responseMessageId)
+    {
+        return false;
+    }
+
+    int64_t receiveTimeUs = rtc::TimeMicros();
+    if (message.dataSize < ResponsePayloadSize)
+    {
+        return true;
+    }
+
+    int64_t requestSendTimeUs = readInt64(message.data);
+    int64_t remoteReceiveTimeUs = readInt64(message.data + sizeof(int64_t));
+    int64_t remoteSendTimeUs = readInt64(message.data + 2 * sizeof(int64_t));
+
+    lock_guard<mutex> lock(m_mutex);
+    m_estimator.addExchange(requestSendTimeUs, remoteReceiveTimeUs, remoteSendTimeUs, receiveTimeUs);
+    return true;
+}
+
+/**
+ * @brief Returns the current estimate of the streamer clock.
+ * @return The current estimate, or std::nullopt if no response was received
+ */
+optional<ClockOffsetEstimate> PixelStreamingClockSync::estimate() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_estimator.estimate();
+}
+
+/**
+ * @brief Converts a time of the streamer clock to the local clock (rtc::TimeMicros).
+ *
+ * @param remoteTimeUs The time of the streamer clock
+ * @return The local time, or std::nullopt if no response was received
+ */
+optional<int64_t> PixelStreamingClockSync::toLocalTimeUs(int64_t remoteTimeUs) const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_estimator.toLocalTimeUs(remoteTimeUs);
+}
@@ -0,0 +1,240 @@
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingInputSender.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingMessageEncoder.h>
+#include <OpenteraWebrtcNativeClient/Utils/FunctionTask.h>
+
+using namespace opentera;
+using namespace std;
+
+/**
+ * @brief Creates an input sender that sends the events with a data channel.
+ *
+ * @param dataChannel The data channel connected to the streamer
+ * @param interval The interval between the ticks once started, typically the video frame interval
+ * @param maxQueueSize The maximum number of queued events, the events enqueued when the queue is full are dropped
+ */
+PixelStreamingInputSender::PixelStreamingInputSender(
+    rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+    chrono::milliseconds interval,
+    size_t maxQueueSize)
+    : PixelStreamingInputSender(
+          [dataChannel = move(dataChannel)](const webrtc::DataBuffer& buffer) { return dataChannel->Send(buffer); },
+          interval,
+          maxQueueSize)
+{
+}
+
+/**
+ * @brief Creates an input sender that sends the events with a function.
+ *
+ * @param send The function that sends a message to the streamer
+ * @param interval The interval between the ticks once started, typically the video frame interval
+ * @param maxQueueSize The maximum number of queued events, the events enqueued when the queue is full are dropped
+ */
+PixelStreamingInputSender::PixelStreamingInputSender(
+    function<bool(const webrtc::DataBuffer&)> send,
+    chrono::milliseconds interval,
+    size_t maxQueueSize)
+    : m_send(move(send)),
+      m_interval(interval),
+      m_maxQueueSize(maxQueueSize),
+      m_coalescedEventCount(0),
+      m_droppedEventCount(0)
+{
+    m_thread = rtc::Thread::Create();
+    m_thread->SetName("PixelStreamingInputSender", nullptr);
+    m_thread->Start();
+}
+
+PixelStreamingInputSender::~PixelStreamingInputSender()
+{
+    stop();
+    m_thread->Stop();
+}
+
+/**
+ * @brief Starts sending the queued events periodically.
+ */
+void PixelStreamingInputSender::start()
+{
+    callSync(
+        m_thread.get(),
+        [this]()
+        {
+            if (m_task.Running())
+            {
+                return;
+            }
+
+            m_task = webrtc::RepeatingTaskHandle::Start(
+                m_thread.get(),
+                [this]()
+                {
+                    flush();
+                    return webrtc::TimeDelta::Millis(m_interval.count());
+                });
+        });
+}
+
+/**
+ * @brief Stops sending the queued events periodically. The events stay queued until the next flush.
+ */
+void PixelStreamingInputSender::stop()
+{
+    callSync(m_thread.get(), [this]() { m_task.Stop(); });
+}
+
+/**
+ * @brief Sends the queued events now, in order.
+ * @return The number of sent events
+ */
+size_t PixelStreamingInputSender::flush()
+{
+    lock_guard<mutex> lock(m_mutex);
+
+    size_t sentEventCount = 0;
+    while (!m_events.empty())
+    {
+        const Event& event = m_events.front();
+        bool sent = false;
+        switch (event.type)
+        {
+            case EventType::Message:
+                sent = m_send(*event.message);
+                break;
+            case EventType::MouseMove:
+                sent = m_send(PixelStreamingMessageEncoder::mouseMove(event.x, event.y, event.deltaX, event.deltaY));
+                break;
+            case EventType::GamepadAnalog:
+                sent = m_send(PixelStreamingMessageEncoder::gamepadAnalog(event.controllerId, event.axis, event.value));
+                break;
+        }
+
+        if (!sent)
+        {
+            break;
+        }
+        m_events.pop_front();
+        sentEventCount++;
+    }
+    return sentEventCount;
+}
+
+/**
+ * @brief Queues a message that is sent as is, for example a key, a mouse button or a command.
+ *
+ * @param message The message encoded with PixelStreamingMessageEncoder
+ * @return true if the message is queued, false if the queue is full
+ */
+bool PixelStreamingInputSender::enqueue(webrtc::DataBuffer message)
+{
+    Event event{};
+    event.type = EventType::Message;
+    event.message = move(message);
+
+    lock_guard<mutex> lock(m_mutex);
+    return push(move(event));
+}
+
+/**
+ * @brief Queues a mouse move. It is merged with the previous event when it is also a mouse move.
+ *
+ * @param x The normalized x position
+ * @param y The normalized y position
+ * @param deltaX The normalized x delta
+ * @param deltaY The normalized y delta
+ * @return true if the move is queued or merged, false if the queue is full
+ */
+bool PixelStreamingInputSender::enqueueMouseMove(float x, float y, float deltaX, float deltaY)
+{
+    lock_guard<mutex> lock(m_mutex);
+    if (!m_events.empty() && m_events.back().type == EventType::MouseMove)
+    {
+        Event& event = m_events.back();
+        event.x = x;
+        event.y = y;
+        event.deltaX += deltaX;
+        event.deltaY += deltaY;
+        m_coalescedEventCount++;
+        return true;
+    }
+
+    Event event{};
+    event.type = EventType::MouseMove;
+    event.x = x;
+    event.y = y;
+    event.deltaX = deltaX;
+    event.deltaY = deltaY;
+    return push(move(event));
+}
+
+/**
+ * @brief Queues a gamepad analog value. It replaces the queued value of the same axis when no other kind of event
+ * is queued after it.
+ *
+ * @param controllerId The controller id
+ * @param axis The axis
+ * @param value The axis value
+ * @return true if the value is queued or merged, false if the queue is full
+ */
+bool PixelStreamingInputSender::enqueueGamepadAnalog(uint8_t controllerId, uint8_t axis, double value)
+{
+    lock_guard<mutex> lock(m_mutex);
+    for (auto it = m_events.rbegin(); it != m_events.rend() && it->type == EventType::GamepadAnalog; ++it)
+    {
+        if (it->controllerId == controllerId && it->axis == axis)
+        {
+            it->value = value;
+            m_coalescedEventCount++;
+            return true;
+        }
+    }
+
+    Event event{};
+    event.type = EventType::GamepadAnalog;
+    event.controllerId = controllerId;
+    event.axis = axis;
+    event.value = value;
+    return push(move(event));
+}
+
+/**
+ * @brief Returns the number of queued events.
+ * @return The number of queued events
+ */
+size_t PixelStreamingInputSender::queueDepth() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_events.size();
+}
+
+/**
+ * @brief Returns the number of events merged with a queued event.
+ * @return The number of events merged with a queued event
+ */
+uint64_t PixelStreamingInputSender::coalescedEventCount() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_coalescedEventCount;
+}
+
+/**
+ * @brief Returns the number of events dropped because the queue was full.
+ * @return The number of events dropped because the queue was full
+ */
+uint64_t PixelStreamingInputSender::droppedEventCount() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_droppedEventCount;
+}
+
+// m_mutex must be locked
+bool PixelStreamingInputSender::push(Event event)
+{
+    if (m_events.size() >= m_maxQueueSize)
+    {
+        m_droppedEventCount++;
+        return false;
+    }
+    m_events.push_back(move(event));
+    return true;
+}
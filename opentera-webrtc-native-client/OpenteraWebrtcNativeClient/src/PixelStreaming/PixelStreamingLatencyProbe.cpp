@@ -0,0 +1,253 @@
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingLatencyProbe.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingMessageEncoder.h>
+#include <OpenteraWebrtcNativeClient/Utils/FunctionTask.h>
+
+#include <nlohmann/json.hpp>
+#include <rtc_base/time_utils.h>
+
+#include <limits>
+
+using namespace opentera;
+using namespace std;
+
+constexpr double NaN = numeric_limits<double>::quiet_NaN();
+
+static double getStreamerTime(const nlohmann::json& timings, const char* name)
+{
+    auto it = timings.find(name);
+    if (it == timings.end() || !it->is_number())
+    {
+        return NaN;
+    }
+    return it->get<double>();
+}
+
+static double getDurationMs(int64_t startTimeUs, int64_t endTimeUs)
+{
+    if (startTimeUs < 0 || endTimeUs < 0)
+    {
+        return NaN;
+    }
+    return static_cast<double>(endTimeUs - startTimeUs) / rtc::kNumMicrosecsPerMillisec;
+}
+
+/**
+ * @brief Creates a latency probe that sends its requests with a data channel.
+ *
+ * @param dataChannel The data channel connected to the streamer
+ * @param interval The interval between the requests once started
+ */
+PixelStreamingLatencyProbe::PixelStreamingLatencyProbe(
+    rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+    chrono::milliseconds interval)
+    : PixelStreamingLatencyProbe(
+          [dataChannel = move(dataChannel)](const webrtc::DataBuffer& buffer) { return dataChannel->Send(buffer); },
+          interval)
+{
+}
+
+/**
+ * @brief Creates a latency probe that sends its requests with a function.
+ *
+ * @param send The function that sends a message to the streamer
+ * @param interval The interval between the requests once started
+ */
+PixelStreamingLatencyProbe::PixelStreamingLatencyProbe(
+    function<bool(const webrtc::DataBuffer&)> send,
+    chrono::milliseconds interval)
+    : m_send(move(send)),
+      m_interval(interval),
+      m_pendingResponseTimeUs(-1),
+      m_averageQP(NaN)
+{
+    m_thread = rtc::Thread::Create();
+    m_thread->SetName("PixelStreamingLatencyProbe", nullptr);
+    m_thread->Start();
+}
+
+PixelStreamingLatencyProbe::~PixelStreamingLatencyProbe()
+{
+    stop();
+    m_thread->Stop();
+}
+
+/**
+ * @brief Starts sending the requests periodically. The first request is sent immediately.
+ */
+void PixelStreamingLatencyProbe::start()
+{
+    callSync(
+        m_thread.get(),
+        [this]()
+        {
+            if (m_task.Running())
+            {
+                return;
+            }
+
+            m_task = webrtc::RepeatingTaskHandle::Start(
+                m_thread.get(),
+                [this]()
+                {
+                    requestLatencyTest();
+                    return webrtc::TimeDelta::Millis(m_interval.count());
+                });
+        });
+}
+
+/**
+ * @brief Stops sending the requests. The pending response is still handled.
+ */
+void PixelStreamingLatencyProbe::stop()
+{
+    callSync(m_thread.get(), [this]() { m_task.Stop(); });
+}
+
+/**
+ * @brief Sends a LatencyTest request now.
+ * @return true if the request is sent
+ */
+bool PixelStreamingLatencyProbe::requestLatencyTest()
+{
+    int64_t nowUs = rtc::TimeMicros();
+    {
+        lock_guard<mutex> lock(m_mutex);
+        m_pendingRequestTimeUs = nowUs;
+    }
+    return m_send(PixelStreamingMessageEncoder::latencyTest(nowUs / rtc::kNumMicrosecsPerMillisec));
+}
+
+/**
+ * @brief Handles a text message of the streamer.
+ *
+ * @param message The message
+ * @return true if the message is a LatencyTest response
+ */
+bool PixelStreamingLatencyProbe::handleTextMessage(const PixelStreamingTextMessage& message)
+{
+    if (message.id != PixelStreamingFromStreamerMessageId::LatencyTest)
+    {
+        return false;
+    }
+
+    int64_t nowUs = rtc::TimeMicros();
+    auto timings = nlohmann::json::parse(message.text.toUtf8(), nullptr, false);
+    if (timings.is_discarded() || !timings.is_object())
+    {
+        return true;
+    }
+
+    lock_guard<mutex> lock(m_mutex);
+    if (!m_pendingRequestTimeUs.has_value())
+    {
+        return true;
+    }
+
+    // The streamer times come from another clock, so only their differences are used.
+    PixelStreamingLatencyReport report;
+    report.roundTripTimeMs = getDurationMs(*m_pendingRequestTimeUs, nowUs);
+    report.streamerProcessingTimeMs =
+        getStreamerTime(timings, "TransmissionTimeMs") - getStreamerTime(timings, "ReceiptTimeMs");
+    report.networkLatencyMs = (report.roundTripTimeMs - report.streamerProcessingTimeMs) / 2.0;
+    report.captureTimeMs =
+        getStreamerTime(timings, "PostCaptureTimeMs") - getStreamerTime(timings, "PreCaptureTimeMs");
+    report.encodeTimeMs =
+        getStreamerTime(timings, "PostEncodeTimeMs") - getStreamerTime(timings, "PreEncodeTimeMs");
+    report.captureToSendTimeMs = getStreamerTime(timings, "CaptureToSendMs");
+    report.receiveToDecodeTimeMs = NaN;
+    report.decodeTimeMs = NaN;
+    report.decodeToDisplayTimeMs = NaN;
+    report.captureToDisplayTimeMs = NaN;
+    report.averageQP = m_averageQP;
+
+    m_pendingRequestTimeUs.reset();
+    m_pendingReport = report;
+    m_pendingResponseTimeUs = nowUs;
+    return true;
+}
+
+/**
+ * @brief Handles a VideoEncoderAvgQP message of the streamer.
+ * @param message The message
+ */
+void PixelStreamingLatencyProbe::handleVideoEncoderAvgQP(const PixelStreamingVideoEncoderAvgQPMessage& message)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_averageQP = message.averageQP;
+}
+
+/**
+ * @brief Reports that a frame is displayed now.
+ *
+ * The first frame received after the LatencyTest response completes the pending report and the report
+ * callback is called from the calling thread.
+ *
+ * @param timestamps The timestamps of the displayed frame
+ */
+void PixelStreamingLatencyProbe::onFrameDisplayed(const VideoFrameTimestamps& timestamps)
+{
+    int64_t displayTimeUs = rtc::TimeMicros();
+    int64_t frameTimeUs = timestamps.receiveTimeUs >= 0 ? timestamps.receiveTimeUs : timestamps.sinkTimeUs;
+
+    PixelStreamingLatencyReport report;
+    function<void(const PixelStreamingLatencyReport&)> onLatencyReport;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (!m_pendingReport.has_value() || (frameTimeUs >= 0 && frameTimeUs < m_pendingResponseTimeUs))
+        {
+            return;
+        }
+
+        report = *m_pendingReport;
+        report.receiveToDecodeTimeMs = getDurationMs(timestamps.receiveTimeUs, timestamps.decodeStartTimeUs);
+        report.decodeTimeMs = getDurationMs(timestamps.decodeStartTimeUs, timestamps.decodeFinishTimeUs);
+        report.decodeToDisplayTimeMs = getDurationMs(timestamps.decodeFinishTimeUs, displayTimeUs);
+        report.captureToDisplayTimeMs = report.captureToSendTimeMs + report.networkLatencyMs +
+                                        getDurationMs(timestamps.receiveTimeUs, displayTimeUs);
+
+        m_pendingReport.reset();
+        m_latestReport = report;
+        onLatencyReport = m_onLatencyReport;
+    }
+
+    if (onLatencyReport)
+    {
+        onLatencyReport(report);
+    }
+}
+
+/**
+ * @brief Returns the latest complete report.
+ * @return The latest complete report, or std::nullopt if no report is complete
+ */
+optional<PixelStreamingLatencyReport> PixelStreamingLatencyProbe::latestReport() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_latestReport;
+}
+
+/**
+ * @brief Returns the latest average QP sent by the streamer encoder.
+ * @return The latest average QP, or NaN if the streamer did not send it yet
+ */
+double PixelStreamingLatencyProbe::averageQP() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_averageQP;
+}
+
+/**
+ * @brief Sets the callback that is called when a report is complete.
+ *
+ * @parblock
+ * Callback parameters:
+ *  - report: The latency report
+ * @endparblock
+ *
+ * @param callback The callback
+ */
+void PixelStreamingLatencyProbe::setOnLatencyReport(function<void(const PixelStreamingLatencyReport&)> callback)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_onLatencyReport = move(callback);
+}
@@ -0,0 +1,365 @@
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingMessageEncoder.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <string>
+
+using namespace opentera;
+using namespace std;
+
+namespace
+{
+    /**
+     * @brief Writes little-endian values in a preallocated buffer.
+     */
+    class MessageWriter
+    {
+        rtc::CopyOnWriteBuffer m_buffer;
+        uint8_t* m_data;
+        size_t m_offset;
+
+    public:
+        MessageWriter(PixelStreamingToStreamerMessageId id, size_t payloadSize)
+            : m_buffer(payloadSize + 1),
+              m_data(m_buffer.MutableData()),
+              m_offset(0)
+        {
+            writeUint8(static_cast<uint8_t>(id));
+        }
+
+        void writeUint8(uint8_t value) { m_data[m_offset++] = value; }
+
+        void writeUint16(uint16_t value)
+        {
+            m_data[m_offset++] = static_cast<uint8_t>(value);
+            m_data[m_offset++] = static_cast<uint8_t>(value >> 8);
+        }
+
+        void writeInt16(int16_t value) { writeUint16(static_cast<uint16_t>(value)); }
+
+        void writeDouble(double value)
+        {
+            uint64_t bits;
+            memcpy(&bits, &value, sizeof(bits));
+            for (size_t i = 0; i < sizeof(bits); i++)
+            {
+                m_data[m_offset++] = static_cast<uint8_t>(bits >> (8 * i));
+            }
+        }
+
+        void writeUtf16(const u16string& value)
+        {
+            for (char16_t codeUnit : value)
+            {
+                writeUint16(static_cast<uint16_t>(codeUnit));
+            }
+        }
+
+        webrtc::DataBuffer toDataBuffer() { return webrtc::DataBuffer(move(m_buffer), true); }
+    };
+
+    u16string utf8ToUtf16(string_view value)
+    {
+        constexpr char32_t ReplacementCharacter = 0xFFFD;
+
+        u16string output;
+        output.reserve(value.size());
+        size_t i = 0;
+        while (i < value.size())
+        {
+            auto byte = static_cast<uint8_t>(value[i]);
+            size_t length = 0;
+            if (byte < 0x80)
+            {
+                length = 1;
+            }
+            else if ((byte >> 5) == 0x6)
+            {
+                length = 2;
+            }
+            else if ((byte >> 4) == 0xE)
+            {
+                length = 3;
+            }
+            else if ((byte >> 3) == 0x1E)
+            {
+                length = 4;
+            }
+
+            if (length == 0 || i + length > value.size())
+            {
+                output.push_back(static_cast<char16_t>(ReplacementCharacter));
+                i++;
+                continue;
+            }
+
+            char32_t codePoint = length == 1 ? byte : byte & (0x7F >> length);
+            bool valid = true;
+            for (size_t j = 1; j < length; j++)
+            {
+                auto continuation = static_cast<uint8_t>(value[i + j]);
+                valid = valid && (continuation & 0xC0) == 0x80;
+                codePoint = (codePoint << 6) | (continuation & 0x3F);
+            }
+            if (!valid || codePoint > 0x10FFFF || (codePoint >= 0xD800 && codePoint <= 0xDFFF))
+            {
+                output.push_back(static_cast<char16_t>(ReplacementCharacter));
+                i++;
+                continue;
+            }
+
+            if (codePoint >= 0x10000)
+            {
+                codePoint -= 0x10000;
+                output.push_back(static_cast<char16_t>(0xD800 + (codePoint >> 10)));
+                output.push_back(static_cast<char16_t>(0xDC00 + (codePoint & 0x3FF)));
+            }
+            else
+            {
+                output.push_back(static_cast<char16_t>(codePoint));
+            }
+            i += length;
+        }
+        return output;
+    }
+
+    uint16_t normalizeUnsigned(float value)
+    {
+        return static_cast<uint16_t>(clamp(lround(value * 65536.f), 0L, 65535L));
+    }
+
+    int16_t normalizeSigned(float value)
+    {
+        return static_cast<int16_t>(clamp(lround(value * 32767.f), -32767L, 32767L));
+    }
+
+    webrtc::DataBuffer encodeIdOnly(PixelStreamingToStreamerMessageId id)
+    {
+        return MessageWriter(id, 0).toDataBuffer();
+    }
+
+    webrtc::DataBuffer encodeString(PixelStreamingToStreamerMessageId id, string_view value)
+    {
+        u16string utf16 = utf8ToUtf16(value);
+        size_t length = min(utf16.size(), static_cast<size_t>(UINT16_MAX));
+        utf16.resize(length);
+
+        MessageWriter writer(id, sizeof(uint16_t) + 2 * length);
+        writer.writeUint16(static_cast<uint16_t>(length));
+        writer.writeUtf16(utf16);
+        return writer.toDataBuffer();
+    }
+
+    webrtc::DataBuffer
+        encodeMouseButton(PixelStreamingToStreamerMessageId id, PixelStreamingMouseButton button, float x, float y)
+    {
+        MessageWriter writer(id, sizeof(uint8_t) + 2 * sizeof(uint16_t));
+        writer.writeUint8(static_cast<uint8_t>(button));
+        writer.writeUint16(normalizeUnsigned(x));
+        writer.writeUint16(normalizeUnsigned(y));
+        return writer.toDataBuffer();
+    }
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::iFrameRequest()
+{
+    return encodeIdOnly(PixelStreamingToStreamerMessageId::IFrameRequest);
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::requestQualityControl()
+{
+    return encodeIdOnly(PixelStreamingToStreamerMessageId::RequestQualityControl);
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::requestInitialSettings()
+{
+    return encodeIdOnly(PixelStreamingToStreamerMessageId::RequestInitialSettings);
+}
+
+/**
+ * @brief Encodes a latency test request. The streamer answers with a LatencyTest message containing its timings.
+ * @param startTimeMs The local time in milliseconds when the request is sent
+ * @return The message
+ */
+webrtc::DataBuffer PixelStreamingMessageEncoder::latencyTest(int64_t startTimeMs)
+{
+    return encodeString(
+        PixelStreamingToStreamerMessageId::LatencyTest,
+        "{\"StartTime\":" + to_string(startTimeMs) + "}");
+}
+
+/**
+ * @brief Encodes a UI interaction message.
+ * @param json The UTF-8 JSON descriptor
+ * @return The message
+ */
+webrtc::DataBuffer PixelStreamingMessageEncoder::uiInteraction(string_view json)
+{
+    return encodeString(PixelStreamingToStreamerMessageId::UIInteraction, json);
+}
+
+/**
+ * @brief Encodes a command message.
+ * @param json The UTF-8 JSON descriptor
+ * @return The message
+ */
+webrtc::DataBuffer PixelStreamingMessageEncoder::command(string_view json)
+{
+    return encodeString(PixelStreamingToStreamerMessageId::Command, json);
+}
+
+/**
+ * @brief Encodes a message with a custom id.
+ *
+ * @param id The message id
+ * @param data The payload
+ * @param size The payload size
+ * @return The message
+ */
+webrtc::DataBuffer PixelStreamingMessageEncoder::custom(uint8_t id, const uint8_t* data, size_t size)
+{
+    rtc::CopyOnWriteBuffer buffer(size + 1);
+    uint8_t* bufferData = buffer.MutableData();
+    bufferData[0] = id;
+    if (size > 0)
+    {
+        memcpy(bufferData + 1, data, size);
+    }
+    return webrtc::DataBuffer(move(buffer), true);
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::keyDown(uint8_t keyCode, bool isRepeat)
+{
+    MessageWriter writer(PixelStreamingToStreamerMessageId::KeyDown, 2 * sizeof(uint8_t));
+    writer.writeUint8(keyCode);
+    writer.writeUint8(isRepeat ? 1 : 0);
+    return writer.toDataBuffer();
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::keyUp(uint8_t keyCode)
+{
+    MessageWriter writer(PixelStreamingToStreamerMessageId::KeyUp, sizeof(uint8_t));
+    writer.writeUint8(keyCode);
+    return writer.toDataBuffer();
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::keyPress(uint16_t charCode)
+{
+    MessageWriter writer(PixelStreamingToStreamerMessageId::KeyPress, sizeof(uint16_t));
+    writer.writeUint16(charCode);
+    return writer.toDataBuffer();
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::mouseEnter()
+{
+    return encodeIdOnly(PixelStreamingToStreamerMessageId::MouseEnter);
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::mouseLeave()
+{
+    return encodeIdOnly(PixelStreamingToStreamerMessageId::MouseLeave);
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::mouseDown(PixelStreamingMouseButton button, float x, float y)
+{
+    return encodeMouseButton(PixelStreamingToStreamerMessageId::MouseDown, button, x, y);
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::mouseUp(PixelStreamingMouseButton button, float x, float y)
+{
+    return encodeMouseButton(PixelStreamingToStreamerMessageId::MouseUp, button, x, y);
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::mouseDouble(PixelStreamingMouseButton button, float x, float y)
+{
+    return encodeMouseButton(PixelStreamingToStreamerMessageId::MouseDouble, button, x, y);
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::mouseMove(float x, float y, float deltaX, float deltaY)
+{
+    MessageWriter writer(PixelStreamingToStreamerMessageId::MouseMove, 4 * sizeof(uint16_t));
+    writer.writeUint16(normalizeUnsigned(x));
+    writer.writeUint16(normalizeUnsigned(y));
+    writer.writeInt16(normalizeSigned(deltaX));
+    writer.writeInt16(normalizeSigned(deltaY));
+    return writer.toDataBuffer();
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::mouseWheel(int16_t delta, float x, float y)
+{
+    MessageWriter writer(PixelStreamingToStreamerMessageId::MouseWheel, 3 * sizeof(uint16_t));
+    writer.writeInt16(delta);
+    writer.writeUint16(normalizeUnsigned(x));
+    writer.writeUint16(normalizeUnsigned(y));
+    return writer.toDataBuffer();
+}
+
+/**
+ * @brief Encodes a touch message.
+ *
+ * @param id TouchStart, TouchEnd or TouchMove
+ * @param touches The touch points (at most 255)
+ * @return The message
+ */
+webrtc::DataBuffer PixelStreamingMessageEncoder::touch(
+    PixelStreamingToStreamerMessageId id,
+    const vector<PixelStreamingTouch>& touches)
+{
+    constexpr size_t TouchSize = 2 * sizeof(uint16_t) + 3 * sizeof(uint8_t);
+    size_t count = min(touches.size(), static_cast<size_t>(UINT8_MAX));
+
+    MessageWriter writer(id, sizeof(uint8_t) + count * TouchSize);
+    writer.writeUint8(static_cast<uint8_t>(count));
+    for (size_t i = 0; i < count; i++)
+    {
+        const auto& touch = touches[i];
+        bool isInside = touch.x >= 0.f && touch.x <= 1.f && touch.y >= 0.f && touch.y <= 1.f;
+
+        writer.writeUint16(normalizeUnsigned(touch.x));
+        writer.writeUint16(normalizeUnsigned(touch.y));
+        writer.writeUint8(touch.id);
+        writer.writeUint8(static_cast<uint8_t>(clamp(lround(touch.force * 255.f), 0L, 255L)));
+        writer.writeUint8(isInside ? 1 : 0);
+    }
+    return writer.toDataBuffer();
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::gamepadConnected()
+{
+    return encodeIdOnly(PixelStreamingToStreamerMessageId::GamepadConnected);
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::gamepadDisconnected(uint8_t controllerId)
+{
+    MessageWriter writer(PixelStreamingToStreamerMessageId::GamepadDisconnected, sizeof(uint8_t));
+    writer.writeUint8(controllerId);
+    return writer.toDataBuffer();
+}
+
+webrtc::DataBuffer
+    PixelStreamingMessageEncoder::gamepadButtonPressed(uint8_t controllerId, uint8_t button, bool isRepeat)
+{
+    MessageWriter writer(PixelStreamingToStreamerMessageId::GamepadButtonPressed, 3 * sizeof(uint8_t));
+    writer.writeUint8(controllerId);
+    writer.writeUint8(button);
+    writer.writeUint8(isRepeat ? 1 : 0);
+    return writer.toDataBuffer();
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::gamepadButtonReleased(uint8_t controllerId, uint8_t button)
+{
+    MessageWriter writer(PixelStreamingToStreamerMessageId::GamepadButtonReleased, 2 * sizeof(uint8_t));
+    writer.writeUint8(controllerId);
+    writer.writeUint8(button);
+    return writer.toDataBuffer();
+}
+
+webrtc::DataBuffer PixelStreamingMessageEncoder::gamepadAnalog(uint8_t controllerId, uint8_t axis, double value)
+{
+    MessageWriter writer(PixelStreamingToStreamerMessageId::GamepadAnalog, 2 * sizeof(uint8_t) + sizeof(double));
+    writer.writeUint8(controllerId);
+    writer.writeUint8(axis);
+    writer.writeDouble(value);
+    return writer.toDataBuffer();
+}
@@ -0,0 +1,300 @@
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingProtocol.h>
+
+#include <array>
+#include <locale>
+#include <sstream>
+
+using namespace opentera;
+using namespace std;
+
+static uint32_t readUint32(const uint8_t* data)
+{
+    return static_cast<uint32_t>(data[0]) | (static_cast<uint32_t>(data[1]) << 8) |
+           (static_cast<uint32_t>(data[2]) << 16) | (static_cast<uint32_t>(data[3]) << 24);
+}
+
+static void appendUtf8(string& output, uint32_t codePoint)
+{
+    if (codePoint < 0x80)
+    {
+        output.push_back(static_cast<char>(codePoint));
+    }
+    else if (codePoint < 0x800)
+    {
+        output.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+        output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else if (codePoint < 0x10000)
+    {
+        output.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+        output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+    else
+    {
+        output.push_back(static_cast<char>(0xF0 | (codePoint >> 18)));
+        output.push_back(static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+        output.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+    }
+}
+
+/**
+ * @brief Converts the string to UTF-8. The unpaired surrogates are replaced by U+FFFD.
+ * @return The UTF-8 string
+ */
+string PixelStreamingUtf16View::toUtf8() const
+{
+    constexpr uint32_t ReplacementCharacter = 0xFFFD;
+
+    string output;
+    output.reserve(m_codeUnitCount);
+    for (size_t i = 0; i < m_codeUnitCount; i++)
+    {
+        uint32_t codeUnit = (*this)[i];
+        if (codeUnit >= 0xD800 && codeUnit <= 0xDBFF && i + 1 < m_codeUnitCount)
+        {
+            uint32_t lowSurrogate = (*this)[i + 1];
+            if (lowSurrogate >= 0xDC00 && lowSurrogate <= 0xDFFF)
+            {
+                appendUtf8(output, 0x10000 + ((codeUnit - 0xD800) << 10) + (lowSurrogate - 0xDC00));
+                i++;
+                continue;
+            }
+        }
+
+        if (codeUnit >= 0xD800 && codeUnit <= 0xDFFF)
+        {
+            appendUtf8(output, ReplacementCharacter);
+        }
+        else
+        {
+            appendUtf8(output, codeUnit);
+        }
+    }
+    return output;
+}
+
+namespace opentera
+{
+    struct PixelStreamingMessageDecoders
+    {
+        using Decoder = bool (*)(const PixelStreamingMessageDispatcher&, uint8_t, const uint8_t*, size_t);
+
+        static bool error(const PixelStreamingMessageDispatcher& self, uint8_t id, const char* reason)
+        {
+            if (self.m_onError)
+            {
+                self.m_onError("Invalid Pixel Streaming message (id=" + to_string(id) + "): " + reason);
+            }
+            return false;
+        }
+
+        static bool decodeOwnership(
+            const PixelStreamingMessageDispatcher& self,
+            uint8_t id,
+            const uint8_t* payload,
+            size_t size)
+        {
+            if (size < 1)
+            {
+                return error(self, id, "missing ownership flag");
+            }
+
+            bool hasOwnership = payload[0] != 0;
+            if (id == static_cast<uint8_t>(PixelStreamingFromStreamerMessageId::QualityControlOwnership) &&
+                self.m_onQualityControlOwnership)
+            {
+                self.m_onQualityControlOwnership(PixelStreamingQualityControlOwnershipMessage{hasOwnership});
+            }
+            else if (
+                id == static_cast<uint8_t>(PixelStreamingFromStreamerMessageId::InputControlOwnership) &&
+                self.m_onInputControlOwnership)
+            {
+                self.m_onInputControlOwnership(PixelStreamingInputControlOwnershipMessage{hasOwnership});
+            }
+            return true;
+        }
+
+        static bool
+            decodeText(const PixelStreamingMessageDispatcher& self, uint8_t id, const uint8_t* payload, size_t size)
+        {
+            if (size % 2 != 0)
+            {
+                return error(self, id, "odd UTF-16 string size");
+            }
+
+            if (self.m_onTextMessage)
+            {
+                self.m_onTextMessage(PixelStreamingTextMessage{
+                    static_cast<PixelStreamingFromStreamerMessageId>(id),
+                    PixelStreamingUtf16View(payload, size / 2)});
+            }
+            return true;
+        }
+
+        static bool decodeFreezeFrame(
+            const PixelStreamingMessageDispatcher& self,
+            uint8_t id,
+            const uint8_t* payload,
+            size_t size)
+        {
+            if (size < sizeof(uint32_t))
+            {
+                return error(self, id, "missing JPEG size");
+            }
+
+            if (self.m_onFreezeFrameChunk)
+            {
+                self.m_onFreezeFrameChunk(PixelStreamingFreezeFrameChunk{
+                    readUint32(payload),
+                    payload + sizeof(uint32_t),
+                    size - sizeof(uint32_t)});
+            }
+            return true;
+        }
+
+        static bool decodeUnfreezeFrame(
+            const PixelStreamingMessageDispatcher& self,
+            [[maybe_unused]] uint8_t id,
+            [[maybe_unused]] const uint8_t* payload,
+            [[maybe_unused]] size_t size)
+        {
+            if (self.m_onUnfreezeFrame)
+            {
+                self.m_onUnfreezeFrame();
+            }
+            return true;
+        }
+
+        static bool decodeVideoEncoderAvgQP(
+            const PixelStreamingMessageDispatcher& self,
+            uint8_t id,
+            const uint8_t* payload,
+            size_t size)
+        {
+            // The QP is sent as a decimal number in a UTF-16 string.
+            constexpr size_t MaxDigitCount = 32;
+            if (size % 2 != 0 || size == 0 || size / 2 > MaxDigitCount)
+            {
+                return error(self, id, "invalid QP string");
+            }
+
+            PixelStreamingUtf16View text(payload, size / 2);
+            char digits[MaxDigitCount + 1];
+            for (size_t i = 0; i < text.size(); i++)
+            {
+                if (text[i] > 0x7F)
+                {
+                    return error(self, id, "invalid QP string");
+                }
+                digits[i] = static_cast<char>(text[i]);
+            }
+            digits[text.size()] = '\0';
+
+            // The decimal separator of the application locale (for example, a comma) must not be used
+            istringstream stream(digits);
+            stream.imbue(locale::classic());
+            double averageQP;
+            if (!(stream >> averageQP))
+            {
+                return error(self, id, "invalid QP string");
+            }
+
+            if (self.m_onVideoEncoderAvgQP)
+            {
+                self.m_onVideoEncoderAvgQP(PixelStreamingVideoEncoderAvgQPMessage{averageQP});
+            }
+            return true;
+        }
+
+        static bool decodeFileContents(
+            const PixelStreamingMessageDispatcher& self,
+            uint8_t id,
+            const uint8_t* payload,
+            size_t size)
+        {
+            if (size < sizeof(uint32_t))
+            {
+                return error(self, id, "missing file size");
+            }
+
+            if (self.m_onFileContentsChunk)
+            {
+                self.m_onFileContentsChunk(PixelStreamingFileContentsChunk{
+                    readUint32(payload),
+                    payload + sizeof(uint32_t),
+                    size - sizeof(uint32_t)});
+            }
+            return true;
+        }
+
+        static bool
+            decodeCustom(const PixelStreamingMessageDispatcher& self, uint8_t id, const uint8_t* payload, size_t size)
+        {
+            auto& callback = self.m_onCustomMessageById[id];
+            if (callback)
+            {
+                callback(PixelStreamingCustomMessage{id, payload, size});
+            }
+            return true;
+        }
+    };
+}
+
+using PixelStreamingMessageDecoder = PixelStreamingMessageDecoders::Decoder;
+
+static constexpr array<PixelStreamingMessageDecoder, 256> createDecoderTable()
+{
+    array<PixelStreamingMessageDecoder, 256> table{};
+    for (auto& decoder : table)
+    {
+        decoder = &PixelStreamingMessageDecoders::decodeCustom;
+    }
+
+    auto set = [&table](PixelStreamingFromStreamerMessageId id, PixelStreamingMessageDecoder decoder)
+    { table[static_cast<uint8_t>(id)] = decoder; };
+
+    using D = PixelStreamingMessageDecoders;
+    set(PixelStreamingFromStreamerMessageId::QualityControlOwnership, &D::decodeOwnership);
+    set(PixelStreamingFromStreamerMessageId::Response, &D::decodeText);
+    set(PixelStreamingFromStreamerMessageId::Command, &D::decodeText);
+    set(PixelStreamingFromStreamerMessageId::FreezeFrame, &D::decodeFreezeFrame);
+    set(PixelStreamingFromStreamerMessageId::UnfreezeFrame, &D::decodeUnfreezeFrame);
+    set(PixelStreamingFromStreamerMessageId::VideoEncoderAvgQP, &D::decodeVideoEncoderAvgQP);
+    set(PixelStreamingFromStreamerMessageId::LatencyTest, &D::decodeText);
+    set(PixelStreamingFromStreamerMessageId::InitialSettings, &D::decodeText);
+    set(PixelStreamingFromStreamerMessageId::FileExtension, &D::decodeText);
+    set(PixelStreamingFromStreamerMessageId::FileMimeType, &D::decodeText);
+    set(PixelStreamingFromStreamerMessageId::FileContents, &D::decodeFileContents);
+    set(PixelStreamingFromStreamerMessageId::TestEcho, &D::decodeText);
+    set(PixelStreamingFromStreamerMessageId::InputControlOwnership, &D::decodeOwnership);
+    set(PixelStreamingFromStreamerMessageId::GamepadResponse, &D::decodeText);
+    set(PixelStreamingFromStreamerMessageId::Protocol, &D::decodeText);
+    return table;
+}
+
+// The decoder is selected with the message id, so the dispatch does not depend on the number of message types.
+static constexpr array<PixelStreamingMessageDecoder, 256> DecoderTable = createDecoderTable();
+
+/**
+ * @brief Decodes a data channel message and calls the matching callback.
+ *
+ * @param data The message data
+ * @param size The message size
+ * @return true if the message is valid
+ */
+bool PixelStreamingMessageDispatcher::dispatch(const uint8_t* data, size_t size) const
+{
+    if (data == nullptr || size == 0)
+    {
+        if (m_onError)
+        {
+            m_onError("Invalid Pixel Streaming message: empty message");
+        }
+        return false;
+    }
+
+    uint8_t id = data[0];
+    return DecoderTable[id](*this, id, data + 1, size - 1);
+}
@@ -2,6 +2,7 @@
 
 #include <ixwebsocket/IXNetSystem.h>
 
+#include <algorithm>
 #include <mutex>
 
 using namespace opentera;
@@ -120,27 +121,31 @@ void WebSocketSignalingClient::closeSync()
 void WebSocketSignalingClient::callAll()
 {
     auto message = eventToMessage("call-all");
-    m_ws.send(message);
+    sendWsMessage(message);
 }
 
 void WebSocketSignalingClient::callIds(const vector<string>& ids)
 {
     auto message = eventToMessage("call-ids", ids);
-    m_ws.send(message);
+    sendWsMessage(message);
 }
 
 void WebSocketSignalingClient::closeAllRoomPeerConnections()
 {
     auto message = eventToMessage("close-all-room-peer-connections");
-    m_ws.send(message);
+    sendWsMessage(message);
 }
 
 void WebSocketSignalingClient::callPeer(const string& toId, const string& sdp)
 {
-    nlohmann::json offer{{"sdp", sdp}, {"type", "offer"}};
-    nlohmann::json data{{"toId", toId}, {"offer", offer}};
-    auto message = eventToMessage("call-peer", data);
-    m_ws.send(message);
+    // The ICE restart offers have new credentials, so the next candidates must use the new username fragment
+    updateUsernameFragment(sdp);
+
+    nlohmann::json offerMessage{
+        {"type", "offer"},
+        {"sdp", sdp}
+    };
+    sendWsMessage(offerMessage.dump());
 }
 
 void WebSocketSignalingClient::makePeerCallAnswer(const string& toId, const string& sdp)
@@ -153,15 +158,7 @@ void WebSocketSignalingClient::makePeerCallAnswer(const string& toId, const stri
     //auto message = eventToMessage("make-peer-call-answer", data);
     // 提取 ICE ufrag (usernameFragment)
 
-    std::smatch match;
-    if (std::regex_search(sdp, match, std::regex("a=ice-ufrag:(\\S+)")))
-    {
-        m_usernameFragment = match[1].str(); // 将 m_usernameFragment 定义为类的成员变量
-    }
-    else
-    {
-        std::cerr << "Failed to extract usernameFragment from SDP." << std::endl;
-    }
+    updateUsernameFragment(sdp);
     // 构建简化的 answer 消息，仅包含 type 和 sdp 字段
     nlohmann::json answerMessage{
         {"type", "answer"},
@@ -170,14 +167,14 @@ void WebSocketSignalingClient::makePeerCallAnswer(const string& toId, const stri
     
     // 将 JSON 数据转换为字符串格式并发送
     auto message = answerMessage.dump();
-    m_ws.send(message);
+    sendWsMessage(message);
 }
 
 void WebSocketSignalingClient::rejectCall(const string& toId)
 {
     nlohmann::json data{{"toId", toId}};
     auto message = eventToMessage("make-peer-call-answer", data);
-    m_ws.send(message);
+    sendWsMessage(message);
 }
 
 void WebSocketSignalingClient::sendIceCandidate(
@@ -206,9 +203,138 @@ void WebSocketSignalingClient::sendIceCandidate(
 
     // 将目标对象设为 Camera01_Default
     auto message = candidateMessage.dump();
+    sendWsMessage(message);
+}
+
+
+/**
+ * @brief Switches the subscription to a streamer.
+ *
+ * The player socket has one subscription at a time. The streamer is moved to the front of the streamer list, so the
+ * current streamer is unsubscribed and its connection is closed as soon as the streamer is available.
+ *
+ * @param streamerId The streamer id
+ */
+void WebSocketSignalingClient::subscribe(const string& streamerId)
+{
+    {
+        lock_guard<mutex> lock(m_streamersMutex);
+        m_streamerList.erase(remove(m_streamerList.begin(), m_streamerList.end(), streamerId), m_streamerList.end());
+        m_streamerList.insert(m_streamerList.begin(), streamerId);
+    }
+    updateSubscription();
+}
+
+/**
+ * @brief Removes a streamer from the streamer list.
+ *
+ * If the streamer is subscribed, it is unsubscribed, its connection is closed and the next available streamer of the
+ * streamer list is subscribed.
+ *
+ * @param streamerId The streamer id
+ */
+void WebSocketSignalingClient::unsubscribe(const string& streamerId)
+{
+    {
+        lock_guard<mutex> lock(m_streamersMutex);
+        m_streamerList.erase(remove(m_streamerList.begin(), m_streamerList.end(), streamerId), m_streamerList.end());
+    }
+    updateSubscription();
+}
+
+/**
+ * @brief Requests the available streamers. The reply subscribes to the first available streamer of the streamer list.
+ */
+void WebSocketSignalingClient::requestStreamerList()
+{
+    nlohmann::json listStreamersMessage = {{"type", "listStreamers"}};
+    sendWsMessage(listStreamersMessage.dump());
+}
+
+/**
+ * @brief Sets the callback that closes the connection of a streamer that is not subscribed anymore.
+ * @param callback The callback, which receives the peer id of the connection
+ */
+void WebSocketSignalingClient::setClosePeerConnection(const function<void(const string& id)>& callback)
+{
+    m_closePeerConnection = callback;
+}
+
+void WebSocketSignalingClient::sendWsMessage(const string& message)
+{
     m_ws.send(message);
 }
 
+bool WebSocketSignalingClient::isWsOpen()
+{
+    return m_ws.getReadyState() == ix::ReadyState::Open;
+}
+
+// Subscribes to the first available streamer of the streamer list, after unsubscribing the current one
+void WebSocketSignalingClient::updateSubscription()
+{
+    string closedPeerId;
+    {
+        lock_guard<mutex> lock(m_streamersMutex);
+        string streamerId;
+        if (isWsOpen())
+        {
+            auto it = find_if(
+                m_streamerList.begin(),
+                m_streamerList.end(),
+                [this](const string& id) { return m_availableStreamerIds.find(id) != m_availableStreamerIds.end(); });
+            if (it != m_streamerList.end())
+            {
+                streamerId = *it;
+            }
+        }
+        if (streamerId == m_subscribedStreamerId)
+        {
+            return;
+        }
+
+        // The messages are sent with the mutex locked, so the concurrent switches are sent in order
+        if (!m_subscribedStreamerId.empty())
+        {
+            nlohmann::json unsubscribeMessage = {{"type", "unsubscribe"}};
+            sendWsMessage(unsubscribeMessage.dump());
+        }
+        m_subscribedStreamerId = streamerId;
+        closedPeerId = move(m_peerId);
+        m_peerId.clear();
+        if (!streamerId.empty())
+        {
+            sendSubscribe(streamerId);
+        }
+    }
+
+    if (!closedPeerId.empty())
+    {
+        invokeIfCallable(m_closePeerConnection, closedPeerId);
+    }
+}
+
+void WebSocketSignalingClient::sendSubscribe(const string& streamerId)
+{
+    nlohmann::json subscribeMessage = {
+        {"type", "subscribe"},
+        {"streamerId", streamerId}
+    };
+    sendWsMessage(subscribeMessage.dump());
+}
+
+void WebSocketSignalingClient::updateUsernameFragment(const std::string& sdp)
+{
+    std::smatch match;
+    if (std::regex_search(sdp, match, std::regex("a=ice-ufrag:(\\S+)")))
+    {
+        m_usernameFragment = match[1].str();
+    }
+    else
+    {
+        std::cerr << "Failed to extract usernameFragment from SDP." << std::endl;
+    }
+}
 
 void WebSocketSignalingClient::connectWsEvents()
 {
@@ -243,13 +369,18 @@ void WebSocketSignalingClient::onWsOpenEvent()
     //    {"room", m_configuration.room()},
     //    {"password", m_configuration.password()},
     //    {"protocolVersion", SignalingProtocolVersion}};
-    //m_ws.send(eventToMessage("join-room", data));
-    nlohmann::json listStreamersMessage = {{"type", "listStreamers"}};
-    m_ws.send(listStreamersMessage.dump());
+    //sendWsMessage(eventToMessage("join-room", data));
+    requestStreamerList();
 }
 
 void WebSocketSignalingClient::onWsCloseEvent()
 {
+    {
+        lock_guard<mutex> lock(m_streamersMutex);
+        m_availableStreamerIds.clear();
+        m_subscribedStreamerId.clear();
+        m_peerId.clear();
+    }
     invokeIfCallable(m_onSignalingConnectionClosed);
 }
 
@@ -260,41 +391,23 @@ void WebSocketSignalingClient::onWsErrorEvent(const string& error)
 
 void WebSocketSignalingClient::onStreamerListReceived(const nlohmann::json& data)
 {
-    if (data.contains("ids") && data["ids"].is_array())
+    JSON_CHECK_RETURN(!data.contains("ids") || !data["ids"].is_array(), "Invalid streamerList message (ids type)");
+
+    set<string> availableStreamerIds;
+    for (const auto& id : data["ids"])
     {
-        auto availableStreamers = data["ids"];
-        
-        if (!availableStreamers.empty())
-        {
-            // 遍历 m_streamerList 并仅订阅 availableStreamers 中存在的 streamerId
-            for (const auto& streamerId : m_streamerList)
-            {
-                if (std::find(availableStreamers.begin(), availableStreamers.end(), streamerId) != availableStreamers.end())
-                {
-                    // 构建并发送订阅请求
-                    nlohmann::json subscribeMessage = {
-                        {"type", "subscribe"},
-                        {"streamerId", streamerId}
-                    };
-
-                    m_ws.send(subscribeMessage.dump());
-                    //std::cout << "Subscribed to streamerId: " << streamerId << std::endl;
-                }
-                else
-                {
-                    //std::cout << "StreamerId not available: " << streamerId << std::endl;
-                }
-            }
-        }
-        else
+        if (id.is_string())
         {
-            //std::cerr << "No available streamers to subscribe." << std::endl;
+            availableStreamerIds.insert(id.get<string>());
         }
     }
-    else
+
     {
-        //std::cerr << "Invalid 'streamerList' message format." << std::endl;
+        lock_guard<mutex> lock(m_streamersMutex);
+        m_availableStreamerIds = move(availableStreamerIds);
     }
+    // A streamer that left is unsubscribed and its connection is closed, so it is subscribed again when it comes back
+    updateSubscription();
 }
 
 
@@ -320,7 +433,7 @@ void WebSocketSignalingClient::onStreamerListReceived(const nlohmann::json& data
 //                {"streamerId", streamerId}
 //            };
 //
-//            m_ws.send(subscribeMessage.dump());
+//            sendWsMessage(subscribeMessage.dump());
 //            std::cout << "Subscribed to streamerId: " << streamerId << std::endl;
 //        }
 //        else
@@ -362,12 +475,34 @@ void WebSocketSignalingClient::onWsMessage(const string& message)
             m_usernameFragment = match[1].str(); // 将 m_usernameFragment 定义为类的成员变量
         }
         std::string fromId = m_usernameFragment;
+        {
+            lock_guard<mutex> lock(m_streamersMutex);
+            m_peerId = fromId;
+        }
 
         if (m_onOfferReceived)
         {
             m_onOfferReceived(fromId, sdp);
         }
     }
+    else if (messageType == "answer")
+    {
+        JSON_CHECK_RETURN(
+            !parsedMessage.contains("sdp") || !parsedMessage["sdp"].is_string(),
+            "Invalid answer message (sdp is missing)");
+        std::string sdp = parsedMessage["sdp"];
+        std::string peerId;
+        {
+            lock_guard<mutex> lock(m_streamersMutex);
+            peerId = m_peerId;
+        }
+        invokeIfCallable(m_receivePeerCallAnswer, peerId, sdp);
+    }
+    else if (messageType == "streamerDisconnected")
+    {
+        // The reply removes the streamer from the subscriptions, so it is subscribed again when it comes back
+        requestStreamerList();
+    }
     else if (messageType == "iceCandidate")
     {
 
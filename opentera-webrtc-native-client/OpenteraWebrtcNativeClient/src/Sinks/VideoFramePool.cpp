@@ -0,0 +1,66 @@
+#include <OpenteraWebrtcNativeClient/Sinks/VideoFramePool.h>
+
+#include <algorithm>
+
+using namespace opentera;
+using namespace std;
+
+static bool isOnlyReferencedByPool(const cv::Mat& buffer)
+{
+    // The reference count is atomically read since frames can be released from any thread.
+    return buffer.u != nullptr && CV_XADD(&buffer.u->refcount, 0) == 1;
+}
+
+/**
+ * @brief Creates a video frame pool.
+ *
+ * @param capacity The maximum number of buffers kept by the pool
+ */
+VideoFramePool::VideoFramePool(size_t capacity) : m_capacity(capacity), m_exhaustionCount(0)
+{
+    m_buffers.reserve(capacity);
+}
+
+/**
+ * @brief Returns a buffer that is not used by any frame.
+ *
+ * The free buffers of another size or type are released. If all pooled buffers are in use, the
+ * buffer is not kept by the pool and the exhaustion is counted.
+ *
+ * @param rows The image height
+ * @param cols The image width
+ * @param type The OpenCV image type
+ * @return A buffer whose content is undefined
+ */
+cv::Mat VideoFramePool::acquire(int rows, int cols, int type)
+{
+    m_buffers.erase(
+        remove_if(
+            m_buffers.begin(),
+            m_buffers.end(),
+            [=](const cv::Mat& buffer)
+            {
+                return isOnlyReferencedByPool(buffer) &&
+                       (buffer.rows != rows || buffer.cols != cols || buffer.type() != type);
+            }),
+        m_buffers.end());
+
+    for (auto& buffer : m_buffers)
+    {
+        if (isOnlyReferencedByPool(buffer))
+        {
+            return buffer;
+        }
+    }
+
+    cv::Mat buffer(rows, cols, type);
+    if (m_buffers.size() < m_capacity)
+    {
+        m_buffers.push_back(buffer);
+    }
+    else
+    {
+        m_exhaustionCount++;
+    }
+    return buffer;
+}
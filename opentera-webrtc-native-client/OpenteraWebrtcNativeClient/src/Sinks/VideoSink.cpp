@@ -1,20 +1,61 @@
 #include <OpenteraWebrtcNativeClient/Sinks/VideoSink.h>
 
 #include <libyuv.h>
-#include <opencv2/imgproc.hpp>
+#include <rtc_base/time_utils.h>
+#include <system_wrappers/include/clock.h>
+
+#include <algorithm>
 #include <utility>
 
 using namespace opentera;
 using namespace rtc;
 using namespace std;
 
+// Enough frames for the consumers to keep a few of them without allocating
+constexpr size_t VideoFramePoolCapacity = 8;
+
+static VideoFrameTimestamps getTimestamps(const webrtc::VideoFrame& frame)
+{
+    VideoFrameTimestamps timestamps;
+    int64_t nowUs = rtc::TimeMicros();
+
+    // The NTP time of a received frame is its capture time in the local NTP clock.
+    if (frame.ntp_time_ms() > 0)
+    {
+        int64_t ageMs = webrtc::Clock::GetRealTimeClock()->CurrentNtpInMilliseconds() - frame.ntp_time_ms();
+        timestamps.captureTimeUs = nowUs - ageMs * rtc::kNumMicrosecsPerMillisec;
+    }
+
+    for (const auto& packetInfo : frame.packet_infos())
+    {
+        if (packetInfo.receive_time().IsFinite())
+        {
+            timestamps.receiveTimeUs = max(timestamps.receiveTimeUs, packetInfo.receive_time().us());
+        }
+    }
+
+    auto processingTime = frame.processing_time();
+    if (processingTime.has_value())
+    {
+        timestamps.decodeStartTimeUs = processingTime->start.us();
+        timestamps.decodeFinishTimeUs = processingTime->finish.us();
+    }
+
+    timestamps.sinkTimeUs = nowUs;
+    return timestamps;
+}
+
 /**
  * @brief Construct a VideoSink
  *
  * @param onFrameReceived callback function that gets called whenever a frame is
  * received
  */
-VideoSink::VideoSink(VideoSinkCallback onFrameReceived) : m_onFrameReceived(move(onFrameReceived))
+VideoSink::VideoSink(VideoSinkCallback onFrameReceived)
+    : m_onFrameReceived(move(onFrameReceived)),
+      m_framePool(VideoFramePoolCapacity),
+      m_format(VideoFrameFormat::BGR),
+      m_targetSize(0)
 {
     m_wants.rotation_applied = false;
 
@@ -26,8 +67,10 @@ VideoSink::VideoSink(VideoSinkCallback onFrameReceived) : m_onFrameReceived(move
  * @brief Process incoming frames from webrtc
  *
  * This function is called by the webrtc transport layer whenever a frame is
- * available. It convert YUV frame data from the I420 buffer to BGR data and
- * call the callback function with a cv::Mat
+ * available. It downscales the I420 buffer to the target size, if one is set,
+ * rotates it in the planar domain, converts YUV frame data from the I420 buffer
+ * to the output format in a single pass and call the callback function with a
+ * pooled frame. The callback can keep the frame without copying it.
  *
  * @param frame available webrtc frame
  */
@@ -38,40 +81,212 @@ void VideoSink::OnFrame(const webrtc::VideoFrame& frame)
         return;
     }
 
-    // Transform data from 3 array in I420 buffer to one cv::Mat in yuv
-    m_bgrImg.create(frame.height(), frame.width(), CV_8UC3);
+    rtc::scoped_refptr<webrtc::I420BufferInterface> i420 = frame.video_frame_buffer()->ToI420();
+    if (i420 == nullptr)
+    {
+        return;
+    }
+    i420 = scaleToTargetSize(move(i420), frame.rotation());
+    i420 = rotate(move(i420), frame.rotation());
+    if (i420 == nullptr)
+    {
+        return;
+    }
 
-    int err = libyuv::ConvertFromI420(
-        frame.video_frame_buffer()->GetI420()->DataY(),
-        frame.video_frame_buffer()->GetI420()->StrideY(),
-        frame.video_frame_buffer()->GetI420()->DataU(),
-        frame.video_frame_buffer()->GetI420()->StrideU(),
-        frame.video_frame_buffer()->GetI420()->DataV(),
-        frame.video_frame_buffer()->GetI420()->StrideV(),
-        m_bgrImg.data,
-        m_bgrImg.step[0],
-        frame.width(),
-        frame.height(),
-        libyuv::FOURCC_24BG);
-    if (err != 0)
+    PooledVideoFrame pooledFrame = convertFromI420(*i420, m_format, getTimestamps(frame));
+    if (pooledFrame.empty())
     {
         return;
     }
 
-    switch (frame.rotation())
+    m_onFrameReceived(pooledFrame, frame.timestamp_us());
+}
+
+/**
+ * @brief Sets the size of the area where the frames are displayed.
+ *
+ * The frames are downscaled in the YUV domain before the color conversion so
+ * they fit in the target size while keeping their aspect ratio. The frames are
+ * never upscaled. This function can be called from any thread.
+ *
+ * @param width the target width, 0 to disable the downscaling
+ * @param height the target height, 0 to disable the downscaling
+ */
+void VideoSink::setTargetSize(int width, int height)
+{
+    m_targetSize = (static_cast<uint64_t>(max(width, 0)) << 32) | static_cast<uint32_t>(max(height, 0));
+}
+
+/**
+ * @brief Sets the pixel layout of the images given to the callback.
+ *
+ * This function can be called from any thread. The change applies to the next frame.
+ *
+ * @param format the output pixel layout
+ */
+void VideoSink::setFormat(VideoFrameFormat format) { m_format = format; }
+
+PooledVideoFrame VideoSink::convertFromI420(
+    const webrtc::I420BufferInterface& buffer,
+    VideoFrameFormat format,
+    const VideoFrameTimestamps& timestamps)
+{
+    cv::Mat img;
+    uint32_t fourcc = libyuv::FOURCC_24BG;
+    switch (format)
     {
-        case webrtc::kVideoRotation_0:
-            m_onFrameReceived(m_bgrImg, frame.timestamp_us());
-            return;
-        case webrtc::kVideoRotation_90:
-            cv::rotate(m_bgrImg, m_bgrRotatedImg, cv::ROTATE_90_CLOCKWISE);
+        case VideoFrameFormat::BGR:
+            img = m_framePool.acquire(buffer.height(), buffer.width(), CV_8UC3);
+            fourcc = libyuv::FOURCC_24BG;
+            break;
+        case VideoFrameFormat::RGB:
+            img = m_framePool.acquire(buffer.height(), buffer.width(), CV_8UC3);
+            fourcc = libyuv::FOURCC_RAW;
             break;
-        case webrtc::kVideoRotation_180:
-            cv::rotate(m_bgrImg, m_bgrRotatedImg, cv::ROTATE_180);
+        case VideoFrameFormat::BGRA:
+            img = m_framePool.acquire(buffer.height(), buffer.width(), CV_8UC4);
+            fourcc = libyuv::FOURCC_ARGB;
             break;
-        case webrtc::kVideoRotation_270:
-            cv::rotate(m_bgrImg, m_bgrRotatedImg, cv::ROTATE_90_COUNTERCLOCKWISE);
+        case VideoFrameFormat::RGBA:
+            img = m_framePool.acquire(buffer.height(), buffer.width(), CV_8UC4);
+            fourcc = libyuv::FOURCC_ABGR;
             break;
+        case VideoFrameFormat::Gray:
+            img = m_framePool.acquire(buffer.height(), buffer.width(), CV_8UC1);
+            libyuv::CopyPlane(
+                buffer.DataY(),
+                buffer.StrideY(),
+                img.data,
+                static_cast<int>(img.step[0]),
+                buffer.width(),
+                buffer.height());
+            return PooledVideoFrame(move(img), timestamps);
     }
-    m_onFrameReceived(m_bgrRotatedImg, frame.timestamp_us());
+
+    int err = libyuv::ConvertFromI420(
+        buffer.DataY(),
+        buffer.StrideY(),
+        buffer.DataU(),
+        buffer.StrideU(),
+        buffer.DataV(),
+        buffer.StrideV(),
+        img.data,
+        static_cast<int>(img.step[0]),
+        buffer.width(),
+        buffer.height(),
+        fourcc);
+    if (err != 0)
+    {
+        return {};
+    }
+    return PooledVideoFrame(move(img), timestamps);
+}
+
+rtc::scoped_refptr<webrtc::I420BufferInterface>
+    VideoSink::scaleToTargetSize(rtc::scoped_refptr<webrtc::I420BufferInterface> buffer, webrtc::VideoRotation rotation)
+{
+    uint64_t targetSize = m_targetSize;
+    int targetWidth = static_cast<int>(targetSize >> 32);
+    int targetHeight = static_cast<int>(targetSize & 0xFFFFFFFF);
+    if (targetWidth == 0 || targetHeight == 0)
+    {
+        return buffer;
+    }
+
+    // The target size is expressed after the rotation.
+    if (rotation == webrtc::kVideoRotation_90 || rotation == webrtc::kVideoRotation_270)
+    {
+        swap(targetWidth, targetHeight);
+    }
+
+    int width = buffer->width();
+    int height = buffer->height();
+    if (width <= targetWidth && height <= targetHeight)
+    {
+        return buffer;
+    }
+
+    double scale = min(
+        static_cast<double>(targetWidth) / static_cast<double>(width),
+        static_cast<double>(targetHeight) / static_cast<double>(height));
+    int scaledWidth = max(2, static_cast<int>(width * scale) & ~1);
+    int scaledHeight = max(2, static_cast<int>(height * scale) & ~1);
+
+    rtc::scoped_refptr<webrtc::I420Buffer> scaledBuffer =
+        m_scaledBufferPool.CreateI420Buffer(scaledWidth, scaledHeight);
+    if (scaledBuffer == nullptr)
+    {
+        return buffer;
+    }
+
+    int err = libyuv::I420Scale(
+        buffer->DataY(),
+        buffer->StrideY(),
+        buffer->DataU(),
+        buffer->StrideU(),
+        buffer->DataV(),
+        buffer->StrideV(),
+        width,
+        height,
+        scaledBuffer->MutableDataY(),
+        scaledBuffer->StrideY(),
+        scaledBuffer->MutableDataU(),
+        scaledBuffer->StrideU(),
+        scaledBuffer->MutableDataV(),
+        scaledBuffer->StrideV(),
+        scaledWidth,
+        scaledHeight,
+        libyuv::kFilterBox);
+    if (err != 0)
+    {
+        return buffer;
+    }
+
+    return scaledBuffer;
+}
+
+rtc::scoped_refptr<webrtc::I420BufferInterface>
+    VideoSink::rotate(rtc::scoped_refptr<webrtc::I420BufferInterface> buffer, webrtc::VideoRotation rotation)
+{
+    if (rotation == webrtc::kVideoRotation_0)
+    {
+        return buffer;
+    }
+
+    int width = buffer->width();
+    int height = buffer->height();
+    bool isTransposed = rotation == webrtc::kVideoRotation_90 || rotation == webrtc::kVideoRotation_270;
+    int rotatedWidth = isTransposed ? height : width;
+    int rotatedHeight = isTransposed ? width : height;
+
+    rtc::scoped_refptr<webrtc::I420Buffer> rotatedBuffer =
+        m_rotatedBufferPool.CreateI420Buffer(rotatedWidth, rotatedHeight);
+    if (rotatedBuffer == nullptr)
+    {
+        return nullptr;
+    }
+
+    // The webrtc rotation values are the libyuv ones (0, 90, 180 and 270 degrees).
+    int err = libyuv::I420Rotate(
+        buffer->DataY(),
+        buffer->StrideY(),
+        buffer->DataU(),
+        buffer->StrideU(),
+        buffer->DataV(),
+        buffer->StrideV(),
+        rotatedBuffer->MutableDataY(),
+        rotatedBuffer->StrideY(),
+        rotatedBuffer->MutableDataU(),
+        rotatedBuffer->StrideU(),
+        rotatedBuffer->MutableDataV(),
+        rotatedBuffer->StrideV(),
+        width,
+        height,
+        static_cast<libyuv::RotationMode>(rotation));
+    if (err != 0)
+    {
+        return nullptr;
+    }
+
+    return rotatedBuffer;
 }
@@ -22,6 +22,11 @@ StreamClient::StreamClient(
       m_isLocalAudioMuted(false),
       m_isRemoteAudioMuted(false),
       m_isLocalVideoMuted(false),
+      m_videoFrameTargetWidth(0),
+      m_videoFrameTargetHeight(0),
+      m_videoFrameFormat(VideoFrameFormat::BGR),
+      m_videoFrameStreams(make_shared<BoundedStreamGroup<ReceivedVideoFrame>>()),
+      m_receiveLatencyConfiguration(ReceiveLatencyConfiguration::create()),
       streamId(streamId)
 {
 }
@@ -43,7 +48,12 @@ StreamClient::StreamClient(
       m_hasOnMixedAudioFrameReceivedCallback(false),
       m_isLocalAudioMuted(false),
       m_isRemoteAudioMuted(false),
-      m_isLocalVideoMuted(false)
+      m_isLocalVideoMuted(false),
+      m_videoFrameTargetWidth(0),
+      m_videoFrameTargetHeight(0),
+      m_videoFrameFormat(VideoFrameFormat::BGR),
+      m_videoFrameStreams(make_shared<BoundedStreamGroup<ReceivedVideoFrame>>()),
+      m_receiveLatencyConfiguration(ReceiveLatencyConfiguration::create())
 {
 }
 
@@ -66,7 +76,12 @@ StreamClient::StreamClient(
       m_hasOnMixedAudioFrameReceivedCallback(false),
       m_isLocalAudioMuted(false),
       m_isRemoteAudioMuted(false),
-      m_isLocalVideoMuted(false)
+      m_isLocalVideoMuted(false),
+      m_videoFrameTargetWidth(0),
+      m_videoFrameTargetHeight(0),
+      m_videoFrameFormat(VideoFrameFormat::BGR),
+      m_videoFrameStreams(make_shared<BoundedStreamGroup<ReceivedVideoFrame>>()),
+      m_receiveLatencyConfiguration(ReceiveLatencyConfiguration::create())
 {
 }
 
@@ -89,7 +104,12 @@ StreamClient::StreamClient(
       m_hasOnMixedAudioFrameReceivedCallback(false),
       m_isLocalAudioMuted(false),
       m_isRemoteAudioMuted(false),
-      m_isLocalVideoMuted(false)
+      m_isLocalVideoMuted(false),
+      m_videoFrameTargetWidth(0),
+      m_videoFrameTargetHeight(0),
+      m_videoFrameFormat(VideoFrameFormat::BGR),
+      m_videoFrameStreams(make_shared<BoundedStreamGroup<ReceivedVideoFrame>>()),
+      m_receiveLatencyConfiguration(ReceiveLatencyConfiguration::create())
 {
     if (m_audioSource != nullptr)
     {
@@ -120,7 +140,12 @@ StreamClient::StreamClient(
       m_hasOnMixedAudioFrameReceivedCallback(false),
       m_isLocalAudioMuted(false),
       m_isRemoteAudioMuted(false),
-      m_isLocalVideoMuted(false)
+      m_isLocalVideoMuted(false),
+      m_videoFrameTargetWidth(0),
+      m_videoFrameTargetHeight(0),
+      m_videoFrameFormat(VideoFrameFormat::BGR),
+      m_videoFrameStreams(make_shared<BoundedStreamGroup<ReceivedVideoFrame>>()),
+      m_receiveLatencyConfiguration(ReceiveLatencyConfiguration::create())
 {
     if (m_audioSource != nullptr)
     {
@@ -131,6 +156,8 @@ StreamClient::StreamClient(
 
 StreamClient::~StreamClient()
 {
+    m_videoFrameStreams->closeAll();
+
     if (m_audioSource != nullptr)
     {
         m_audioSource->setAudioDeviceModule(nullptr);
@@ -147,7 +174,17 @@ StreamClient::~StreamClient()
  */
 void StreamClient::setLocalAudioMuted(bool muted)
 {
-    callSync(
+    setLocalAudioMutedAsync(muted).get();
+}
+
+/**
+ * @brief Mutes or unmutes the local audio without blocking the caller.
+ * @param muted indicates if the local audio is muted or not
+ * @return The future that is ready when the tracks are updated
+ */
+future<void> StreamClient::setLocalAudioMutedAsync(bool muted)
+{
+    return callFuture(
         getInternalClientThread(),
         [this, muted]()
         {
@@ -165,7 +202,17 @@ void StreamClient::setLocalAudioMuted(bool muted)
  */
 void StreamClient::setRemoteAudioMuted(bool muted)
 {
-    callSync(
+    setRemoteAudioMutedAsync(muted).get();
+}
+
+/**
+ * @brief Mutes or unmutes the remote audio without blocking the caller.
+ * @param muted indicates if the remote audio is muted or not
+ * @return The future that is ready when the tracks are updated
+ */
+future<void> StreamClient::setRemoteAudioMutedAsync(bool muted)
+{
+    return callFuture(
         getInternalClientThread(),
         [this, muted]()
         {
@@ -183,7 +230,17 @@ void StreamClient::setRemoteAudioMuted(bool muted)
  */
 void StreamClient::setLocalVideoMuted(bool muted)
 {
-    callSync(
+    setLocalVideoMutedAsync(muted).get();
+}
+
+/**
+ * @brief Mutes or unmutes the local video without blocking the caller.
+ * @param muted indicates if the local video is muted or not
+ * @return The future that is ready when the tracks are updated
+ */
+future<void> StreamClient::setLocalVideoMutedAsync(bool muted)
+{
+    return callFuture(
         getInternalClientThread(),
         [this, muted]()
         {
@@ -195,6 +252,108 @@ void StreamClient::setLocalVideoMuted(bool muted)
         });
 }
 
+/**
+ * @brief Sets the size of the area where the received video frames are displayed.
+ *
+ * The received frames are downscaled before the color conversion so they fit in
+ * this size while keeping their aspect ratio. They are never upscaled.
+ *
+ * @param width the target width, 0 to receive the frames at their native size
+ * @param height the target height, 0 to receive the frames at their native size
+ */
+void StreamClient::setVideoFrameTargetSize(int width, int height)
+{
+    setVideoFrameTargetSizeAsync(width, height).get();
+}
+
+/**
+ * @brief Sets the size of the area where the received video frames are displayed without blocking the caller.
+ *
+ * This function can be called from a GUI thread when the display area is resized.
+ *
+ * @param width the target width, 0 to receive the frames at their native size
+ * @param height the target height, 0 to receive the frames at their native size
+ * @return The future that is ready when the video sinks are updated
+ */
+future<void> StreamClient::setVideoFrameTargetSizeAsync(int width, int height)
+{
+    return callFuture(
+        getInternalClientThread(),
+        [this, width, height]()
+        {
+            m_videoFrameTargetWidth = width;
+            m_videoFrameTargetHeight = height;
+            for (auto& pair : m_peerConnectionHandlersById)
+            {
+                dynamic_cast<StreamPeerConnectionHandler*>(pair.second.get())->setVideoSinkTargetSize(width, height);
+            }
+        });
+}
+
+/**
+ * @brief Sets the pixel layout of the received video frames.
+ *
+ * The frames are converted from I420 to this layout in a single pass, so the
+ * layout expected by the consumer should be used to avoid another conversion.
+ *
+ * @param format the pixel layout of the received video frames (BGR by default)
+ */
+void StreamClient::setVideoFrameFormat(VideoFrameFormat format)
+{
+    callSync(
+        getInternalClientThread(),
+        [this, format]()
+        {
+            m_videoFrameFormat = format;
+            for (auto& pair : m_peerConnectionHandlersById)
+            {
+                dynamic_cast<StreamPeerConnectionHandler*>(pair.second.get())->setVideoSinkFormat(format);
+            }
+        });
+}
+
+/**
+ * @brief Sets the receive latency configuration of the received videos.
+ *
+ * The configuration is applied to the current connections and to the next ones, so the latency of each stream can
+ * be traded for smoothness at runtime.
+ *
+ * @param configuration The receive latency configuration
+ */
+void StreamClient::setReceiveLatencyConfiguration(const ReceiveLatencyConfiguration& configuration)
+{
+    callSync(
+        getInternalClientThread(),
+        [this, &configuration]()
+        {
+            m_receiveLatencyConfiguration = configuration;
+            for (auto& pair : m_peerConnectionHandlersById)
+            {
+                dynamic_cast<StreamPeerConnectionHandler*>(pair.second.get())
+                    ->setReceiveLatencyConfiguration(configuration);
+            }
+        });
+}
+
+/**
+ * @brief Creates a stream of the received video frames.
+ *
+ * The frames of all peer connections are added to the stream from the WebRTC decoding thread, in addition to the
+ * frame callback. The consumer pulls them with next, next with a timeout or tryNext, and several streams can be
+ * handled by one thread with their availability callbacks. A frame holds its pooled image buffer until it is
+ * released, so the capacity should stay small. The stream is closed when the client is destroyed, and it stops
+ * receiving frames when it is released. The video is only offered to be received when a frame callback or a stream
+ * exists, so the stream must be created before connecting when the frame callback is not set.
+ *
+ * @param capacity The maximum number of frames waiting for the consumer
+ * @param dropPolicy The frame that is dropped when the stream is full
+ * @return The stream
+ */
+shared_ptr<VideoFrameStream> StreamClient::createVideoFrameStream(size_t capacity, StreamDropPolicy dropPolicy)
+{
+    return m_videoFrameStreams->create(capacity, dropPolicy);
+}
+
 /**
  * @brief Creates the peer connection handler for this client
  *
@@ -224,7 +383,25 @@ unique_ptr<PeerConnectionHandler>
     auto onAddRemoteStream = [this](const Client& client) { invokeIfCallable(m_onAddRemoteStream, client); };
     auto onRemoveRemoteStream = [this](const Client& client) { invokeIfCallable(m_onRemoveRemoteStream, client); };
 
-    return make_unique<StreamPeerConnectionHandler>(
+    // The video is only received when the frames have a consumer. The streams created after the handler receive its
+    // frames once the video is received.
+    VideoFrameReceivedCallback onVideoFrameReceived;
+    if (m_onVideoFrameReceived || !m_videoFrameStreams->empty())
+    {
+        onVideoFrameReceived = [callback = m_onVideoFrameReceived, streams = m_videoFrameStreams](
+                                   const Client& client,
+                                   const PooledVideoFrame& frame,
+                                   uint64_t timestampUs)
+        {
+            if (callback)
+            {
+                callback(client, frame, timestampUs);
+            }
+            streams->push(ReceivedVideoFrame{client, frame, timestampUs});
+        };
+    }
+
+    auto handler = make_unique<StreamPeerConnectionHandler>(
         id,
         peerClient,
         isCaller,
@@ -238,11 +415,38 @@ unique_ptr<PeerConnectionHandler>
         audioTrack,
         onAddRemoteStream,
         onRemoveRemoteStream,
-        m_onVideoFrameReceived,
+        onVideoFrameReceived,
         m_onEncodedVideoFrameReceived,
         m_onAudioFrameReceived,
         m_onDataChannelOpened
         );
+    handler->setVideoSinkTargetSize(m_videoFrameTargetWidth, m_videoFrameTargetHeight);
+    handler->setVideoSinkFormat(m_videoFrameFormat);
+    handler->setReceiveLatencyConfiguration(m_receiveLatencyConfiguration);
+    if (m_videoFreezeWatchdogConfiguration.has_value())
+    {
+        handler->enableVideoFreezeWatchdog(
+            *m_videoFreezeWatchdogConfiguration,
+            [this](const Client& client, VideoFreezeRecoveryStep step)
+            { invokeIfCallable(m_onVideoFreezeRecovery, client, step); });
+    }
+    return handler;
+}
+
+/**
+ * @brief Applies the mute states, the video sink settings and the receive latency configuration to a claimed handler
+ *
+ * @param handler the claimed pooled handler
+ */
+void StreamClient::updatePooledPeerConnectionHandler(PeerConnectionHandler& handler)
+{
+    auto& streamHandler = dynamic_cast<StreamPeerConnectionHandler&>(handler);
+    streamHandler.setAllLocalAudioTracksEnabled(!m_isLocalAudioMuted);
+    streamHandler.setAllRemoteAudioTracksEnabled(!m_isRemoteAudioMuted);
+    streamHandler.setAllVideoTracksEnabled(!m_isLocalVideoMuted);
+    streamHandler.setVideoSinkTargetSize(m_videoFrameTargetWidth, m_videoFrameTargetHeight);
+    streamHandler.setVideoSinkFormat(m_videoFrameFormat);
+    streamHandler.setReceiveLatencyConfiguration(m_receiveLatencyConfiguration);
 }
 
 void StreamClient::connect()
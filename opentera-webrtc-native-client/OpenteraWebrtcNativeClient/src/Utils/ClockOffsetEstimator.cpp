@@ -0,0 +1,165 @@
+#include <OpenteraWebrtcNativeClient/Utils/ClockOffsetEstimator.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+using namespace opentera;
+using namespace std;
+
+// The drift is only estimated when the kept exchanges span at least this duration
+constexpr int64_t MinDriftSpanUs = 2'000'000;
+constexpr double MicrosecondsPerSecond = 1e6;
+
+/**
+ * @brief Creates a clock offset estimator.
+ *
+ * @param windowSize The number of exchanges kept to estimate the offset and the drift
+ * @param maxDriftPpm The maximum absolute drift, in ppm, larger estimates are clamped
+ */
+ClockOffsetEstimator::ClockOffsetEstimator(size_t windowSize, double maxDriftPpm)
+    : m_windowSize(max<size_t>(windowSize, 1)),
+      m_maxDriftPpm(maxDriftPpm)
+{
+}
+
+/**
+ * @brief Adds a request/response exchange and updates the estimate.
+ *
+ * @param requestSendTimeUs The local time when the request was sent
+ * @param remoteReceiveTimeUs The remote time when the request was received
+ * @param remoteSendTimeUs The remote time when the response was sent
+ * @param responseReceiveTimeUs The local time when the response was received
+ * @return true if the exchange is valid
+ */
+bool ClockOffsetEstimator::addExchange(
+    int64_t requestSendTimeUs,
+    int64_t remoteReceiveTimeUs,
+    int64_t remoteSendTimeUs,
+    int64_t responseReceiveTimeUs)
+{
+    int64_t roundTripTimeUs = (responseReceiveTimeUs - requestSendTimeUs) - (remoteSendTimeUs - remoteReceiveTimeUs);
+    if (responseReceiveTimeUs < requestSendTimeUs || remoteSendTimeUs < remoteReceiveTimeUs || roundTripTimeUs < 0)
+    {
+        return false;
+    }
+
+    Exchange exchange;
+    exchange.localTimeUs = requestSendTimeUs + (responseReceiveTimeUs - requestSendTimeUs) / 2;
+    exchange.offsetUs = ((remoteReceiveTimeUs - requestSendTimeUs) + (remoteSendTimeUs - responseReceiveTimeUs)) / 2;
+    exchange.roundTripTimeUs = roundTripTimeUs;
+
+    m_exchanges.push_back(exchange);
+    while (m_exchanges.size() > m_windowSize)
+    {
+        m_exchanges.pop_front();
+    }
+
+    updateEstimate();
+    return true;
+}
+
+/**
+ * @brief Removes all exchanges, for example when the remote clock changes.
+ */
+void ClockOffsetEstimator::reset()
+{
+    m_exchanges.clear();
+    m_estimate = nullopt;
+}
+
+/**
+ * @brief Returns the offset at a local time.
+ *
+ * @param localTimeUs The local time
+ * @return The remote time minus the local time or std::nullopt if there is no estimate
+ */
+optional<int64_t> ClockOffsetEstimator::offsetAt(int64_t localTimeUs) const
+{
+    if (!m_estimate)
+    {
+        return nullopt;
+    }
+
+    double elapsedS = static_cast<double>(localTimeUs - m_estimate->referenceTimeUs) / MicrosecondsPerSecond;
+    return m_estimate->offsetUs + static_cast<int64_t>(llround(elapsedS * m_estimate->driftPpm));
+}
+
+/**
+ * @brief Converts a remote time to the local clock.
+ *
+ * @param remoteTimeUs The remote time
+ * @return The local time or std::nullopt if there is no estimate
+ */
+optional<int64_t> ClockOffsetEstimator::toLocalTimeUs(int64_t remoteTimeUs) const
+{
+    if (!m_estimate)
+    {
+        return nullopt;
+    }
+
+    // The error of the approximate local time is the drift times the elapsed time, so its effect on the offset is
+    // proportional to the drift squared and negligible.
+    int64_t approximateLocalTimeUs = remoteTimeUs - m_estimate->offsetUs;
+    return remoteTimeUs - *offsetAt(approximateLocalTimeUs);
+}
+
+void ClockOffsetEstimator::updateEstimate()
+{
+    // Keep the quarter of the exchanges with the shortest round trip times
+    vector<int64_t> roundTripTimesUs;
+    roundTripTimesUs.reserve(m_exchanges.size());
+    for (const auto& exchange : m_exchanges)
+    {
+        roundTripTimesUs.push_back(exchange.roundTripTimeUs);
+    }
+    size_t keptCount = max<size_t>(roundTripTimesUs.size() / 4, 1);
+    nth_element(roundTripTimesUs.begin(), roundTripTimesUs.begin() + (keptCount - 1), roundTripTimesUs.end());
+    int64_t maxRoundTripTimeUs = roundTripTimesUs[keptCount - 1];
+    int64_t minRoundTripTimeUs = *min_element(roundTripTimesUs.begin(), roundTripTimesUs.begin() + keptCount);
+
+    vector<const Exchange*> kept;
+    kept.reserve(m_exchanges.size());
+    for (const auto& exchange : m_exchanges)
+    {
+        if (exchange.roundTripTimeUs <= maxRoundTripTimeUs)
+        {
+            kept.push_back(&exchange);
+        }
+    }
+
+    // The regression is done relative to the first kept exchange to keep the precision of the doubles
+    const Exchange& origin = *kept.front();
+    double meanX = 0.0;
+    double meanY = 0.0;
+    for (const Exchange* exchange : kept)
+    {
+        meanX += static_cast<double>(exchange->localTimeUs - origin.localTimeUs);
+        meanY += static_cast<double>(exchange->offsetUs - origin.offsetUs);
+    }
+    meanX /= static_cast<double>(kept.size());
+    meanY /= static_cast<double>(kept.size());
+
+    double driftPpm = 0.0;
+    if (kept.back()->localTimeUs - origin.localTimeUs >= MinDriftSpanUs)
+    {
+        double covariance = 0.0;
+        double variance = 0.0;
+        for (const Exchange* exchange : kept)
+        {
+            double x = static_cast<double>(exchange->localTimeUs - origin.localTimeUs) - meanX;
+            double y = static_cast<double>(exchange->offsetUs - origin.offsetUs) - meanY;
+            covariance += x * y;
+            variance += x * x;
+        }
+        driftPpm = clamp(covariance / variance * MicrosecondsPerSecond, -m_maxDriftPpm, m_maxDriftPpm);
+    }
+
+    ClockOffsetEstimate estimate;
+    estimate.referenceTimeUs = origin.localTimeUs + static_cast<int64_t>(llround(meanX));
+    estimate.offsetUs = origin.offsetUs + static_cast<int64_t>(llround(meanY));
+    estimate.driftPpm = driftPpm;
+    estimate.roundTripTimeUs = minRoundTripTimeUs;
+    estimate.exchangeCount = m_exchanges.size();
+    m_estimate = estimate;
+}
@@ -0,0 +1,60 @@
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunk.h>
+
+using namespace opentera;
+using namespace std;
+
+static void writeUint32(uint8_t* data, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        data[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static uint32_t readUint32(const uint8_t* data)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        value |= static_cast<uint32_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+/**
+ * @brief Writes the header.
+ * @param data The destination, it must have at least DataChannelChunkHeader::Size bytes
+ */
+void DataChannelChunkHeader::write(uint8_t* data) const
+{
+    writeUint32(data, Magic);
+    data[4] = Version;
+    data[5] = binary ? 1 : 0;
+    data[6] = 0;
+    data[7] = 0;
+    writeUint32(data + 8, messageId);
+    writeUint32(data + 12, totalSize);
+    writeUint32(data + 16, offset);
+}
+
+/**
+ * @brief Reads a header.
+ *
+ * @param data The message data
+ * @param size The message size
+ * @return The header, or std::nullopt if the message is not a chunk
+ */
+optional<DataChannelChunkHeader> DataChannelChunkHeader::read(const uint8_t* data, size_t size)
+{
+    if (size < Size || readUint32(data) != Magic || data[4] != Version)
+    {
+        return nullopt;
+    }
+
+    DataChannelChunkHeader header{};
+    header.binary = (data[5] & 1) != 0;
+    header.messageId = readUint32(data + 8);
+    header.totalSize = readUint32(data + 12);
+    header.offset = readUint32(data + 16);
+    return header;
+}
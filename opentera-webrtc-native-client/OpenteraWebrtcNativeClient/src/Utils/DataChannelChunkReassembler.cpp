@@ -0,0 +1,387 @@
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunkReassembler.h>
+
+#include <rtc_base/time_utils.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace opentera;
+using namespace std;
+
+// ranges must be merged
+static bool isRangeReceived(const map<uint64_t, uint64_t>& ranges, uint64_t begin, uint64_t end)
+{
+    auto it = ranges.upper_bound(begin);
+    if (it == ranges.begin())
+    {
+        return false;
+    }
+    --it;
+    return it->second >= end;
+}
+
+// Returns the number of bytes of the range that were not received yet
+static uint64_t addReceivedRange(map<uint64_t, uint64_t>& ranges, uint64_t begin, uint64_t end)
+{
+    auto it = ranges.upper_bound(begin);
+    if (it != ranges.begin() && prev(it)->second >= begin)
+    {
+        --it;
+    }
+
+    uint64_t mergedBegin = begin;
+    uint64_t mergedEnd = end;
+    uint64_t receivedBytes = 0;
+    while (it != ranges.end() && it->first <= end)
+    {
+        uint64_t overlapBegin = max(begin, it->first);
+        uint64_t overlapEnd = min(end, it->second);
+        if (overlapEnd > overlapBegin)
+        {
+            receivedBytes += overlapEnd - overlapBegin;
+        }
+        mergedBegin = min(mergedBegin, it->first);
+        mergedEnd = max(mergedEnd, it->second);
+        it = ranges.erase(it);
+    }
+    ranges[mergedBegin] = mergedEnd;
+    return (end - begin) - receivedBytes;
+}
+
+/**
+ * @brief Creates a chunk reassembler.
+ *
+ * The callbacks are called from the thread that calls handleMessage. The callbacks should not block.
+ *
+ * @parblock
+ * Message callback parameters:
+ * - buffer: The reassembled message, its payload can be kept after the callback returns
+ * @endparblock
+ *
+ * @parblock
+ * Progress callback parameters:
+ * - progress: The progress of the message, it is reported once per received chunk
+ * @endparblock
+ *
+ * @param onMessage The message callback
+ * @param onProgress The progress callback, it can be null
+ * @param maxMessageSize The maximum size of a message, the larger messages are dropped
+ * @param maxPendingMessageCount The maximum number of incomplete messages, the oldest one is dropped when a new
+ * message does not fit
+ * @param timeout The time without chunk after which an incomplete message is dropped
+ * @param maxPendingBytes The maximum number of bytes allocated for the incomplete messages and the pooled buffers,
+ * the pooled buffers are released and then the oldest messages are dropped when a chunk does not fit
+ */
+DataChannelChunkReassembler::DataChannelChunkReassembler(
+    function<void(const webrtc::DataBuffer&)> onMessage,
+    function<void(const DataChannelTransferProgress&)> onProgress,
+    size_t maxMessageSize,
+    size_t maxPendingMessageCount,
+    chrono::milliseconds timeout,
+    size_t maxPendingBytes)
+    : m_onMessage(move(onMessage)),
+      m_onProgress(move(onProgress)),
+      m_maxMessageSize(maxMessageSize),
+      m_maxPendingMessageCount(max<size_t>(maxPendingMessageCount, 1)),
+      m_timeout(timeout),
+      m_maxPendingBytes(maxPendingBytes),
+      m_pendingBytes(0),
+      m_pooledBytes(0),
+      m_droppedMessageCount(0)
+{
+}
+
+/**
+ * @brief Handles a message received from the data channel.
+ *
+ * @param buffer The received message
+ * @return true if the message is a chunk, even if it is dropped, false if it must be handled as a regular message
+ */
+bool DataChannelChunkReassembler::handleMessage(const webrtc::DataBuffer& buffer)
+{
+    if (!buffer.binary)
+    {
+        return false;
+    }
+    auto header = DataChannelChunkHeader::read(buffer.data.cdata(), buffer.size());
+    if (!header)
+    {
+        return false;
+    }
+
+    int64_t nowUs = rtc::TimeMicros();
+    dropExpiredMessages(nowUs);
+
+    size_t payloadSize = buffer.size() - DataChannelChunkHeader::Size;
+    uint64_t chunkEnd = static_cast<uint64_t>(header->offset) + payloadSize;
+    auto it = m_messages.find(header->messageId);
+    bool isValid = header->totalSize <= m_maxMessageSize && chunkEnd <= header->totalSize &&
+                   (it == m_messages.end() || it->second.totalSize == header->totalSize);
+    if (!isValid)
+    {
+        if (it != m_messages.end())
+        {
+            eraseMessage(it);
+        }
+        m_droppedMessageCount++;
+        return true;
+    }
+
+    if (it == m_messages.end())
+    {
+        if (m_messages.size() >= m_maxPendingMessageCount)
+        {
+            dropOldestMessage(header->messageId);
+        }
+        it = m_messages
+                 .emplace(
+                     header->messageId,
+                     Message{acquireBuffer(), {}, header->binary, header->totalSize, {}, 0, nowUs, nowUs})
+                 .first;
+    }
+    else if (isRangeReceived(it->second.receivedRanges, header->offset, chunkEnd))
+    {
+        return true;
+    }
+
+    Message& message = it->second;
+    const uint8_t* payload = buffer.data.cdata() + DataChannelChunkHeader::Size;
+    bool isStored = header->offset <= message.buffer.size()
+                        ? writeChunk(header->messageId, message, header->offset, payload, payloadSize)
+                        : deferChunk(header->messageId, message, header->offset, payload, payloadSize);
+    if (!isStored)
+    {
+        eraseMessage(it);
+        m_droppedMessageCount++;
+        return true;
+    }
+
+    if (payloadSize > 0)
+    {
+        message.receivedBytes += addReceivedRange(message.receivedRanges, header->offset, chunkEnd);
+    }
+    message.lastChunkTimeUs = nowUs;
+
+    if (m_onProgress)
+    {
+        int64_t elapsedTimeUs = nowUs - message.startTimeUs;
+        m_onProgress(DataChannelTransferProgress{
+            header->messageId,
+            message.receivedBytes,
+            header->totalSize,
+            elapsedTimeUs > 0 ? static_cast<double>(message.receivedBytes) * 1e6 / elapsedTimeUs : 0.0});
+    }
+
+    // All bytes are received, so the last chunk filled the last gap and the chunks kept apart are written
+    if (message.receivedBytes >= header->totalSize)
+    {
+        m_pendingBytes -= message.buffer.capacity();
+        rtc::CopyOnWriteBuffer messageBuffer = move(message.buffer);
+        bool binary = message.binary;
+        m_messages.erase(it);
+
+        m_onMessage(webrtc::DataBuffer(messageBuffer, binary));
+        releaseBuffer(move(messageBuffer));
+    }
+    return true;
+}
+
+/**
+ * @brief Drops the incomplete messages.
+ */
+void DataChannelChunkReassembler::clear()
+{
+    while (!m_messages.empty())
+    {
+        eraseMessage(m_messages.begin());
+    }
+}
+
+// The chunk starts in the received bytes, so the chunks kept apart that become contiguous are written after it.
+bool DataChannelChunkReassembler::writeChunk(
+    uint32_t messageId,
+    Message& message,
+    uint64_t offset,
+    const uint8_t* data,
+    size_t size)
+{
+    uint64_t end = offset + size;
+    if (end > message.buffer.size() && !growBuffer(messageId, message, end))
+    {
+        return false;
+    }
+    if (size > 0)
+    {
+        memcpy(message.buffer.MutableData() + offset, data, size);
+    }
+
+    while (!message.deferredChunks.empty() && message.deferredChunks.begin()->first <= message.buffer.size())
+    {
+        auto chunkIt = message.deferredChunks.begin();
+        uint64_t chunkEnd = chunkIt->first + chunkIt->second.size();
+        if (chunkEnd > message.buffer.size())
+        {
+            if (!growBuffer(messageId, message, chunkEnd))
+            {
+                return false;
+            }
+            memcpy(message.buffer.MutableData() + chunkIt->first, chunkIt->second.cdata(), chunkIt->second.size());
+        }
+        m_pendingBytes -= chunkIt->second.capacity();
+        message.deferredChunks.erase(chunkIt);
+    }
+    return true;
+}
+
+// The chunk is after a gap, so it is copied apart instead of growing the buffer up to its end.
+bool DataChannelChunkReassembler::deferChunk(
+    uint32_t messageId,
+    Message& message,
+    uint64_t offset,
+    const uint8_t* data,
+    size_t size)
+{
+    auto chunkIt = message.deferredChunks.find(offset);
+    if (size == 0 || (chunkIt != message.deferredChunks.end() && chunkIt->second.size() >= size))
+    {
+        return true;
+    }
+    if (!reserveBytes(messageId, size))
+    {
+        return false;
+    }
+
+    rtc::CopyOnWriteBuffer chunk(data, size);
+    m_pendingBytes += chunk.capacity();
+    if (chunkIt != message.deferredChunks.end())
+    {
+        m_pendingBytes -= chunkIt->second.capacity();
+        chunkIt->second = move(chunk);
+    }
+    else
+    {
+        message.deferredChunks.emplace(offset, move(chunk));
+    }
+    return true;
+}
+
+// The buffer capacity is at least doubled, so a message received in order is not copied for each chunk, unless the
+// doubled capacity does not fit in the pending bytes.
+bool DataChannelChunkReassembler::growBuffer(uint32_t messageId, Message& message, size_t size)
+{
+    size_t capacity = message.buffer.capacity();
+    if (size > capacity)
+    {
+        size_t newCapacity = min<size_t>(max(size, 2 * capacity), message.totalSize);
+        if (m_pendingBytes + m_pooledBytes + (newCapacity - capacity) > m_maxPendingBytes)
+        {
+            newCapacity = size;
+        }
+        if (!reserveBytes(messageId, newCapacity - capacity))
+        {
+            return false;
+        }
+
+        message.buffer.EnsureCapacity(newCapacity);
+        m_pendingBytes += message.buffer.capacity() - capacity;
+    }
+    message.buffer.SetSize(size);
+    return true;
+}
+
+// The pooled buffers are released before the oldest messages are dropped.
+bool DataChannelChunkReassembler::reserveBytes(uint32_t messageId, uint64_t size)
+{
+    while (m_pendingBytes + m_pooledBytes + size > m_maxPendingBytes)
+    {
+        if (!m_bufferPool.empty())
+        {
+            m_pooledBytes -= m_bufferPool.back().capacity();
+            m_bufferPool.pop_back();
+        }
+        else if (!dropOldestMessage(messageId))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+void DataChannelChunkReassembler::dropExpiredMessages(int64_t nowUs)
+{
+    int64_t timeoutUs = chrono::duration_cast<chrono::microseconds>(m_timeout).count();
+    for (auto it = m_messages.begin(); it != m_messages.end();)
+    {
+        if (nowUs - it->second.lastChunkTimeUs > timeoutUs)
+        {
+            auto expiredIt = it++;
+            eraseMessage(expiredIt);
+            m_droppedMessageCount++;
+        }
+        else
+        {
+            ++it;
+        }
+    }
+}
+
+bool DataChannelChunkReassembler::dropOldestMessage(uint32_t keptMessageId)
+{
+    auto oldestIt = m_messages.end();
+    for (auto it = m_messages.begin(); it != m_messages.end(); ++it)
+    {
+        if (it->first != keptMessageId &&
+            (oldestIt == m_messages.end() || it->second.lastChunkTimeUs < oldestIt->second.lastChunkTimeUs))
+        {
+            oldestIt = it;
+        }
+    }
+    if (oldestIt == m_messages.end())
+    {
+        return false;
+    }
+
+    eraseMessage(oldestIt);
+    m_droppedMessageCount++;
+    return true;
+}
+
+void DataChannelChunkReassembler::eraseMessage(unordered_map<uint32_t, Message>::iterator it)
+{
+    for (const auto& pair : it->second.deferredChunks)
+    {
+        m_pendingBytes -= pair.second.capacity();
+    }
+    m_pendingBytes -= it->second.buffer.capacity();
+    releaseBuffer(move(it->second.buffer));
+    m_messages.erase(it);
+}
+
+// Clear does not copy a buffer that is still shared with a delivered message, it allocates a new one with the same
+// capacity instead. The capacity moves from the pooled bytes to the pending bytes.
+rtc::CopyOnWriteBuffer DataChannelChunkReassembler::acquireBuffer()
+{
+    if (m_bufferPool.empty())
+    {
+        return rtc::CopyOnWriteBuffer();
+    }
+
+    rtc::CopyOnWriteBuffer buffer = move(m_bufferPool.back());
+    m_bufferPool.pop_back();
+    m_pooledBytes -= buffer.capacity();
+    buffer.Clear();
+    m_pendingBytes += buffer.capacity();
+    return buffer;
+}
+
+// A buffer is only pooled if its capacity fits in the pending bytes.
+void DataChannelChunkReassembler::releaseBuffer(rtc::CopyOnWriteBuffer buffer)
+{
+    size_t capacity = buffer.capacity();
+    if (capacity > 0 && m_bufferPool.size() < MaxPooledBufferCount &&
+        m_pendingBytes + m_pooledBytes + capacity <= m_maxPendingBytes)
+    {
+        m_bufferPool.push_back(move(buffer));
+        m_pooledBytes += capacity;
+    }
+}
@@ -0,0 +1,279 @@
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunkSender.h>
+
+#include <rtc_base/time_utils.h>
+
+#include <algorithm>
+#include <cstring>
+
+using namespace opentera;
+using namespace std;
+
+/**
+ * @brief Creates a chunk sender.
+ *
+ * The send function must return false without calling its completion callback when the chunk is rejected.
+ * Otherwise, it must call the completion callback once the data channel accepted the chunk or failed.
+ *
+ * @param send The function that sends a chunk, typically DataChannelSendQueue::send
+ * @param maxChunkSize The maximum size of a chunk, including its header
+ * @param maxInFlightChunkCount The maximum number of chunks handed to the send function and not completed yet
+ */
+DataChannelChunkSender::DataChannelChunkSender(
+    function<bool(const webrtc::DataBuffer&, function<void(bool)>)> send,
+    size_t maxChunkSize,
+    size_t maxInFlightChunkCount)
+    : m_send(move(send)),
+      m_maxInFlightChunkCount(max<size_t>(maxInFlightChunkCount, 1)),
+      m_maxChunkSize(max(maxChunkSize, DataChannelChunkHeader::Size + 1)),
+      m_nextMessageId(0),
+      m_inFlightChunkCount(0),
+      m_isPumping(false)
+{
+}
+
+DataChannelChunkSender::~DataChannelChunkSender()
+{
+    cancel();
+}
+
+/**
+ * @brief Sends a message in chunks.
+ *
+ * The callbacks are called from the thread that completes the chunks. The callbacks should not block.
+ *
+ * @parblock
+ * Progress callback parameters:
+ * - progress: The progress of the message, it is reported once per accepted chunk
+ * @endparblock
+ *
+ * @parblock
+ * Completion callback parameters:
+ * - sent: true if the data channel accepted all the chunks, false if a chunk failed or the transfer was cancelled
+ * @endparblock
+ *
+ * @param buffer The message, its payload is not copied until its chunks are sent
+ * @param onProgress The progress callback, it can be null
+ * @param onComplete The completion callback, it can be null
+ * @return true if the message is pending, false if it is larger than MaxMessageSize
+ */
+bool DataChannelChunkSender::send(
+    const webrtc::DataBuffer& buffer,
+    function<void(const DataChannelTransferProgress&)> onProgress,
+    function<void(bool)> onComplete)
+{
+    if (buffer.size() > MaxMessageSize)
+    {
+        return false;
+    }
+
+    {
+        // A new message sends its first chunk before the next chunk of the current messages
+        lock_guard<mutex> lock(m_mutex);
+        m_transfers.push_front(make_shared<Transfer>(Transfer{
+            m_nextMessageId++,
+            buffer,
+            0,
+            0,
+            0,
+            0,
+            rtc::TimeMicros(),
+            false,
+            move(onProgress),
+            move(onComplete)}));
+    }
+
+    pump();
+    return true;
+}
+
+/**
+ * @brief Cancels the pending messages. Their completion callbacks are called with false.
+ *
+ * The chunks already handed to the send function are not recalled, so the receiver can get an incomplete message.
+ */
+void DataChannelChunkSender::cancel()
+{
+    list<shared_ptr<Transfer>> transfers;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        swap(transfers, m_transfers);
+        for (auto& transfer : transfers)
+        {
+            transfer->isDone = true;
+        }
+    }
+
+    for (auto& transfer : transfers)
+    {
+        if (transfer->onComplete)
+        {
+            transfer->onComplete(false);
+        }
+    }
+}
+
+/**
+ * @brief Changes the maximum size of the next chunks, typically to the negotiated max message size.
+ * @param maxChunkSize The maximum size of a chunk, including its header
+ */
+void DataChannelChunkSender::setMaxChunkSize(size_t maxChunkSize)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_maxChunkSize = max(maxChunkSize, DataChannelChunkHeader::Size + 1);
+}
+
+/**
+ * @brief Returns the maximum size of a chunk, including its header.
+ * @return The maximum size of a chunk
+ */
+size_t DataChannelChunkSender::maxChunkSize()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_maxChunkSize;
+}
+
+/**
+ * @brief Returns the number of messages that are not completely sent.
+ * @return The number of messages that are not completely sent
+ */
+size_t DataChannelChunkSender::pendingMessageCount()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_transfers.size();
+}
+
+// Only one thread pumps at a time (m_isPumping), so a completion called from the send function does not recurse.
+void DataChannelChunkSender::pump()
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_isPumping)
+        {
+            return;
+        }
+        m_isPumping = true;
+    }
+
+    while (true)
+    {
+        shared_ptr<Transfer> transfer;
+        rtc::CopyOnWriteBuffer chunk;
+        size_t payloadSize;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            auto it = find_if(
+                m_transfers.begin(),
+                m_transfers.end(),
+                [](const shared_ptr<Transfer>& t)
+                { return t->nextOffset < t->buffer.size() || t->sentChunkCount == 0; });
+            if (m_inFlightChunkCount >= m_maxInFlightChunkCount || it == m_transfers.end())
+            {
+                m_isPumping = false;
+                return;
+            }
+
+            // Round-robin between the messages
+            transfer = *it;
+            m_transfers.splice(m_transfers.end(), m_transfers, it);
+
+            payloadSize =
+                min(m_maxChunkSize - DataChannelChunkHeader::Size, transfer->buffer.size() - transfer->nextOffset);
+            DataChannelChunkHeader header{
+                transfer->messageId,
+                transfer->buffer.binary,
+                static_cast<uint32_t>(transfer->buffer.size()),
+                static_cast<uint32_t>(transfer->nextOffset)};
+
+            chunk = rtc::CopyOnWriteBuffer(DataChannelChunkHeader::Size + payloadSize);
+            header.write(chunk.MutableData());
+            if (payloadSize > 0)
+            {
+                memcpy(
+                    chunk.MutableData() + DataChannelChunkHeader::Size,
+                    transfer->buffer.data.cdata() + transfer->nextOffset,
+                    payloadSize);
+            }
+
+            transfer->nextOffset += payloadSize;
+            transfer->sentChunkCount++;
+            transfer->inFlightChunkCount++;
+            m_inFlightChunkCount++;
+        }
+
+        bool accepted = m_send(
+            webrtc::DataBuffer(chunk, true),
+            [this, transfer, payloadSize](bool sent) { onChunkComplete(transfer, payloadSize, sent); });
+        if (!accepted)
+        {
+            {
+                lock_guard<mutex> lock(m_mutex);
+                transfer->inFlightChunkCount--;
+                m_inFlightChunkCount--;
+            }
+            fail(transfer);
+        }
+    }
+}
+
+void DataChannelChunkSender::onChunkComplete(const shared_ptr<Transfer>& transfer, size_t payloadSize, bool sent)
+{
+    optional<DataChannelTransferProgress> progress;
+    bool isCompleted = false;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        transfer->inFlightChunkCount--;
+        m_inFlightChunkCount--;
+
+        if (sent && !transfer->isDone)
+        {
+            transfer->acceptedBytes += payloadSize;
+
+            int64_t elapsedTimeUs = rtc::TimeMicros() - transfer->startTimeUs;
+            progress = DataChannelTransferProgress{
+                transfer->messageId,
+                transfer->acceptedBytes,
+                transfer->buffer.size(),
+                elapsedTimeUs > 0 ? static_cast<double>(transfer->acceptedBytes) * 1e6 / elapsedTimeUs : 0.0};
+
+            if (transfer->nextOffset == transfer->buffer.size() && transfer->inFlightChunkCount == 0)
+            {
+                isCompleted = true;
+                transfer->isDone = true;
+                m_transfers.remove(transfer);
+            }
+        }
+    }
+
+    if (!sent)
+    {
+        fail(transfer);
+    }
+    else if (progress && transfer->onProgress)
+    {
+        transfer->onProgress(*progress);
+    }
+    if (isCompleted && transfer->onComplete)
+    {
+        transfer->onComplete(true);
+    }
+
+    pump();
+}
+
+void DataChannelChunkSender::fail(const shared_ptr<Transfer>& transfer)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (transfer->isDone)
+        {
+            return;
+        }
+        transfer->isDone = true;
+        m_transfers.remove(transfer);
+    }
+
+    if (transfer->onComplete)
+    {
+        transfer->onComplete(false);
+    }
+}
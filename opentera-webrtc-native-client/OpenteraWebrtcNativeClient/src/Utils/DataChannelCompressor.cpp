@@ -0,0 +1,376 @@
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelCompressor.h>
+
+#include <rtc_base/time_utils.h>
+
+#ifdef USE_ZSTD
+#include <zstd.h>
+#endif
+
+using namespace opentera;
+using namespace std;
+
+static void writeUint32(uint8_t* data, uint32_t value)
+{
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        data[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+static uint32_t readUint32(const uint8_t* data)
+{
+    uint32_t value = 0;
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        value |= static_cast<uint32_t>(data[i]) << (8 * i);
+    }
+    return value;
+}
+
+static constexpr uint8_t BinaryFlag = 1;
+static constexpr uint8_t AcknowledgementFlag = 2;
+
+static void writeHeader(
+    uint8_t* header,
+    DataChannelCompressionCodec codec,
+    uint8_t flags,
+    uint32_t uncompressedSize,
+    uint32_t dictionaryId)
+{
+    writeUint32(header, DataChannelCompressor::Magic);
+    header[4] = DataChannelCompressor::Version;
+    header[5] = static_cast<uint8_t>(codec);
+    header[6] = flags;
+    header[7] = 0;
+    writeUint32(header + 8, uncompressedSize);
+    writeUint32(header + 12, dictionaryId);
+}
+
+static string createAdvertisementToken(DataChannelCompressionCodec codec, uint32_t dictionaryId)
+{
+    return string(DataChannelCompressor::ProtocolPrefix) + to_string(DataChannelCompressor::Version) + "/" +
+           to_string(static_cast<int>(codec)) + "/" + to_string(dictionaryId);
+}
+
+// FNV-1a, so the peers detect a dictionary mismatch instead of decoding garbage
+static uint32_t computeDictionaryId(const vector<uint8_t>& dictionary)
+{
+    if (dictionary.empty())
+    {
+        return 0;
+    }
+
+    uint32_t hash = 2166136261u;
+    for (uint8_t byte : dictionary)
+    {
+        hash ^= byte;
+        hash *= 16777619u;
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+#ifdef USE_ZSTD
+struct DataChannelCompressor::Contexts
+{
+    ZSTD_CCtx* compressionContext = nullptr;
+    ZSTD_DCtx* decompressionContext = nullptr;
+    ZSTD_CDict* compressionDictionary = nullptr;
+    ZSTD_DDict* decompressionDictionary = nullptr;
+
+    ~Contexts()
+    {
+        ZSTD_freeCCtx(compressionContext);
+        ZSTD_freeDCtx(decompressionContext);
+        ZSTD_freeCDict(compressionDictionary);
+        ZSTD_freeDDict(decompressionDictionary);
+    }
+};
+#else
+struct DataChannelCompressor::Contexts
+{
+};
+#endif
+
+/**
+ * @brief Creates a compressor.
+ *
+ * When the codec is not supported by the library build, the messages are not compressed, but the uncompressed
+ * messages of the peers are still received.
+ *
+ * @param codec The codec of the compressed messages
+ * @param threshold The size from which the messages are compressed
+ * @param level The codec compression level, the higher levels are slower
+ * @param dictionary The dictionary, it must be the same for both peers and it can be empty
+ * @param maxUncompressedSize The maximum uncompressed size of a received message
+ */
+DataChannelCompressor::DataChannelCompressor(
+    DataChannelCompressionCodec codec,
+    size_t threshold,
+    int level,
+    vector<uint8_t> dictionary,
+    size_t maxUncompressedSize)
+    : m_codec(isSupported(codec) ? codec : DataChannelCompressionCodec::None),
+      m_threshold(threshold),
+      m_level(level),
+      m_dictionary(move(dictionary)),
+      m_dictionaryId(computeDictionaryId(m_dictionary)),
+      m_maxUncompressedSize(maxUncompressedSize),
+      m_contexts(make_unique<Contexts>())
+{
+#ifdef USE_ZSTD
+    m_contexts->compressionContext = ZSTD_createCCtx();
+    m_contexts->decompressionContext = ZSTD_createDCtx();
+    if (!m_dictionary.empty())
+    {
+        m_contexts->compressionDictionary = ZSTD_createCDict(m_dictionary.data(), m_dictionary.size(), m_level);
+        m_contexts->decompressionDictionary = ZSTD_createDDict(m_dictionary.data(), m_dictionary.size());
+    }
+#endif
+}
+
+DataChannelCompressor::~DataChannelCompressor() = default;
+
+/**
+ * @brief Indicates if a codec is supported by the library build.
+ *
+ * @param codec The codec
+ * @return true if the codec is supported
+ */
+bool DataChannelCompressor::isSupported(DataChannelCompressionCodec codec)
+{
+    switch (codec)
+    {
+        case DataChannelCompressionCodec::None:
+            return true;
+        case DataChannelCompressionCodec::Zstd:
+#ifdef USE_ZSTD
+            return true;
+#else
+            return false;
+#endif
+        default:
+            return false;
+    }
+}
+
+/**
+ * @brief Adds the codec and the dictionary of the compressor to a data channel protocol.
+ *
+ * The protocol is returned as is when the codec is not supported, so the peer never compresses its messages.
+ *
+ * @param protocol The data channel protocol, it can be empty
+ * @return The data channel protocol advertising the compression
+ */
+string DataChannelCompressor::advertise(const string& protocol) const
+{
+    if (m_codec == DataChannelCompressionCodec::None)
+    {
+        return protocol;
+    }
+
+    string token = createAdvertisementToken(m_codec, m_dictionaryId);
+    return protocol.empty() ? token : protocol + ";" + token;
+}
+
+/**
+ * @brief Indicates if a data channel protocol advertises the codec and the dictionary of the compressor.
+ *
+ * @param protocol The data channel protocol of the peer
+ * @return true if the messages can be compressed toward the peer
+ */
+bool DataChannelCompressor::isAdvertisedBy(const string& protocol) const
+{
+    if (m_codec == DataChannelCompressionCodec::None)
+    {
+        return false;
+    }
+
+    string token = createAdvertisementToken(m_codec, m_dictionaryId);
+    size_t start = 0;
+    while (start <= protocol.size())
+    {
+        size_t end = protocol.find(';', start);
+        if (end == string::npos)
+        {
+            end = protocol.size();
+        }
+        if (protocol.compare(start, end - start, token) == 0)
+        {
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+/**
+ * @brief Creates the message acknowledging the compression advertised by the peer.
+ * @return The acknowledgement
+ */
+webrtc::DataBuffer DataChannelCompressor::createAcknowledgement() const
+{
+    rtc::CopyOnWriteBuffer acknowledgement(HeaderSize);
+    writeHeader(acknowledgement.MutableData(), m_codec, AcknowledgementFlag, 0, m_dictionaryId);
+    return webrtc::DataBuffer(acknowledgement, true);
+}
+
+/**
+ * @brief Indicates if a received message acknowledges the compression with the codec and the dictionary of the
+ * compressor.
+ *
+ * @param message The received message
+ * @return true if the messages can be compressed toward the peer
+ */
+bool DataChannelCompressor::isAcknowledgement(const webrtc::DataBuffer& message) const
+{
+    const uint8_t* data = message.data.cdata();
+    return m_codec != DataChannelCompressionCodec::None && message.binary && message.size() == HeaderSize &&
+           readUint32(data) == Magic && data[4] == Version && data[5] == static_cast<uint8_t>(m_codec) &&
+           (data[6] & AcknowledgementFlag) != 0 && readUint32(data + 12) == m_dictionaryId;
+}
+
+/**
+ * @brief Compresses a message when it is large enough and it shrinks.
+ *
+ * @param message The message
+ * @return The compressed message, or the message itself
+ */
+webrtc::DataBuffer DataChannelCompressor::compress(const webrtc::DataBuffer& message)
+{
+    lock_guard<mutex> lock(m_mutex);
+    if (m_codec == DataChannelCompressionCodec::None || message.size() < m_threshold ||
+        message.size() > m_maxUncompressedSize)
+    {
+        m_stats.uncompressedMessageCount++;
+        return message;
+    }
+
+#ifdef USE_ZSTD
+    int64_t startTimeUs = rtc::TimeMicros();
+
+    rtc::CopyOnWriteBuffer compressed(HeaderSize + ZSTD_compressBound(message.size()));
+    uint8_t* destination = compressed.MutableData() + HeaderSize;
+    size_t capacity = compressed.size() - HeaderSize;
+    size_t compressedSize =
+        m_contexts->compressionDictionary != nullptr
+            ? ZSTD_compress_usingCDict(
+                  m_contexts->compressionContext,
+                  destination,
+                  capacity,
+                  message.data.cdata(),
+                  message.size(),
+                  m_contexts->compressionDictionary)
+            : ZSTD_compressCCtx(
+                  m_contexts->compressionContext,
+                  destination,
+                  capacity,
+                  message.data.cdata(),
+                  message.size(),
+                  m_level);
+
+    m_stats.compressionTimeUs += rtc::TimeMicros() - startTimeUs;
+    if (ZSTD_isError(compressedSize) || HeaderSize + compressedSize >= message.size())
+    {
+        m_stats.uncompressedMessageCount++;
+        return message;
+    }
+
+    writeHeader(
+        compressed.MutableData(),
+        m_codec,
+        message.binary ? BinaryFlag : 0,
+        static_cast<uint32_t>(message.size()),
+        m_dictionaryId);
+    compressed.SetSize(HeaderSize + compressedSize);
+
+    m_stats.compressedMessageCount++;
+    m_stats.uncompressedBytes += message.size();
+    m_stats.compressedBytes += compressed.size();
+    return webrtc::DataBuffer(compressed, true);
+#else
+    m_stats.uncompressedMessageCount++;
+    return message;
+#endif
+}
+
+/**
+ * @brief Decompresses a message if it is compressed.
+ *
+ * @param message The received message
+ * @return The decompressed message, the message itself if it is not compressed, or std::nullopt if it cannot be
+ * decompressed (unsupported codec, other dictionary or corrupted payload)
+ */
+optional<webrtc::DataBuffer> DataChannelCompressor::decompress(const webrtc::DataBuffer& message)
+{
+    const uint8_t* data = message.data.cdata();
+    if (!message.binary || message.size() < HeaderSize || readUint32(data) != Magic || data[4] != Version)
+    {
+        return message;
+    }
+
+    auto codec = static_cast<DataChannelCompressionCodec>(data[5]);
+    bool binary = (data[6] & BinaryFlag) != 0;
+    size_t uncompressedSize = readUint32(data + 8);
+    uint32_t dictionaryId = readUint32(data + 12);
+
+    lock_guard<mutex> lock(m_mutex);
+    if (codec != DataChannelCompressionCodec::Zstd || !isSupported(codec) || dictionaryId != m_dictionaryId ||
+        uncompressedSize > m_maxUncompressedSize)
+    {
+        m_stats.decompressionErrorCount++;
+        return nullopt;
+    }
+
+#ifdef USE_ZSTD
+    int64_t startTimeUs = rtc::TimeMicros();
+
+    rtc::CopyOnWriteBuffer decompressed(uncompressedSize);
+    size_t decompressedSize =
+        m_contexts->decompressionDictionary != nullptr
+            ? ZSTD_decompress_usingDDict(
+                  m_contexts->decompressionContext,
+                  decompressed.MutableData(),
+                  uncompressedSize,
+                  data + HeaderSize,
+                  message.size() - HeaderSize,
+                  m_contexts->decompressionDictionary)
+            : ZSTD_decompressDCtx(
+                  m_contexts->decompressionContext,
+                  decompressed.MutableData(),
+                  uncompressedSize,
+                  data + HeaderSize,
+                  message.size() - HeaderSize);
+
+    m_stats.decompressionTimeUs += rtc::TimeMicros() - startTimeUs;
+    if (ZSTD_isError(decompressedSize) || decompressedSize != uncompressedSize)
+    {
+        m_stats.decompressionErrorCount++;
+        return nullopt;
+    }
+
+    m_stats.decompressedMessageCount++;
+    return webrtc::DataBuffer(decompressed, binary);
+#else
+    m_stats.decompressionErrorCount++;
+    return nullopt;
+#endif
+}
+
+/**
+ * @brief Returns the statistics.
+ * @return The statistics
+ */
+DataChannelCompressionStats DataChannelCompressor::stats()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_stats;
+}
+
+/**
+ * @brief Resets the statistics.
+ */
+void DataChannelCompressor::resetStats()
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_stats = DataChannelCompressionStats();
+}
@@ -0,0 +1,242 @@
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelSendQueue.h>
+
+#include <optional>
+
+using namespace opentera;
+using namespace std;
+
+/**
+ * @brief Creates a send queue for a data channel.
+ *
+ * @param dataChannel The data channel
+ * @param highWatermark The buffered amount, in bytes, above which the messages are queued
+ * @param lowWatermark The buffered amount, in bytes, at which a paused queue resumes
+ * @param maxQueuedBytes The maximum number of queued bytes, the messages that do not fit are rejected
+ */
+DataChannelSendQueue::DataChannelSendQueue(
+    rtc::scoped_refptr<webrtc::DataChannelInterface> dataChannel,
+    uint64_t highWatermark,
+    uint64_t lowWatermark,
+    uint64_t maxQueuedBytes)
+    : DataChannelSendQueue(
+          [dataChannel](const webrtc::DataBuffer& buffer) { return dataChannel->Send(buffer); },
+          [dataChannel]() { return dataChannel->buffered_amount(); },
+          highWatermark,
+          lowWatermark,
+          maxQueuedBytes)
+{
+}
+
+/**
+ * @brief Creates a send queue with functions.
+ *
+ * @param send The function that sends a message
+ * @param bufferedAmount The function that returns the buffered amount of the data channel
+ * @param highWatermark The buffered amount, in bytes, above which the messages are queued
+ * @param lowWatermark The buffered amount, in bytes, at which a paused queue resumes
+ * @param maxQueuedBytes The maximum number of queued bytes, the messages that do not fit are rejected
+ */
+DataChannelSendQueue::DataChannelSendQueue(
+    function<bool(const webrtc::DataBuffer&)> send,
+    function<uint64_t()> bufferedAmount,
+    uint64_t highWatermark,
+    uint64_t lowWatermark,
+    uint64_t maxQueuedBytes)
+    : m_send(move(send)),
+      m_bufferedAmount(move(bufferedAmount)),
+      m_highWatermark(highWatermark),
+      m_lowWatermark(min(lowWatermark, highWatermark)),
+      m_maxQueuedBytes(maxQueuedBytes),
+      m_queuedBytes(0),
+      m_isPaused(false),
+      m_isDraining(false),
+      m_hasBufferedAmountChanged(false)
+{
+}
+
+DataChannelSendQueue::~DataChannelSendQueue()
+{
+    clear();
+}
+
+/**
+ * @brief Sends a message now or queues it.
+ *
+ * The completion callback is called from the thread that sends the message, which can be the calling thread or
+ * the thread calling onBufferedAmountChange. The callback should not block.
+ *
+ * @parblock
+ * Callback parameters:
+ * - sent: true if the data channel accepted the message, false if it failed or the queue was cleared
+ * @endparblock
+ *
+ * @param buffer The message
+ * @param priority The message priority
+ * @param onComplete The completion callback, it can be null
+ * @return true if the message is sent or queued, false if the queue is full
+ */
+bool DataChannelSendQueue::send(
+    const webrtc::DataBuffer& buffer,
+    DataChannelSendPriority priority,
+    function<void(bool)> onComplete)
+{
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_queuedBytes + buffer.size() > m_maxQueuedBytes)
+        {
+            return false;
+        }
+
+        auto& entries = priority == DataChannelSendPriority::High ? m_highPriorityEntries : m_normalPriorityEntries;
+        entries.push_back(Entry{buffer, move(onComplete)});
+        m_queuedBytes += buffer.size();
+
+        if (m_isDraining)
+        {
+            return true;
+        }
+        m_isDraining = true;
+    }
+
+    drain();
+    return true;
+}
+
+/**
+ * @brief Resumes the queue when the buffered amount is low enough.
+ */
+void DataChannelSendQueue::onBufferedAmountChange()
+{
+    uint64_t bufferedAmount = m_bufferedAmount();
+    {
+        lock_guard<mutex> lock(m_mutex);
+        if (m_isPaused && bufferedAmount <= m_lowWatermark)
+        {
+            m_isPaused = false;
+        }
+        if (m_isDraining)
+        {
+            // The draining thread may have read the buffered amount before this change
+            m_hasBufferedAmountChanged = true;
+            return;
+        }
+        if (!hasSendableEntry())
+        {
+            return;
+        }
+        m_isDraining = true;
+    }
+
+    drain();
+}
+
+/**
+ * @brief Removes the queued messages. Their completion callbacks are called with false.
+ */
+void DataChannelSendQueue::clear()
+{
+    deque<Entry> highPriorityEntries;
+    deque<Entry> normalPriorityEntries;
+    {
+        lock_guard<mutex> lock(m_mutex);
+        swap(highPriorityEntries, m_highPriorityEntries);
+        swap(normalPriorityEntries, m_normalPriorityEntries);
+        m_queuedBytes = 0;
+        m_isPaused = false;
+    }
+
+    for (auto* entries : {&highPriorityEntries, &normalPriorityEntries})
+    {
+        for (auto& entry : *entries)
+        {
+            if (entry.onComplete)
+            {
+                entry.onComplete(false);
+            }
+        }
+    }
+}
+
+/**
+ * @brief Returns the number of queued messages.
+ * @return The number of queued messages
+ */
+size_t DataChannelSendQueue::queuedMessageCount()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_highPriorityEntries.size() + m_normalPriorityEntries.size();
+}
+
+/**
+ * @brief Returns the number of queued bytes.
+ * @return The number of queued bytes
+ */
+uint64_t DataChannelSendQueue::queuedBytes()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_queuedBytes;
+}
+
+/**
+ * @brief Indicates if the normal priority messages wait for the low watermark.
+ * @return true if the normal priority messages wait for the low watermark
+ */
+bool DataChannelSendQueue::isPaused()
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_isPaused;
+}
+
+// m_mutex must be locked
+bool DataChannelSendQueue::hasSendableEntry() const
+{
+    return !m_highPriorityEntries.empty() || (!m_isPaused && !m_normalPriorityEntries.empty());
+}
+
+// Only one thread drains at a time (m_isDraining), so the entries are sent in order without calling the data
+// channel with m_mutex locked.
+void DataChannelSendQueue::drain()
+{
+    while (true)
+    {
+        optional<Entry> entry;
+        deque<Entry>* entries;
+        {
+            lock_guard<mutex> lock(m_mutex);
+            if (!hasSendableEntry())
+            {
+                m_isDraining = false;
+                return;
+            }
+
+            entries = m_highPriorityEntries.empty() ? &m_normalPriorityEntries : &m_highPriorityEntries;
+            entry = move(entries->front());
+            entries->pop_front();
+            m_queuedBytes -= entry->buffer.size();
+            m_hasBufferedAmountChanged = false;
+        }
+
+        uint64_t bufferedAmount = m_bufferedAmount();
+        if (bufferedAmount > 0 && bufferedAmount + entry->buffer.size() > m_highWatermark)
+        {
+            // The data channel calls onBufferedAmountChange again since its buffered amount is not 0. A change
+            // that happened after the buffered amount was read did not resume the queue, so it is read again.
+            lock_guard<mutex> lock(m_mutex);
+            m_queuedBytes += entry->buffer.size();
+            entries->push_front(move(*entry));
+            if (m_hasBufferedAmountChanged)
+            {
+                continue;
+            }
+            m_isPaused = true;
+            m_isDraining = false;
+            return;
+        }
+
+        bool sent = m_send(entry->buffer);
+        if (entry->onComplete)
+        {
+            entry->onComplete(sent);
+        }
+    }
+}
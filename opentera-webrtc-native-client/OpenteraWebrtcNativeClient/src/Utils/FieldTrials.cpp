@@ -0,0 +1,50 @@
+#include <OpenteraWebrtcNativeClient/Utils/FieldTrials.h>
+
+#include <system_wrappers/include/field_trial.h>
+
+#include <list>
+#include <mutex>
+
+using namespace opentera;
+using namespace std;
+
+/**
+ * @brief Creates the field trials that force the playout delay of all received videos.
+ *
+ * The playout delay is usually set by the sender with the playout-delay RTP header extension. A maximum playout delay
+ * of 0 renders the frames as soon as they are decoded, so the render pacing between the frames is also disabled.
+ *
+ * @param minimumPlayoutDelay The minimum playout delay
+ * @param maximumPlayoutDelay The maximum playout delay
+ * @return The field trials to give to initializeFieldTrials
+ */
+string opentera::createPlayoutDelayFieldTrials(
+    chrono::milliseconds minimumPlayoutDelay,
+    chrono::milliseconds maximumPlayoutDelay)
+{
+    string fieldTrials = "WebRTC-ForcePlayoutDelay/min_ms:" + to_string(minimumPlayoutDelay.count()) +
+                         ",max_ms:" + to_string(maximumPlayoutDelay.count()) + "/";
+    if (maximumPlayoutDelay.count() == 0)
+    {
+        fieldTrials += "WebRTC-ZeroPlayoutDelay/min_pacing:0ms/";
+    }
+    return fieldTrials;
+}
+
+/**
+ * @brief Initializes the WebRTC field trials of the process.
+ *
+ * The field trials apply to all clients and must be initialized before the clients are created.
+ *
+ * @param fieldTrials The field trials (for example, "WebRTC-Name/Value/WebRTC-OtherName/OtherValue/")
+ */
+void opentera::initializeFieldTrials(const string& fieldTrials)
+{
+    // WebRTC keeps a pointer to the string, so the strings of the previous calls are kept alive
+    static mutex fieldTrialsMutex;
+    static list<string> fieldTrialsStrings;
+
+    lock_guard<mutex> lock(fieldTrialsMutex);
+    fieldTrialsStrings.emplace_back(fieldTrials);
+    webrtc::field_trial::InitFieldTrialsFromString(fieldTrialsStrings.back().c_str());
+}
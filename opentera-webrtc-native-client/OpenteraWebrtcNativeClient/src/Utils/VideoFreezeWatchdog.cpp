@@ -0,0 +1,158 @@
+#include <OpenteraWebrtcNativeClient/Utils/VideoFreezeWatchdog.h>
+
+using namespace opentera;
+using namespace std;
+
+static int64_t toMicroseconds(chrono::milliseconds duration)
+{
+    return chrono::duration_cast<chrono::microseconds>(duration).count();
+}
+
+/**
+ * @brief Creates a frozen video watchdog.
+ *
+ * @param configuration The watchdog configuration
+ */
+VideoFreezeWatchdog::VideoFreezeWatchdog(VideoFreezeWatchdogConfiguration configuration)
+    : m_configuration(move(configuration)),
+      m_isFrozen(false),
+      m_keyFrameRequestCount(0),
+      m_isIceRestarted(false),
+      m_isIceRestartSkipped(false),
+      m_isReconnectionRequested(false),
+      m_stats{0, 0, 0, 0, 0}
+{
+}
+
+/**
+ * @brief Reports a decoded frame, which arms the watchdog and ends the current freeze.
+ * @param timeUs The current time in microseconds
+ */
+void VideoFreezeWatchdog::onFrameDecoded(int64_t timeUs)
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_lastFrameTimeUs = timeUs;
+
+    if (m_isFrozen)
+    {
+        m_isFrozen = false;
+        m_stats.recoveredFreezeCount++;
+        resetEscalation();
+    }
+}
+
+/**
+ * @brief Checks the decoded frame timeout and chooses the next recovery step.
+ *
+ * The key frames are requested first, keyFrameRequestInterval apart. ICE is restarted keyFrameRequestInterval after
+ * the last key frame request. A reconnection is requested iceRestartTimeout after the ICE restart, or at the next
+ * update if the ICE restart is skipped. The reconnection is requested once.
+ *
+ * @param timeUs The current time in microseconds
+ * @return The recovery step to perform, or std::nullopt if there is nothing to do
+ */
+optional<VideoFreezeRecoveryStep> VideoFreezeWatchdog::update(int64_t timeUs)
+{
+    lock_guard<mutex> lock(m_mutex);
+    if (!m_lastFrameTimeUs.has_value() || m_isReconnectionRequested ||
+        timeUs - *m_lastFrameTimeUs < toMicroseconds(m_configuration.frozenTimeout()))
+    {
+        return nullopt;
+    }
+
+    if (!m_isFrozen)
+    {
+        m_isFrozen = true;
+        m_stats.freezeCount++;
+    }
+
+    int64_t stepIntervalUs = toMicroseconds(m_configuration.keyFrameRequestInterval());
+    bool isStepIntervalElapsed = !m_lastStepTimeUs.has_value() || timeUs - *m_lastStepTimeUs >= stepIntervalUs;
+    if (m_keyFrameRequestCount < m_configuration.keyFrameRequestCount())
+    {
+        if (!isStepIntervalElapsed)
+        {
+            return nullopt;
+        }
+        m_keyFrameRequestCount++;
+        m_stats.keyFrameRequestCount++;
+        m_lastStepTimeUs = timeUs;
+        return VideoFreezeRecoveryStep::RequestKeyFrame;
+    }
+
+    if (!m_isIceRestarted)
+    {
+        if (!isStepIntervalElapsed)
+        {
+            return nullopt;
+        }
+        m_isIceRestarted = true;
+        m_stats.iceRestartCount++;
+        m_lastStepTimeUs = timeUs;
+        return VideoFreezeRecoveryStep::RestartIce;
+    }
+
+    if (!m_isIceRestartSkipped && timeUs - *m_lastStepTimeUs < toMicroseconds(m_configuration.iceRestartTimeout()))
+    {
+        return nullopt;
+    }
+    m_isReconnectionRequested = true;
+    m_stats.reconnectionCount++;
+    return VideoFreezeRecoveryStep::Reconnect;
+}
+
+/**
+ * @brief Reports that the ICE restart step was not performed, for example because no ICE restart attempt is left.
+ *
+ * The ICE restart is not counted, and the reconnection is requested at the next update instead of waiting for the
+ * ICE restart timeout.
+ */
+void VideoFreezeWatchdog::onIceRestartSkipped()
+{
+    lock_guard<mutex> lock(m_mutex);
+    if (m_isIceRestarted && !m_isIceRestartSkipped)
+    {
+        m_isIceRestartSkipped = true;
+        m_stats.iceRestartCount--;
+    }
+}
+
+/**
+ * @brief Disarms the watchdog until the next decoded frame, for example when the video track is removed.
+ */
+void VideoFreezeWatchdog::reset()
+{
+    lock_guard<mutex> lock(m_mutex);
+    m_lastFrameTimeUs = nullopt;
+    m_isFrozen = false;
+    resetEscalation();
+}
+
+/**
+ * @brief Indicates if the video is frozen.
+ * @return true if the video is frozen
+ */
+bool VideoFreezeWatchdog::isFrozen() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_isFrozen;
+}
+
+/**
+ * @brief Returns the watchdog statistics.
+ * @return The watchdog statistics
+ */
+VideoFreezeWatchdogStats VideoFreezeWatchdog::stats() const
+{
+    lock_guard<mutex> lock(m_mutex);
+    return m_stats;
+}
+
+void VideoFreezeWatchdog::resetEscalation()
+{
+    m_lastStepTimeUs = nullopt;
+    m_keyFrameRequestCount = 0;
+    m_isIceRestarted = false;
+    m_isIceRestartSkipped = false;
+    m_isReconnectionRequested = false;
+}
@@ -15,6 +15,9 @@ WebrtcClient::WebrtcClient(SignalingServerConfiguration&& signalingServerConfigu
                            VideoStreamConfiguration&& videoStreamConfiguration,
                            const std::vector<std::string>& streamerList)
     : m_webrtcConfiguration(std::move(webrtcConfiguration)),
+      m_maxIceRestartAttemptCount(0),
+      m_iceRestartTimeout(0),
+      m_peerConnectionPoolSize(0),
       m_destructorCalled(false)
 {
     m_signalingClient = std::make_unique<WebSocketSignalingClient>(signalingServerConfiguration, streamerList);
@@ -24,6 +27,16 @@ WebrtcClient::WebrtcClient(SignalingServerConfiguration&& signalingServerConfigu
     {
         wsSignalingClient->m_onOfferReceived = 
             [this](const std::string& fromId, const std::string& sdp) { receivePeerCall(fromId, sdp); };
+        wsSignalingClient->setClosePeerConnection(
+            [this](const string& id)
+            {
+                if (m_destructorCalled)
+                {
+                    return;
+                }
+
+                callAsync(m_internalClientThread.get(), [this, id]() { removeConnection(id); });
+            });
     }
 
     connectSignalingClientCallbacks();
@@ -68,6 +81,9 @@ WebrtcClient::WebrtcClient(
     WebrtcConfiguration&& webrtcConfiguration,
     VideoStreamConfiguration&& videoStreamConfiguration)
     : m_webrtcConfiguration(move(webrtcConfiguration)),
+      m_maxIceRestartAttemptCount(0),
+      m_iceRestartTimeout(0),
+      m_peerConnectionPoolSize(0),
       m_destructorCalled(false)
 {
     m_signalingClient = make_unique<WebSocketSignalingClient>(signalingServerConfiguration);
@@ -77,6 +93,16 @@ WebrtcClient::WebrtcClient(
     {
         wsSignalingClient->m_onOfferReceived = 
             [this](const std::string& fromId, const std::string& sdp) { receivePeerCall(fromId, sdp); };
+        wsSignalingClient->setClosePeerConnection(
+            [this](const string& id)
+            {
+                if (m_destructorCalled)
+                {
+                    return;
+                }
+
+                callAsync(m_internalClientThread.get(), [this, id]() { removeConnection(id); });
+            });
     }
 
     connectSignalingClientCallbacks();
@@ -118,7 +144,13 @@ WebrtcClient::WebrtcClient(
 
 WebrtcClient::~WebrtcClient()
 {
-    callSync(m_internalClientThread.get(), [this]() { m_destructorCalled = true; });
+    callSync(
+        m_internalClientThread.get(),
+        [this]()
+        {
+            m_destructorCalled = true;
+            m_streamerListRefreshTask.Stop();
+        });
     closeSync();
 }
 
@@ -134,6 +166,31 @@ void WebrtcClient::setTlsVerificationEnabled(bool isEnabled)
         [this, isEnabled]() { m_signalingClient->setTlsVerificationEnabled(isEnabled); });
 }
 
+/**
+ * @brief Sets the number of callee connections created before the offers are received.
+ *
+ * The pooled connections are created in the background and their ICE candidates are gathered, so an offer is
+ * answered without creating a connection. A claimed connection is replaced after the offer is handled. The current
+ * settings are applied to a connection when it is claimed, but the pooled connections use the callbacks of the
+ * moment they are created, so the pool is created again when the client connects.
+ *
+ * @param size The number of pooled connections, 0 disables the pool
+ */
+void WebrtcClient::setPeerConnectionPoolSize(size_t size)
+{
+    callSync(
+        m_internalClientThread.get(),
+        [this, size]()
+        {
+            m_peerConnectionPoolSize = size;
+            while (m_pooledPeerConnectionHandlers.size() > m_peerConnectionPoolSize)
+            {
+                m_pooledPeerConnectionHandlers.pop_back();
+            }
+        });
+    callAsync(m_internalClientThread.get(), [this]() { fillPeerConnectionPool(); });
+}
+
 /**
  * @brief Connects the client the signaling server.
  */
@@ -145,6 +202,7 @@ void WebrtcClient::connect()
         {
             closeAllConnections();
             m_signalingClient->connect();
+            fillPeerConnectionPool();
         });
 }
 
@@ -167,7 +225,16 @@ void WebrtcClient::close()
  */
 void WebrtcClient::closeSync()
 {
-    callSync(
+    closeAsync().get();
+}
+
+/**
+ * @brief Closes all client connections without blocking the caller.
+ * @return The future that is ready when all client connections are closed
+ */
+future<void> WebrtcClient::closeAsync()
+{
+    return callFuture(
         m_internalClientThread.get(),
         [this]()
         {
@@ -210,6 +277,98 @@ void WebrtcClient::callIds(const vector<string>& ids)
         });
 }
 
+/**
+ * @brief Switches to a Pixel Streaming streamer without reconnecting.
+ *
+ * The player has one streamer at a time, so the current streamer is unsubscribed and its connection is closed. If
+ * the streamer is not available yet, the switch happens when it appears in a refreshed streamer list.
+ *
+ * @param streamerId The streamer id
+ */
+void WebrtcClient::subscribe(const string& streamerId)
+{
+    callAsync(
+        m_internalClientThread.get(),
+        [this, streamerId]()
+        {
+            log("subscribe (streamer_id=" + streamerId + ")");
+            auto wsSignalingClient = dynamic_cast<WebSocketSignalingClient*>(m_signalingClient.get());
+            if (wsSignalingClient != nullptr)
+            {
+                wsSignalingClient->subscribe(streamerId);
+            }
+        });
+}
+
+/**
+ * @brief Removes a Pixel Streaming streamer from the streamer list without reconnecting.
+ *
+ * If the streamer is subscribed, its connection is closed and the next available streamer of the list is subscribed.
+ *
+ * @param streamerId The streamer id
+ */
+void WebrtcClient::unsubscribe(const string& streamerId)
+{
+    callAsync(
+        m_internalClientThread.get(),
+        [this, streamerId]()
+        {
+            log("unsubscribe (streamer_id=" + streamerId + ")");
+            auto wsSignalingClient = dynamic_cast<WebSocketSignalingClient*>(m_signalingClient.get());
+            if (wsSignalingClient != nullptr)
+            {
+                wsSignalingClient->unsubscribe(streamerId);
+            }
+        });
+}
+
+/**
+ * @brief Requests the available streamers, so the first available streamer of the streamer list is subscribed.
+ */
+void WebrtcClient::refreshStreamerList()
+{
+    callAsync(
+        m_internalClientThread.get(),
+        [this]()
+        {
+            auto wsSignalingClient = dynamic_cast<WebSocketSignalingClient*>(m_signalingClient.get());
+            if (wsSignalingClient != nullptr)
+            {
+                wsSignalingClient->requestStreamerList();
+            }
+        });
+}
+
+/**
+ * @brief Sets the interval of the automatic streamer list refreshes.
+ *
+ * A streamer of the streamer list that starts after the connection is subscribed at the next refresh.
+ *
+ * @param interval The refresh interval, 0 disables the automatic refreshes
+ */
+void WebrtcClient::setStreamerListRefreshInterval(chrono::milliseconds interval)
+{
+    callSync(
+        m_internalClientThread.get(),
+        [this, interval]()
+        {
+            m_streamerListRefreshTask.Stop();
+            if (interval.count() <= 0)
+            {
+                return;
+            }
+
+            m_streamerListRefreshTask = webrtc::RepeatingTaskHandle::DelayedStart(
+                m_internalClientThread.get(),
+                webrtc::TimeDelta::Millis(interval.count()),
+                [this, interval]()
+                {
+                    refreshStreamerList();
+                    return webrtc::TimeDelta::Millis(interval.count());
+                });
+        });
+}
+
 /**
  * @brief Hangs up all clients.
  */
@@ -238,7 +397,16 @@ void WebrtcClient::closeAllRoomPeerConnections()
  */
 vector<string> WebrtcClient::getConnectedRoomClientIds()
 {
-    return callSync(
+    return getConnectedRoomClientIdsAsync().get();
+}
+
+/**
+ * @brief Returns the connected room client ids without blocking the caller.
+ * @return The future of the connected room client ids
+ */
+future<vector<string>> WebrtcClient::getConnectedRoomClientIdsAsync()
+{
+    return callFuture(
         m_internalClientThread.get(),
         [this]()
         {
@@ -258,7 +426,16 @@ vector<string> WebrtcClient::getConnectedRoomClientIds()
  */
 vector<RoomClient> WebrtcClient::getRoomClients()
 {
-    return callSync(
+    return getRoomClientsAsync().get();
+}
+
+/**
+ * @brief Returns the room clients without blocking the caller.
+ * @return The future of the room clients
+ */
+future<vector<RoomClient>> WebrtcClient::getRoomClientsAsync()
+{
+    return callFuture(
         m_internalClientThread.get(),
         [this]()
         {
@@ -465,7 +642,12 @@ void WebrtcClient::receivePeerCall(const string& fromId, const string& sdp)
             }
 
             // 创建并接受连接
-            m_peerConnectionHandlersById[fromId] = createConnection(fromId, Client(), false);  // 使用空的 Client 对象
+            auto handler = claimPooledConnection();
+            if (handler == nullptr)
+            {
+                handler = createConnection(fromId, Client(), false);  // 使用空的 Client 对象
+            }
+            m_peerConnectionHandlersById[fromId] = move(handler);
             if (m_peerConnectionHandlersById[fromId])
             {
                 m_peerConnectionHandlersById[fromId]->receivePeerCall(sdp);
@@ -474,6 +656,9 @@ void WebrtcClient::receivePeerCall(const string& fromId, const string& sdp)
             {
                 std::cerr << "Failed to create PeerConnectionHandler for " << fromId << std::endl;
             }
+
+            // The answer is sent before the pool is replenished
+            callAsync(m_internalClientThread.get(), [this]() { fillPeerConnectionPool(); });
         });
 }
 
@@ -531,6 +716,7 @@ void WebrtcClient::closeAllConnections()
             {
                 removeConnection(id);
             }
+            m_pooledPeerConnectionHandlers.clear();
         });
 }
 
@@ -571,7 +757,7 @@ bool WebrtcClient::getCallAcceptance(const string& id)
 }
 
 unique_ptr<PeerConnectionHandler>
-    WebrtcClient::createConnection(const string& peerId, const Client& peerClient, bool isCaller)
+    WebrtcClient::createConnection(const string& peerId, const Client& peerClient, bool isCaller, bool isPooled)
 {
 
     return callSync(
@@ -579,6 +765,11 @@ unique_ptr<PeerConnectionHandler>
         [&, this]()
         {
             auto configuration = static_cast<webrtc::PeerConnectionInterface::RTCConfiguration>(m_webrtcConfiguration);
+            if (isPooled && configuration.ice_candidate_pool_size < 1)
+            {
+                // The pooled ICE candidates are gathered before the local description is set
+                configuration.ice_candidate_pool_size = 1;
+            }
             unique_ptr<PeerConnectionHandler> handler = createPeerConnectionHandler(id(), peerClient, isCaller);
             auto peerConnection = m_peerConnectionFactory->CreatePeerConnectionOrError(
                 configuration,
@@ -586,6 +777,10 @@ unique_ptr<PeerConnectionHandler>
             if (peerConnection.ok())
             {
                 handler->setPeerConnection(peerConnection.MoveValue());
+                handler->setIceRestartAttempts(
+                    m_maxIceRestartAttemptCount,
+                    m_iceRestartTimeout,
+                    m_internalClientThread.get());
             }
             else
             {
@@ -618,3 +813,63 @@ void WebrtcClient::removeConnection(const string& id)
             }
         });
 }
+
+/**
+ * @brief Applies the current settings of the client to a pooled handler when it is claimed.
+ *
+ * The setters of the derived clients only update the connected handlers, so the settings changed while a handler
+ * was pooled must be applied again. This method is called from the internal client thread.
+ *
+ * @param handler The claimed handler
+ */
+void WebrtcClient::updatePooledPeerConnectionHandler(PeerConnectionHandler& handler) {}
+
+unique_ptr<PeerConnectionHandler> WebrtcClient::claimPooledConnection()
+{
+    return callSync(
+        m_internalClientThread.get(),
+        [this]() -> unique_ptr<PeerConnectionHandler>
+        {
+            if (m_pooledPeerConnectionHandlers.empty())
+            {
+                return nullptr;
+            }
+
+            auto handler = move(m_pooledPeerConnectionHandlers.front());
+            m_pooledPeerConnectionHandlers.pop_front();
+            // The settings may have changed since the connection was pooled
+            handler->setIceRestartAttempts(
+                m_maxIceRestartAttemptCount,
+                m_iceRestartTimeout,
+                m_internalClientThread.get());
+            updatePooledPeerConnectionHandler(*handler);
+            log("claimPooledConnection (remaining=" + to_string(m_pooledPeerConnectionHandlers.size()) + ")");
+            return handler;
+        });
+}
+
+void WebrtcClient::fillPeerConnectionPool()
+{
+    callSync(
+        m_internalClientThread.get(),
+        [this]()
+        {
+            if (m_destructorCalled || m_pooledPeerConnectionHandlers.size() >= m_peerConnectionPoolSize)
+            {
+                return;
+            }
+
+            try
+            {
+                m_pooledPeerConnectionHandlers.emplace_back(createConnection("", Client(), false, true));
+            }
+            catch (const runtime_error& e)
+            {
+                invokeIfCallable(m_onError, string(e.what()));
+                return;
+            }
+
+            // One connection is created per task, so the offers are not delayed by the whole pool
+            callAsync(m_internalClientThread.get(), [this]() { fillPeerConnectionPool(); });
+        });
+}
@@ -246,3 +246,52 @@ TEST(VideoCodecFactoriesTests, Create_shouldCallDummyFactory)
     EXPECT_EQ(dynamic_cast<DummyVideoDecoder&>(*decoder).format().name, cricket::kVp9CodecName);
     EXPECT_EQ(dynamic_cast<DummyVideoEncoder&>(*encoder).format().name, cricket::kH264CodecName);
 }
+
+TEST(VideoCodecFactoriesTests, PassthroughVideoDecoderFactory_GetSupportedFormats_shouldReturnTheWrappedFormats)
+{
+    PassthroughVideoDecoderFactory decoderFactory(make_unique<ForcedCodecVideoDecoderFactory>(
+        make_unique<DummyVideoDecoderFactory>(),
+        unordered_set<VideoStreamCodec>{VideoStreamCodec::VP8}));
+
+    auto supportedFormats = decoderFactory.GetSupportedFormats();
+
+    ASSERT_EQ(supportedFormats.size(), 1);
+    EXPECT_EQ(supportedFormats[0].name, cricket::kVp8CodecName);
+}
+
+TEST(VideoCodecFactoriesTests, PassthroughVideoDecoderFactory_Create_shouldCreateAPassthroughDecoder)
+{
+    PassthroughVideoDecoderFactory decoderFactory(make_unique<DummyVideoDecoderFactory>());
+
+    auto environmentFactory = webrtc::EnvironmentFactory();
+    auto env = environmentFactory.Create();
+    auto decoder = decoderFactory.Create(env, webrtc::SdpVideoFormat(cricket::kVp9CodecName));
+
+    EXPECT_NE(dynamic_cast<PassthroughVideoDecoder*>(decoder.get()), nullptr);
+}
+
+TEST(VideoCodecFactoriesTests, PassthroughVideoDecoder_Decode_shouldRequestKeyFramesUntilOneIsReceived)
+{
+    PassthroughVideoDecoder decoder;
+    ASSERT_TRUE(decoder.Configure(webrtc::VideoDecoder::Settings()));
+
+    webrtc::EncodedImage deltaFrame;
+    deltaFrame._frameType = webrtc::VideoFrameType::kVideoFrameDelta;
+    webrtc::EncodedImage keyFrame;
+    keyFrame._frameType = webrtc::VideoFrameType::kVideoFrameKey;
+
+    EXPECT_EQ(decoder.Decode(deltaFrame, false, 0), WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME);
+    EXPECT_EQ(decoder.Decode(keyFrame, false, 0), WEBRTC_VIDEO_CODEC_OK);
+    EXPECT_EQ(decoder.Decode(deltaFrame, false, 0), WEBRTC_VIDEO_CODEC_OK);
+    EXPECT_EQ(decoder.Decode(deltaFrame, true, 0), WEBRTC_VIDEO_CODEC_OK_REQUEST_KEYFRAME);
+    EXPECT_EQ(decoder.Decode(keyFrame, true, 0), WEBRTC_VIDEO_CODEC_OK);
+}
+
+TEST(VideoCodecFactoriesTests, createVideoDecoderFactory_receiveEncodedVideoOnly_shouldCreateAPassthroughFactory)
+{
+    auto configuration = VideoStreamConfiguration::create({}, false, false, true);
+
+    auto decoderFactory = createVideoDecoderFactory(configuration);
+
+    EXPECT_NE(dynamic_cast<PassthroughVideoDecoderFactory*>(decoderFactory.get()), nullptr);
+}
@@ -0,0 +1,60 @@
+#include <OpenteraWebrtcNativeClient/Configurations/NamedDataChannelConfiguration.h>
+
+#include <gtest/gtest.h>
+
+using namespace opentera;
+using namespace std;
+
+TEST(NamedDataChannelConfigurationTests, create_label_shouldSetTheAttributes)
+{
+    NamedDataChannelConfiguration testee = NamedDataChannelConfiguration::create("commands");
+
+    EXPECT_EQ(testee.label(), "commands");
+    EXPECT_EQ(testee.dataChannelConfiguration().ordered(), true);
+    EXPECT_EQ(testee.dataChannelConfiguration().maxPacketLifeTime(), absl::nullopt);
+    EXPECT_EQ(testee.dataChannelConfiguration().maxRetransmits(), absl::nullopt);
+    EXPECT_EQ(testee.priority(), DataChannelPriority::Medium);
+}
+
+TEST(NamedDataChannelConfigurationTests, create_labelDataChannelConfiguration_shouldSetTheAttributes)
+{
+    NamedDataChannelConfiguration testee =
+        NamedDataChannelConfiguration::create("telemetry", DataChannelConfiguration::createMaxRetransmits(false, 0));
+
+    EXPECT_EQ(testee.label(), "telemetry");
+    EXPECT_EQ(testee.dataChannelConfiguration().ordered(), false);
+    EXPECT_EQ(testee.dataChannelConfiguration().maxRetransmits(), 0);
+    EXPECT_EQ(testee.priority(), DataChannelPriority::Medium);
+}
+
+TEST(NamedDataChannelConfigurationTests, create_labelDataChannelConfigurationPriority_shouldSetTheAttributes)
+{
+    NamedDataChannelConfiguration testee = NamedDataChannelConfiguration::create(
+        "bulk",
+        DataChannelConfiguration::createProtocol("a"),
+        DataChannelPriority::VeryLow);
+
+    EXPECT_EQ(testee.label(), "bulk");
+    EXPECT_EQ(testee.dataChannelConfiguration().protocol(), "a");
+    EXPECT_EQ(testee.priority(), DataChannelPriority::VeryLow);
+}
+
+TEST(NamedDataChannelConfigurationTests, operator_webrtcDataChannelInit_shouldSetTheAttributes)
+{
+    auto testee1 = static_cast<webrtc::DataChannelInit>(NamedDataChannelConfiguration::create("a"));
+    auto testee2 = static_cast<webrtc::DataChannelInit>(NamedDataChannelConfiguration::create(
+        "b",
+        DataChannelConfiguration::createMaxPacketLifeTime(false, 10, "p"),
+        DataChannelPriority::High));
+
+    EXPECT_EQ(testee1.ordered, true);
+    EXPECT_EQ(testee1.maxRetransmitTime, absl::nullopt);
+    EXPECT_EQ(testee1.maxRetransmits, absl::nullopt);
+    EXPECT_EQ(testee1.priority, webrtc::Priority::kMedium);
+
+    EXPECT_EQ(testee2.ordered, false);
+    EXPECT_EQ(testee2.maxRetransmitTime, 10);
+    EXPECT_EQ(testee2.maxRetransmits, absl::nullopt);
+    EXPECT_EQ(testee2.protocol, "p");
+    EXPECT_EQ(testee2.priority, webrtc::Priority::kHigh);
+}
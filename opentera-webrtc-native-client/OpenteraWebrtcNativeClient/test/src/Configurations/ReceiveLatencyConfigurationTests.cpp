@@ -0,0 +1,19 @@
+#include <OpenteraWebrtcNativeClient/Configurations/ReceiveLatencyConfiguration.h>
+#include <gtest/gtest.h>
+
+using namespace opentera;
+using namespace std;
+
+TEST(ReceiveLatencyConfigurationTests, create_shouldSetTheAttributes)
+{
+    ReceiveLatencyConfiguration testee = ReceiveLatencyConfiguration::create();
+
+    EXPECT_EQ(testee.jitterBufferMinimumDelay(), nullopt);
+}
+
+TEST(ReceiveLatencyConfigurationTests, create_jitterBufferMinimumDelay_shouldSetTheAttributes)
+{
+    ReceiveLatencyConfiguration testee = ReceiveLatencyConfiguration::create(150ms);
+
+    EXPECT_EQ(testee.jitterBufferMinimumDelay(), 150ms);
+}
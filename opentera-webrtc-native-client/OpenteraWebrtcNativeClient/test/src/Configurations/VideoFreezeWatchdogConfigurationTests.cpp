@@ -0,0 +1,35 @@
+#include <OpenteraWebrtcNativeClient/Configurations/VideoFreezeWatchdogConfiguration.h>
+#include <gtest/gtest.h>
+
+using namespace opentera;
+using namespace std;
+
+TEST(VideoFreezeWatchdogConfigurationTests, create_shouldSetTheAttributes)
+{
+    VideoFreezeWatchdogConfiguration testee = VideoFreezeWatchdogConfiguration::create();
+
+    EXPECT_EQ(testee.frozenTimeout(), 1000ms);
+    EXPECT_EQ(testee.keyFrameRequestInterval(), 300ms);
+    EXPECT_EQ(testee.keyFrameRequestCount(), 3);
+    EXPECT_EQ(testee.iceRestartTimeout(), 3000ms);
+}
+
+TEST(VideoFreezeWatchdogConfigurationTests, create_frozenTimeout_shouldSetTheAttributes)
+{
+    VideoFreezeWatchdogConfiguration testee = VideoFreezeWatchdogConfiguration::create(500ms);
+
+    EXPECT_EQ(testee.frozenTimeout(), 500ms);
+    EXPECT_EQ(testee.keyFrameRequestInterval(), 300ms);
+    EXPECT_EQ(testee.keyFrameRequestCount(), 3);
+    EXPECT_EQ(testee.iceRestartTimeout(), 3000ms);
+}
+
+TEST(VideoFreezeWatchdogConfigurationTests, create_all_shouldSetTheAttributes)
+{
+    VideoFreezeWatchdogConfiguration testee = VideoFreezeWatchdogConfiguration::create(500ms, 100ms, 1, 2000ms);
+
+    EXPECT_EQ(testee.frozenTimeout(), 500ms);
+    EXPECT_EQ(testee.keyFrameRequestInterval(), 100ms);
+    EXPECT_EQ(testee.keyFrameRequestCount(), 1);
+    EXPECT_EQ(testee.iceRestartTimeout(), 2000ms);
+}
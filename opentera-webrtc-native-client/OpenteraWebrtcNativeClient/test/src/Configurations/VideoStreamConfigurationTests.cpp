@@ -29,6 +29,7 @@ TEST(VideoStreamConfigurationTests, create_shouldSetTheAttributes)
     EXPECT_EQ(testee.forcedCodecs(), unordered_set<VideoStreamCodec>({}));
     EXPECT_EQ(testee.forceGStreamerHardwareAcceleration(), false);
     EXPECT_EQ(testee.useGStreamerSoftwareEncoderDecoder(), false);
+    EXPECT_EQ(testee.receiveEncodedVideoOnly(), false);
 }
 
 TEST(VideoStreamConfigurationTests, create_forcedCodecs_shouldSetTheAttributes)
@@ -38,6 +39,7 @@ TEST(VideoStreamConfigurationTests, create_forcedCodecs_shouldSetTheAttributes)
     EXPECT_EQ(testee.forcedCodecs(), unordered_set<VideoStreamCodec>({VideoStreamCodec::VP8}));
     EXPECT_EQ(testee.forceGStreamerHardwareAcceleration(), false);
     EXPECT_EQ(testee.useGStreamerSoftwareEncoderDecoder(), false);
+    EXPECT_EQ(testee.receiveEncodedVideoOnly(), false);
 }
 
 TEST(VideoStreamConfigurationTests, create_all_shouldSetTheAttributes)
@@ -47,6 +49,7 @@ TEST(VideoStreamConfigurationTests, create_all_shouldSetTheAttributes)
     EXPECT_EQ(testee1.forcedCodecs(), unordered_set<VideoStreamCodec>({VideoStreamCodec::VP9}));
     EXPECT_EQ(testee1.forceGStreamerHardwareAcceleration(), false);
     EXPECT_EQ(testee1.useGStreamerSoftwareEncoderDecoder(), true);
+    EXPECT_EQ(testee1.receiveEncodedVideoOnly(), false);
 
 
     VideoStreamConfiguration testee2 =
@@ -55,4 +58,14 @@ TEST(VideoStreamConfigurationTests, create_all_shouldSetTheAttributes)
     EXPECT_EQ(testee2.forcedCodecs(), unordered_set<VideoStreamCodec>({VideoStreamCodec::VP8, VideoStreamCodec::H264}));
     EXPECT_EQ(testee2.forceGStreamerHardwareAcceleration(), true);
     EXPECT_EQ(testee2.useGStreamerSoftwareEncoderDecoder(), false);
+    EXPECT_EQ(testee2.receiveEncodedVideoOnly(), false);
+
+
+    VideoStreamConfiguration testee3 =
+        VideoStreamConfiguration::create({VideoStreamCodec::H264}, false, false, true);
+
+    EXPECT_EQ(testee3.forcedCodecs(), unordered_set<VideoStreamCodec>({VideoStreamCodec::H264}));
+    EXPECT_EQ(testee3.forceGStreamerHardwareAcceleration(), false);
+    EXPECT_EQ(testee3.useGStreamerSoftwareEncoderDecoder(), false);
+    EXPECT_EQ(testee3.receiveEncodedVideoOnly(), true);
 }
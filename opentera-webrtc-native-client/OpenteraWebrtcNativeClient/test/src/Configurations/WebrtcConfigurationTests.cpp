@@ -8,6 +8,10 @@ TEST(WebrtcConfigurationTests, create_shouldSetTheAttributes)
 {
     WebrtcConfiguration testee = WebrtcConfiguration::create();
     EXPECT_EQ(testee.iceServers().size(), 0);
+    EXPECT_EQ(testee.candidateNetworkPolicy(), IceCandidateNetworkPolicy::All);
+    EXPECT_EQ(testee.gatheringPolicy(), IceGatheringPolicy::GatherOnce);
+    EXPECT_TRUE(testee.tcpCandidatesEnabled());
+    EXPECT_FALSE(testee.bundleRequired());
 }
 
 TEST(WebrtcConfigurationTests, create_iceServers_shouldSetTheAttributes)
@@ -18,6 +22,31 @@ TEST(WebrtcConfigurationTests, create_iceServers_shouldSetTheAttributes)
     EXPECT_EQ(testee.iceServers()[0].urls()[0], "url1");
 }
 
+TEST(WebrtcConfigurationTests, create_all_shouldSetTheAttributes)
+{
+    WebrtcConfiguration testee = WebrtcConfiguration::create(
+        {IceServer("url1")},
+        IceCandidateNetworkPolicy::LowCost,
+        IceGatheringPolicy::GatherContinually,
+        false,
+        true);
+    ASSERT_EQ(testee.iceServers().size(), 1);
+    EXPECT_EQ(testee.candidateNetworkPolicy(), IceCandidateNetworkPolicy::LowCost);
+    EXPECT_EQ(testee.gatheringPolicy(), IceGatheringPolicy::GatherContinually);
+    EXPECT_FALSE(testee.tcpCandidatesEnabled());
+    EXPECT_TRUE(testee.bundleRequired());
+}
+
+TEST(WebrtcConfigurationTests, createForLocalNetwork_shouldSetTheAttributes)
+{
+    WebrtcConfiguration testee = WebrtcConfiguration::createForLocalNetwork();
+    EXPECT_EQ(testee.iceServers().size(), 0);
+    EXPECT_EQ(testee.candidateNetworkPolicy(), IceCandidateNetworkPolicy::All);
+    EXPECT_EQ(testee.gatheringPolicy(), IceGatheringPolicy::GatherOnce);
+    EXPECT_FALSE(testee.tcpCandidatesEnabled());
+    EXPECT_TRUE(testee.bundleRequired());
+}
+
 TEST(WebrtcConfigurationTests, operator_webrtcPeerConnectionInterfaceRtcConfiguration_shouldSetTheAttributes)
 {
     auto testee = static_cast<webrtc::PeerConnectionInterface::RTCConfiguration>(
@@ -26,3 +55,18 @@ TEST(WebrtcConfigurationTests, operator_webrtcPeerConnectionInterfaceRtcConfigur
     ASSERT_EQ(testee.servers[0].urls.size(), 1);
     EXPECT_EQ(testee.servers[0].urls[0], "url1");
 }
+
+TEST(WebrtcConfigurationTests, operator_webrtcPeerConnectionInterfaceRtcConfiguration_policies_shouldSetTheAttributes)
+{
+    auto testee = static_cast<webrtc::PeerConnectionInterface::RTCConfiguration>(WebrtcConfiguration::create(
+        {},
+        IceCandidateNetworkPolicy::LowCost,
+        IceGatheringPolicy::GatherContinually,
+        false,
+        true));
+    EXPECT_EQ(testee.candidate_network_policy, webrtc::PeerConnectionInterface::kCandidateNetworkPolicyLowCost);
+    EXPECT_EQ(testee.continual_gathering_policy, webrtc::PeerConnectionInterface::GATHER_CONTINUALLY);
+    EXPECT_EQ(testee.tcp_candidate_policy, webrtc::PeerConnectionInterface::kTcpCandidatePolicyDisabled);
+    EXPECT_EQ(testee.bundle_policy, webrtc::PeerConnectionInterface::kBundlePolicyMaxBundle);
+    EXPECT_EQ(testee.rtcp_mux_policy, webrtc::PeerConnectionInterface::kRtcpMuxPolicyRequire);
+}
@@ -10,6 +10,7 @@
 
 #include <memory>
 #include <thread>
+#include <utility>
 
 using namespace opentera;
 using namespace std;
@@ -229,6 +230,76 @@ protected:
     }
 };
 
+class NamedDataChannelClientTests : public DataChannelClientTests
+{
+protected:
+    unique_ptr<DataChannelClient> m_client1;
+    unique_ptr<DataChannelClient> m_client2;
+    unique_ptr<DataChannelClient> m_client3;
+
+    string m_clientId1;
+    string m_clientId2;
+    string m_clientId3;
+
+    void SetUp() override
+    {
+        DataChannelClientTests::SetUp();
+
+        CallbackAwaiter setupAwaiter(3, 15s);
+        m_client1 = make_unique<DataChannelClient>(
+            SignalingServerConfiguration::createWithData(m_baseUrl, "c1", "cd1", "chat", "abc"),
+            DefaultWebrtcConfiguration,
+            DataChannelConfiguration::create(),
+            vector<NamedDataChannelConfiguration>{NamedDataChannelConfiguration::create("telemetry")});
+        m_client2 = make_unique<DataChannelClient>(
+            SignalingServerConfiguration::createWithData(m_baseUrl, "c2", "cd2", "chat", "abc"),
+            DefaultWebrtcConfiguration,
+            DataChannelConfiguration::create(),
+            vector<NamedDataChannelConfiguration>{NamedDataChannelConfiguration::create("telemetry")});
+        // The third client has no named data channel
+        m_client3 = make_unique<DataChannelClient>(
+            SignalingServerConfiguration::createWithData(m_baseUrl, "c3", "cd3", "chat", "abc"),
+            DefaultWebrtcConfiguration,
+            DataChannelConfiguration::create());
+
+        m_client1->setTlsVerificationEnabled(false);
+        m_client2->setTlsVerificationEnabled(false);
+        m_client3->setTlsVerificationEnabled(false);
+
+        m_client1->setOnSignalingConnectionOpened([&] { setupAwaiter.done(); });
+        m_client2->setOnSignalingConnectionOpened([&] { setupAwaiter.done(); });
+        m_client3->setOnSignalingConnectionOpened([&] { setupAwaiter.done(); });
+
+        m_client1->setOnError([](const string& error) { ADD_FAILURE() << error; });
+        m_client2->setOnError([](const string& error) { ADD_FAILURE() << error; });
+        m_client3->setOnError([](const string& error) { ADD_FAILURE() << error; });
+
+        m_client1->connect();
+        this_thread::sleep_for(250ms);
+        m_client2->connect();
+        this_thread::sleep_for(250ms);
+        m_client3->connect();
+        setupAwaiter.wait(__FILE__, __LINE__);
+
+        m_client1->setOnSignalingConnectionOpened([] {});
+        m_client2->setOnSignalingConnectionOpened([] {});
+        m_client3->setOnSignalingConnectionOpened([] {});
+
+        m_clientId1 = m_client1->id();
+        m_clientId2 = m_client2->id();
+        m_clientId3 = m_client3->id();
+    }
+
+    void TearDown() override
+    {
+        m_client1->closeSync();
+        m_client2->closeSync();
+        m_client3->closeSync();
+
+        DataChannelClientTests::TearDown();
+    }
+};
+
 TEST_P(DisconnectedDataChannelClientTests, isConnected_shouldReturnFalse)
 {
     EXPECT_FALSE(m_client1->isConnected());
@@ -775,6 +846,107 @@ TEST_P(RightPasswordDataChannelClientTests, sendTo_binary_shouldSendTheDataToThe
     m_client3->setOnDataChannelMessageBinary([](const Client& client, const uint8_t* data, size_t size) {});
 }
 
+TEST_P(RightPasswordDataChannelClientTests, sendTo_closedFirstClient_shouldSendTheDataToTheOtherClients)
+{
+    CallbackAwaiter onDataChannelOpenAwaiter(4, 60s);
+    CallbackAwaiter onSentAwaiter(2, 60s);
+    bool isFirstClose = true;
+
+    auto onDataChannelOpened = [&onDataChannelOpenAwaiter](const Client& client) { onDataChannelOpenAwaiter.done(); };
+    m_client1->setOnDataChannelOpened(onDataChannelOpened);
+    m_client2->setOnDataChannelOpened(onDataChannelOpened);
+    m_client3->setOnDataChannelOpened(onDataChannelOpened);
+
+    // The connection is removed after the callback, so the first client still has a closed data channel
+    m_client1->setOnDataChannelClosed(
+        [this, &onSentAwaiter, &isFirstClose](const Client& client)
+        {
+            if (client.id() != m_clientId2 || !exchange(isFirstClose, false))
+            {
+                return;
+            }
+
+            auto onComplete = [this, &onSentAwaiter](const Client& client, bool sent)
+            {
+                EXPECT_EQ(client.id(), m_clientId3);
+                EXPECT_TRUE(sent);
+                onSentAwaiter.done();
+            };
+            EXPECT_FALSE(
+                m_client1->sendTo("data", {m_clientId2, m_clientId3}, DataChannelSendPriority::Normal, onComplete));
+        });
+    m_client3->setOnDataChannelMessageString(
+        [this, &onSentAwaiter](const Client& client, const string& data)
+        {
+            EXPECT_EQ(client.id(), m_clientId1);
+            EXPECT_EQ(data, "data");
+            onSentAwaiter.done();
+        });
+
+    m_client1->callIds({m_clientId2, m_clientId3});
+    onDataChannelOpenAwaiter.wait(__FILE__, __LINE__);
+    m_client2->hangUpAll();
+    onSentAwaiter.wait(__FILE__, __LINE__);
+
+    m_client1->setOnDataChannelOpened([](const Client& client) {});
+    m_client2->setOnDataChannelOpened([](const Client& client) {});
+    m_client3->setOnDataChannelOpened([](const Client& client) {});
+
+    m_client1->setOnDataChannelClosed([](const Client& client) {});
+    m_client3->setOnDataChannelMessageString([](const Client& client, const string& data) {});
+}
+
+TEST_P(RightPasswordDataChannelClientTests, sendChunkedTo_closedFirstClient_shouldSendTheDataToTheOtherClients)
+{
+    CallbackAwaiter onDataChannelOpenAwaiter(4, 60s);
+    CallbackAwaiter onSentAwaiter(2, 60s);
+    bool isFirstClose = true;
+
+    auto onDataChannelOpened = [&onDataChannelOpenAwaiter](const Client& client) { onDataChannelOpenAwaiter.done(); };
+    m_client1->setOnDataChannelOpened(onDataChannelOpened);
+    m_client2->setOnDataChannelOpened(onDataChannelOpened);
+    m_client3->setOnDataChannelOpened(onDataChannelOpened);
+    m_client3->setChunkedMessageEnabled(true);
+
+    // The connection is removed after the callback, so the first client still has a closed data channel
+    m_client1->setOnDataChannelClosed(
+        [this, &onSentAwaiter, &isFirstClose](const Client& client)
+        {
+            if (client.id() != m_clientId2 || !exchange(isFirstClose, false))
+            {
+                return;
+            }
+
+            auto onComplete = [this, &onSentAwaiter](const Client& client, bool sent)
+            {
+                EXPECT_EQ(client.id(), m_clientId3);
+                EXPECT_TRUE(sent);
+                onSentAwaiter.done();
+            };
+            EXPECT_FALSE(
+                m_client1->sendChunkedTo(webrtc::DataBuffer("data"), {m_clientId2, m_clientId3}, nullptr, onComplete));
+        });
+    m_client3->setOnDataChannelMessageString(
+        [this, &onSentAwaiter](const Client& client, const string& data)
+        {
+            EXPECT_EQ(client.id(), m_clientId1);
+            EXPECT_EQ(data, "data");
+            onSentAwaiter.done();
+        });
+
+    m_client1->callIds({m_clientId2, m_clientId3});
+    onDataChannelOpenAwaiter.wait(__FILE__, __LINE__);
+    m_client2->hangUpAll();
+    onSentAwaiter.wait(__FILE__, __LINE__);
+
+    m_client1->setOnDataChannelOpened([](const Client& client) {});
+    m_client2->setOnDataChannelOpened([](const Client& client) {});
+    m_client3->setOnDataChannelOpened([](const Client& client) {});
+
+    m_client1->setOnDataChannelClosed([](const Client& client) {});
+    m_client3->setOnDataChannelMessageString([](const Client& client, const string& data) {});
+}
+
 TEST_P(RightPasswordDataChannelClientTests, sendTo_string_shouldSendTheDataToTheSpecifiedClients)
 {
     CallbackAwaiter onDataChannelOpenedAwaiter(6, 60s);
@@ -1046,6 +1218,104 @@ TEST_P(RightPasswordDataChannelClientTests, sendToAll_string_shouldSendTheDataTo
     m_client3->setOnDataChannelMessageString([](const Client& client, const string& data) {});
 }
 
+TEST_P(NamedDataChannelClientTests, sendOnChannelTo_incomingNamedDataChannel_shouldRouteTheMessagesByLabel)
+{
+    CallbackAwaiter onNamedDataChannelOpenedAwaiter(2, 60s);
+    CallbackAwaiter onNamedDataChannelMessageAwaiter(2, 60s);
+
+    // The named data channel of client 2 is created by client 1, so it is routed by its label when it is received
+    auto onNamedDataChannelOpened =
+        [this, &onNamedDataChannelOpenedAwaiter](const Client& client, const string& label)
+    {
+        EXPECT_EQ(label, "telemetry");
+        if (onNamedDataChannelOpenedAwaiter.done())
+        {
+            EXPECT_TRUE(m_client1->sendOnChannelTo("telemetry", "data1", {m_clientId2}));
+            EXPECT_TRUE(m_client2->sendOnChannelTo("telemetry", "data2", {m_clientId1}));
+        }
+    };
+    m_client1->setOnNamedDataChannelOpened(onNamedDataChannelOpened);
+    m_client2->setOnNamedDataChannelOpened(onNamedDataChannelOpened);
+
+    m_client1->setOnNamedDataChannelMessageString(
+        [this, &onNamedDataChannelMessageAwaiter](const Client& client, const string& label, const string& data)
+        {
+            EXPECT_EQ(client.id(), m_clientId2);
+            EXPECT_EQ(label, "telemetry");
+            EXPECT_EQ(data, "data2");
+            onNamedDataChannelMessageAwaiter.done();
+        });
+    m_client2->setOnNamedDataChannelMessageString(
+        [this, &onNamedDataChannelMessageAwaiter](const Client& client, const string& label, const string& data)
+        {
+            EXPECT_EQ(client.id(), m_clientId1);
+            EXPECT_EQ(label, "telemetry");
+            EXPECT_EQ(data, "data1");
+            onNamedDataChannelMessageAwaiter.done();
+        });
+    m_client1->setOnDataChannelMessageString([](const Client& client, const string& data) { ADD_FAILURE(); });
+    m_client2->setOnDataChannelMessageString([](const Client& client, const string& data) { ADD_FAILURE(); });
+
+    m_client1->callIds({m_clientId2});
+    onNamedDataChannelOpenedAwaiter.wait(__FILE__, __LINE__);
+    onNamedDataChannelMessageAwaiter.wait(__FILE__, __LINE__);
+
+    m_client1->setOnNamedDataChannelOpened([](const Client& client, const string& label) {});
+    m_client2->setOnNamedDataChannelOpened([](const Client& client, const string& label) {});
+    m_client1->setOnNamedDataChannelMessageString(
+        [](const Client& client, const string& label, const string& data) {});
+    m_client2->setOnNamedDataChannelMessageString(
+        [](const Client& client, const string& label, const string& data) {});
+    m_client1->setOnDataChannelMessageString([](const Client& client, const string& data) {});
+    m_client2->setOnDataChannelMessageString([](const Client& client, const string& data) {});
+}
+
+TEST_P(NamedDataChannelClientTests, sendOnChannelTo_firstClientWithoutTheLabel_shouldSendTheDataToTheOtherClients)
+{
+    CallbackAwaiter onOpenedAwaiter(3, 60s);
+    CallbackAwaiter onSentAwaiter(2, 60s);
+
+    // The third client calls the first one, so their connection has no named data channel
+    auto onNamedDataChannelOpened = [&onOpenedAwaiter](const Client& client, const string& label)
+    { onOpenedAwaiter.done(); };
+    m_client1->setOnNamedDataChannelOpened(onNamedDataChannelOpened);
+    m_client2->setOnNamedDataChannelOpened(onNamedDataChannelOpened);
+    m_client3->setOnDataChannelOpened([&onOpenedAwaiter](const Client& client) { onOpenedAwaiter.done(); });
+
+    m_client2->setOnNamedDataChannelMessageString(
+        [this, &onSentAwaiter](const Client& client, const string& label, const string& data)
+        {
+            EXPECT_EQ(client.id(), m_clientId1);
+            EXPECT_EQ(label, "telemetry");
+            EXPECT_EQ(data, "data");
+            onSentAwaiter.done();
+        });
+
+    m_client1->callIds({m_clientId2});
+    m_client3->callIds({m_clientId1});
+    onOpenedAwaiter.wait(__FILE__, __LINE__);
+
+    auto onComplete = [this, &onSentAwaiter](const Client& client, bool sent)
+    {
+        EXPECT_EQ(client.id(), m_clientId2);
+        EXPECT_TRUE(sent);
+        onSentAwaiter.done();
+    };
+    EXPECT_FALSE(m_client1->sendOnChannelTo(
+        "telemetry",
+        "data",
+        {m_clientId3, m_clientId2},
+        DataChannelSendPriority::Normal,
+        onComplete));
+    onSentAwaiter.wait(__FILE__, __LINE__);
+
+    m_client1->setOnNamedDataChannelOpened([](const Client& client, const string& label) {});
+    m_client2->setOnNamedDataChannelOpened([](const Client& client, const string& label) {});
+    m_client3->setOnDataChannelOpened([](const Client& client) {});
+    m_client2->setOnNamedDataChannelMessageString(
+        [](const Client& client, const string& label, const string& data) {});
+}
+
 INSTANTIATE_TEST_SUITE_P(
     WrongPasswordDataChannelClientTests,
     WrongPasswordDataChannelClientTests,
@@ -1058,6 +1328,8 @@ INSTANTIATE_TEST_SUITE_P(
     RightPasswordDataChannelClientTests,
     ::testing::Values(false, true));
 
+INSTANTIATE_TEST_SUITE_P(NamedDataChannelClientTests, NamedDataChannelClientTests, ::testing::Values(false, true));
+
 INSTANTIATE_TEST_SUITE_P(
     DisconnectedDataChannelClientTests,
     DisconnectedDataChannelClientTests,
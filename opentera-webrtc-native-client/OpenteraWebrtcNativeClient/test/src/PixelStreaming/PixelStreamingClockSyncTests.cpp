@@ -0,0 +1,90 @@
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingClockSync.h>
+
+#include <rtc_base/time_utils.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace opentera;
+using namespace std;
+
+constexpr uint8_t RequestMessageId = 126;
+constexpr uint8_t ResponseMessageId = 127;
+
+static void appendInt64(vector<uint8_t>& data, int64_t value)
+{
+    for (size_t i = 0; i < sizeof(value); i++)
+    {
+        data.push_back(static_cast<uint8_t>(static_cast<uint64_t>(value) >> (8 * i)));
+    }
+}
+
+TEST(PixelStreamingClockSyncTests, requestSync_shouldSendTheLocalTime)
+{
+    vector<webrtc::DataBuffer> sentBuffers;
+    PixelStreamingClockSync testee(
+        [&](const webrtc::DataBuffer& buffer)
+        {
+            sentBuffers.push_back(buffer);
+            return true;
+        },
+        RequestMessageId,
+        ResponseMessageId,
+        chrono::seconds(1));
+
+    int64_t beforeUs = rtc::TimeMicros();
+    EXPECT_TRUE(testee.requestSync());
+
+    ASSERT_EQ(sentBuffers.size(), 1);
+    ASSERT_EQ(sentBuffers[0].size(), 1 + PixelStreamingClockSync::RequestPayloadSize);
+    EXPECT_TRUE(sentBuffers[0].binary);
+    EXPECT_EQ(sentBuffers[0].data.cdata()[0], RequestMessageId);
+
+    int64_t sendTimeUs = 0;
+    for (size_t i = 0; i < sizeof(sendTimeUs); i++)
+    {
+        sendTimeUs |= static_cast<int64_t>(sentBuffers[0].data.cdata()[1 + i]) << (8 * i);
+    }
+    EXPECT_GE(sendTimeUs, beforeUs);
+    EXPECT_LE(sendTimeUs, rtc::TimeMicros());
+}
+
+TEST(PixelStreamingClockSyncTests, handleCustomMessage_otherId_shouldReturnFalse)
+{
+    PixelStreamingClockSync testee(
+        [](const webrtc::DataBuffer&) { return true; },
+        RequestMessageId,
+        ResponseMessageId,
+        chrono::seconds(1));
+    uint8_t data[1] = {0};
+
+    EXPECT_FALSE(testee.handleCustomMessage(PixelStreamingCustomMessage{123, data, sizeof(data)}));
+}
+
+TEST(PixelStreamingClockSyncTests, handleCustomMessage_response_shouldUpdateTheEstimate)
+{
+    PixelStreamingClockSync testee(
+        [](const webrtc::DataBuffer&) { return true; },
+        RequestMessageId,
+        ResponseMessageId,
+        chrono::seconds(1));
+
+    vector<uint8_t> truncated(PixelStreamingClockSync::ResponsePayloadSize - 1);
+    EXPECT_TRUE(
+        testee.handleCustomMessage(PixelStreamingCustomMessage{ResponseMessageId, truncated.data(), truncated.size()}));
+    EXPECT_FALSE(testee.estimate().has_value());
+
+    constexpr int64_t OffsetUs = 5'000'000'000;
+    int64_t sendTimeUs = rtc::TimeMicros();
+    vector<uint8_t> response;
+    appendInt64(response, sendTimeUs);
+    appendInt64(response, sendTimeUs + OffsetUs);
+    appendInt64(response, sendTimeUs + OffsetUs);
+    EXPECT_TRUE(
+        testee.handleCustomMessage(PixelStreamingCustomMessage{ResponseMessageId, response.data(), response.size()}));
+
+    ASSERT_TRUE(testee.estimate().has_value());
+    EXPECT_NEAR(static_cast<double>(testee.estimate()->offsetUs), static_cast<double>(OffsetUs), 100'000.0);
+    ASSERT_TRUE(testee.toLocalTimeUs(sendTimeUs + OffsetUs).has_value());
+}
@@ -0,0 +1,114 @@
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingInputSender.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingMessageEncoder.h>
+
+#include <gtest/gtest.h>
+
+#include <vector>
+
+using namespace opentera;
+using namespace std;
+
+static uint8_t messageId(const webrtc::DataBuffer& buffer)
+{
+    return buffer.data.cdata()[0];
+}
+
+static uint8_t messageId(PixelStreamingToStreamerMessageId id)
+{
+    return static_cast<uint8_t>(id);
+}
+
+TEST(PixelStreamingInputSenderTests, flush_shouldSendTheEventsInOrder)
+{
+    vector<webrtc::DataBuffer> sentBuffers;
+    PixelStreamingInputSender testee(
+        [&](const webrtc::DataBuffer& buffer)
+        {
+            sentBuffers.push_back(buffer);
+            return true;
+        },
+        chrono::milliseconds(16));
+
+    EXPECT_TRUE(testee.enqueue(PixelStreamingMessageEncoder::keyDown(65, false)));
+    EXPECT_TRUE(testee.enqueueMouseMove(0.5f, 0.5f, 0.1f, 0.f));
+    EXPECT_TRUE(testee.enqueue(PixelStreamingMessageEncoder::keyUp(65)));
+    EXPECT_EQ(testee.queueDepth(), 3);
+
+    EXPECT_EQ(testee.flush(), 3);
+
+    ASSERT_EQ(sentBuffers.size(), 3);
+    EXPECT_EQ(messageId(sentBuffers[0]), messageId(PixelStreamingToStreamerMessageId::KeyDown));
+    EXPECT_EQ(messageId(sentBuffers[1]), messageId(PixelStreamingToStreamerMessageId::MouseMove));
+    EXPECT_EQ(messageId(sentBuffers[2]), messageId(PixelStreamingToStreamerMessageId::KeyUp));
+    EXPECT_EQ(testee.queueDepth(), 0);
+}
+
+TEST(PixelStreamingInputSenderTests, enqueueMouseMove_consecutiveMoves_shouldBeMerged)
+{
+    vector<webrtc::DataBuffer> sentBuffers;
+    PixelStreamingInputSender testee(
+        [&](const webrtc::DataBuffer& buffer)
+        {
+            sentBuffers.push_back(buffer);
+            return true;
+        },
+        chrono::milliseconds(16));
+
+    testee.enqueueMouseMove(0.1f, 0.1f, 0.25f, 0.f);
+    testee.enqueueMouseMove(0.2f, 0.1f, 0.25f, 0.f);
+    testee.enqueue(PixelStreamingMessageEncoder::mouseDown(PixelStreamingMouseButton::Main, 0.2f, 0.1f));
+    testee.enqueueMouseMove(0.3f, 0.1f, 0.25f, 0.f);
+    EXPECT_EQ(testee.queueDepth(), 3);
+    EXPECT_EQ(testee.coalescedEventCount(), 1);
+
+    testee.flush();
+
+    ASSERT_EQ(sentBuffers.size(), 3);
+    auto expectedMove = PixelStreamingMessageEncoder::mouseMove(0.2f, 0.1f, 0.5f, 0.f);
+    EXPECT_EQ(
+        vector<uint8_t>(sentBuffers[0].data.cdata(), sentBuffers[0].data.cdata() + sentBuffers[0].size()),
+        vector<uint8_t>(expectedMove.data.cdata(), expectedMove.data.cdata() + expectedMove.size()));
+    EXPECT_EQ(messageId(sentBuffers[1]), messageId(PixelStreamingToStreamerMessageId::MouseDown));
+    EXPECT_EQ(messageId(sentBuffers[2]), messageId(PixelStreamingToStreamerMessageId::MouseMove));
+}
+
+TEST(PixelStreamingInputSenderTests, enqueueGamepadAnalog_sameAxis_shouldKeepTheLatestValue)
+{
+    PixelStreamingInputSender testee([](const webrtc::DataBuffer&) { return true; }, chrono::milliseconds(16));
+
+    testee.enqueueGamepadAnalog(0, 1, 0.25);
+    testee.enqueueGamepadAnalog(0, 2, 0.5);
+    testee.enqueueGamepadAnalog(0, 1, 0.75);
+    EXPECT_EQ(testee.queueDepth(), 2);
+
+    testee.enqueue(PixelStreamingMessageEncoder::gamepadButtonPressed(0, 3, false));
+    testee.enqueueGamepadAnalog(0, 1, 1.0);
+    EXPECT_EQ(testee.queueDepth(), 4);
+    EXPECT_EQ(testee.coalescedEventCount(), 1);
+}
+
+TEST(PixelStreamingInputSenderTests, flush_sendFailure_shouldKeepTheRemainingEvents)
+{
+    int sendCount = 0;
+    PixelStreamingInputSender testee(
+        [&](const webrtc::DataBuffer&) { return ++sendCount < 2; },
+        chrono::milliseconds(16));
+
+    testee.enqueue(PixelStreamingMessageEncoder::keyDown(65, false));
+    testee.enqueue(PixelStreamingMessageEncoder::keyUp(65));
+    testee.enqueue(PixelStreamingMessageEncoder::keyPress(97));
+
+    EXPECT_EQ(testee.flush(), 1);
+    EXPECT_EQ(testee.queueDepth(), 2);
+}
+
+TEST(PixelStreamingInputSenderTests, enqueue_fullQueue_shouldDropTheEvent)
+{
+    PixelStreamingInputSender testee([](const webrtc::DataBuffer&) { return true; }, chrono::milliseconds(16), 1);
+
+    EXPECT_TRUE(testee.enqueue(PixelStreamingMessageEncoder::keyDown(65, false)));
+    EXPECT_FALSE(testee.enqueue(PixelStreamingMessageEncoder::keyUp(65)));
+
+    EXPECT_EQ(testee.queueDepth(), 1);
+    EXPECT_EQ(testee.droppedEventCount(), 1);
+}
@@ -0,0 +1,92 @@
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingLatencyProbe.h>
+
+#include <rtc_base/time_utils.h>
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <vector>
+
+using namespace opentera;
+using namespace std;
+
+static vector<uint8_t> toUtf16(const string& text)
+{
+    vector<uint8_t> data;
+    for (char c : text)
+    {
+        data.push_back(static_cast<uint8_t>(c));
+        data.push_back(0);
+    }
+    return data;
+}
+
+static const string LatencyTestResponse = "{\"ReceiptTimeMs\":1000,\"TransmissionTimeMs\":1004,"
+                                          "\"PreCaptureTimeMs\":990,\"PostCaptureTimeMs\":991,"
+                                          "\"PreEncodeTimeMs\":992,\"PostEncodeTimeMs\":997,"
+                                          "\"CaptureToSendMs\":8}";
+
+TEST(PixelStreamingLatencyProbeTests, requestLatencyTest_shouldSendALatencyTestMessage)
+{
+    vector<webrtc::DataBuffer> sentBuffers;
+    PixelStreamingLatencyProbe testee(
+        [&](const webrtc::DataBuffer& buffer)
+        {
+            sentBuffers.push_back(buffer);
+            return true;
+        },
+        chrono::seconds(1));
+
+    EXPECT_TRUE(testee.requestLatencyTest());
+
+    ASSERT_EQ(sentBuffers.size(), 1);
+    EXPECT_TRUE(sentBuffers[0].binary);
+    EXPECT_EQ(sentBuffers[0].data.cdata()[0], static_cast<uint8_t>(PixelStreamingToStreamerMessageId::LatencyTest));
+}
+
+TEST(PixelStreamingLatencyProbeTests, onFrameDisplayed_afterResponse_shouldCompleteTheReport)
+{
+    PixelStreamingLatencyProbe testee([](const webrtc::DataBuffer&) { return true; }, chrono::seconds(1));
+    int reportCount = 0;
+    testee.setOnLatencyReport([&](const PixelStreamingLatencyReport&) { reportCount++; });
+
+    testee.handleVideoEncoderAvgQP(PixelStreamingVideoEncoderAvgQPMessage{27.0});
+    testee.requestLatencyTest();
+    auto response = toUtf16(LatencyTestResponse);
+    EXPECT_TRUE(testee.handleTextMessage(
+        PixelStreamingTextMessage{PixelStreamingFromStreamerMessageId::LatencyTest,
+                                  PixelStreamingUtf16View(response.data(), response.size() / 2)}));
+    EXPECT_FALSE(testee.latestReport().has_value());
+
+    int64_t nowUs = rtc::TimeMicros();
+    VideoFrameTimestamps timestamps;
+    timestamps.receiveTimeUs = nowUs;
+    timestamps.decodeStartTimeUs = nowUs + 3000;
+    timestamps.decodeFinishTimeUs = nowUs + 5000;
+    timestamps.sinkTimeUs = nowUs + 6000;
+    testee.onFrameDisplayed(timestamps);
+    testee.onFrameDisplayed(timestamps);
+
+    ASSERT_TRUE(testee.latestReport().has_value());
+    auto report = *testee.latestReport();
+    EXPECT_EQ(reportCount, 1);
+    EXPECT_DOUBLE_EQ(report.streamerProcessingTimeMs, 4.0);
+    EXPECT_DOUBLE_EQ(report.captureTimeMs, 1.0);
+    EXPECT_DOUBLE_EQ(report.encodeTimeMs, 5.0);
+    EXPECT_DOUBLE_EQ(report.captureToSendTimeMs, 8.0);
+    EXPECT_DOUBLE_EQ(report.receiveToDecodeTimeMs, 3.0);
+    EXPECT_DOUBLE_EQ(report.decodeTimeMs, 2.0);
+    EXPECT_DOUBLE_EQ(report.averageQP, 27.0);
+    EXPECT_FALSE(isnan(report.captureToDisplayTimeMs));
+}
+
+TEST(PixelStreamingLatencyProbeTests, handleTextMessage_otherMessage_shouldReturnFalse)
+{
+    PixelStreamingLatencyProbe testee([](const webrtc::DataBuffer&) { return true; }, chrono::seconds(1));
+
+    auto response = toUtf16("{}");
+    EXPECT_FALSE(testee.handleTextMessage(PixelStreamingTextMessage{
+        PixelStreamingFromStreamerMessageId::Response,
+        PixelStreamingUtf16View(response.data(), response.size() / 2)}));
+    EXPECT_TRUE(isnan(testee.averageQP()));
+}
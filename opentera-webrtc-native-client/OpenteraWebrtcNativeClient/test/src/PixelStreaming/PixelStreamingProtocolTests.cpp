@@ -0,0 +1,168 @@
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingMessageEncoder.h>
+#include <OpenteraWebrtcNativeClient/PixelStreaming/PixelStreamingProtocol.h>
+
+#include <gtest/gtest.h>
+
+#include <clocale>
+
+using namespace opentera;
+using namespace std;
+
+static vector<uint8_t> toVector(const webrtc::DataBuffer& buffer)
+{
+    return vector<uint8_t>(buffer.data.cdata(), buffer.data.cdata() + buffer.data.size());
+}
+
+TEST(PixelStreamingUtf16ViewTests, toUtf8_shouldConvertTheSurrogatePairs)
+{
+    const uint8_t data[] = {'a', 0, 0xE9, 0, 0x3D, 0xD8, 0x00, 0xDE, 0x3D, 0xD8};
+    PixelStreamingUtf16View testee(data, 5);
+
+    EXPECT_EQ(testee.size(), 5);
+    EXPECT_EQ(testee[1], u'é');
+    EXPECT_EQ(testee.toUtf8(), "a\xC3\xA9\xF0\x9F\x98\x80\xEF\xBF\xBD");
+}
+
+TEST(PixelStreamingMessageDispatcherTests, dispatch_qualityControlOwnership_shouldCallTheCallback)
+{
+    PixelStreamingMessageDispatcher testee;
+    bool hasOwnership = false;
+    testee.setOnQualityControlOwnership([&](const PixelStreamingQualityControlOwnershipMessage& message)
+                                        { hasOwnership = message.hasQualityControlOwnership; });
+
+    const uint8_t data[] = {0, 1};
+    EXPECT_TRUE(testee.dispatch(data, sizeof(data)));
+    EXPECT_TRUE(hasOwnership);
+}
+
+TEST(PixelStreamingMessageDispatcherTests, dispatch_textMessage_shouldNotCopyThePayload)
+{
+    PixelStreamingMessageDispatcher testee;
+    PixelStreamingTextMessage received{};
+    string text;
+    testee.setOnTextMessage(
+        [&](const PixelStreamingTextMessage& message)
+        {
+            received = message;
+            text = message.text.toUtf8();
+        });
+
+    const uint8_t data[] = {7, '{', 0, '}', 0};
+    EXPECT_TRUE(testee.dispatch(data, sizeof(data)));
+    EXPECT_EQ(received.id, PixelStreamingFromStreamerMessageId::InitialSettings);
+    EXPECT_EQ(text, "{}");
+}
+
+TEST(PixelStreamingMessageDispatcherTests, dispatch_freezeFrameChunk_shouldReadTheJpegSize)
+{
+    PixelStreamingMessageDispatcher testee;
+    PixelStreamingFreezeFrameChunk received{};
+    testee.setOnFreezeFrameChunk([&](const PixelStreamingFreezeFrameChunk& chunk) { received = chunk; });
+
+    const uint8_t data[] = {3, 0x04, 0x03, 0x02, 0x01, 0xFF, 0xD8};
+    EXPECT_TRUE(testee.dispatch(data, sizeof(data)));
+    EXPECT_EQ(received.jpegSize, 0x01020304);
+    EXPECT_EQ(received.data, data + 5);
+    EXPECT_EQ(received.dataSize, 2);
+}
+
+TEST(PixelStreamingMessageDispatcherTests, dispatch_videoEncoderAvgQP_shouldParseTheNumber)
+{
+    PixelStreamingMessageDispatcher testee;
+    double averageQP = 0.0;
+    testee.setOnVideoEncoderAvgQP([&](const PixelStreamingVideoEncoderAvgQPMessage& message)
+                                  { averageQP = message.averageQP; });
+
+    const uint8_t data[] = {5, '2', 0, '4', 0, '.', 0, '5', 0};
+    EXPECT_TRUE(testee.dispatch(data, sizeof(data)));
+    EXPECT_DOUBLE_EQ(averageQP, 24.5);
+}
+
+TEST(PixelStreamingMessageDispatcherTests, dispatch_videoEncoderAvgQP_commaDecimalLocale_shouldParseTheNumber)
+{
+    // strtod and atof use the C locale, so it must be changed instead of the C++ global locale
+    string previousLocale = setlocale(LC_NUMERIC, nullptr);
+    if (setlocale(LC_NUMERIC, "de_DE.UTF-8") == nullptr)
+    {
+        GTEST_SKIP() << "The de_DE.UTF-8 locale is not available";
+    }
+
+    PixelStreamingMessageDispatcher testee;
+    double averageQP = 0.0;
+    testee.setOnVideoEncoderAvgQP([&](const PixelStreamingVideoEncoderAvgQPMessage& message)
+                                  { averageQP = message.averageQP; });
+
+    const uint8_t data[] = {5, '2', 0, '4', 0, '.', 0, '5', 0};
+    bool isDispatched = testee.dispatch(data, sizeof(data));
+    setlocale(LC_NUMERIC, previousLocale.c_str());
+
+    EXPECT_TRUE(isDispatched);
+    EXPECT_DOUBLE_EQ(averageQP, 24.5);
+}
+
+TEST(PixelStreamingMessageDispatcherTests, dispatch_customMessage_shouldCallTheCallbackOfTheId)
+{
+    PixelStreamingMessageDispatcher testee;
+    string text;
+    testee.setOnCustomMessage(123, [&](const PixelStreamingCustomMessage& message) { text = message.text(); });
+
+    const uint8_t data[] = {123, '{', '}'};
+    const uint8_t otherData[] = {124, 'a'};
+    EXPECT_TRUE(testee.dispatch(data, sizeof(data)));
+    EXPECT_TRUE(testee.dispatch(otherData, sizeof(otherData)));
+    EXPECT_EQ(text, "{}");
+}
+
+TEST(PixelStreamingMessageDispatcherTests, dispatch_malformedMessage_shouldCallOnError)
+{
+    PixelStreamingMessageDispatcher testee;
+    int errorCount = 0;
+    bool callbackCalled = false;
+    testee.setOnError([&](const string&) { errorCount++; });
+    testee.setOnFreezeFrameChunk([&](const PixelStreamingFreezeFrameChunk&) { callbackCalled = true; });
+
+    const uint8_t freezeFrame[] = {3, 0x04, 0x03};
+    const uint8_t oddText[] = {1, 'a'};
+    EXPECT_FALSE(testee.dispatch(freezeFrame, sizeof(freezeFrame)));
+    EXPECT_FALSE(testee.dispatch(oddText, sizeof(oddText)));
+    EXPECT_FALSE(testee.dispatch(nullptr, 0));
+    EXPECT_EQ(errorCount, 3);
+    EXPECT_FALSE(callbackCalled);
+}
+
+TEST(PixelStreamingMessageEncoderTests, mouseMove_shouldNormalizeTheCoordinates)
+{
+    auto buffer = PixelStreamingMessageEncoder::mouseMove(0.5f, 1.f, -1.f, 0.f);
+
+    EXPECT_TRUE(buffer.binary);
+    EXPECT_EQ(toVector(buffer), vector<uint8_t>({74, 0x00, 0x80, 0xFF, 0xFF, 0x01, 0x80, 0x00, 0x00}));
+}
+
+TEST(PixelStreamingMessageEncoderTests, keyDown_shouldEncodeTheKeyCodeAndRepeat)
+{
+    EXPECT_EQ(toVector(PixelStreamingMessageEncoder::keyDown(65, true)), vector<uint8_t>({60, 65, 1}));
+    EXPECT_EQ(toVector(PixelStreamingMessageEncoder::keyUp(65)), vector<uint8_t>({61, 65}));
+}
+
+TEST(PixelStreamingMessageEncoderTests, command_shouldEncodeALengthPrefixedUtf16String)
+{
+    auto buffer = PixelStreamingMessageEncoder::command("{\xC3\xA9}");
+
+    EXPECT_EQ(toVector(buffer), vector<uint8_t>({51, 3, 0, '{', 0, 0xE9, 0, '}', 0}));
+}
+
+TEST(PixelStreamingMessageEncoderTests, touch_shouldEncodeEveryTouch)
+{
+    auto buffer = PixelStreamingMessageEncoder::touch(
+        PixelStreamingToStreamerMessageId::TouchStart,
+        {PixelStreamingTouch{0.f, 0.5f, 2, 1.f}});
+
+    EXPECT_EQ(toVector(buffer), vector<uint8_t>({80, 1, 0x00, 0x00, 0x00, 0x80, 2, 255, 1}));
+}
+
+TEST(PixelStreamingMessageEncoderTests, gamepadAnalog_shouldEncodeALittleEndianDouble)
+{
+    auto buffer = PixelStreamingMessageEncoder::gamepadAnalog(1, 2, 1.0);
+
+    EXPECT_EQ(toVector(buffer), vector<uint8_t>({92, 1, 2, 0, 0, 0, 0, 0, 0, 0xF0, 0x3F}));
+}
@@ -0,0 +1,169 @@
+#include <OpenteraWebrtcNativeClient/Signaling/WebSocketSignalingClient.h>
+
+#include <gtest/gtest.h>
+
+using namespace opentera;
+using namespace std;
+
+class FakeWebSocketSignalingClient : public WebSocketSignalingClient
+{
+public:
+    vector<nlohmann::json> sentMessages;
+
+    explicit FakeWebSocketSignalingClient(const vector<string>& streamerList)
+        : WebSocketSignalingClient(SignalingServerConfiguration::create("ws://localhost", "c1", "room"), streamerList)
+    {
+    }
+
+    using WebSocketSignalingClient::onWsCloseEvent;
+    using WebSocketSignalingClient::onWsMessage;
+
+    void receiveStreamerList(const vector<string>& ids)
+    {
+        onWsMessage(nlohmann::json{{"type", "streamerList"}, {"ids", ids}}.dump());
+    }
+
+    void receiveOffer(const string& usernameFragment)
+    {
+        onWsMessage(nlohmann::json{{"type", "offer"}, {"sdp", "a=ice-ufrag:" + usernameFragment + "\r\n"}}.dump());
+    }
+
+protected:
+    void sendWsMessage(const string& message) override { sentMessages.push_back(nlohmann::json::parse(message)); }
+    bool isWsOpen() override { return true; }
+};
+
+static nlohmann::json subscribeMessage(const string& streamerId)
+{
+    return nlohmann::json{{"type", "subscribe"}, {"streamerId", streamerId}};
+}
+
+static const nlohmann::json UnsubscribeMessage{{"type", "unsubscribe"}};
+
+class WebSocketSignalingClientTests : public ::testing::Test
+{
+protected:
+    unique_ptr<FakeWebSocketSignalingClient> m_testee;
+    vector<string> m_offerPeerIds;
+    vector<string> m_closedPeerIds;
+
+    void SetUp() override
+    {
+        m_testee = make_unique<FakeWebSocketSignalingClient>(vector<string>{"a", "b", "c"});
+        m_testee->m_onOfferReceived = [this](const string& fromId, const string& sdp)
+        { m_offerPeerIds.push_back(fromId); };
+        m_testee->setClosePeerConnection([this](const string& id) { m_closedPeerIds.push_back(id); });
+    }
+};
+
+TEST_F(WebSocketSignalingClientTests, streamerList_shouldSubscribeTheFirstAvailableStreamerOnly)
+{
+    m_testee->receiveStreamerList({"c", "b"});
+
+    ASSERT_EQ(m_testee->sentMessages.size(), 1u);
+    EXPECT_EQ(m_testee->sentMessages[0], subscribeMessage("b"));
+}
+
+TEST_F(WebSocketSignalingClientTests, streamerList_sameStreamer_shouldNotSubscribeAgain)
+{
+    m_testee->receiveStreamerList({"a"});
+    m_testee->receiveStreamerList({"a", "c"});
+
+    ASSERT_EQ(m_testee->sentMessages.size(), 1u);
+    EXPECT_EQ(m_testee->sentMessages[0], subscribeMessage("a"));
+}
+
+TEST_F(WebSocketSignalingClientTests, offer_shouldUseTheUsernameFragmentAsPeerId)
+{
+    string answerPeerId;
+    m_testee->setReceivePeerCallAnswer([&](const string& fromId, const string& sdp) { answerPeerId = fromId; });
+    m_testee->receiveStreamerList({"a"});
+
+    m_testee->receiveOffer("peerA");
+    m_testee->onWsMessage(nlohmann::json{{"type", "answer"}, {"sdp", "a=ice-ufrag:local\r\n"}}.dump());
+
+    EXPECT_EQ(m_offerPeerIds, vector<string>{"peerA"});
+    EXPECT_EQ(answerPeerId, "peerA");
+}
+
+TEST_F(WebSocketSignalingClientTests, subscribe_otherStreamer_shouldSwitchTheSubscription)
+{
+    m_testee->receiveStreamerList({"a", "b"});
+    m_testee->receiveOffer("peerA");
+
+    m_testee->subscribe("b");
+
+    ASSERT_EQ(m_testee->sentMessages.size(), 3u);
+    EXPECT_EQ(m_testee->sentMessages[0], subscribeMessage("a"));
+    EXPECT_EQ(m_testee->sentMessages[1], UnsubscribeMessage);
+    EXPECT_EQ(m_testee->sentMessages[2], subscribeMessage("b"));
+    EXPECT_EQ(m_closedPeerIds, vector<string>{"peerA"});
+}
+
+TEST_F(WebSocketSignalingClientTests, subscribe_unavailableStreamer_shouldSwitchWhenItIsAvailable)
+{
+    m_testee->receiveStreamerList({"a"});
+    m_testee->receiveOffer("peerA");
+
+    m_testee->subscribe("d");
+    EXPECT_EQ(m_testee->sentMessages.size(), 1u);
+    EXPECT_TRUE(m_closedPeerIds.empty());
+
+    m_testee->receiveStreamerList({"a", "d"});
+
+    ASSERT_EQ(m_testee->sentMessages.size(), 3u);
+    EXPECT_EQ(m_testee->sentMessages[1], UnsubscribeMessage);
+    EXPECT_EQ(m_testee->sentMessages[2], subscribeMessage("d"));
+    EXPECT_EQ(m_closedPeerIds, vector<string>{"peerA"});
+}
+
+TEST_F(WebSocketSignalingClientTests, unsubscribe_subscribedStreamer_shouldSubscribeTheNextAvailableStreamer)
+{
+    m_testee->receiveStreamerList({"a", "c"});
+    m_testee->receiveOffer("peerA");
+
+    m_testee->unsubscribe("a");
+
+    ASSERT_EQ(m_testee->sentMessages.size(), 3u);
+    EXPECT_EQ(m_testee->sentMessages[1], UnsubscribeMessage);
+    EXPECT_EQ(m_testee->sentMessages[2], subscribeMessage("c"));
+    EXPECT_EQ(m_closedPeerIds, vector<string>{"peerA"});
+}
+
+TEST_F(WebSocketSignalingClientTests, unsubscribe_otherStreamer_shouldKeepTheSubscription)
+{
+    m_testee->receiveStreamerList({"a", "b"});
+    m_testee->receiveOffer("peerA");
+
+    m_testee->unsubscribe("b");
+
+    EXPECT_EQ(m_testee->sentMessages.size(), 1u);
+    EXPECT_TRUE(m_closedPeerIds.empty());
+}
+
+TEST_F(WebSocketSignalingClientTests, streamerList_subscribedStreamerLeft_shouldCloseItsConnection)
+{
+    m_testee->receiveStreamerList({"a"});
+    m_testee->receiveOffer("peerA");
+
+    m_testee->receiveStreamerList({});
+    m_testee->receiveStreamerList({"a"});
+
+    ASSERT_EQ(m_testee->sentMessages.size(), 3u);
+    EXPECT_EQ(m_testee->sentMessages[1], UnsubscribeMessage);
+    EXPECT_EQ(m_testee->sentMessages[2], subscribeMessage("a"));
+    EXPECT_EQ(m_closedPeerIds, vector<string>{"peerA"});
+}
+
+TEST_F(WebSocketSignalingClientTests, onWsCloseEvent_shouldSubscribeAgainAtTheNextStreamerList)
+{
+    m_testee->receiveStreamerList({"a"});
+    m_testee->receiveOffer("peerA");
+
+    m_testee->onWsCloseEvent();
+    m_testee->receiveStreamerList({"a"});
+
+    ASSERT_EQ(m_testee->sentMessages.size(), 2u);
+    EXPECT_EQ(m_testee->sentMessages[1], subscribeMessage("a"));
+    EXPECT_TRUE(m_closedPeerIds.empty());
+}
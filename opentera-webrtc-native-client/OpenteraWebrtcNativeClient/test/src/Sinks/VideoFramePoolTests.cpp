@@ -0,0 +1,63 @@
+#include <OpenteraWebrtcNativeClient/Sinks/VideoFramePool.h>
+
+#include <gtest/gtest.h>
+
+using namespace opentera;
+using namespace std;
+
+TEST(VideoFramePoolTests, acquire_releasedBuffer_shouldReuseIt)
+{
+    VideoFramePool testee(2);
+
+    uint8_t* data = nullptr;
+    {
+        PooledVideoFrame frame(testee.acquire(4, 8, CV_8UC3));
+        data = frame.mat().data;
+    }
+    PooledVideoFrame frame(testee.acquire(4, 8, CV_8UC3));
+
+    EXPECT_EQ(frame.mat().data, data);
+    EXPECT_EQ(frame.width(), 8);
+    EXPECT_EQ(frame.height(), 4);
+    EXPECT_EQ(testee.size(), 1);
+    EXPECT_EQ(testee.exhaustionCount(), 0u);
+}
+
+TEST(VideoFramePoolTests, acquire_heldFrameOrMatHeader_shouldNotReuseTheBufferAndCountTheExhaustion)
+{
+    VideoFramePool testee(2);
+
+    PooledVideoFrame frame1(testee.acquire(4, 8, CV_8UC3));
+    cv::Mat header = PooledVideoFrame(testee.acquire(4, 8, CV_8UC3));
+    PooledVideoFrame frame3(testee.acquire(4, 8, CV_8UC3));
+
+    EXPECT_NE(frame1.mat().data, header.data);
+    EXPECT_NE(frame1.mat().data, frame3.mat().data);
+    EXPECT_NE(header.data, frame3.mat().data);
+    EXPECT_EQ(testee.size(), 2);
+    EXPECT_EQ(testee.exhaustionCount(), 1u);
+}
+
+TEST(VideoFramePoolTests, acquire_otherSize_shouldReleaseTheFreeBuffers)
+{
+    VideoFramePool testee(2);
+
+    testee.acquire(4, 8, CV_8UC3);
+    testee.acquire(4, 8, CV_8UC3);
+    ASSERT_EQ(testee.size(), 1);
+
+    PooledVideoFrame frame(testee.acquire(8, 16, CV_8UC4));
+
+    EXPECT_EQ(frame.mat().type(), CV_8UC4);
+    EXPECT_EQ(testee.size(), 1);
+}
+
+TEST(VideoFramePoolTests, conversion_shouldNotCopyThePixels)
+{
+    VideoFramePool testee(1);
+    PooledVideoFrame frame(testee.acquire(4, 8, CV_8UC1));
+
+    const cv::Mat& mat = frame;
+
+    EXPECT_EQ(mat.data, frame.mat().data);
+}
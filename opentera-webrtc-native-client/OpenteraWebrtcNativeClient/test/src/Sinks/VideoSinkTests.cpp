@@ -0,0 +1,141 @@
+#include <OpenteraWebrtcNativeClient/Sinks/VideoSink.h>
+
+#include <api/video/i420_buffer.h>
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+using namespace opentera;
+using namespace std;
+
+static webrtc::VideoFrame createBlackFrame(int width, int height, webrtc::VideoRotation rotation)
+{
+    rtc::scoped_refptr<webrtc::I420Buffer> buffer = webrtc::I420Buffer::Create(width, height);
+    webrtc::I420Buffer::SetBlack(buffer.get());
+
+    return webrtc::VideoFrame::Builder()
+        .set_video_frame_buffer(buffer)
+        .set_rotation(rotation)
+        .set_timestamp_us(10)
+        .build();
+}
+
+static webrtc::VideoFrame createRedFrame(int width, int height)
+{
+    rtc::scoped_refptr<webrtc::I420Buffer> buffer = webrtc::I420Buffer::Create(width, height);
+    memset(buffer->MutableDataY(), 81, buffer->StrideY() * height);
+    memset(buffer->MutableDataU(), 90, buffer->StrideU() * buffer->ChromaHeight());
+    memset(buffer->MutableDataV(), 240, buffer->StrideV() * buffer->ChromaHeight());
+
+    return webrtc::VideoFrame::Builder().set_video_frame_buffer(buffer).set_timestamp_us(10).build();
+}
+
+TEST(VideoSinkTests, OnFrame_noTargetSize_shouldNotScale)
+{
+    cv::Size size;
+    uint64_t timestampUs = 0;
+    VideoSink testee(
+        [&](const cv::Mat& bgrImg, uint64_t t)
+        {
+            size = bgrImg.size();
+            timestampUs = t;
+        });
+
+    testee.OnFrame(createBlackFrame(640, 480, webrtc::kVideoRotation_0));
+
+    EXPECT_EQ(size, cv::Size(640, 480));
+    EXPECT_EQ(timestampUs, 10);
+}
+
+TEST(VideoSinkTests, OnFrame_targetSize_shouldDownscaleAndKeepTheAspectRatio)
+{
+    cv::Size size;
+    VideoSink testee([&](const cv::Mat& bgrImg, uint64_t) { size = bgrImg.size(); });
+    testee.setTargetSize(320, 320);
+
+    testee.OnFrame(createBlackFrame(640, 480, webrtc::kVideoRotation_0));
+
+    EXPECT_EQ(size, cv::Size(320, 240));
+}
+
+TEST(VideoSinkTests, OnFrame_targetSizeLargerThanTheFrame_shouldNotUpscale)
+{
+    cv::Size size;
+    VideoSink testee([&](const cv::Mat& bgrImg, uint64_t) { size = bgrImg.size(); });
+    testee.setTargetSize(1920, 1080);
+
+    testee.OnFrame(createBlackFrame(640, 480, webrtc::kVideoRotation_0));
+
+    EXPECT_EQ(size, cv::Size(640, 480));
+}
+
+TEST(VideoSinkTests, OnFrame_targetSizeAndRotation_shouldFitTheRotatedFrame)
+{
+    cv::Size size;
+    VideoSink testee([&](const cv::Mat& bgrImg, uint64_t) { size = bgrImg.size(); });
+    testee.setTargetSize(240, 640);
+
+    testee.OnFrame(createBlackFrame(640, 480, webrtc::kVideoRotation_90));
+
+    EXPECT_EQ(size, cv::Size(240, 320));
+}
+
+TEST(VideoSinkTests, OnFrame_format_shouldConvertToTheRequestedLayout)
+{
+    cv::Mat img;
+    VideoSink testee([&](const cv::Mat& frameImg, uint64_t) { img = frameImg.clone(); });
+
+    testee.OnFrame(createRedFrame(16, 16));
+    ASSERT_EQ(img.type(), CV_8UC3);
+    EXPECT_GT(img.at<cv::Vec3b>(0, 0)[2], 200);
+    EXPECT_LT(img.at<cv::Vec3b>(0, 0)[0], 50);
+
+    testee.setFormat(VideoFrameFormat::RGB);
+    testee.OnFrame(createRedFrame(16, 16));
+    ASSERT_EQ(img.type(), CV_8UC3);
+    EXPECT_GT(img.at<cv::Vec3b>(0, 0)[0], 200);
+    EXPECT_LT(img.at<cv::Vec3b>(0, 0)[2], 50);
+
+    testee.setFormat(VideoFrameFormat::BGRA);
+    testee.OnFrame(createRedFrame(16, 16));
+    ASSERT_EQ(img.type(), CV_8UC4);
+    EXPECT_GT(img.at<cv::Vec4b>(0, 0)[2], 200);
+    EXPECT_LT(img.at<cv::Vec4b>(0, 0)[0], 50);
+    EXPECT_EQ(img.at<cv::Vec4b>(0, 0)[3], 255);
+
+    testee.setFormat(VideoFrameFormat::RGBA);
+    testee.OnFrame(createRedFrame(16, 16));
+    ASSERT_EQ(img.type(), CV_8UC4);
+    EXPECT_GT(img.at<cv::Vec4b>(0, 0)[0], 200);
+    EXPECT_LT(img.at<cv::Vec4b>(0, 0)[2], 50);
+    EXPECT_EQ(img.at<cv::Vec4b>(0, 0)[3], 255);
+
+    testee.setFormat(VideoFrameFormat::Gray);
+    testee.OnFrame(createRedFrame(16, 16));
+    ASSERT_EQ(img.type(), CV_8UC1);
+    EXPECT_EQ(img.at<uint8_t>(0, 0), 81);
+}
+
+TEST(VideoSinkTests, OnFrame_rotation_shouldRotateTheImage)
+{
+    rtc::scoped_refptr<webrtc::I420Buffer> buffer = webrtc::I420Buffer::Create(16, 8);
+    webrtc::I420Buffer::SetBlack(buffer.get());
+    memset(buffer->MutableDataY(), 200, buffer->StrideY() * 4);  // Bright top half
+    auto frame = webrtc::VideoFrame::Builder()
+                     .set_video_frame_buffer(buffer)
+                     .set_rotation(webrtc::kVideoRotation_90)
+                     .set_timestamp_us(10)
+                     .build();
+
+    cv::Mat img;
+    VideoSink testee([&](const cv::Mat& frameImg, uint64_t) { img = frameImg.clone(); });
+    testee.setFormat(VideoFrameFormat::Gray);
+
+    testee.OnFrame(frame);
+
+    ASSERT_EQ(img.size(), cv::Size(8, 16));
+    EXPECT_EQ(img.at<uint8_t>(0, 7), 200);
+    EXPECT_EQ(img.at<uint8_t>(15, 7), 200);
+    EXPECT_NE(img.at<uint8_t>(0, 0), 200);
+}
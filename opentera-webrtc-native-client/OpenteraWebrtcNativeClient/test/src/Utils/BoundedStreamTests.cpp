@@ -0,0 +1,153 @@
+#include <OpenteraWebrtcNativeClient/Utils/BoundedStream.h>
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace opentera;
+using namespace std;
+
+TEST(BoundedStreamTests, constructor_zeroCapacity_shouldSetTheCapacityTo1)
+{
+    BoundedStream<int> testee(0, StreamDropPolicy::DropOldest);
+
+    EXPECT_EQ(testee.capacity(), 1);
+    EXPECT_EQ(testee.dropPolicy(), StreamDropPolicy::DropOldest);
+}
+
+TEST(BoundedStreamTests, push_dropOldest_shouldKeepTheMostRecentItems)
+{
+    BoundedStream<int> testee(2, StreamDropPolicy::DropOldest);
+
+    EXPECT_TRUE(testee.push(1));
+    EXPECT_TRUE(testee.push(2));
+    EXPECT_TRUE(testee.push(3));
+
+    EXPECT_EQ(testee.size(), 2);
+    EXPECT_EQ(testee.droppedCount(), 1);
+    EXPECT_EQ(testee.tryNext(), 2);
+    EXPECT_EQ(testee.tryNext(), 3);
+    EXPECT_EQ(testee.tryNext(), nullopt);
+}
+
+TEST(BoundedStreamTests, push_dropNewest_shouldKeepTheOldestItems)
+{
+    BoundedStream<int> testee(2, StreamDropPolicy::DropNewest);
+
+    EXPECT_TRUE(testee.push(1));
+    EXPECT_TRUE(testee.push(2));
+    EXPECT_FALSE(testee.push(3));
+
+    EXPECT_EQ(testee.droppedCount(), 1);
+    EXPECT_EQ(testee.tryNext(), 1);
+    EXPECT_EQ(testee.tryNext(), 2);
+    EXPECT_EQ(testee.tryNext(), nullopt);
+}
+
+TEST(BoundedStreamTests, push_closed_shouldDropTheItem)
+{
+    BoundedStream<int> testee(2, StreamDropPolicy::DropOldest);
+    testee.close();
+
+    EXPECT_FALSE(testee.push(1));
+    EXPECT_TRUE(testee.isClosed());
+    EXPECT_EQ(testee.size(), 0);
+}
+
+TEST(BoundedStreamTests, push_shouldCallTheAvailabilityCallback)
+{
+    BoundedStream<int> testee(1, StreamDropPolicy::DropNewest);
+    int callCount = 0;
+    testee.setOnAvailable([&callCount]() { callCount++; });
+
+    testee.push(1);
+    testee.push(2);
+    testee.close();
+
+    EXPECT_EQ(callCount, 2);
+}
+
+TEST(BoundedStreamTests, next_shouldWaitTheNextItem)
+{
+    BoundedStream<int> testee(2, StreamDropPolicy::DropOldest);
+
+    thread producer(
+        [&testee]()
+        {
+            this_thread::sleep_for(50ms);
+            testee.push(10);
+        });
+
+    EXPECT_EQ(testee.next(), 10);
+    producer.join();
+}
+
+TEST(BoundedStreamTests, next_closed_shouldReturnTheRemainingItemsAndNullopt)
+{
+    BoundedStream<int> testee(2, StreamDropPolicy::DropOldest);
+    testee.push(1);
+
+    thread producer(
+        [&testee]()
+        {
+            this_thread::sleep_for(50ms);
+            testee.close();
+        });
+
+    EXPECT_EQ(testee.next(), 1);
+    EXPECT_EQ(testee.next(), nullopt);
+    producer.join();
+}
+
+TEST(BoundedStreamTests, next_timeout_shouldReturnNullopt)
+{
+    BoundedStream<int> testee(2, StreamDropPolicy::DropOldest);
+
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    optional<int> item = testee.next(50ms);
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+    EXPECT_EQ(item, nullopt);
+    EXPECT_GE(chrono::duration_cast<chrono::milliseconds>(end - begin).count(), 40);
+}
+
+TEST(BoundedStreamGroupTests, push_shouldAddTheItemToAllStreams)
+{
+    BoundedStreamGroup<int> testee;
+    auto stream1 = testee.create(2, StreamDropPolicy::DropOldest);
+    auto stream2 = testee.create(1, StreamDropPolicy::DropNewest);
+
+    testee.push(1);
+    testee.push(2);
+
+    EXPECT_EQ(stream1->tryNext(), 1);
+    EXPECT_EQ(stream1->tryNext(), 2);
+    EXPECT_EQ(stream2->tryNext(), 1);
+    EXPECT_EQ(stream2->tryNext(), nullopt);
+}
+
+TEST(BoundedStreamGroupTests, empty_releasedStreams_shouldReturnTrue)
+{
+    BoundedStreamGroup<int> testee;
+    EXPECT_TRUE(testee.empty());
+
+    auto stream = testee.create(2, StreamDropPolicy::DropOldest);
+    EXPECT_FALSE(testee.empty());
+
+    stream.reset();
+    EXPECT_TRUE(testee.empty());
+    testee.push(1);
+}
+
+TEST(BoundedStreamGroupTests, closeAll_shouldCloseAllStreams)
+{
+    BoundedStreamGroup<int> testee;
+    auto stream1 = testee.create(2, StreamDropPolicy::DropOldest);
+    auto stream2 = testee.create(2, StreamDropPolicy::DropOldest);
+
+    testee.closeAll();
+
+    EXPECT_TRUE(stream1->isClosed());
+    EXPECT_TRUE(stream2->isClosed());
+    EXPECT_TRUE(testee.empty());
+}
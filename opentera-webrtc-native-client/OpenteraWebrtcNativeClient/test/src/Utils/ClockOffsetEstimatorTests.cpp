@@ -0,0 +1,88 @@
+#include <OpenteraWebrtcNativeClient/Utils/ClockOffsetEstimator.h>
+
+#include <gtest/gtest.h>
+
+using namespace opentera;
+using namespace std;
+
+TEST(ClockOffsetEstimatorTests, estimate_noExchange_shouldReturnNullopt)
+{
+    ClockOffsetEstimator testee;
+
+    EXPECT_FALSE(testee.estimate().has_value());
+    EXPECT_FALSE(testee.toLocalTimeUs(1000).has_value());
+}
+
+TEST(ClockOffsetEstimatorTests, addExchange_invalidTimes_shouldReturnFalse)
+{
+    ClockOffsetEstimator testee;
+
+    EXPECT_FALSE(testee.addExchange(1000, 5000, 4000, 2000));
+    EXPECT_FALSE(testee.addExchange(2000, 5000, 5100, 1000));
+    EXPECT_FALSE(testee.addExchange(1000, 5000, 6000, 1500));
+    EXPECT_FALSE(testee.estimate().has_value());
+}
+
+TEST(ClockOffsetEstimatorTests, addExchange_symmetricDelays_shouldEstimateTheOffset)
+{
+    ClockOffsetEstimator testee;
+
+    // Remote clock = local clock + 1 000 000 us, 2 ms each way, 1 ms of processing
+    EXPECT_TRUE(testee.addExchange(10'000, 1'012'000, 1'013'000, 15'000));
+
+    ASSERT_TRUE(testee.estimate().has_value());
+    EXPECT_EQ(testee.estimate()->offsetUs, 1'000'000);
+    EXPECT_EQ(testee.estimate()->roundTripTimeUs, 4'000);
+    EXPECT_EQ(testee.estimate()->exchangeCount, 1u);
+    EXPECT_EQ(testee.toLocalTimeUs(1'050'000), 50'000);
+}
+
+TEST(ClockOffsetEstimatorTests, addExchange_delayedExchanges_shouldKeepTheShortestRoundTripTimes)
+{
+    ClockOffsetEstimator testee(8);
+
+    for (int64_t i = 0; i < 8; i++)
+    {
+        int64_t sendTimeUs = i * 100'000;
+        // Every other exchange has 20 ms of queuing on the way back, which biases its offset by -10 ms
+        int64_t returnDelayUs = i % 2 == 0 ? 1'000 : 21'000;
+        int64_t remoteTimeUs = sendTimeUs + 1'000 + 500'000;
+        testee.addExchange(sendTimeUs, remoteTimeUs, remoteTimeUs, sendTimeUs + 1'000 + returnDelayUs);
+    }
+
+    ASSERT_TRUE(testee.estimate().has_value());
+    EXPECT_EQ(testee.estimate()->offsetUs, 500'000);
+    EXPECT_EQ(testee.estimate()->roundTripTimeUs, 2'000);
+}
+
+TEST(ClockOffsetEstimatorTests, addExchange_driftingClock_shouldEstimateTheDrift)
+{
+    ClockOffsetEstimator testee(16);
+
+    // The remote clock runs 100 ppm faster than the local clock
+    for (int64_t i = 0; i < 16; i++)
+    {
+        int64_t sendTimeUs = i * 1'000'000;
+        int64_t localTimeUs = sendTimeUs + 1'000;
+        int64_t remoteTimeUs = localTimeUs + 200'000 + localTimeUs / 10'000;
+        testee.addExchange(sendTimeUs, remoteTimeUs, remoteTimeUs, sendTimeUs + 2'000);
+    }
+
+    ASSERT_TRUE(testee.estimate().has_value());
+    EXPECT_NEAR(testee.estimate()->driftPpm, 100.0, 1.0);
+
+    int64_t localTimeUs = 30'000'000;
+    int64_t remoteTimeUs = localTimeUs + 200'000 + localTimeUs / 10'000;
+    ASSERT_TRUE(testee.toLocalTimeUs(remoteTimeUs).has_value());
+    EXPECT_NEAR(static_cast<double>(*testee.toLocalTimeUs(remoteTimeUs)), static_cast<double>(localTimeUs), 50.0);
+}
+
+TEST(ClockOffsetEstimatorTests, reset_shouldRemoveTheEstimate)
+{
+    ClockOffsetEstimator testee;
+    testee.addExchange(10'000, 1'012'000, 1'013'000, 15'000);
+
+    testee.reset();
+
+    EXPECT_FALSE(testee.estimate().has_value());
+}
@@ -0,0 +1,261 @@
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunkReassembler.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace opentera;
+using namespace std;
+
+static webrtc::DataBuffer
+    createChunk(uint32_t messageId, bool binary, uint32_t totalSize, uint32_t offset, const string& payload)
+{
+    DataChannelChunkHeader header{messageId, binary, totalSize, offset};
+    rtc::CopyOnWriteBuffer data(DataChannelChunkHeader::Size + payload.size());
+    header.write(data.MutableData());
+    copy(payload.begin(), payload.end(), data.MutableData() + DataChannelChunkHeader::Size);
+    return webrtc::DataBuffer(data, true);
+}
+
+class DataChannelChunkReassemblerTests : public ::testing::Test
+{
+protected:
+    vector<string> m_messages;
+    vector<bool> m_binaryFlags;
+    vector<DataChannelTransferProgress> m_progresses;
+
+    DataChannelChunkReassembler createTestee(
+        size_t maxMessageSize = DataChannelChunkReassembler::DefaultMaxMessageSize,
+        size_t maxPendingMessageCount = DataChannelChunkReassembler::DefaultMaxPendingMessageCount,
+        chrono::milliseconds timeout = DataChannelChunkReassembler::DefaultTimeout,
+        size_t maxPendingBytes = DataChannelChunkReassembler::DefaultMaxPendingBytes)
+    {
+        return DataChannelChunkReassembler(
+            [this](const webrtc::DataBuffer& buffer)
+            {
+                m_messages.emplace_back(reinterpret_cast<const char*>(buffer.data.cdata()), buffer.size());
+                m_binaryFlags.push_back(buffer.binary);
+            },
+            [this](const DataChannelTransferProgress& progress) { m_progresses.push_back(progress); },
+            maxMessageSize,
+            maxPendingMessageCount,
+            timeout,
+            maxPendingBytes);
+    }
+};
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_regularMessage_shouldReturnFalse)
+{
+    auto testee = createTestee();
+
+    EXPECT_FALSE(testee.handleMessage(webrtc::DataBuffer("a string message")));
+    EXPECT_FALSE(testee.handleMessage(webrtc::DataBuffer(rtc::CopyOnWriteBuffer(4), true)));
+
+    EXPECT_TRUE(m_messages.empty());
+    EXPECT_EQ(testee.droppedMessageCount(), 0);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_outOfOrderChunks_shouldReassembleTheMessage)
+{
+    auto testee = createTestee();
+
+    EXPECT_TRUE(testee.handleMessage(createChunk(7, false, 11, 6, "world")));
+    EXPECT_TRUE(testee.handleMessage(createChunk(7, false, 11, 0, "hello ")));
+
+    EXPECT_EQ(m_messages, vector<string>({"hello world"}));
+    EXPECT_EQ(m_binaryFlags, vector<bool>({false}));
+    ASSERT_EQ(m_progresses.size(), 2);
+    EXPECT_EQ(m_progresses[0].transferredBytes, 5);
+    EXPECT_EQ(m_progresses[1].transferredBytes, 11);
+    EXPECT_EQ(m_progresses[1].totalBytes, 11);
+    EXPECT_EQ(testee.pendingMessageCount(), 0);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_interleavedMessages_shouldReassembleBoth)
+{
+    auto testee = createTestee();
+
+    testee.handleMessage(createChunk(1, true, 4, 0, "ab"));
+    testee.handleMessage(createChunk(2, true, 4, 0, "wx"));
+    testee.handleMessage(createChunk(1, true, 4, 2, "cd"));
+    testee.handleMessage(createChunk(2, true, 4, 2, "yz"));
+
+    EXPECT_EQ(m_messages, vector<string>({"abcd", "wxyz"}));
+    EXPECT_EQ(m_binaryFlags, vector<bool>({true, true}));
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_duplicateChunks_shouldIgnoreThem)
+{
+    auto testee = createTestee();
+
+    EXPECT_TRUE(testee.handleMessage(createChunk(1, true, 6, 0, "ab")));
+    EXPECT_TRUE(testee.handleMessage(createChunk(1, true, 6, 0, "ab")));
+    EXPECT_TRUE(testee.handleMessage(createChunk(1, true, 6, 2, "cd")));
+    EXPECT_TRUE(testee.handleMessage(createChunk(1, true, 6, 2, "cd")));
+    EXPECT_TRUE(m_messages.empty());
+
+    EXPECT_TRUE(testee.handleMessage(createChunk(1, true, 6, 4, "ef")));
+
+    EXPECT_EQ(m_messages, vector<string>({"abcdef"}));
+    ASSERT_EQ(m_progresses.size(), 3);
+    EXPECT_EQ(m_progresses[0].transferredBytes, 2);
+    EXPECT_EQ(m_progresses[1].transferredBytes, 4);
+    EXPECT_EQ(m_progresses[2].transferredBytes, 6);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_overlappingChunks_shouldOnlyCountTheNewBytes)
+{
+    auto testee = createTestee();
+
+    testee.handleMessage(createChunk(1, true, 6, 2, "cd"));
+    testee.handleMessage(createChunk(1, true, 6, 1, "bcde"));
+    EXPECT_TRUE(m_messages.empty());
+
+    testee.handleMessage(createChunk(1, true, 6, 0, "a"));
+    EXPECT_TRUE(m_messages.empty());
+
+    testee.handleMessage(createChunk(1, true, 6, 4, "ef"));
+    EXPECT_EQ(m_messages, vector<string>({"abcdef"}));
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_largeMessage_shouldOnlyAllocateTheReceivedChunks)
+{
+    auto testee = createTestee();
+
+    testee.handleMessage(createChunk(1, true, 1024 * 1024, 0, "ab"));
+    testee.handleMessage(createChunk(1, true, 1024 * 1024, 2, "cd"));
+
+    EXPECT_EQ(testee.pendingMessageCount(), 1);
+    EXPECT_EQ(testee.pendingBytes(), 4);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_chunkAfterAGap_shouldOnlyAllocateTheChunk)
+{
+    auto testee = createTestee();
+
+    testee.handleMessage(createChunk(1, true, 1024 * 1024, 1024 * 1024 - 2, "yz"));
+
+    EXPECT_EQ(testee.pendingMessageCount(), 1);
+    EXPECT_EQ(testee.pendingBytes(), 2);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_anyChunks_shouldNotAllocateMoreThanTheMaxPendingBytes)
+{
+    constexpr size_t MaxPendingBytes = 16;
+    auto testee = createTestee(
+        DataChannelChunkReassembler::DefaultMaxMessageSize,
+        DataChannelChunkReassembler::DefaultMaxPendingMessageCount,
+        DataChannelChunkReassembler::DefaultTimeout,
+        MaxPendingBytes);
+
+    const vector<webrtc::DataBuffer> chunks{
+        createChunk(1, true, 10, 0, "012"),
+        createChunk(1, true, 10, 3, "345"),
+        createChunk(1, true, 10, 6, "678"),
+        createChunk(1, true, 10, 9, "9"),
+        createChunk(2, true, 10, 8, "ij"),
+        createChunk(2, true, 10, 0, "abc"),
+        createChunk(2, true, 10, 3, "defgh"),
+        createChunk(3, true, 14, 12, "mn"),
+        createChunk(3, true, 14, 0, "abcdefghijkl"),
+        createChunk(4, true, 20, 0, "0123456789"),
+        createChunk(4, true, 20, 10, "0123456789"),
+        createChunk(5, true, 10, 0, "abcdefghij")};
+    for (const auto& chunk : chunks)
+    {
+        testee.handleMessage(chunk);
+        EXPECT_LE(testee.pendingBytes() + testee.pooledBytes(), MaxPendingBytes);
+    }
+
+    EXPECT_EQ(m_messages, vector<string>({"0123456789", "abcdefghij", "abcdefghijklmn", "abcdefghij"}));
+    EXPECT_EQ(testee.pendingBytes(), 0);
+    EXPECT_EQ(testee.droppedMessageCount(), 1);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_tooManyPendingBytes_shouldDropTheOldest)
+{
+    auto testee = createTestee(
+        DataChannelChunkReassembler::DefaultMaxMessageSize,
+        DataChannelChunkReassembler::DefaultMaxPendingMessageCount,
+        DataChannelChunkReassembler::DefaultTimeout,
+        6);
+
+    testee.handleMessage(createChunk(1, true, 8, 0, "ab"));
+    this_thread::sleep_for(1ms);
+    testee.handleMessage(createChunk(2, true, 8, 0, "wx"));
+    EXPECT_EQ(testee.pendingBytes(), 4);
+
+    testee.handleMessage(createChunk(2, true, 8, 2, "yz"));
+    testee.handleMessage(createChunk(2, true, 8, 4, "01"));
+    EXPECT_EQ(testee.pendingMessageCount(), 1);
+    EXPECT_EQ(testee.pendingBytes(), 6);
+    EXPECT_EQ(testee.droppedMessageCount(), 1);
+
+    testee.handleMessage(createChunk(2, true, 8, 6, "23"));
+    EXPECT_TRUE(m_messages.empty());
+    EXPECT_EQ(testee.pendingMessageCount(), 0);
+    EXPECT_EQ(testee.pendingBytes(), 0);
+    EXPECT_EQ(testee.droppedMessageCount(), 2);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_invalidChunk_shouldDropTheMessage)
+{
+    auto testee = createTestee(8);
+
+    EXPECT_TRUE(testee.handleMessage(createChunk(1, true, 9, 0, "a")));
+    EXPECT_TRUE(testee.handleMessage(createChunk(2, true, 4, 3, "ab")));
+    EXPECT_TRUE(testee.handleMessage(createChunk(3, true, 4, 0, "ab")));
+    EXPECT_TRUE(testee.handleMessage(createChunk(3, true, 6, 2, "cd")));
+
+    EXPECT_TRUE(m_messages.empty());
+    EXPECT_EQ(testee.pendingMessageCount(), 0);
+    EXPECT_EQ(testee.droppedMessageCount(), 3);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_tooManyPendingMessages_shouldDropTheOldest)
+{
+    auto testee = createTestee(DataChannelChunkReassembler::DefaultMaxMessageSize, 2);
+
+    testee.handleMessage(createChunk(1, true, 4, 0, "ab"));
+    this_thread::sleep_for(1ms);
+    testee.handleMessage(createChunk(2, true, 4, 0, "ab"));
+    this_thread::sleep_for(1ms);
+    testee.handleMessage(createChunk(3, true, 4, 0, "ab"));
+    testee.handleMessage(createChunk(2, true, 4, 2, "cd"));
+    testee.handleMessage(createChunk(1, true, 4, 2, "cd"));
+
+    EXPECT_EQ(m_messages, vector<string>({"abcd"}));
+    EXPECT_EQ(testee.pendingMessageCount(), 2);
+    EXPECT_EQ(testee.droppedMessageCount(), 1);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, handleMessage_expiredMessage_shouldDropIt)
+{
+    auto testee = createTestee(
+        DataChannelChunkReassembler::DefaultMaxMessageSize,
+        DataChannelChunkReassembler::DefaultMaxPendingMessageCount,
+        1ms);
+
+    testee.handleMessage(createChunk(1, true, 4, 0, "ab"));
+    this_thread::sleep_for(5ms);
+    testee.handleMessage(createChunk(1, true, 4, 2, "cd"));
+
+    EXPECT_TRUE(m_messages.empty());
+    EXPECT_EQ(testee.pendingMessageCount(), 1);
+    EXPECT_EQ(testee.droppedMessageCount(), 1);
+}
+
+TEST_F(DataChannelChunkReassemblerTests, clear_shouldDropTheIncompleteMessages)
+{
+    auto testee = createTestee();
+
+    testee.handleMessage(createChunk(1, true, 4, 0, "ab"));
+    testee.clear();
+    EXPECT_EQ(testee.pendingBytes(), 0);
+    testee.handleMessage(createChunk(1, true, 4, 2, "cd"));
+
+    EXPECT_TRUE(m_messages.empty());
+    EXPECT_EQ(testee.pendingMessageCount(), 1);
+}
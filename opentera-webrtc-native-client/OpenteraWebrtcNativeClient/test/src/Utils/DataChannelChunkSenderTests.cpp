@@ -0,0 +1,176 @@
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelChunkSender.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace opentera;
+using namespace std;
+
+static webrtc::DataBuffer createMessage(size_t size)
+{
+    rtc::CopyOnWriteBuffer data(size);
+    for (size_t i = 0; i < size; i++)
+    {
+        data.MutableData()[i] = static_cast<uint8_t>(i);
+    }
+    return webrtc::DataBuffer(data, true);
+}
+
+class DataChannelChunkSenderTests : public ::testing::Test
+{
+protected:
+    vector<DataChannelChunkHeader> m_sentHeaders;
+    vector<size_t> m_sentPayloadSizes;
+    vector<function<void(bool)>> m_pendingCompletions;
+    bool m_isSynchronous = true;
+    bool m_sendResult = true;
+
+    DataChannelChunkSender createTestee(size_t maxChunkSize, size_t maxInFlightChunkCount = 4)
+    {
+        return DataChannelChunkSender(
+            [this](const webrtc::DataBuffer& buffer, function<void(bool)> onComplete)
+            {
+                if (!m_sendResult)
+                {
+                    return false;
+                }
+
+                auto header = DataChannelChunkHeader::read(buffer.data.cdata(), buffer.size());
+                EXPECT_TRUE(header.has_value());
+                m_sentHeaders.push_back(*header);
+                m_sentPayloadSizes.push_back(buffer.size() - DataChannelChunkHeader::Size);
+
+                if (m_isSynchronous)
+                {
+                    onComplete(true);
+                }
+                else
+                {
+                    m_pendingCompletions.push_back(move(onComplete));
+                }
+                return true;
+            },
+            maxChunkSize,
+            maxInFlightChunkCount);
+    }
+};
+
+TEST_F(DataChannelChunkSenderTests, send_smallMessage_shouldSendOneChunk)
+{
+    auto testee = createTestee(1024);
+    vector<bool> results;
+
+    EXPECT_TRUE(testee.send(createMessage(10), nullptr, [&](bool sent) { results.push_back(sent); }));
+
+    ASSERT_EQ(m_sentHeaders.size(), 1);
+    EXPECT_EQ(m_sentHeaders[0].totalSize, 10);
+    EXPECT_EQ(m_sentHeaders[0].offset, 0);
+    EXPECT_TRUE(m_sentHeaders[0].binary);
+    EXPECT_EQ(m_sentPayloadSizes[0], 10);
+    EXPECT_EQ(results, vector<bool>({true}));
+    EXPECT_EQ(testee.pendingMessageCount(), 0);
+}
+
+TEST_F(DataChannelChunkSenderTests, send_largeMessage_shouldSplitByMaxChunkSize)
+{
+    auto testee = createTestee(DataChannelChunkHeader::Size + 100);
+    vector<DataChannelTransferProgress> progresses;
+
+    EXPECT_TRUE(
+        testee.send(createMessage(250), [&](const DataChannelTransferProgress& p) { progresses.push_back(p); }));
+
+    ASSERT_EQ(m_sentHeaders.size(), 3);
+    EXPECT_EQ(m_sentHeaders[0].offset, 0);
+    EXPECT_EQ(m_sentHeaders[1].offset, 100);
+    EXPECT_EQ(m_sentHeaders[2].offset, 200);
+    EXPECT_EQ(m_sentPayloadSizes, vector<size_t>({100, 100, 50}));
+
+    ASSERT_EQ(progresses.size(), 3);
+    EXPECT_EQ(progresses[0].transferredBytes, 100);
+    EXPECT_EQ(progresses[1].transferredBytes, 200);
+    EXPECT_EQ(progresses[2].transferredBytes, 250);
+    EXPECT_EQ(progresses[2].totalBytes, 250);
+}
+
+TEST_F(DataChannelChunkSenderTests, send_twoMessages_shouldInterleaveTheirChunks)
+{
+    m_isSynchronous = false;
+    auto testee = createTestee(DataChannelChunkHeader::Size + 100, 1);
+
+    testee.send(createMessage(300));
+    testee.send(createMessage(300));
+    while (!m_pendingCompletions.empty())
+    {
+        auto onComplete = move(m_pendingCompletions.front());
+        m_pendingCompletions.erase(m_pendingCompletions.begin());
+        onComplete(true);
+    }
+
+    vector<uint32_t> messageIds;
+    for (const auto& header : m_sentHeaders)
+    {
+        messageIds.push_back(header.messageId);
+    }
+    EXPECT_EQ(messageIds, vector<uint32_t>({0, 1, 0, 1, 0, 1}));
+    EXPECT_EQ(testee.pendingMessageCount(), 0);
+}
+
+TEST_F(DataChannelChunkSenderTests, send_shouldLimitTheInFlightChunks)
+{
+    m_isSynchronous = false;
+    auto testee = createTestee(DataChannelChunkHeader::Size + 10, 2);
+
+    testee.send(createMessage(100));
+    EXPECT_EQ(m_sentHeaders.size(), 2);
+
+    auto onComplete = move(m_pendingCompletions.front());
+    m_pendingCompletions.erase(m_pendingCompletions.begin());
+    onComplete(true);
+    EXPECT_EQ(m_sentHeaders.size(), 3);
+}
+
+TEST_F(DataChannelChunkSenderTests, send_rejectedChunk_shouldFailTheMessage)
+{
+    m_sendResult = false;
+    auto testee = createTestee(1024);
+    vector<bool> results;
+
+    EXPECT_TRUE(testee.send(createMessage(10), nullptr, [&](bool sent) { results.push_back(sent); }));
+
+    EXPECT_EQ(results, vector<bool>({false}));
+    EXPECT_EQ(testee.pendingMessageCount(), 0);
+}
+
+TEST_F(DataChannelChunkSenderTests, send_failedChunk_shouldFailTheMessageOnce)
+{
+    m_isSynchronous = false;
+    auto testee = createTestee(DataChannelChunkHeader::Size + 10);
+    vector<bool> results;
+
+    testee.send(createMessage(100), nullptr, [&](bool sent) { results.push_back(sent); });
+    auto pendingCompletions = move(m_pendingCompletions);
+    for (auto& onComplete : pendingCompletions)
+    {
+        onComplete(false);
+    }
+
+    EXPECT_EQ(results, vector<bool>({false}));
+    EXPECT_EQ(testee.pendingMessageCount(), 0);
+}
+
+TEST_F(DataChannelChunkSenderTests, cancel_shouldCompleteThePendingMessages)
+{
+    m_isSynchronous = false;
+    auto testee = createTestee(DataChannelChunkHeader::Size + 10, 1);
+    vector<bool> results;
+
+    testee.send(createMessage(100), nullptr, [&](bool sent) { results.push_back(sent); });
+    testee.cancel();
+    m_pendingCompletions.front()(true);
+
+    EXPECT_EQ(results, vector<bool>({false}));
+    EXPECT_EQ(m_sentHeaders.size(), 1);
+    EXPECT_EQ(testee.pendingMessageCount(), 0);
+}
@@ -0,0 +1,242 @@
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelCompressor.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace opentera;
+using namespace std;
+
+static string createJsonMessage(int index)
+{
+    string message;
+    for (int i = 0; i < 20; i++)
+    {
+        message += R"({"type":"telemetry","index":)" + to_string(index + i) + R"(,"battery":0.98,"state":"idle"})";
+    }
+    return message;
+}
+
+static string toString(const webrtc::DataBuffer& buffer)
+{
+    return string(reinterpret_cast<const char*>(buffer.data.cdata()), buffer.size());
+}
+
+#define SKIP_IF_ZSTD_IS_NOT_SUPPORTED()                                                                                \
+    if (!DataChannelCompressor::isSupported(DataChannelCompressionCodec::Zstd))                                        \
+    {                                                                                                                  \
+        GTEST_SKIP() << "zstd is not supported";                                                                       \
+    }
+
+TEST(DataChannelCompressorTests, isSupported_none_shouldReturnTrue)
+{
+    EXPECT_TRUE(DataChannelCompressor::isSupported(DataChannelCompressionCodec::None));
+}
+
+TEST(DataChannelCompressorTests, compress_noneCodec_shouldReturnTheMessage)
+{
+    DataChannelCompressor testee(DataChannelCompressionCodec::None, 0);
+    string message = createJsonMessage(0);
+
+    webrtc::DataBuffer compressed = testee.compress(webrtc::DataBuffer(message));
+
+    EXPECT_FALSE(compressed.binary);
+    EXPECT_EQ(toString(compressed), message);
+    EXPECT_EQ(testee.stats().uncompressedMessageCount, 1);
+    EXPECT_EQ(testee.stats().compressedMessageCount, 0);
+}
+
+TEST(DataChannelCompressorTests, compress_messageBelowThreshold_shouldReturnTheMessage)
+{
+    SKIP_IF_ZSTD_IS_NOT_SUPPORTED();
+    DataChannelCompressor testee(DataChannelCompressionCodec::Zstd, 256);
+    string message(255, 'a');
+
+    webrtc::DataBuffer compressed = testee.compress(webrtc::DataBuffer(message));
+
+    EXPECT_FALSE(compressed.binary);
+    EXPECT_EQ(toString(compressed), message);
+    EXPECT_EQ(testee.stats().uncompressedMessageCount, 1);
+}
+
+TEST(DataChannelCompressorTests, compress_incompressibleMessage_shouldReturnTheMessage)
+{
+    SKIP_IF_ZSTD_IS_NOT_SUPPORTED();
+    DataChannelCompressor testee(DataChannelCompressionCodec::Zstd, 0);
+    rtc::CopyOnWriteBuffer data(512);
+    uint32_t state = 12345;
+    for (size_t i = 0; i < data.size(); i++)
+    {
+        state = state * 1103515245 + 12345;
+        data.MutableData()[i] = static_cast<uint8_t>(state >> 16);
+    }
+
+    webrtc::DataBuffer compressed = testee.compress(webrtc::DataBuffer(data, true));
+
+    EXPECT_EQ(compressed.size(), 512);
+    EXPECT_EQ(testee.stats().uncompressedMessageCount, 1);
+}
+
+TEST(DataChannelCompressorTests, compressDecompress_string_shouldReturnTheOriginalMessage)
+{
+    SKIP_IF_ZSTD_IS_NOT_SUPPORTED();
+    DataChannelCompressor sender(DataChannelCompressionCodec::Zstd);
+    DataChannelCompressor receiver(DataChannelCompressionCodec::Zstd);
+    string message = createJsonMessage(0);
+
+    webrtc::DataBuffer compressed = sender.compress(webrtc::DataBuffer(message));
+    optional<webrtc::DataBuffer> decompressed = receiver.decompress(compressed);
+
+    EXPECT_TRUE(compressed.binary);
+    EXPECT_LT(compressed.size(), message.size());
+    ASSERT_TRUE(decompressed.has_value());
+    EXPECT_FALSE(decompressed->binary);
+    EXPECT_EQ(toString(*decompressed), message);
+
+    DataChannelCompressionStats senderStats = sender.stats();
+    EXPECT_EQ(senderStats.compressedMessageCount, 1);
+    EXPECT_EQ(senderStats.uncompressedBytes, message.size());
+    EXPECT_EQ(senderStats.compressedBytes, compressed.size());
+    EXPECT_GT(senderStats.compressionRatio(), 1.0);
+    EXPECT_EQ(receiver.stats().decompressedMessageCount, 1);
+}
+
+TEST(DataChannelCompressorTests, compressDecompress_dictionary_shouldReturnTheOriginalMessageAndImproveTheRatio)
+{
+    SKIP_IF_ZSTD_IS_NOT_SUPPORTED();
+    string dictionaryString = createJsonMessage(1000);
+    vector<uint8_t> dictionary(dictionaryString.begin(), dictionaryString.end());
+    DataChannelCompressor senderWithoutDictionary(DataChannelCompressionCodec::Zstd, 0);
+    DataChannelCompressor sender(DataChannelCompressionCodec::Zstd, 0, DataChannelCompressor::DefaultLevel, dictionary);
+    DataChannelCompressor receiver(
+        DataChannelCompressionCodec::Zstd,
+        0,
+        DataChannelCompressor::DefaultLevel,
+        dictionary);
+    string message = R"({"type":"telemetry","index":42,"battery":0.98,"state":"idle"})";
+
+    webrtc::DataBuffer compressedWithoutDictionary = senderWithoutDictionary.compress(webrtc::DataBuffer(message));
+    webrtc::DataBuffer compressed = sender.compress(webrtc::DataBuffer(message));
+    optional<webrtc::DataBuffer> decompressed = receiver.decompress(compressed);
+
+    EXPECT_NE(sender.dictionaryId(), 0);
+    EXPECT_EQ(sender.dictionaryId(), receiver.dictionaryId());
+    EXPECT_LT(compressed.size(), compressedWithoutDictionary.size());
+    ASSERT_TRUE(decompressed.has_value());
+    EXPECT_EQ(toString(*decompressed), message);
+}
+
+TEST(DataChannelCompressorTests, decompress_otherDictionary_shouldReturnNullopt)
+{
+    SKIP_IF_ZSTD_IS_NOT_SUPPORTED();
+    string dictionaryString = createJsonMessage(1000);
+    DataChannelCompressor sender(
+        DataChannelCompressionCodec::Zstd,
+        0,
+        DataChannelCompressor::DefaultLevel,
+        vector<uint8_t>(dictionaryString.begin(), dictionaryString.end()));
+    DataChannelCompressor receiver(DataChannelCompressionCodec::Zstd);
+
+    webrtc::DataBuffer compressed = sender.compress(webrtc::DataBuffer(createJsonMessage(0)));
+
+    EXPECT_FALSE(receiver.decompress(compressed).has_value());
+    EXPECT_EQ(receiver.stats().decompressionErrorCount, 1);
+}
+
+TEST(DataChannelCompressorTests, decompress_corruptedPayload_shouldReturnNullopt)
+{
+    SKIP_IF_ZSTD_IS_NOT_SUPPORTED();
+    DataChannelCompressor testee(DataChannelCompressionCodec::Zstd);
+    webrtc::DataBuffer compressed = testee.compress(webrtc::DataBuffer(createJsonMessage(0)));
+    rtc::CopyOnWriteBuffer corrupted(compressed.data.cdata(), compressed.size() / 2);
+
+    EXPECT_FALSE(testee.decompress(webrtc::DataBuffer(corrupted, true)).has_value());
+    EXPECT_EQ(testee.stats().decompressionErrorCount, 1);
+}
+
+TEST(DataChannelCompressorTests, decompress_uncompressedMessage_shouldReturnTheMessage)
+{
+    DataChannelCompressor testee(DataChannelCompressionCodec::None);
+    uint8_t data[] = {1, 2, 3};
+
+    optional<webrtc::DataBuffer> decompressedString = testee.decompress(webrtc::DataBuffer("abc"));
+    optional<webrtc::DataBuffer> decompressedBinary =
+        testee.decompress(webrtc::DataBuffer(rtc::CopyOnWriteBuffer(data, sizeof(data)), true));
+
+    ASSERT_TRUE(decompressedString.has_value());
+    EXPECT_FALSE(decompressedString->binary);
+    EXPECT_EQ(toString(*decompressedString), "abc");
+    ASSERT_TRUE(decompressedBinary.has_value());
+    EXPECT_TRUE(decompressedBinary->binary);
+    EXPECT_EQ(decompressedBinary->size(), sizeof(data));
+    EXPECT_EQ(testee.stats().decompressionErrorCount, 0);
+}
+
+TEST(DataChannelCompressorTests, advertise_noneCodec_shouldReturnTheProtocol)
+{
+    DataChannelCompressor testee(DataChannelCompressionCodec::None);
+
+    EXPECT_EQ(testee.advertise(""), "");
+    EXPECT_EQ(testee.advertise("json"), "json");
+    EXPECT_FALSE(testee.isAdvertisedBy(testee.advertise("json")));
+}
+
+TEST(DataChannelCompressorTests, isAdvertisedBy_sameCodecAndDictionary_shouldReturnTrue)
+{
+    SKIP_IF_ZSTD_IS_NOT_SUPPORTED();
+    DataChannelCompressor sender(DataChannelCompressionCodec::Zstd);
+    DataChannelCompressor receiver(DataChannelCompressionCodec::Zstd);
+
+    string protocol = sender.advertise("json");
+
+    EXPECT_EQ(protocol.rfind("json;", 0), 0u);
+    EXPECT_TRUE(receiver.isAdvertisedBy(protocol));
+    EXPECT_TRUE(receiver.isAdvertisedBy(sender.advertise("")));
+}
+
+TEST(DataChannelCompressorTests, isAdvertisedBy_otherDictionaryOrNoCompression_shouldReturnFalse)
+{
+    SKIP_IF_ZSTD_IS_NOT_SUPPORTED();
+    string dictionaryString = createJsonMessage(1000);
+    DataChannelCompressor sender(
+        DataChannelCompressionCodec::Zstd,
+        0,
+        DataChannelCompressor::DefaultLevel,
+        vector<uint8_t>(dictionaryString.begin(), dictionaryString.end()));
+    DataChannelCompressor senderWithoutCompression(DataChannelCompressionCodec::None);
+    DataChannelCompressor receiver(DataChannelCompressionCodec::Zstd);
+
+    EXPECT_FALSE(receiver.isAdvertisedBy(sender.advertise("json")));
+    EXPECT_FALSE(receiver.isAdvertisedBy(senderWithoutCompression.advertise("json")));
+    EXPECT_FALSE(receiver.isAdvertisedBy(""));
+}
+
+TEST(DataChannelCompressorTests, isAcknowledgement_shouldOnlyReturnTrueForTheAcknowledgementOfTheSameDictionary)
+{
+    SKIP_IF_ZSTD_IS_NOT_SUPPORTED();
+    string dictionaryString = createJsonMessage(1000);
+    DataChannelCompressor receiver(DataChannelCompressionCodec::Zstd);
+    DataChannelCompressor otherReceiver(
+        DataChannelCompressionCodec::Zstd,
+        0,
+        DataChannelCompressor::DefaultLevel,
+        vector<uint8_t>(dictionaryString.begin(), dictionaryString.end()));
+    DataChannelCompressor testee(DataChannelCompressionCodec::Zstd, 0);
+
+    EXPECT_TRUE(testee.isAcknowledgement(receiver.createAcknowledgement()));
+    EXPECT_FALSE(testee.isAcknowledgement(otherReceiver.createAcknowledgement()));
+    EXPECT_FALSE(testee.isAcknowledgement(testee.compress(webrtc::DataBuffer(createJsonMessage(0)))));
+    EXPECT_FALSE(testee.isAcknowledgement(webrtc::DataBuffer("abc")));
+}
+
+TEST(DataChannelCompressorTests, resetStats_shouldResetTheStats)
+{
+    DataChannelCompressor testee(DataChannelCompressionCodec::None);
+    testee.compress(webrtc::DataBuffer("abc"));
+
+    testee.resetStats();
+
+    EXPECT_EQ(testee.stats().uncompressedMessageCount, 0);
+    EXPECT_EQ(testee.stats().compressionRatio(), 1.0);
+}
@@ -0,0 +1,172 @@
+#include <OpenteraWebrtcNativeClient/Utils/DataChannelSendQueue.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace opentera;
+using namespace std;
+
+class DataChannelSendQueueTests : public ::testing::Test
+{
+protected:
+    vector<string> m_sentMessages;
+    uint64_t m_bufferedAmount = 0;
+    bool m_sendResult = true;
+    // Called once after the buffered amount is read, to change it while the queue drains
+    function<void()> m_onBufferedAmountRead;
+
+    DataChannelSendQueue createTestee(uint64_t maxQueuedBytes = DataChannelSendQueue::DefaultMaxQueuedBytes)
+    {
+        return DataChannelSendQueue(
+            [this](const webrtc::DataBuffer& buffer)
+            {
+                if (m_sendResult)
+                {
+                    m_sentMessages.emplace_back(reinterpret_cast<const char*>(buffer.data.cdata()), buffer.size());
+                    m_bufferedAmount += buffer.size();
+                }
+                return m_sendResult;
+            },
+            [this]()
+            {
+                uint64_t bufferedAmount = m_bufferedAmount;
+                if (m_onBufferedAmountRead)
+                {
+                    auto onBufferedAmountRead = move(m_onBufferedAmountRead);
+                    m_onBufferedAmountRead = nullptr;
+                    onBufferedAmountRead();
+                }
+                return bufferedAmount;
+            },
+            10,
+            4,
+            maxQueuedBytes);
+    }
+};
+
+TEST_F(DataChannelSendQueueTests, send_belowHighWatermark_shouldSendImmediately)
+{
+    auto testee = createTestee();
+    vector<bool> results;
+
+    EXPECT_TRUE(testee.send(
+        webrtc::DataBuffer("abc"),
+        DataChannelSendPriority::Normal,
+        [&](bool sent) { results.push_back(sent); }));
+
+    EXPECT_EQ(m_sentMessages, vector<string>({"abc"}));
+    EXPECT_EQ(results, vector<bool>({true}));
+    EXPECT_EQ(testee.queuedMessageCount(), 0);
+}
+
+TEST_F(DataChannelSendQueueTests, send_aboveHighWatermark_shouldQueueUntilTheLowWatermark)
+{
+    auto testee = createTestee();
+
+    testee.send(webrtc::DataBuffer("12345678"));
+    testee.send(webrtc::DataBuffer("abcd"));
+    testee.send(webrtc::DataBuffer("efgh"));
+    EXPECT_EQ(m_sentMessages, vector<string>({"12345678"}));
+    EXPECT_EQ(testee.queuedMessageCount(), 2);
+    EXPECT_EQ(testee.queuedBytes(), 8);
+    EXPECT_TRUE(testee.isPaused());
+
+    m_bufferedAmount = 6;
+    testee.onBufferedAmountChange();
+    EXPECT_EQ(m_sentMessages.size(), 1);
+
+    m_bufferedAmount = 4;
+    testee.onBufferedAmountChange();
+    EXPECT_EQ(m_sentMessages, vector<string>({"12345678", "abcd"}));
+    EXPECT_EQ(testee.queuedMessageCount(), 1);
+
+    m_bufferedAmount = 0;
+    testee.onBufferedAmountChange();
+    EXPECT_EQ(m_sentMessages, vector<string>({"12345678", "abcd", "efgh"}));
+    EXPECT_EQ(testee.queuedMessageCount(), 0);
+}
+
+TEST_F(DataChannelSendQueueTests, send_bufferedAmountChangeDuringTheDrain_shouldNotStayPaused)
+{
+    auto testee = createTestee();
+    testee.send(webrtc::DataBuffer("12345678"));
+
+    m_onBufferedAmountRead = [&]()
+    {
+        m_bufferedAmount = 0;
+        testee.onBufferedAmountChange();
+    };
+    testee.send(webrtc::DataBuffer("abcd"));
+
+    EXPECT_EQ(m_sentMessages, vector<string>({"12345678", "abcd"}));
+    EXPECT_EQ(testee.queuedMessageCount(), 0);
+    EXPECT_FALSE(testee.isPaused());
+}
+
+TEST_F(DataChannelSendQueueTests, send_highPriority_shouldBeSentBeforeTheNormalMessages)
+{
+    auto testee = createTestee();
+
+    testee.send(webrtc::DataBuffer("12345678"));
+    testee.send(webrtc::DataBuffer("abcd"));
+    testee.send(webrtc::DataBuffer("x"), DataChannelSendPriority::High);
+    EXPECT_EQ(m_sentMessages, vector<string>({"12345678", "x"}));
+
+    testee.send(webrtc::DataBuffer("yz"), DataChannelSendPriority::High);
+    EXPECT_EQ(m_sentMessages, vector<string>({"12345678", "x"}));
+
+    m_bufferedAmount = 6;
+    testee.onBufferedAmountChange();
+    EXPECT_EQ(m_sentMessages, vector<string>({"12345678", "x", "yz"}));
+    EXPECT_EQ(testee.queuedMessageCount(), 1);
+}
+
+TEST_F(DataChannelSendQueueTests, send_largerThanHighWatermark_shouldBeSentWhenNothingIsBuffered)
+{
+    auto testee = createTestee();
+
+    testee.send(webrtc::DataBuffer("0123456789abcdef"));
+
+    EXPECT_EQ(m_sentMessages.size(), 1);
+}
+
+TEST_F(DataChannelSendQueueTests, send_fullQueue_shouldReturnFalse)
+{
+    auto testee = createTestee(4);
+    m_bufferedAmount = 10;
+
+    EXPECT_TRUE(testee.send(webrtc::DataBuffer("abcd")));
+    EXPECT_FALSE(testee.send(webrtc::DataBuffer("e")));
+}
+
+TEST_F(DataChannelSendQueueTests, send_failure_shouldCallTheCompletionCallbackWithFalse)
+{
+    auto testee = createTestee();
+    m_sendResult = false;
+    vector<bool> results;
+
+    EXPECT_TRUE(testee.send(
+        webrtc::DataBuffer("abc"),
+        DataChannelSendPriority::Normal,
+        [&](bool sent) { results.push_back(sent); }));
+
+    EXPECT_EQ(results, vector<bool>({false}));
+}
+
+TEST_F(DataChannelSendQueueTests, clear_shouldCallTheCompletionCallbacksWithFalse)
+{
+    auto testee = createTestee();
+    m_bufferedAmount = 10;
+    vector<bool> results;
+
+    auto onComplete = [&](bool sent) { results.push_back(sent); };
+    testee.send(webrtc::DataBuffer("abc"), DataChannelSendPriority::Normal, onComplete);
+    testee.send(webrtc::DataBuffer("def"), DataChannelSendPriority::High, onComplete);
+    testee.clear();
+
+    EXPECT_EQ(results, vector<bool>({false, false}));
+    EXPECT_EQ(testee.queuedMessageCount(), 0);
+    EXPECT_EQ(testee.queuedBytes(), 0);
+}
@@ -0,0 +1,18 @@
+#include <OpenteraWebrtcNativeClient/Utils/FieldTrials.h>
+
+#include <gtest/gtest.h>
+
+using namespace opentera;
+using namespace std;
+
+TEST(FieldTrialsTests, createPlayoutDelayFieldTrials_shouldForceThePlayoutDelay)
+{
+    EXPECT_EQ(createPlayoutDelayFieldTrials(10ms, 100ms), "WebRTC-ForcePlayoutDelay/min_ms:10,max_ms:100/");
+}
+
+TEST(FieldTrialsTests, createPlayoutDelayFieldTrials_zeroMaximum_shouldDisableTheRenderPacing)
+{
+    EXPECT_EQ(
+        createPlayoutDelayFieldTrials(0ms, 0ms),
+        "WebRTC-ForcePlayoutDelay/min_ms:0,max_ms:0/WebRTC-ZeroPlayoutDelay/min_pacing:0ms/");
+}
@@ -145,3 +145,44 @@ TEST_F(FunctionTaskTests, callSync_voidRecursive_shouldCallTheFunction)
     EXPECT_NEAR(chrono::duration_cast<chrono::milliseconds>(end - begin).count(), 0, 10);
     awaiter.wait(__FILE__, __LINE__);
 }
+
+TEST_F(FunctionTaskTests, callFuture_int_shouldCallTheFunctionAndNotWait)
+{
+    constexpr chrono::milliseconds SleepDuration = 100ms;
+
+    chrono::steady_clock::time_point begin = chrono::steady_clock::now();
+    future<int> result = callFuture(
+        m_thread.get(),
+        [this, SleepDuration]()
+        {
+            this_thread::sleep_for(SleepDuration);
+            EXPECT_TRUE(m_thread->IsCurrent());
+            return 10;
+        });
+    chrono::steady_clock::time_point end = chrono::steady_clock::now();
+
+    EXPECT_NEAR(chrono::duration_cast<chrono::milliseconds>(end - begin).count(), 0, 10);
+    EXPECT_EQ(result.wait_for(0s), future_status::timeout);
+    EXPECT_EQ(result.get(), 10);
+}
+
+TEST_F(FunctionTaskTests, callFuture_voidRecursive_shouldCallTheFunctionImmediately)
+{
+    bool flag = false;
+    callSync(
+        m_thread.get(),
+        [this, &flag]()
+        {
+            future<void> result = callFuture(m_thread.get(), [&flag]() { flag = true; });
+            EXPECT_EQ(result.wait_for(0s), future_status::ready);
+        });
+
+    EXPECT_TRUE(flag);
+}
+
+TEST_F(FunctionTaskTests, callFuture_exception_shouldStoreTheException)
+{
+    future<int> result = callFuture(m_thread.get(), []() -> int { throw runtime_error("error"); });
+
+    EXPECT_THROW(result.get(), runtime_error);
+}
@@ -0,0 +1,95 @@
+#include <OpenteraWebrtcNativeClient/Utils/VideoFreezeWatchdog.h>
+
+#include <gtest/gtest.h>
+
+using namespace opentera;
+using namespace std;
+
+constexpr int64_t Ms = 1000;
+
+static VideoFreezeWatchdogConfiguration createConfiguration()
+{
+    return VideoFreezeWatchdogConfiguration::create(1000ms, 300ms, 2, 3000ms);
+}
+
+TEST(VideoFreezeWatchdogTests, update_noDecodedFrame_shouldReturnNullopt)
+{
+    VideoFreezeWatchdog testee(createConfiguration());
+
+    EXPECT_EQ(testee.update(10000 * Ms), nullopt);
+    EXPECT_FALSE(testee.isFrozen());
+}
+
+TEST(VideoFreezeWatchdogTests, update_beforeFrozenTimeout_shouldReturnNullopt)
+{
+    VideoFreezeWatchdog testee(createConfiguration());
+    testee.onFrameDecoded(0);
+
+    EXPECT_EQ(testee.update(999 * Ms), nullopt);
+    EXPECT_FALSE(testee.isFrozen());
+}
+
+TEST(VideoFreezeWatchdogTests, update_frozen_shouldEscalateTheRecoverySteps)
+{
+    VideoFreezeWatchdog testee(createConfiguration());
+    testee.onFrameDecoded(0);
+
+    EXPECT_EQ(testee.update(1000 * Ms), VideoFreezeRecoveryStep::RequestKeyFrame);
+    EXPECT_TRUE(testee.isFrozen());
+    EXPECT_EQ(testee.update(1200 * Ms), nullopt);
+    EXPECT_EQ(testee.update(1300 * Ms), VideoFreezeRecoveryStep::RequestKeyFrame);
+    EXPECT_EQ(testee.update(1500 * Ms), nullopt);
+    EXPECT_EQ(testee.update(1600 * Ms), VideoFreezeRecoveryStep::RestartIce);
+    EXPECT_EQ(testee.update(4500 * Ms), nullopt);
+    EXPECT_EQ(testee.update(4600 * Ms), VideoFreezeRecoveryStep::Reconnect);
+    EXPECT_EQ(testee.update(10000 * Ms), nullopt);
+
+    VideoFreezeWatchdogStats stats = testee.stats();
+    EXPECT_EQ(stats.freezeCount, 1);
+    EXPECT_EQ(stats.recoveredFreezeCount, 0);
+    EXPECT_EQ(stats.keyFrameRequestCount, 2);
+    EXPECT_EQ(stats.iceRestartCount, 1);
+    EXPECT_EQ(stats.reconnectionCount, 1);
+}
+
+TEST(VideoFreezeWatchdogTests, onIceRestartSkipped_shouldReconnectAtTheNextUpdate)
+{
+    VideoFreezeWatchdog testee(createConfiguration());
+    testee.onFrameDecoded(0);
+    EXPECT_EQ(testee.update(1000 * Ms), VideoFreezeRecoveryStep::RequestKeyFrame);
+    EXPECT_EQ(testee.update(1300 * Ms), VideoFreezeRecoveryStep::RequestKeyFrame);
+    EXPECT_EQ(testee.update(1600 * Ms), VideoFreezeRecoveryStep::RestartIce);
+
+    testee.onIceRestartSkipped();
+
+    EXPECT_EQ(testee.update(1650 * Ms), VideoFreezeRecoveryStep::Reconnect);
+    EXPECT_EQ(testee.stats().iceRestartCount, 0);
+    EXPECT_EQ(testee.stats().reconnectionCount, 1);
+}
+
+TEST(VideoFreezeWatchdogTests, onFrameDecoded_frozen_shouldRestartTheEscalation)
+{
+    VideoFreezeWatchdog testee(createConfiguration());
+    testee.onFrameDecoded(0);
+    EXPECT_EQ(testee.update(1000 * Ms), VideoFreezeRecoveryStep::RequestKeyFrame);
+
+    testee.onFrameDecoded(1100 * Ms);
+
+    EXPECT_FALSE(testee.isFrozen());
+    EXPECT_EQ(testee.update(2000 * Ms), nullopt);
+    EXPECT_EQ(testee.update(2100 * Ms), VideoFreezeRecoveryStep::RequestKeyFrame);
+    EXPECT_EQ(testee.stats().freezeCount, 2);
+    EXPECT_EQ(testee.stats().recoveredFreezeCount, 1);
+}
+
+TEST(VideoFreezeWatchdogTests, reset_shouldDisarmTheWatchdog)
+{
+    VideoFreezeWatchdog testee(createConfiguration());
+    testee.onFrameDecoded(0);
+    EXPECT_EQ(testee.update(1000 * Ms), VideoFreezeRecoveryStep::RequestKeyFrame);
+
+    testee.reset();
+
+    EXPECT_FALSE(testee.isFrozen());
+    EXPECT_EQ(testee.update(10000 * Ms), nullopt);
+}